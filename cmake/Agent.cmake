@@ -230,6 +230,7 @@ target_link_libraries(shel_manager
 )
 
 add_library(core
+  fboss/agent/AclMatchEngine.cpp
   fboss/agent/AclNexthopHandler.cpp
   fboss/agent/ApplyThriftConfig.cpp
   fboss/agent/ArpCache.cpp
@@ -270,8 +271,10 @@ add_library(core
   fboss/agent/MPLSHandler.cpp
   fboss/agent/MultiHwSwitchHandler.cpp
   fboss/agent/MultiSwitchFb303Stats.cpp
+  fboss/agent/MultiSwitchPacketRings.cpp
   fboss/agent/MultiSwitchPacketStreamMap.cpp
   fboss/agent/NdpCache.cpp
+  fboss/agent/NeighborRefreshEngine.cpp
   fboss/agent/NeighborUpdater.cpp
   fboss/agent/NeighborUpdaterImpl.cpp
   fboss/agent/NeighborUpdaterNoopImpl.cpp
@@ -283,9 +286,12 @@ add_library(core
   fboss/agent/ResourceAccountant.cpp
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
+  fboss/agent/RxPacketClassifier.cpp
+  fboss/agent/RxSlowPathScheduler.cpp
   fboss/agent/StaticL2ForNeighborObserver.cpp
   fboss/agent/StaticL2ForNeighborUpdater.cpp
   fboss/agent/StaticL2ForNeighborSwSwitchUpdater.cpp
+  fboss/agent/StateUpdateBatchingPolicy.cpp
   fboss/agent/SwitchInfoTable.cpp
   fboss/agent/SwitchStatsObserver.cpp
   fboss/agent/SwSwitch.cpp
@@ -314,6 +320,7 @@ target_link_libraries(
   hwswitch_matcher
   state
   fsdb_model
+  fsdb_path_converter
   tuple_utils
   switch_reachability_cpp2
   switch_state_cpp2
@@ -383,6 +390,7 @@ set(core_libs
   ecmp_resource_manager
   thrift_method_rate_limit
   shel_manager
+  shm_packet_ring
 )
 
 target_link_libraries(core ${core_libs})
@@ -426,6 +434,7 @@ target_link_libraries(fboss_types
 
 add_library(fboss_event_base
   fboss/agent/FbossEventBase.h
+  fboss/agent/TimerWheel.cpp
 )
 
 target_link_libraries(fboss_event_base
@@ -593,6 +602,16 @@ target_link_libraries(route_update_wrapper
   Folly::folly
 )
 
+add_library(shm_packet_ring
+  fboss/agent/mnpu/SharedMemPacketRing.cpp
+)
+
+target_link_libraries(shm_packet_ring
+  error
+  fboss_types
+  Folly::folly
+)
+
 add_library(split_agent_thrift_syncer
   fboss/agent/mnpu/FdbEventSyncer.cpp
   fboss/agent/mnpu/HwSwitchStatsSinkClient.cpp
@@ -609,6 +628,7 @@ target_link_libraries(split_agent_thrift_syncer
   multiswitch_service
   Folly::folly
   hw_switch
+  shm_packet_ring
 )
 
 add_library(load_agent_config
@@ -67,6 +67,7 @@ add_library(prbs_stats_entry
 target_link_libraries(hw_switch_warmboot_helper
   async_logger
   utils
+  binary_dynamic
   common_file_utils
   Folly::folly
   sw_switch_warmboot_helper
@@ -168,6 +168,18 @@ target_link_libraries(hw_rib_resolution_speed
   Folly::follybenchmark
 )
 
+add_library(hw_rib_incremental_resolution_speed
+  fboss/agent/hw/benchmarks/HwRibIncrementalResolutionBenchmark.cpp
+)
+
+target_link_libraries(hw_rib_incremental_resolution_speed
+  config_factory
+  mono_agent_ensemble
+  mono_agent_benchmarks
+  Folly::folly
+  Folly::follybenchmark
+)
+
 add_library(hw_rib_sync_fib_speed
   fboss/agent/hw/benchmarks/HwRibSyncFibBenchmark.cpp
 )
@@ -208,6 +220,7 @@ target_link_libraries(hw_ecmp_shrink_speed
   mono_agent_ensemble
   mono_agent_benchmarks
   function_call_time_reporter
+  fb303::fb303
   Folly::folly
   Folly::follybenchmark
 )
@@ -297,6 +310,9 @@ target_link_libraries(hw_init_and_exit_benchmark_helper
   Folly::folly
   Folly::follybenchmark
   function_call_time_reporter
+  hw_switch_warmboot_helper
+  binary_dynamic
+  common_file_utils
 )
 
 add_library(hw_init_and_exit_40Gx10G
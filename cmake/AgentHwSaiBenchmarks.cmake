@@ -433,6 +433,24 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_rib_incremental_resolution_speed-${SAI_IMPL_NAME} /dev/null)
+
+  target_link_libraries(sai_rib_incremental_resolution_speed-${SAI_IMPL_NAME}
+    -Wl,--whole-archive
+    hw_rib_incremental_resolution_speed
+    mono_sai_agent_benchmarks_main
+    route_scale_gen
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_rib_incremental_resolution_speed-${SAI_IMPL_NAME}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
   add_executable(sai_rib_sync_fib_speed-${SAI_IMPL_NAME} /dev/null)
 
   target_link_libraries(sai_rib_sync_fib_speed-${SAI_IMPL_NAME}
@@ -597,6 +615,9 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_rib_resolution_speed-sai_impl)
+  install(
+    TARGETS
+    sai_rib_incremental_resolution_speed-sai_impl)
   install(
     TARGETS
     sai_switch_reachability_change_speed-sai_impl)
@@ -11,6 +11,7 @@ add_library(sai_store
 
 target_link_libraries(sai_store
   sai_api
+  binary_dynamic
   ref_map
   tuple_utils
 )
@@ -6,6 +6,7 @@
 add_library(packet
   fboss/agent/Packet.cpp
   fboss/agent/TxPacket.cpp
+  fboss/agent/TxPacketPool.cpp
   fboss/agent/packet/ArpHdr.cpp
   fboss/agent/packet/DHCPv4Packet.cpp
   fboss/agent/packet/DHCPv6Packet.cpp
@@ -4,6 +4,7 @@
 # cmake/FooBar.cmake
 
 add_library(radix_tree
+  fboss/lib/MultibitTrie.h
   fboss/lib/RadixTree.h
   fboss/lib/RadixTree-inl.h
 )
@@ -224,3 +225,12 @@ target_link_libraries(warm_boot_file_utils
   state
   Folly::folly
 )
+
+add_library(binary_dynamic
+  fboss/lib/BinaryDynamic.cpp
+)
+
+target_link_libraries(binary_dynamic
+  fmt::fmt
+  Folly::folly
+)
@@ -91,3 +91,16 @@ target_link_libraries(platform_manager_presence_checker_test
 )
 
 gtest_discover_tests(platform_manager_presence_checker_test)
+
+add_executable(platform_manager_exploration_scheduler_test
+  fboss/platform/platform_manager/tests/ExplorationSchedulerTest.cpp
+)
+
+target_link_libraries(platform_manager_exploration_scheduler_test
+  platform_manager_platform_explorer
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(platform_manager_exploration_scheduler_test)
@@ -0,0 +1,641 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AclMatchEngine.h"
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/hash/Hash.h>
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+#include <limits>
+
+DEFINE_bool(
+    acl_match_engine,
+    false,
+    "Keep a software classifier of the ingress ACLs in sync with the switch "
+    "state, to find the ACL a packet would hit without the ASIC");
+
+namespace facebook::fboss {
+
+namespace {
+
+using Key = AclClassifier::Key;
+using Rule = AclClassifier::Rule;
+
+/*
+ * Key layout, the ACL qualifiers and the packet header fields they match:
+ *  0-1: source IP, IPv4 as IPv4-mapped IPv6
+ *  2-3: destination IP, same
+ *  4:   proto, dscp, ttl, tcp flags, icmp type, icmp code and ether type
+ *  5:   L4 source and destination ports, source and destination ports
+ *  6:   destination MAC
+ *  7:   VLAN, L2/neighbor/route lookup classes and packet lookup result
+ *  8:   flags, for the presence of optional fields and packet properties
+ */
+constexpr size_t kSrcIpWord = 0;
+constexpr size_t kDstIpWord = 2;
+constexpr size_t kL3Word = 4;
+constexpr size_t kPortWord = 5;
+constexpr size_t kMacWord = 6;
+constexpr size_t kLookupWord = 7;
+constexpr size_t kFlagWord = 8;
+
+// shifts in kL3Word
+constexpr int kProtoShift = 0;
+constexpr int kDscpShift = 8;
+constexpr int kTtlShift = 16;
+constexpr int kTcpFlagsShift = 24;
+constexpr int kIcmpTypeShift = 32;
+constexpr int kIcmpCodeShift = 40;
+constexpr int kEtherTypeShift = 48;
+// shifts in kPortWord
+constexpr int kL4SrcPortShift = 0;
+constexpr int kL4DstPortShift = 16;
+constexpr int kSrcPortShift = 32;
+constexpr int kDstPortShift = 48;
+// shifts in kLookupWord
+constexpr int kVlanShift = 0;
+constexpr int kClassL2Shift = 32;
+constexpr int kClassNeighborShift = 40;
+constexpr int kClassRouteShift = 48;
+constexpr int kLookupResultShift = 56;
+
+enum Flag : uint64_t {
+  SRC_IP = 1 << 0,
+  DST_IP = 1 << 1,
+  IPV4 = 1 << 2,
+  IPV6 = 1 << 3,
+  ARP_REQUEST = 1 << 4,
+  ARP_REPLY = 1 << 5,
+  FRAGMENT = 1 << 6,
+  NON_FIRST_FRAGMENT = 1 << 7,
+  TCP_FLAGS = 1 << 8,
+  ICMP_TYPE = 1 << 9,
+  ICMP_CODE = 1 << 10,
+  L4_SRC_PORT = 1 << 11,
+  L4_DST_PORT = 1 << 12,
+  SRC_PORT = 1 << 13,
+  DST_PORT = 1 << 14,
+  DST_MAC = 1 << 15,
+  VLAN = 1 << 16,
+  CLASS_L2 = 1 << 17,
+  CLASS_NEIGHBOR = 1 << 18,
+  CLASS_ROUTE = 1 << 19,
+  LOOKUP_RESULT = 1 << 20,
+};
+
+constexpr uint8_t kTcpFlagsMask = 0x3F;
+constexpr uint8_t kDscpMask = 0x3F;
+
+void setField(
+    Rule& rule,
+    size_t word,
+    int shift,
+    uint64_t bits,
+    uint64_t value,
+    uint64_t flag = 0) {
+  uint64_t mask = (bits == 64 ? ~0ULL : ((1ULL << bits) - 1)) << shift;
+  rule.mask[word] |= mask;
+  rule.value[word] = (rule.value[word] & ~mask) | ((value << shift) & mask);
+  rule.mask[kFlagWord] |= flag;
+  rule.value[kFlagWord] |= flag;
+}
+
+void setFlags(Rule& rule, uint64_t mask, uint64_t value) {
+  rule.mask[kFlagWord] |= mask;
+  rule.value[kFlagWord] = (rule.value[kFlagWord] & ~mask) | (value & mask);
+}
+
+// the 128 bits of the address, IPv4 addresses as IPv4-mapped IPv6
+std::pair<uint64_t, uint64_t> ipBits(const folly::IPAddress& ip) {
+  auto v6 = ip.isV4() ? ip.asV4().createIPv6() : ip.asV6();
+  auto bytes = v6.toByteArray();
+  uint64_t hi = 0;
+  uint64_t lo = 0;
+  for (int i = 0; i < 8; ++i) {
+    hi = (hi << 8) | bytes[i];
+    lo = (lo << 8) | bytes[i + 8];
+  }
+  return {hi, lo};
+}
+
+void setNetwork(
+    Rule& rule,
+    size_t word,
+    const folly::CIDRNetwork& network,
+    uint64_t flag) {
+  auto [hi, lo] = ipBits(network.first);
+  // IPv4-mapped addresses share their first 96 bits
+  uint32_t prefixLen = network.second + (network.first.isV4() ? 96 : 0);
+  uint64_t hiMask = prefixLen >= 64 ? ~0ULL
+      : prefixLen == 0              ? 0
+                                    : ~0ULL << (64 - prefixLen);
+  uint64_t loMask = prefixLen <= 64 ? 0
+      : prefixLen >= 128            ? ~0ULL
+                                    : ~0ULL << (128 - prefixLen);
+  rule.mask[word] |= hiMask;
+  rule.mask[word + 1] |= loMask;
+  rule.value[word] = hi & hiMask;
+  rule.value[word + 1] = lo & loMask;
+  setFlags(
+      rule, flag | IPV4 | IPV6, flag | (network.first.isV4() ? IPV4 : IPV6));
+}
+
+// empty for entries that never match
+std::vector<Rule> compileEntry(const AclEntry& entry) {
+  if (entry.isEnabled().has_value() && !entry.isEnabled().value()) {
+    return {};
+  }
+  if (entry.getUdfGroups() || entry.getRoceOpcode() || entry.getRoceBytes() ||
+      entry.getRoceMask() || entry.getUdfTable()) {
+    return {};
+  }
+
+  Rule rule;
+  if (auto srcIp = entry.getSrcIp(); srcIp.first) {
+    setNetwork(rule, kSrcIpWord, srcIp, SRC_IP);
+  }
+  if (auto dstIp = entry.getDstIp(); dstIp.first) {
+    setNetwork(rule, kDstIpWord, dstIp, DST_IP);
+  }
+  if (auto proto = entry.getProto()) {
+    setField(rule, kL3Word, kProtoShift, 8, *proto);
+  }
+  if (auto dscp = entry.getDscp()) {
+    setField(rule, kL3Word, kDscpShift, 6, *dscp & kDscpMask);
+  }
+  if (auto ttl = entry.getTtl()) {
+    uint64_t mask = ttl->getMask() & 0xFF;
+    rule.mask[kL3Word] |= mask << kTtlShift;
+    rule.value[kL3Word] |= (ttl->getValue() & mask) << kTtlShift;
+  }
+  if (auto tcpFlags = entry.getTcpFlagsBitMap()) {
+    setField(
+        rule,
+        kL3Word,
+        kTcpFlagsShift,
+        6,
+        *tcpFlags & kTcpFlagsMask,
+        TCP_FLAGS);
+  }
+  if (auto icmpType = entry.getIcmpType()) {
+    setField(rule, kL3Word, kIcmpTypeShift, 8, *icmpType, ICMP_TYPE);
+  }
+  if (auto icmpCode = entry.getIcmpCode()) {
+    setField(rule, kL3Word, kIcmpCodeShift, 8, *icmpCode, ICMP_CODE);
+  }
+  if (auto etherType = entry.getEtherType();
+      etherType && *etherType != cfg::EtherType::ANY) {
+    setField(
+        rule,
+        kL3Word,
+        kEtherTypeShift,
+        16,
+        static_cast<uint16_t>(*etherType));
+  }
+  if (auto port = entry.getL4SrcPort()) {
+    setField(rule, kPortWord, kL4SrcPortShift, 16, *port, L4_SRC_PORT);
+  }
+  if (auto port = entry.getL4DstPort()) {
+    setField(rule, kPortWord, kL4DstPortShift, 16, *port, L4_DST_PORT);
+  }
+  if (auto port = entry.getSrcPort()) {
+    setField(rule, kPortWord, kSrcPortShift, 16, *port, SRC_PORT);
+  }
+  if (auto port = entry.getDstPort()) {
+    setField(rule, kPortWord, kDstPortShift, 16, *port, DST_PORT);
+  }
+  if (auto dstMac = entry.getDstMac()) {
+    setField(rule, kMacWord, 0, 48, dstMac->u64HBO(), DST_MAC);
+  }
+  if (auto vlan = entry.getVlanID()) {
+    setField(rule, kLookupWord, kVlanShift, 32, *vlan, VLAN);
+  }
+  if (auto lookupClass = entry.getLookupClassL2()) {
+    setField(
+        rule,
+        kLookupWord,
+        kClassL2Shift,
+        8,
+        static_cast<uint64_t>(*lookupClass),
+        CLASS_L2);
+  }
+  if (auto lookupClass = entry.getLookupClassNeighbor()) {
+    setField(
+        rule,
+        kLookupWord,
+        kClassNeighborShift,
+        8,
+        static_cast<uint64_t>(*lookupClass),
+        CLASS_NEIGHBOR);
+  }
+  if (auto lookupClass = entry.getLookupClassRoute()) {
+    setField(
+        rule,
+        kLookupWord,
+        kClassRouteShift,
+        8,
+        static_cast<uint64_t>(*lookupClass),
+        CLASS_ROUTE);
+  }
+  if (auto lookupResult = entry.getPacketLookupResult()) {
+    setField(
+        rule,
+        kLookupWord,
+        kLookupResultShift,
+        8,
+        static_cast<uint64_t>(*lookupResult),
+        LOOKUP_RESULT);
+  }
+  if (auto ipFrag = entry.getIpFrag()) {
+    switch (*ipFrag) {
+      case cfg::IpFragMatch::MATCH_NOT_FRAGMENTED:
+        setFlags(rule, FRAGMENT, 0);
+        break;
+      case cfg::IpFragMatch::MATCH_FIRST_FRAGMENT:
+        setFlags(rule, FRAGMENT | NON_FIRST_FRAGMENT, FRAGMENT);
+        break;
+      case cfg::IpFragMatch::MATCH_NOT_FRAGMENTED_OR_FIRST_FRAGMENT:
+        setFlags(rule, NON_FIRST_FRAGMENT, 0);
+        break;
+      case cfg::IpFragMatch::MATCH_NOT_FIRST_FRAGMENT:
+        setFlags(rule, NON_FIRST_FRAGMENT, NON_FIRST_FRAGMENT);
+        break;
+      case cfg::IpFragMatch::MATCH_ANY_FRAGMENT:
+        setFlags(rule, FRAGMENT, FRAGMENT);
+        break;
+    }
+  }
+
+  // an entry for either IP version, qualifying on the IP type, needs one
+  // rule per version
+  auto withFlags = [&rule](uint64_t mask, uint64_t value) {
+    auto copy = rule;
+    setFlags(copy, mask, value);
+    return copy;
+  };
+  auto ipType = entry.getIpType().value_or(cfg::IpType::ANY);
+  switch (ipType) {
+    case cfg::IpType::ANY:
+      return {rule};
+    case cfg::IpType::IP:
+      if (rule.mask[kFlagWord] & (IPV4 | IPV6)) {
+        // already constrained by the IP addresses
+        return {rule};
+      }
+      return {withFlags(IPV4, IPV4), withFlags(IPV6, IPV6)};
+    case cfg::IpType::IP4:
+      return {withFlags(IPV4, IPV4)};
+    case cfg::IpType::IP6:
+      return {withFlags(IPV6, IPV6)};
+    case cfg::IpType::ARP_REQUEST:
+      return {withFlags(ARP_REQUEST, ARP_REQUEST)};
+    case cfg::IpType::ARP_REPLY:
+      return {withFlags(ARP_REPLY, ARP_REPLY)};
+    case cfg::IpType::NON_IP:
+      return {withFlags(IPV4 | IPV6, 0)};
+  }
+  return {rule};
+}
+
+Key headersKey(const AclPacketHeaders& headers) {
+  Key key{};
+  auto& flags = key[kFlagWord];
+  auto setIp = [&key, &flags](size_t word, const folly::IPAddress& ip) {
+    auto [hi, lo] = ipBits(ip);
+    key[word] = hi;
+    key[word + 1] = lo;
+    flags |= ip.isV4() ? IPV4 : IPV6;
+  };
+  if (headers.srcIp) {
+    setIp(kSrcIpWord, *headers.srcIp);
+    flags |= SRC_IP;
+  }
+  if (headers.dstIp) {
+    setIp(kDstIpWord, *headers.dstIp);
+    flags |= DST_IP;
+  }
+  if (headers.arpOp) {
+    flags |= *headers.arpOp == AclPacketHeaders::ArpOp::REQUEST ? ARP_REQUEST
+                                                                 : ARP_REPLY;
+  }
+  switch (headers.fragment) {
+    case AclPacketHeaders::Fragment::NOT_FRAGMENTED:
+      break;
+    case AclPacketHeaders::Fragment::FIRST_FRAGMENT:
+      flags |= FRAGMENT;
+      break;
+    case AclPacketHeaders::Fragment::NON_FIRST_FRAGMENT:
+      flags |= FRAGMENT | NON_FIRST_FRAGMENT;
+      break;
+  }
+
+  auto set = [&key, &flags](
+                 size_t word, int shift, uint64_t value, uint64_t flag = 0) {
+    key[word] |= value << shift;
+    flags |= flag;
+  };
+  set(kL3Word, kProtoShift, headers.proto);
+  set(kL3Word, kDscpShift, headers.dscp & kDscpMask);
+  set(kL3Word, kTtlShift, headers.ttl);
+  set(kL3Word, kEtherTypeShift, headers.etherType);
+  if (headers.tcpFlags) {
+    set(kL3Word, kTcpFlagsShift, *headers.tcpFlags & kTcpFlagsMask, TCP_FLAGS);
+  }
+  if (headers.icmpType) {
+    set(kL3Word, kIcmpTypeShift, *headers.icmpType, ICMP_TYPE);
+  }
+  if (headers.icmpCode) {
+    set(kL3Word, kIcmpCodeShift, *headers.icmpCode, ICMP_CODE);
+  }
+  if (headers.l4SrcPort) {
+    set(kPortWord, kL4SrcPortShift, *headers.l4SrcPort, L4_SRC_PORT);
+  }
+  if (headers.l4DstPort) {
+    set(kPortWord, kL4DstPortShift, *headers.l4DstPort, L4_DST_PORT);
+  }
+  if (headers.srcPort) {
+    set(kPortWord, kSrcPortShift, uint16_t(*headers.srcPort), SRC_PORT);
+  }
+  if (headers.dstPort) {
+    set(kPortWord, kDstPortShift, uint16_t(*headers.dstPort), DST_PORT);
+  }
+  if (headers.dstMac) {
+    set(kMacWord, 0, headers.dstMac->u64HBO(), DST_MAC);
+  }
+  if (headers.vlanID) {
+    set(kLookupWord, kVlanShift, *headers.vlanID, VLAN);
+  }
+  if (headers.lookupClassL2) {
+    set(kLookupWord,
+        kClassL2Shift,
+        static_cast<uint8_t>(*headers.lookupClassL2),
+        CLASS_L2);
+  }
+  if (headers.lookupClassNeighbor) {
+    set(kLookupWord,
+        kClassNeighborShift,
+        static_cast<uint8_t>(*headers.lookupClassNeighbor),
+        CLASS_NEIGHBOR);
+  }
+  if (headers.lookupClassRoute) {
+    set(kLookupWord,
+        kClassRouteShift,
+        static_cast<uint8_t>(*headers.lookupClassRoute),
+        CLASS_ROUTE);
+  }
+  if (headers.packetLookupResult) {
+    set(kLookupWord,
+        kLookupResultShift,
+        static_cast<uint8_t>(*headers.packetLookupResult),
+        LOOKUP_RESULT);
+  }
+  return key;
+}
+
+Key maskKey(const Key& key, const Key& mask) {
+  Key masked;
+  for (size_t i = 0; i < masked.size(); ++i) {
+    masked[i] = key[i] & mask[i];
+  }
+  return masked;
+}
+
+} // namespace
+
+size_t AclClassifier::KeyHash::operator()(const Key& key) const {
+  return folly::hash::hash_range(key.begin(), key.end());
+}
+
+AclClassifier::AclClassifier() {}
+
+AclClassifier::~AclClassifier() {}
+
+void AclClassifier::addEntry(const std::shared_ptr<AclEntry>& entry) {
+  removeEntry(entry->getID());
+  CompiledEntry compiled{entry->getPriority(), compileEntry(*entry)};
+  if (compiled.rules.empty()) {
+    ++numUnsupported_;
+  }
+  for (const auto& rule : compiled.rules) {
+    insertRule(rule, entry);
+  }
+  entries_.emplace(entry->getID(), std::move(compiled));
+  sortTuples();
+}
+
+void AclClassifier::removeEntry(const std::string& name) {
+  auto it = entries_.find(name);
+  if (it == entries_.end()) {
+    return;
+  }
+  if (it->second.rules.empty()) {
+    --numUnsupported_;
+  }
+  for (const auto& rule : it->second.rules) {
+    removeRule(rule, name);
+  }
+  entries_.erase(it);
+  sortTuples();
+}
+
+void AclClassifier::clear() {
+  entries_.clear();
+  tuples_.clear();
+  sortedTuples_.clear();
+  numUnsupported_ = 0;
+}
+
+void AclClassifier::build(const std::shared_ptr<const AclMap>& acls) {
+  clear();
+  if (!acls) {
+    return;
+  }
+  for (const auto& iter : *acls) {
+    addEntry(iter.second);
+  }
+}
+
+void AclClassifier::insertRule(
+    const Rule& rule,
+    const std::shared_ptr<AclEntry>& entry) {
+  auto& tuple = tuples_[rule.mask];
+  if (!tuple) {
+    tuple = std::make_unique<Tuple>();
+    tuple->mask = rule.mask;
+    tuple->bestPriority = entry->getPriority();
+  }
+  auto& ruleEntries = tuple->rules[rule.value];
+  RuleEntry ruleEntry{entry->getPriority(), entry};
+  ruleEntries.insert(
+      std::upper_bound(
+          ruleEntries.begin(),
+          ruleEntries.end(),
+          ruleEntry,
+          [](const auto& lhs, const auto& rhs) {
+            return lhs.priority < rhs.priority;
+          }),
+      std::move(ruleEntry));
+  tuple->bestPriority = std::min(tuple->bestPriority, entry->getPriority());
+}
+
+void AclClassifier::removeRule(const Rule& rule, const std::string& name) {
+  auto tupleIt = tuples_.find(rule.mask);
+  if (tupleIt == tuples_.end()) {
+    return;
+  }
+  auto& tuple = *tupleIt->second;
+  auto rulesIt = tuple.rules.find(rule.value);
+  if (rulesIt == tuple.rules.end()) {
+    return;
+  }
+  auto& ruleEntries = rulesIt->second;
+  auto removedPriority = std::numeric_limits<int>::max();
+  ruleEntries.erase(
+      std::remove_if(
+          ruleEntries.begin(),
+          ruleEntries.end(),
+          [&](const auto& ruleEntry) {
+            if (ruleEntry.entry->getID() != name) {
+              return false;
+            }
+            removedPriority = ruleEntry.priority;
+            return true;
+          }),
+      ruleEntries.end());
+  if (ruleEntries.empty()) {
+    tuple.rules.erase(rulesIt);
+  }
+  if (tuple.rules.empty()) {
+    tuples_.erase(tupleIt);
+  } else if (removedPriority == tuple.bestPriority) {
+    tuple.bestPriority = std::numeric_limits<int>::max();
+    for (const auto& [value, remaining] : tuple.rules) {
+      tuple.bestPriority =
+          std::min(tuple.bestPriority, remaining.front().priority);
+    }
+  }
+}
+
+void AclClassifier::sortTuples() {
+  sortedTuples_.clear();
+  sortedTuples_.reserve(tuples_.size());
+  for (const auto& [mask, tuple] : tuples_) {
+    sortedTuples_.push_back(tuple.get());
+  }
+  std::sort(
+      sortedTuples_.begin(),
+      sortedTuples_.end(),
+      [](const Tuple* lhs, const Tuple* rhs) {
+        return lhs->bestPriority < rhs->bestPriority;
+      });
+}
+
+std::shared_ptr<AclEntry> AclClassifier::match(
+    const AclPacketHeaders& headers) const {
+  auto key = headersKey(headers);
+  const RuleEntry* best = nullptr;
+  for (const auto* tuple : sortedTuples_) {
+    if (best && tuple->bestPriority >= best->priority) {
+      // no rule of this or the remaining tuples can beat best
+      break;
+    }
+    auto it = tuple->rules.find(maskKey(key, tuple->mask));
+    if (it == tuple->rules.end()) {
+      continue;
+    }
+    const auto& candidate = it->second.front();
+    if (!best || candidate.priority < best->priority) {
+      best = &candidate;
+    }
+  }
+  return best ? best->entry : nullptr;
+}
+
+bool AclClassifier::Rule::matches(const Key& key) const {
+  return maskKey(key, mask) == value;
+}
+
+std::vector<AclClassifier::Rule> AclClassifier::compile(
+    const AclEntry& entry) {
+  return compileEntry(entry);
+}
+
+AclClassifier::Key AclClassifier::packetKey(const AclPacketHeaders& headers) {
+  return headersKey(headers);
+}
+
+bool AclClassifier::matches(
+    const AclEntry& entry,
+    const AclPacketHeaders& headers) {
+  auto key = headersKey(headers);
+  auto rules = compileEntry(entry);
+  return std::any_of(rules.begin(), rules.end(), [&key](const Rule& rule) {
+    return rule.matches(key);
+  });
+}
+
+AclMatchEngine::AclMatchEngine(SwSwitch* sw) : sw_(sw) {
+  sw_->registerStateObserver(this, "AclMatchEngine");
+}
+
+AclMatchEngine::~AclMatchEngine() {
+  sw_->unregisterStateObserver(this);
+}
+
+void AclMatchEngine::stateUpdated(const StateDelta& delta) {
+  auto aclsDelta = FLAGS_enable_acl_table_group
+      ? delta.getAclsDelta(
+            cfg::AclStage::INGRESS,
+            cfg::switch_config_constants::DEFAULT_INGRESS_ACL_TABLE())
+      : delta.getAclsDelta();
+  // the delta is ordered by priority, an entry moving to another priority is
+  // both removed and added, in either order: remove first
+  std::vector<std::string> removed;
+  std::vector<std::shared_ptr<AclEntry>> added;
+  DeltaFunctions::forEachChanged(
+      aclsDelta,
+      [&](const std::shared_ptr<AclEntry>& oldAcl,
+          const std::shared_ptr<AclEntry>& newAcl) {
+        if (oldAcl->getID() != newAcl->getID()) {
+          removed.push_back(oldAcl->getID());
+        }
+        added.push_back(newAcl);
+      },
+      [&](const std::shared_ptr<AclEntry>& addedAcl) {
+        added.push_back(addedAcl);
+      },
+      [&](const std::shared_ptr<AclEntry>& removedAcl) {
+        removed.push_back(removedAcl->getID());
+      });
+  if (removed.empty() && added.empty()) {
+    return;
+  }
+
+  auto classifier = classifier_.wlock();
+  for (const auto& name : removed) {
+    classifier->removeEntry(name);
+  }
+  for (const auto& acl : added) {
+    classifier->addEntry(acl);
+  }
+  XLOG(DBG2) << "ACL match engine: " << removed.size() << " ACLs removed, "
+             << added.size() << " added or changed, "
+             << classifier->numEntries() << " ACLs in "
+             << classifier->numTuples() << " tuples";
+}
+
+} // namespace facebook::fboss
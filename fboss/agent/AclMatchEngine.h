@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+#include <folly/MacAddress.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+DECLARE_bool(acl_match_engine);
+
+namespace facebook::fboss {
+
+class AclEntry;
+class AclMap;
+class StateDelta;
+class SwSwitch;
+
+/*
+ * The packet headers (and lookup results) ACL entries qualify on. Unset
+ * fields are absent from the packet, and never match an ACL entry qualifying
+ * on them.
+ */
+struct AclPacketHeaders {
+  enum class Fragment {
+    NOT_FRAGMENTED,
+    FIRST_FRAGMENT,
+    NON_FIRST_FRAGMENT,
+  };
+  enum class ArpOp {
+    REQUEST,
+    REPLY,
+  };
+
+  std::optional<PortID> srcPort;
+  std::optional<PortID> dstPort;
+  std::optional<uint32_t> vlanID;
+  std::optional<folly::MacAddress> dstMac;
+  uint16_t etherType{0};
+  std::optional<ArpOp> arpOp;
+  // IP headers, unset for non IP packets
+  std::optional<folly::IPAddress> srcIp;
+  std::optional<folly::IPAddress> dstIp;
+  uint8_t proto{0};
+  uint8_t dscp{0};
+  uint8_t ttl{0};
+  Fragment fragment{Fragment::NOT_FRAGMENTED};
+  std::optional<uint8_t> tcpFlags;
+  std::optional<uint16_t> l4SrcPort;
+  std::optional<uint16_t> l4DstPort;
+  std::optional<uint8_t> icmpType;
+  std::optional<uint8_t> icmpCode;
+  // lookup results
+  std::optional<cfg::AclLookupClass> lookupClassL2;
+  std::optional<cfg::AclLookupClass> lookupClassNeighbor;
+  std::optional<cfg::AclLookupClass> lookupClassRoute;
+  std::optional<cfg::PacketLookupResultType> packetLookupResult;
+};
+
+/*
+ * Software classifier of packets against a set of ACL entries, returning the
+ * entry with the highest priority (smallest priority value) matching a
+ * packet, as the ASIC would.
+ *
+ * Every entry is compiled to one or more rules, each a mask of the packet
+ * header bits the entry qualifies on and the value those bits must have.
+ * Rules with the same mask share a tuple, a hash table from the masked bits
+ * to the rules, so a lookup costs one hash probe per distinct mask instead
+ * of a walk over all entries. Tuples are probed from the one with the
+ * highest priority rule down, and the lookup stops as soon as no remaining
+ * tuple can beat the match found so far.
+ *
+ * Entries qualifying on UDF or RoCE payload bytes, which are not part of
+ * AclPacketHeaders, and disabled entries never match. Not thread safe.
+ */
+class AclClassifier {
+ public:
+  AclClassifier();
+  ~AclClassifier();
+
+  // replaces the entry with the same name, if any
+  void addEntry(const std::shared_ptr<AclEntry>& entry);
+  void removeEntry(const std::string& name);
+  void clear();
+  // rebuild from scratch
+  void build(const std::shared_ptr<const AclMap>& acls);
+
+  std::shared_ptr<AclEntry> match(const AclPacketHeaders& headers) const;
+
+  size_t numEntries() const {
+    return entries_.size();
+  }
+  size_t numTuples() const {
+    return tuples_.size();
+  }
+  // entries that never match, see above
+  size_t numUnsupportedEntries() const {
+    return numUnsupported_;
+  }
+
+  /*
+   * Whether the entry matches the packet, evaluating the entry on its own.
+   * Same result as a classifier holding only this entry.
+   */
+  static bool matches(const AclEntry& entry, const AclPacketHeaders& headers);
+
+  static constexpr size_t kKeyWords = 9;
+  using Key = std::array<uint64_t, kKeyWords>;
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+  struct Rule {
+    Key mask{};
+    Key value{};
+
+    bool matches(const Key& key) const;
+  };
+
+  // the rules of an entry, any of which matching is a match of the entry
+  static std::vector<Rule> compile(const AclEntry& entry);
+  static Key packetKey(const AclPacketHeaders& headers);
+
+ private:
+  struct RuleEntry {
+    int priority;
+    std::shared_ptr<AclEntry> entry;
+  };
+  struct Tuple {
+    Key mask;
+    // sorted by priority, more than one only for entries with the same match
+    folly::F14FastMap<Key, std::vector<RuleEntry>, KeyHash> rules;
+    // priority of the highest priority rule
+    int bestPriority;
+  };
+  struct CompiledEntry {
+    int priority;
+    std::vector<Rule> rules;
+  };
+
+  void insertRule(const Rule& rule, const std::shared_ptr<AclEntry>& entry);
+  void removeRule(const Rule& rule, const std::string& name);
+  void sortTuples();
+
+  folly::F14FastMap<std::string, CompiledEntry> entries_;
+  folly::F14FastMap<Key, std::unique_ptr<Tuple>, KeyHash> tuples_;
+  // by bestPriority
+  std::vector<Tuple*> sortedTuples_;
+  size_t numUnsupported_{0};
+};
+
+/*
+ * Keeps an AclClassifier in sync with the ingress ACLs of the switch state,
+ * updating it with the ACL changes of every state delta, for software paths
+ * and tools to find the ACL a packet would hit without going to the ASIC.
+ */
+class AclMatchEngine : public StateObserver {
+ public:
+  explicit AclMatchEngine(SwSwitch* sw);
+  ~AclMatchEngine() override;
+
+  void stateUpdated(const StateDelta& delta) override;
+  bool isConcurrentSafe() const override {
+    return true;
+  }
+
+  std::shared_ptr<AclEntry> match(const AclPacketHeaders& headers) const {
+    return classifier_.rlock()->match(headers);
+  }
+  size_t numEntries() const {
+    return classifier_.rlock()->numEntries();
+  }
+
+ private:
+  SwSwitch* sw_;
+  folly::Synchronized<AclClassifier> classifier_;
+};
+
+} // namespace facebook::fboss
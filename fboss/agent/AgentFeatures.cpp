@@ -330,3 +330,55 @@ DEFINE_bool(
     enable_high_frequency_stats_polling,
     false,
     "Enable high frequency stats polling");
+
+DEFINE_bool(
+    parallel_state_observers,
+    false,
+    "Notify state observers which are safe to run concurrently on a worker "
+    "pool instead of serially on the update thread");
+
+DEFINE_int32(
+    state_observer_threads,
+    4,
+    "Number of worker threads used with --parallel_state_observers");
+
+DEFINE_uint32(
+    state_update_max_batch_size,
+    0,
+    "Max number of state updates applied in one batch, 0 for no limit");
+
+DEFINE_uint32(
+    state_update_batch_budget_ms,
+    0,
+    "Wall clock budget for preparing a batch of state updates, remaining "
+    "updates are deferred to the next batch. 0 for no limit");
+
+DEFINE_uint32(
+    state_update_linger_ms,
+    0,
+    "Time a state update may wait for more updates to batch it with");
+
+DEFINE_bool(
+    state_update_priority_lanes,
+    false,
+    "Queue high priority state updates (link and neighbor changes) ahead of "
+    "regular state updates");
+
+DEFINE_uint32(
+    rx_packet_burst_size,
+    1,
+    "Max number of trapped packets handed to the SwSwitch in one burst. "
+    "Unless this is above 1 at init, packets are handed over one at a time, "
+    "as they are received");
+
+DEFINE_uint32(
+    rx_packet_burst_queue_size,
+    8192,
+    "Max number of trapped packets queued for the rx burst thread. Packets "
+    "received while the queue is full are dropped");
+
+DEFINE_bool(
+    incremental_config_apply,
+    false,
+    "Only re-apply the top level config sections that changed since the "
+    "last applied config, keeping the switch state of the other sections");
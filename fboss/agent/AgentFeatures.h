@@ -112,3 +112,16 @@ DECLARE_int32(agent_exit_delay_s);
 DECLARE_bool(dsf_single_stage_r192_f40_e32);
 
 DECLARE_bool(enable_high_frequency_stats_polling);
+
+DECLARE_bool(parallel_state_observers);
+DECLARE_int32(state_observer_threads);
+
+DECLARE_uint32(state_update_max_batch_size);
+DECLARE_uint32(state_update_batch_budget_ms);
+DECLARE_uint32(state_update_linger_ms);
+DECLARE_bool(state_update_priority_lanes);
+
+DECLARE_uint32(rx_packet_burst_size);
+DECLARE_uint32(rx_packet_burst_queue_size);
+
+DECLARE_bool(incremental_config_apply);
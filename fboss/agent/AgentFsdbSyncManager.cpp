@@ -5,7 +5,9 @@
 #include <type_traits>
 #include "fboss/agent/AgentFsdbSyncManager.h"
 
+#include "fboss/fsdb/oper/instantiations/FsdbPathConverter.h"
 #include "fboss/lib/TupleUtils.h"
+#include "fboss/thrift_cow/visitors/VisitorUtils.h"
 
 DEFINE_bool(fsdb_sync_full_state, true, "sync whole switch state to fsdb");
 DEFINE_bool(
@@ -75,6 +77,24 @@ void AgentFsdbSyncManager::stateUpdated(const StateDelta& delta) {
     return stateUpdatedDelta(delta);
   }
   std::shared_ptr<SwitchState> newState = delta.newState();
+  if (auto agentDelta = getAgentOperDelta(delta, nullptr)) {
+    updateStateWithDelta([oldState = delta.oldState(),
+                          newState = std::move(newState),
+                          agentDelta = std::move(*agentDelta)](
+                             const auto& agentState) mutable {
+      auto newAgentState = agentState->clone();
+      newAgentState->template ref<fsdb_model_tags::switchState>() = newState;
+      // the delta holds only if the synced state is the one it started from
+      bool deltaApplies =
+          agentState->template cref<fsdb_model_tags::switchState>() ==
+          oldState;
+      return std::make_pair(
+          newAgentState,
+          deltaApplies ? std::make_optional(std::move(agentDelta))
+                       : std::nullopt);
+    });
+    return;
+  }
   updateState([newState = std::move(newState)](const auto& agentState) {
     auto newAgentState = agentState->clone();
     newAgentState->template ref<fsdb_model_tags::switchState>() = newState;
@@ -144,8 +164,107 @@ bool AgentFsdbSyncManager::modify(
   return changed;
 }
 
+bool AgentFsdbSyncManager::synced(
+    const std::shared_ptr<SwitchState>& syncedState,
+    const std::shared_ptr<SwitchState>& state) {
+  bool allSynced = true;
+  SubscribedMaps maps;
+  tupleForEach(
+      [&](auto& element) {
+        using tag = std::decay_t<decltype(element)>;
+        allSynced &=
+            syncedState->template cref<tag>() == state->template cref<tag>();
+      },
+      maps);
+  return allSynced;
+}
+
+const std::unordered_set<std::string>& AgentFsdbSyncManager::subscribedMembers(
+    bool useIdPaths) {
+  auto getMembers = [](bool useId) {
+    std::unordered_set<std::string> members;
+    SubscribedMaps maps;
+    tupleForEach(
+        [&](auto& element) {
+          using tag = std::decay_t<decltype(element)>;
+          members.insert(
+              thrift_cow::getMemberName<
+                  typename SwitchState::Fields::template MemberFor<tag>>(
+                  useId));
+        },
+        maps);
+    return members;
+  };
+  static const auto kMemberIds = getMembers(true);
+  static const auto kMemberNames = getMembers(false);
+  return useIdPaths ? kMemberIds : kMemberNames;
+}
+
+std::optional<fsdb::OperDelta> AgentFsdbSyncManager::getAgentOperDelta(
+    const StateDelta& delta,
+    const std::unordered_set<std::string>* members) const {
+  if (FLAGS_publish_patches_to_fsdb) {
+    return std::nullopt;
+  }
+  // paths of the switch state oper delta are converted when published with
+  // the other kind of path
+  bool convertPaths = useIdPaths() != FLAGS_state_oper_delta_use_id_paths;
+  auto switchStateKey = thrift_cow::getMemberName<
+      typename AgentData::Fields::template MemberFor<
+          fsdb_model_tags::switchState>>(FLAGS_state_oper_delta_use_id_paths);
+  const auto agentTokens = kAgentPath.tokens();
+  std::vector<fsdb::OperDeltaUnit> changes;
+  for (const auto& change : *delta.getOperDelta().changes()) {
+    const auto& path = *change.path()->raw();
+    if (members && (path.empty() || !members->count(path.front()))) {
+      continue;
+    }
+    auto& agentChange = changes.emplace_back(change);
+    auto& agentPath = *agentChange.path()->raw();
+    agentPath.insert(agentPath.begin(), switchStateKey);
+    if (convertPaths) {
+      auto fullPath = agentTokens;
+      fullPath.insert(fullPath.end(), agentPath.begin(), agentPath.end());
+      auto converted = useIdPaths()
+          ? fsdb::PathConverter<fsdb::FsdbOperStateRoot>::pathToIdTokens(
+                fullPath)
+          : fsdb::PathConverter<fsdb::FsdbOperStateRoot>::pathToNameTokens(
+                fullPath);
+      agentPath.assign(
+          converted.begin() + agentTokens.size(), converted.end());
+    }
+  }
+  return fsdb::createDelta(std::move(changes));
+}
+
 void AgentFsdbSyncManager::stateUpdatedDelta(const StateDelta& delta) {
   std::shared_ptr<SwitchState> newState = delta.newState();
+  auto agentDelta = getAgentOperDelta(
+      delta, &subscribedMembers(FLAGS_state_oper_delta_use_id_paths));
+  if (agentDelta) {
+    updateStateWithDelta([oldState = delta.oldState(),
+                          newState = std::move(newState),
+                          agentDelta = std::move(*agentDelta)](
+                             const auto& agentState) mutable {
+      // TODO: sync all objects, currently only syncing what fsdb state delta
+      // converter supports
+      auto newAgentState = agentState->clone();
+      auto& switchState =
+          newAgentState->template modify<fsdb_model_tags::switchState>();
+      // the delta holds only if the synced maps are the ones it started from
+      bool deltaApplies = AgentFsdbSyncManager::synced(switchState, oldState);
+      if (!AgentFsdbSyncManager::modify(switchState, newState)) {
+        return std::make_pair(agentState, std::optional<fsdb::OperDelta>());
+      }
+      newAgentState->template ref<fsdb_model_tags::switchState>() =
+          switchState;
+      return std::make_pair(
+          newAgentState,
+          deltaApplies ? std::make_optional(std::move(agentDelta))
+                       : std::nullopt);
+    });
+    return;
+  }
   updateState([newState = std::move(newState)](const auto& agentState) {
     bool changed = false;
     // TODO: sync all objects, currently only syncing what fsdb state delta
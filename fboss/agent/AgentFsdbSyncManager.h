@@ -13,6 +13,10 @@
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <optional>
+#include <string>
+#include <unordered_set>
+
 DECLARE_bool(fsdb_sync_full_state);
 DECLARE_bool(agent_fsdb_sync);
 
@@ -84,6 +88,20 @@ class AgentFsdbSyncManager
   static bool modify(
       std::shared_ptr<facebook::fboss::SwitchState>& oldState,
       const std::shared_ptr<facebook::fboss::SwitchState>& newState);
+  // whether the subscribed maps of both states are the same
+  static bool synced(
+      const std::shared_ptr<SwitchState>& syncedState,
+      const std::shared_ptr<SwitchState>& state);
+  // keys of the subscribed maps in oper delta paths of the switch state
+  static const std::unordered_set<std::string>& subscribedMembers(
+      bool useIdPaths);
+
+  // The oper delta already computed for a switch state update, moved under
+  // the switch state of agent data. Only changes under the given members are
+  // kept, if any. nullopt if deltas are not what gets published.
+  std::optional<fsdb::OperDelta> getAgentOperDelta(
+      const StateDelta& delta,
+      const std::unordered_set<std::string>* members) const;
 };
 
 } // namespace facebook::fboss
@@ -12,6 +12,7 @@
 #include <fboss/thrift_cow/nodes/ThriftMapNode-inl.h>
 #include <folly/FileUtil.h>
 #include <folly/gen/Base.h>
+#include <thrift/lib/cpp2/op/Get.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <memory>
 #include <optional>
@@ -80,6 +81,7 @@
 
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
+#include <folly/Portability.h>
 #include <folly/Range.h>
 #include <algorithm>
 #include <cmath>
@@ -223,6 +225,95 @@ bool checkParallelLinksToInterfaceNodes(
   }
   return hasParallelLinks;
 }
+
+/*
+ * Top level config fields the config sections are built from, including the
+ * fields of the sections whose state they read. With a previous config, a
+ * section is only re-applied if one of its fields changed. Sections not listed
+ * here are always applied, as they also fill in bookkeeping later sections
+ * rely on (interfaces, switch settings) or are cheap. Debug builds check each
+ * incremental apply against applying the whole config, which catches fields
+ * missing here.
+ */
+const std::vector<folly::StringPiece> kBufferPoolFields = {
+    "bufferPoolConfigs"};
+const std::vector<folly::StringPiece> kPortFlowletFields = {
+    "portFlowletConfigs"};
+// ports, system ports and remote system ports
+const std::vector<folly::StringPiece> kPortFields = {
+    "ports",
+    "bufferPoolConfigs",
+    "cpuTrafficPolicy",
+    "dataPlaneTrafficPolicy",
+    "defaultPortQueues",
+    "defaultVoqConfig",
+    "dsfNodes",
+    "interfaces",
+    "portFlowletConfigs",
+    "portPgConfigs",
+    "portQueueConfigs",
+    "qosPolicies",
+    "switchSettings",
+    "vlanPorts",
+    "vlans"};
+const std::vector<folly::StringPiece> kAggregatePortFields = {
+    "aggregatePorts",
+    "dsfNodes",
+    "interfaces",
+    "lacp",
+    "ports",
+    "switchSettings",
+    "vlanPorts"};
+// the default data plane policy is kept out of the qos policy map
+const std::vector<folly::StringPiece> kQosPolicyFields = {
+    "qosPolicies",
+    "dataPlaneTrafficPolicy"};
+const std::vector<folly::StringPiece> kSflowCollectorFields = {
+    "sFlowCollectors"};
+const std::vector<folly::StringPiece> kIpInIpTunnelFields = {"ipInIpTunnels"};
+const std::vector<folly::StringPiece> kDsfNodeFields = {
+    "dsfNodes",
+    "defaultVoqConfig",
+    "switchSettings"};
+
+template <typename... Fields>
+std::vector<folly::StringPiece> withPortFields(Fields... fields) {
+  std::vector<folly::StringPiece> all = {fields...};
+  all.insert(all.end(), kPortFields.begin(), kPortFields.end());
+  return all;
+}
+const std::vector<folly::StringPiece> kMirrorFields = withPortFields("mirrors");
+const std::vector<folly::StringPiece> kAclFields = withPortFields(
+    "acls",
+    "aclTableGroup",
+    "aclTableGroups",
+    "loadBalancers",
+    "mirrors",
+    "trafficCounters",
+    "udfConfig");
+const std::vector<folly::StringPiece> kVlanFields =
+    withPortFields("defaultVlan");
+const std::vector<folly::StringPiece> kMirrorOnDropReportFields =
+    withPortFields("mirrorOnDropReports");
+
+// Names of the top level fields that differ between the two configs
+std::unordered_set<std::string> getChangedConfigFields(
+    const cfg::SwitchConfig& oldConfig,
+    const cfg::SwitchConfig& newConfig) {
+  std::unordered_set<std::string> changed;
+  apache::thrift::op::for_each_field_id<cfg::SwitchConfig>([&]<class Id>(Id) {
+    auto oldField = apache::thrift::op::getValueOrNull(
+        apache::thrift::op::get<Id>(oldConfig));
+    auto newField = apache::thrift::op::getValueOrNull(
+        apache::thrift::op::get<Id>(newConfig));
+    if ((oldField == nullptr) != (newField == nullptr) ||
+        (oldField && !(*oldField == *newField))) {
+      changed.insert(
+          apache::thrift::op::get_name_v<cfg::SwitchConfig, Id>.str());
+    }
+  });
+  return changed;
+}
 } // anonymous namespace
 
 namespace facebook::fboss {
@@ -243,7 +334,8 @@ class ThriftConfigApplier {
       RoutingInformationBase* rib,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      const cfg::SwitchConfig* prevConfig)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -251,7 +343,11 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable) {
+    if (prevConfig) {
+      changedConfigFields_ = getChangedConfigFields(*prevConfig, *config);
+    }
+  }
 
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
@@ -260,7 +356,8 @@ class ThriftConfigApplier {
       RouteUpdateWrapper* routeUpdater,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      const cfg::SwitchConfig* prevConfig)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -268,7 +365,11 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable) {
+    if (prevConfig) {
+      changedConfigFields_ = getChangedConfigFields(*prevConfig, *config);
+    }
+  }
 
   std::shared_ptr<SwitchState> run();
 
@@ -277,6 +378,19 @@ class ThriftConfigApplier {
   ThriftConfigApplier(ThriftConfigApplier const&) = delete;
   ThriftConfigApplier& operator=(ThriftConfigApplier const&) = delete;
 
+  /*
+   * Whether any of the given top level config fields changed since the
+   * previous config. Always true when applying without a previous config.
+   */
+  bool configChanged(const std::vector<folly::StringPiece>& fields) const {
+    if (!changedConfigFields_) {
+      return true;
+    }
+    return std::any_of(fields.begin(), fields.end(), [this](auto field) {
+      return changedConfigFields_->count(field.str()) > 0;
+    });
+  }
+
   template <typename Node, typename NodeMap>
   bool updateMap(
       NodeMap* map,
@@ -602,6 +716,8 @@ class ThriftConfigApplier {
   SwitchIdScopeResolver scopeResolver_;
   const PlatformMapping* platformMapping_{nullptr};
   const HwAsicTable* hwAsicTable_{nullptr};
+  // unset when applying the whole config
+  std::optional<std::unordered_set<std::string>> changedConfigFields_;
 
   struct InterfaceIpInfo {
     InterfaceIpInfo(uint8_t mask, MacAddress mac, InterfaceID intf)
@@ -627,6 +743,11 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   new_ = orig_->clone();
   bool changed = false;
 
+  if (changedConfigFields_) {
+    XLOG(DBG2) << "Applying config changes in "
+               << changedConfigFields_->size() << " top level config fields";
+  }
+
   {
     auto newControlPlane = updateControlPlane();
     if (newControlPlane) {
@@ -637,7 +758,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   processVlanPorts();
 
-  {
+  if (configChanged(kBufferPoolFields)) {
     bool bufferPoolConfigChanged = false;
     auto newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
     if (bufferPoolConfigChanged) {
@@ -646,7 +767,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (configChanged(kPortFlowletFields)) {
     bool portFlowletConfigChanged = false;
     auto newPortFlowletCfg =
         updatePortFlowletConfigs(&portFlowletConfigChanged);
@@ -664,7 +785,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   processInterfaceForPort();
 
-  {
+  if (configChanged(kPortFields)) {
     auto newPorts = updatePorts(new_->getTransceivers());
     if (newPorts) {
       new_->resetPorts(
@@ -678,7 +799,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (configChanged(kAggregatePortFields)) {
     auto newAggPorts = updateAggregatePorts();
     if (newAggPorts) {
       new_->resetAggregatePorts(toMultiSwitchMap<MultiSwitchAggregatePortMap>(
@@ -688,7 +809,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
-  {
+  if (configChanged(kMirrorFields)) {
     auto newMirrors = updateMirrors();
     if (newMirrors) {
       new_->resetMirrors(
@@ -698,7 +819,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  if (configChanged(kAclFields)) {
     if (FLAGS_enable_acl_table_group) {
       auto newAclTableGroups = updateAclTableGroups();
       if (newAclTableGroups) {
@@ -716,7 +837,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (configChanged(kQosPolicyFields)) {
     auto newQosPolicies = updateQosPolicies();
     if (newQosPolicies) {
       new_->resetQosPolicies(toMultiSwitchMap<MultiSwitchQosPolicyMap>(
@@ -737,7 +858,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   // Note: updateInterfaces() must be called before updateVlans(),
   // as updateInterfaces() populates the vlanInterfaces_ data structure.
-  {
+  if (configChanged(kVlanFields)) {
     auto newVlans = updateVlans();
     if (newVlans) {
       new_->resetVlans(
@@ -828,7 +949,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
+  if (configChanged(kSflowCollectorFields)) {
     auto newCollectors = updateSflowCollectors();
     if (newCollectors) {
       new_->resetSflowCollectors(toMultiSwitchMap<MultiSwitchSflowCollectorMap>(
@@ -838,7 +959,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // MirrorOnDrop must come after interfaces, since it looks up interface IPs.
-  {
+  if (configChanged(kMirrorOnDropReportFields)) {
     auto newMirrorOnDropReports = updateMirrorOnDropReports();
     if (newMirrorOnDropReports) {
       new_->resetMirrorOnDropReports(
@@ -861,7 +982,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (configChanged(kIpInIpTunnelFields)) {
     auto newTunnels = updateIpInIpTunnels();
     if (newTunnels) {
       new_->resetTunnels(
@@ -870,7 +991,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (configChanged(kDsfNodeFields)) {
     auto voqSwitchId = getAnyVoqSwitchId();
     std::shared_ptr<SwitchSettings> origSwitchSettings{};
     if (voqSwitchId.has_value()) {
@@ -6122,6 +6243,87 @@ void ThriftConfigApplier::updateSystemPortSelfHealingEcmpLagDestinationEnable(
   }
 }
 
+namespace {
+/*
+ * Checks that the sections re-applied from the changed config fields give the
+ * same state as applying the whole config. Routes are left out, the full
+ * apply here does not touch the RIB.
+ */
+void checkIncrementalApply(
+    const std::shared_ptr<SwitchState>& state,
+    const std::shared_ptr<SwitchState>& incremental,
+    const cfg::SwitchConfig* config,
+    bool supportsAddRemovePort,
+    const PlatformMapping* platformMapping,
+    const HwAsicTable* hwAsicTable,
+    AclNexthopHandler* aclNexthopHandler) {
+  auto full = ThriftConfigApplier(
+                  state,
+                  config,
+                  supportsAddRemovePort,
+                  static_cast<RoutingInformationBase*>(nullptr),
+                  aclNexthopHandler,
+                  platformMapping,
+                  hwAsicTable,
+                  nullptr /* prevConfig */)
+                  .run();
+  const auto& fullState = full ? full : state;
+  const auto& incrementalState = incremental ? incremental : state;
+  auto checkSame = [](const auto& fullNode,
+                      const auto& incrementalNode,
+                      folly::StringPiece name) {
+    bool same = fullNode && incrementalNode
+        ? fullNode->toThrift() == incrementalNode->toThrift()
+        : fullNode == incrementalNode;
+    DCHECK(same) << "Incremental config apply differs from a full apply in "
+                 << name << ", a config field is missing from its section";
+  };
+  checkSame(fullState->getPorts(), incrementalState->getPorts(), "ports");
+  checkSame(
+      fullState->getSystemPorts(),
+      incrementalState->getSystemPorts(),
+      "system ports");
+  checkSame(
+      fullState->getRemoteSystemPorts(),
+      incrementalState->getRemoteSystemPorts(),
+      "remote system ports");
+  checkSame(
+      fullState->getAggregatePorts(),
+      incrementalState->getAggregatePorts(),
+      "aggregate ports");
+  checkSame(fullState->getMirrors(), incrementalState->getMirrors(), "mirrors");
+  checkSame(fullState->getAcls(), incrementalState->getAcls(), "acls");
+  checkSame(
+      fullState->getAclTableGroups(),
+      incrementalState->getAclTableGroups(),
+      "acl table groups");
+  checkSame(
+      fullState->getQosPolicies(),
+      incrementalState->getQosPolicies(),
+      "qos policies");
+  checkSame(fullState->getVlans(), incrementalState->getVlans(), "vlans");
+  checkSame(
+      fullState->getSflowCollectors(),
+      incrementalState->getSflowCollectors(),
+      "sflow collectors");
+  checkSame(
+      fullState->getMirrorOnDropReports(),
+      incrementalState->getMirrorOnDropReports(),
+      "mirror on drop reports");
+  checkSame(fullState->getTunnels(), incrementalState->getTunnels(), "tunnels");
+  checkSame(
+      fullState->getDsfNodes(), incrementalState->getDsfNodes(), "dsf nodes");
+  checkSame(
+      fullState->getBufferPoolCfgs(),
+      incrementalState->getBufferPoolCfgs(),
+      "buffer pools");
+  checkSame(
+      fullState->getPortFlowletCfgs(),
+      incrementalState->getPortFlowletCfgs(),
+      "port flowlet configs");
+}
+} // namespace
+
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
@@ -6129,16 +6331,29 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib,
-    AclNexthopHandler* aclNexthopHandler) {
-  return ThriftConfigApplier(
-             state,
-             config,
-             supportsAddRemovePort,
-             rib,
-             aclNexthopHandler,
-             platformMapping,
-             hwAsicTable)
-      .run();
+    AclNexthopHandler* aclNexthopHandler,
+    const cfg::SwitchConfig* prevConfig) {
+  auto newState = ThriftConfigApplier(
+                      state,
+                      config,
+                      supportsAddRemovePort,
+                      rib,
+                      aclNexthopHandler,
+                      platformMapping,
+                      hwAsicTable,
+                      prevConfig)
+                      .run();
+  if (folly::kIsDebug && prevConfig) {
+    checkIncrementalApply(
+        state,
+        newState,
+        config,
+        supportsAddRemovePort,
+        platformMapping,
+        hwAsicTable,
+        aclNexthopHandler);
+  }
+  return newState;
 }
 
 std::shared_ptr<SwitchState> applyThriftConfig(
@@ -6148,16 +6363,29 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler) {
-  return ThriftConfigApplier(
-             state,
-             config,
-             supportsAddRemovePort,
-             routeUpdater,
-             aclNexthopHandler,
-             platformMapping,
-             hwAsicTable)
-      .run();
+    AclNexthopHandler* aclNexthopHandler,
+    const cfg::SwitchConfig* prevConfig) {
+  auto newState = ThriftConfigApplier(
+                      state,
+                      config,
+                      supportsAddRemovePort,
+                      routeUpdater,
+                      aclNexthopHandler,
+                      platformMapping,
+                      hwAsicTable,
+                      prevConfig)
+                      .run();
+  if (folly::kIsDebug && prevConfig) {
+    checkIncrementalApply(
+        state,
+        newState,
+        config,
+        supportsAddRemovePort,
+        platformMapping,
+        hwAsicTable,
+        aclNexthopHandler);
+  }
+  return newState;
 }
 
 } // namespace facebook::fboss
@@ -32,6 +32,11 @@ class HwAsicTable;
  *
  * Returns a new SwitchState object with the resulting state, or null if
  * the config file results in no changes.
+ *
+ * If prevConfig is given, state must be the result of applying prevConfig,
+ * and only the config sections built from the top level config fields that
+ * changed since prevConfig are re-applied. The state nodes of the other
+ * sections are kept as they are.
  */
 
 std::shared_ptr<SwitchState> applyThriftConfig(
@@ -41,7 +46,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib = nullptr,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
@@ -50,6 +56,7 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 } // namespace facebook::fboss
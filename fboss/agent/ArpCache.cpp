@@ -66,7 +66,8 @@ inline void ArpCache::checkReachability(
 }
 
 inline void ArpCache::probeFor(folly::IPAddressV4 ip) const {
-  ArpHandler::sendArpRequest(getSw(), ip);
+  sendProbe(
+      ip, [sw = getSw(), ip]() { ArpHandler::sendArpRequest(sw, ip); });
 }
 
 std::list<ArpEntryThrift> ArpCache::getArpCacheData() {
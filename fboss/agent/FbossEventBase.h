@@ -10,15 +10,27 @@
 #pragma once
 
 #include "fboss/agent/AgentFeatures.h"
+#include "fboss/agent/TimerWheel.h"
 
 #include <folly/io/async/EventBase.h>
 #include <folly/logging/xlog.h>
+#include <memory>
 #include <string>
 
 namespace facebook::fboss {
 class FbossEventBase : public folly::EventBase {
  public:
-  explicit FbossEventBase(const std::string& name) : eventBaseName_(name) {}
+  explicit FbossEventBase(const std::string& name)
+      : eventBaseName_(name),
+        timerWheel_(std::make_unique<TimerWheel>(
+            this,
+            std::chrono::milliseconds(FLAGS_timer_wheel_tick_ms),
+            FLAGS_timer_wheel_max_expiries_per_loop)) {}
+
+  // shared by the many long lived timers run by this event base
+  TimerWheel* getTimerWheel() const {
+    return timerWheel_.get();
+  }
 
   void runInFbossEventBaseThread(Func fn) noexcept {
     if (!isRunning()) {
@@ -70,6 +82,7 @@ class FbossEventBase : public folly::EventBase {
 
  private:
   std::string eventBaseName_;
+  std::unique_ptr<TimerWheel> timerWheel_;
 };
 
 } // namespace facebook::fboss
@@ -11,6 +11,7 @@
 
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/HwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/TxPacket.h"
 #include "fboss/agent/TxPacketUtils.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/hw/HwSwitchFb303Stats.h"
@@ -24,6 +25,7 @@
 
 #include <fb303/ThreadCachedServiceData.h>
 #include <folly/FileUtil.h>
+#include <folly/io/Cursor.h>
 #include <folly/logging/xlog.h>
 #include <folly/testing/TestUtil.h>
 
@@ -160,6 +162,16 @@ HwSwitchFb303Stats* HwSwitch::getSwitchStats() const {
   return hwSwitchStats_.get();
 }
 
+std::unique_ptr<TxPacket> HwSwitch::allocatePacketFromBuf(
+    std::unique_ptr<folly::IOBuf> buf) const {
+  auto len = buf->computeChainDataLength();
+  auto pkt = allocatePacket(len);
+  folly::io::Cursor inCursor(buf.get());
+  folly::io::RWPrivateCursor outCursor(pkt->buf());
+  outCursor.pushAtMost(inCursor, len);
+  return pkt;
+}
+
 void HwSwitch::switchRunStateChanged(SwitchRunState newState) {
   if (runState_ != newState) {
     switchRunStateChangedImpl(newState);
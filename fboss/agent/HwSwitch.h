@@ -33,6 +33,7 @@
 
 namespace folly {
 struct dynamic;
+class IOBuf;
 }
 
 DECLARE_bool(flowletStatsEnable);
@@ -190,6 +191,14 @@ class HwSwitch {
    */
   virtual std::unique_ptr<TxPacket> allocatePacket(uint32_t size) const = 0;
 
+  /*
+   * TxPacket with the contents of buf, e.g. a packet received from the
+   * SwSwitch in split mode. Implementations that can send from buf avoid
+   * copying it, by default it is copied into allocatePacket().
+   */
+  virtual std::unique_ptr<TxPacket> allocatePacketFromBuf(
+      std::unique_ptr<folly::IOBuf> buf) const;
+
   /*
    * Send a packet, use switching logic to send it out the correct port(s)
    * for the specified VLAN and destination MAC.
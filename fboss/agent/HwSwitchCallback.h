@@ -32,6 +32,19 @@ class HwSwitchCallback {
    */
   virtual void packetReceived(std::unique_ptr<RxPacket> pkt) noexcept = 0;
 
+  /*
+   * packetsReceived() is invoked by the HwSwitch with a burst of trapped
+   * packets, in the order they were received, when it collects them in
+   * bursts (see --rx_packet_burst_size). By default the packets are handled
+   * one at a time.
+   */
+  virtual void packetsReceived(
+      std::vector<std::unique_ptr<RxPacket>> pkts) noexcept {
+    for (auto& pkt : pkts) {
+      packetReceived(std::move(pkt));
+    }
+  }
+
   /*
    * linkStateChanged() is invoked by the HwSwitch whenever the link
    * up/down status changes on a port.
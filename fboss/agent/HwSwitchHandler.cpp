@@ -95,11 +95,17 @@ HwSwitchStateUpdateResult HwSwitchHandler::stateChangedImpl(
   }
   // outDelta would be combined delta if update fails at first delta
   // return the old state
-  auto inDelta = operDeltaFilter_.filterWithSwitchStateRootPath(
-      StateDelta(update.oldState, update.newState).getOperDelta());
-  if (inDelta && *inDelta == outDelta) {
+  if (outDelta == getCombinedOperDelta(inDeltas)) {
     return {update.oldState, stateUpdateResult.second};
   }
+  if (inDeltas.size() > 1) {
+    // a failed HwSwitch computes the combined delta over the whole update
+    auto inDelta = operDeltaFilter_.filterWithSwitchStateRootPath(
+        StateDelta(update.oldState, update.newState).getOperDelta());
+    if (inDelta && *inDelta == outDelta) {
+      return {update.oldState, stateUpdateResult.second};
+    }
+  }
   // obtain the state that actually got programmed
   return {
       StateDelta(update.newState, outDelta).newState(),
@@ -124,4 +130,15 @@ fsdb::OperDelta HwSwitchHandler::getFullSyncOperDelta(
   return filteredOper.value();
 }
 
+fsdb::OperDelta HwSwitchHandler::getCombinedOperDelta(
+    const std::vector<fsdb::OperDelta>& deltas) {
+  CHECK(!deltas.empty());
+  auto combined = deltas.front();
+  for (auto it = std::next(deltas.begin()); it != deltas.end(); ++it) {
+    auto& changes = *combined.changes();
+    changes.insert(changes.end(), it->changes()->begin(), it->changes()->end());
+  }
+  return combined;
+}
+
 } // namespace facebook::fboss
@@ -121,6 +121,11 @@ class HwSwitchHandler {
   fsdb::OperDelta getFullSyncOperDelta(
       const std::shared_ptr<SwitchState>& state) const;
 
+  // Changes of the deltas in order, equivalent to applying them one after
+  // the other
+  static fsdb::OperDelta getCombinedOperDelta(
+      const std::vector<fsdb::OperDelta>& deltas);
+
  private:
   HwSwitchStateUpdateResult stateChangedImpl(
       const HwSwitchStateUpdate& update,
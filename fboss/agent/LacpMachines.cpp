@@ -141,10 +141,10 @@ std::ostream& operator<<(std::ostream& out, MuxMachine::MuxState s) {
 
 ReceiveMachine::ReceiveMachine(
     LacpController& controller,
-    folly::EventBase* evb,
+    FbossEventBase* evb,
     LacpServicerIf* servicer,
     uint16_t holdTimerMultiplier)
-    : folly::AsyncTimeout(evb),
+    : TimerWheel::Callback(evb->getTimerWheel()),
       controller_(controller),
       servicer_(servicer),
       slowEpochSeconds_(std::chrono::seconds(30 * holdTimerMultiplier)),
@@ -407,8 +407,8 @@ const std::chrono::seconds PeriodicTransmissionMachine::LONG_PERIOD(30);
 
 PeriodicTransmissionMachine::PeriodicTransmissionMachine(
     LacpController& controller,
-    folly::EventBase* evb)
-    : folly::AsyncTimeout(evb), controller_(controller) {}
+    FbossEventBase* evb)
+    : TimerWheel::Callback(evb->getTimerWheel()), controller_(controller) {}
 
 PeriodicTransmissionMachine::~PeriodicTransmissionMachine() {}
 
@@ -497,9 +497,11 @@ const int TransmitMachine::MAX_TRANSMISSIONS_IN_SHORT_PERIOD = 3;
 
 TransmitMachine::TransmitMachine(
     LacpController& controller,
-    folly::EventBase* evb,
+    FbossEventBase* evb,
     LacpServicerIf* servicer)
-    : folly::AsyncTimeout(evb), controller_(controller), servicer_(servicer) {}
+    : TimerWheel::Callback(evb->getTimerWheel()),
+      controller_(controller),
+      servicer_(servicer) {}
 
 TransmitMachine::~TransmitMachine() {}
 
@@ -547,9 +549,11 @@ void TransmitMachine::ntt(LACPDU lacpdu) {
 const std::chrono::seconds MuxMachine::AGGREGATE_WAIT_DURATION(2);
 MuxMachine::MuxMachine(
     LacpController& controller,
-    folly::EventBase* evb,
+    FbossEventBase* evb,
     LacpServicerIf* servicer)
-    : AsyncTimeout(evb), controller_(controller), servicer_(servicer) {}
+    : TimerWheel::Callback(evb->getTimerWheel()),
+      controller_(controller),
+      servicer_(servicer) {}
 
 MuxMachine::~MuxMachine() {}
 
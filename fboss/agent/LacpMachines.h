@@ -9,11 +9,11 @@
  */
 #pragma once
 
-#include <folly/io/async/AsyncTimeout.h>
 #include <optional>
 
 #include <boost/container/flat_map.hpp>
 
+#include "fboss/agent/FbossEventBase.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/state/AggregatePort.h"
 #include "fboss/agent/types.h"
@@ -30,11 +30,11 @@ struct LacpServicerIf;
  * See IEEE 802.3AD-2000 43.4.3 for an overview of each state machine
  */
 
-class ReceiveMachine : private folly::AsyncTimeout {
+class ReceiveMachine : private TimerWheel::Callback {
  public:
   explicit ReceiveMachine(
       LacpController& controller,
-      folly::EventBase* evb,
+      FbossEventBase* evb,
       LacpServicerIf* servicer,
       uint16_t holdTimerMultiplier);
   ~ReceiveMachine() override;
@@ -98,11 +98,11 @@ class ReceiveMachine : private folly::AsyncTimeout {
 void toAppend(ReceiveMachine::ReceiveState state, std::string* result);
 std::ostream& operator<<(std::ostream& out, ReceiveMachine::ReceiveState s);
 
-class PeriodicTransmissionMachine : private folly::AsyncTimeout {
+class PeriodicTransmissionMachine : private TimerWheel::Callback {
  public:
   explicit PeriodicTransmissionMachine(
       LacpController& controller,
-      folly::EventBase* evb);
+      FbossEventBase* evb);
   ~PeriodicTransmissionMachine() override;
 
   void portUp();
@@ -132,11 +132,11 @@ void toAppend(
     PeriodicTransmissionMachine::PeriodicState state,
     std::string* result);
 
-class TransmitMachine : private folly::AsyncTimeout {
+class TransmitMachine : private TimerWheel::Callback {
  public:
   TransmitMachine(
       LacpController& controller,
-      folly::EventBase* evb,
+      FbossEventBase* evb,
       LacpServicerIf* servicer);
   ~TransmitMachine() override;
 
@@ -159,11 +159,11 @@ class TransmitMachine : private folly::AsyncTimeout {
   LacpServicerIf* servicer_{nullptr};
 };
 
-class MuxMachine : private folly::AsyncTimeout {
+class MuxMachine : private TimerWheel::Callback {
  public:
   MuxMachine(
       LacpController& controller,
-      folly::EventBase* evb,
+      FbossEventBase* evb,
       LacpServicerIf* servicer);
   ~MuxMachine() override;
 
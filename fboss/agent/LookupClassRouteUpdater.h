@@ -28,6 +28,11 @@ class LookupClassRouteUpdater : public StateObserver {
   }
 
   void stateUpdated(const StateDelta& stateDelta) override;
+  // All caches are only accessed from stateUpdated, updates to the switch
+  // state are scheduled rather than applied inline
+  bool isConcurrentSafe() const override {
+    return true;
+  }
 
   // Method used by unit tests
   const boost::container::
@@ -16,6 +16,10 @@ class MirrorManager : public StateObserver {
   ~MirrorManager() override;
 
   void stateUpdated(const StateDelta& delta) override;
+  // Only reads the delta, mirror resolution itself is a separate update
+  bool isConcurrentSafe() const override {
+    return true;
+  }
 
  private:
   SwSwitch* sw_;
@@ -0,0 +1,151 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/agent/MultiSwitchPacketRings.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/Utils.h"
+
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr auto kRingWaitTimeout = std::chrono::milliseconds(100);
+} // namespace
+
+MultiSwitchPacketRings::MultiSwitchPacketRings(RxPacketHandler handler)
+    : handler_(std::move(handler)) {}
+
+MultiSwitchPacketRings::~MultiSwitchPacketRings() {
+  detachAll();
+}
+
+std::optional<MultiSwitchPacketRings::AttachmentId>
+MultiSwitchPacketRings::attach(SwitchID switchId) {
+  std::lock_guard<std::mutex> lock(attachMutex_);
+  auto rings = std::make_shared<SwitchRings>();
+  try {
+    rings->rxRing = SharedMemPacketRing::attach(SharedMemPacketRing::ringName(
+        switchId, SharedMemPacketRing::Direction::RX));
+    rings->txRing = SharedMemPacketRing::attach(SharedMemPacketRing::ringName(
+        switchId, SharedMemPacketRing::Direction::TX));
+  } catch (const FbossError& ex) {
+    XLOG(DBG2) << "Exchanging packets with switch " << switchId
+               << " via thrift, " << ex.what();
+    // the rings of a previous instance, if any, are gone
+    if (auto oldRings = removeRings(switchId)) {
+      stopRxThread(oldRings.get());
+    }
+    return std::nullopt;
+  }
+  rings->attachmentId = ++lastAttachmentId_;
+  // the RX ring has a single consumer, stop the thread of the rings replaced
+  // before starting the new one
+  if (auto oldRings = removeRings(switchId)) {
+    stopRxThread(oldRings.get());
+  }
+  auto* ringsPtr = rings.get();
+  rings->rxThread = std::make_unique<std::thread>([this, switchId, ringsPtr]() {
+    initThread("fbossRxPktRing");
+    rxLoop(switchId, ringsPtr);
+  });
+  auto attachmentId = rings->attachmentId;
+  (*rings_.wlock())[switchId] = std::move(rings);
+  XLOG(DBG2) << "Exchanging packets with switch " << switchId
+             << " via shared memory";
+  return attachmentId;
+}
+
+void MultiSwitchPacketRings::detach(
+    SwitchID switchId,
+    AttachmentId attachmentId) {
+  std::lock_guard<std::mutex> lock(attachMutex_);
+  if (auto rings = removeRings(switchId, attachmentId)) {
+    stopRxThread(rings.get());
+  }
+}
+
+void MultiSwitchPacketRings::detachAll() {
+  std::lock_guard<std::mutex> lock(attachMutex_);
+  std::unordered_map<SwitchID, std::shared_ptr<SwitchRings>> rings;
+  rings_.wlock()->swap(rings);
+  for (auto& [switchId, switchRings] : rings) {
+    stopRxThread(switchRings.get());
+  }
+}
+
+std::shared_ptr<MultiSwitchPacketRings::SwitchRings>
+MultiSwitchPacketRings::removeRings(
+    SwitchID switchId,
+    std::optional<AttachmentId> attachmentId) {
+  auto lockedRings = rings_.wlock();
+  auto it = lockedRings->find(switchId);
+  if (it == lockedRings->end() ||
+      (attachmentId && it->second->attachmentId != *attachmentId)) {
+    return nullptr;
+  }
+  auto rings = std::move(it->second);
+  lockedRings->erase(it);
+  return rings;
+}
+
+bool MultiSwitchPacketRings::sendPacket(
+    SwitchID switchId,
+    const TxPacket& pkt,
+    std::optional<PortID> portID,
+    std::optional<uint8_t> queue) {
+  std::shared_ptr<SwitchRings> rings;
+  {
+    auto lockedRings = rings_.rlock();
+    auto it = lockedRings->find(switchId);
+    if (it == lockedRings->end()) {
+      return false;
+    }
+    rings = it->second;
+  }
+  SharedMemPacketRing::PacketMeta meta;
+  if (portID) {
+    meta.port = *portID;
+  }
+  if (queue) {
+    meta.queue = *queue;
+  }
+  return rings->txRing->push(meta, *pkt.buf());
+}
+
+void MultiSwitchPacketRings::rxLoop(SwitchID switchId, SwitchRings* rings) {
+  auto handlePacket = [this, switchId](
+                          const SharedMemPacketRing::PacketMeta& meta,
+                          folly::ByteRange data) {
+    // See MultiSwitchThriftHandler::co_notifyRxPacket()
+    auto pkt = std::make_unique<SwRxPacket>(
+        folly::IOBuf::copyBuffer(data.data(), data.size()));
+    pkt->setSrcPort(PortID(meta.port));
+    if (meta.vlan >= 0) {
+      pkt->setSrcVlan(VlanID(meta.vlan));
+    } else {
+      pkt->setSrcVlan(std::nullopt);
+    }
+    if (meta.aggPort >= 0) {
+      pkt->setSrcAggregatePort(AggregatePortID(meta.aggPort));
+    }
+    if (meta.queue >= 0) {
+      pkt->setCosQueue(static_cast<uint8_t>(meta.queue));
+    }
+    handler_(switchId, std::move(pkt));
+  };
+  while (!rings->stop) {
+    while (!rings->stop && rings->rxRing->pop(handlePacket)) {
+    }
+    rings->rxRing->wait(kRingWaitTimeout);
+  }
+}
+
+void MultiSwitchPacketRings::stopRxThread(SwitchRings* rings) {
+  rings->stop = true;
+  rings->rxRing->wake();
+  rings->rxThread->join();
+  rings->rxThread.reset();
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,81 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include "fboss/agent/SwRxPacket.h"
+#include "fboss/agent/TxPacket.h"
+#include "fboss/agent/mnpu/SharedMemPacketRing.h"
+#include "fboss/agent/types.h"
+
+#include <folly/Synchronized.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+namespace facebook::fboss {
+
+/*
+ * SwSwitch side of the shared memory packet transport: the packet rings of
+ * every HwAgent attached to, with a thread per HwAgent draining its RX ring.
+ * TX packets of HwAgents without rings, or whose ring is full, keep going
+ * through MultiSwitchPacketStreamMap.
+ */
+class MultiSwitchPacketRings {
+ public:
+  using RxPacketHandler =
+      std::function<void(SwitchID switchId, std::unique_ptr<SwRxPacket> pkt)>;
+  // identifies one attach() to the rings of a switch
+  using AttachmentId = uint64_t;
+
+  explicit MultiSwitchPacketRings(RxPacketHandler handler);
+  ~MultiSwitchPacketRings();
+
+  /*
+   * Attach to the rings created by the HwAgent of switchId, replacing the
+   * rings of a previous attachment. None if the HwAgent has no rings, e.g. it
+   * runs on another host or without --shm_packet_transport.
+   */
+  std::optional<AttachmentId> attach(SwitchID switchId);
+  // noop unless attachmentId is still the attachment of switchId, so that
+  // tearing down a replaced attachment leaves the new one alone
+  void detach(SwitchID switchId, AttachmentId attachmentId);
+  void detachAll();
+
+  // false if not attached to switchId, or its TX ring can't take the packet
+  bool sendPacket(
+      SwitchID switchId,
+      const TxPacket& pkt,
+      std::optional<PortID> portID,
+      std::optional<uint8_t> queue);
+
+ private:
+  struct SwitchRings {
+    AttachmentId attachmentId{0};
+    std::unique_ptr<SharedMemPacketRing> rxRing;
+    std::unique_ptr<SharedMemPacketRing> txRing;
+    std::unique_ptr<std::thread> rxThread;
+    std::atomic<bool> stop{false};
+  };
+
+  void rxLoop(SwitchID switchId, SwitchRings* rings);
+  static void stopRxThread(SwitchRings* rings);
+  std::shared_ptr<SwitchRings> removeRings(
+      SwitchID switchId,
+      std::optional<AttachmentId> attachmentId = std::nullopt);
+
+  RxPacketHandler handler_;
+  // serializes attaching and detaching, so that a ring never has two
+  // consumer threads
+  std::mutex attachMutex_;
+  AttachmentId lastAttachmentId_{0};
+  folly::Synchronized<
+      std::unordered_map<SwitchID, std::shared_ptr<SwitchRings>>>
+      rings_;
+};
+
+} // namespace facebook::fboss
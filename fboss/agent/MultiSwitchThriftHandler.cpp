@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "fboss/agent/MultiSwitchPacketRings.h"
 #include "fboss/agent/MultiSwitchPacketStreamMap.h"
 #include "fboss/agent/MultiSwitchThriftHandler.h"
 #include "fboss/agent/SwRxPacket.h"
@@ -323,10 +324,21 @@ MultiSwitchThriftHandler::co_getTxPackets(int64_t switchId) {
   ensureConfigured(__func__);
   auto switchIndex =
       sw_->getSwitchInfoTable().getSwitchIndexFromSwitchId(SwitchID(switchId));
+  // the HwAgent creates its packet rings before connecting the stream
+  std::optional<MultiSwitchPacketRings::AttachmentId> ringsAttachment;
+  if (auto packetRings = sw_->getPacketRings()) {
+    ringsAttachment = packetRings->attach(SwitchID(switchId));
+  }
   auto streamAndPublisher =
       apache::thrift::ServerStream<multiswitch::TxPacket>::createPublisher(
-          [this, switchId, switchIndex] {
+          [this, switchId, switchIndex, ringsAttachment] {
             sw_->getPacketStreamMap()->removePacketStream(SwitchID(switchId));
+            // only the rings attached along with this stream, the HwAgent
+            // may have reconnected already
+            auto packetRings = sw_->getPacketRings();
+            if (packetRings && ringsAttachment) {
+              packetRings->detach(SwitchID(switchId), *ringsAttachment);
+            }
             XLOG(DBG2) << "Removed stream for switch " << switchId;
             sw_->stats()->hwAgentTxPktEventStreamConnectionStatus(
                 switchIndex, false);
@@ -20,6 +20,64 @@
 
 namespace facebook::fboss {
 
+namespace {
+void sendUnicastProbe(
+    SwSwitch* sw,
+    folly::IPAddressV6 targetIP,
+    folly::MacAddress targetMac,
+    PortDescriptor port) {
+  const auto state = sw->getState();
+
+  InterfaceID intfID;
+  std::shared_ptr<Interface> srcIntf;
+  switch (port.type()) {
+    case PortDescriptor::PortType::PHYSICAL:
+      intfID = sw->getState()->getInterfaceIDForPort(port);
+      srcIntf = state->getInterfaces()->getNodeIf(intfID);
+      break;
+    case PortDescriptor::PortType::AGGREGATE: {
+      auto aggregatePort =
+          sw->getState()->getAggregatePorts()->getNodeIf(port.aggPortID());
+      if (!aggregatePort) {
+        XLOG(ERR) << "Aggregate port " << port.aggPortID()
+                  << " not found. Skip sending probe";
+        return;
+      }
+      intfID = InterfaceID(aggregatePort->getInterfaceIDs()->at(0)->cref());
+      srcIntf = state->getInterfaces()->getNodeIf(intfID);
+      break;
+    }
+    case PortDescriptor::PortType::SYSTEM_PORT:
+      auto physPortID = getPortID(port.sysPortID(), sw->getState());
+      intfID = sw->getState()->getInterfaceIDForPort(
+          PortDescriptor(physPortID));
+      srcIntf = state->getInterfaces()->getNodeIf(intfID);
+      break;
+  }
+
+  if (!srcIntf) {
+    // srcIntf must/can never be nullptr
+    XLOG(DBG2) << "No interface found " << intfID << ". Skip sending probe";
+    return;
+  }
+
+  folly::MacAddress srcMac = srcIntf->getMac();
+  folly::IPAddressV6 srcIP(folly::IPAddressV6::LINK_LOCAL, srcMac);
+  if (srcIntf->canReachAddress(targetIP)) {
+    srcIP = srcIntf->getAddressToReach(targetIP)->first.asV6();
+  }
+  // unicast solicitation
+  IPv6Handler::sendUnicastNeighborSolicitation(
+      sw,
+      targetIP,
+      targetMac,
+      srcIP,
+      srcMac,
+      srcIntf->getVlanIDIf(),
+      port);
+}
+} // namespace
+
 NdpCache::NdpCache(
     SwSwitch* sw,
     const SwitchState* state,
@@ -129,60 +187,16 @@ inline void NdpCache::checkReachability(
     folly::IPAddressV6 targetIP,
     folly::MacAddress targetMac,
     PortDescriptor port) const {
-  const auto state = getSw()->getState();
-
-  InterfaceID intfID;
-  std::shared_ptr<Interface> srcIntf;
-  switch (port.type()) {
-    case PortDescriptor::PortType::PHYSICAL:
-      intfID = getSw()->getState()->getInterfaceIDForPort(port);
-      srcIntf = state->getInterfaces()->getNodeIf(intfID);
-      break;
-    case PortDescriptor::PortType::AGGREGATE: {
-      auto aggregatePort =
-          getSw()->getState()->getAggregatePorts()->getNodeIf(port.aggPortID());
-      if (!aggregatePort) {
-        XLOG(ERR) << "Aggregate port " << port.aggPortID()
-                  << " not found. Skip sending probe";
-        return;
-      }
-      intfID = InterfaceID(aggregatePort->getInterfaceIDs()->at(0)->cref());
-      srcIntf = state->getInterfaces()->getNodeIf(intfID);
-      break;
-    }
-    case PortDescriptor::PortType::SYSTEM_PORT:
-      auto physPortID = getPortID(port.sysPortID(), getSw()->getState());
-      intfID = getSw()->getState()->getInterfaceIDForPort(
-          PortDescriptor(physPortID));
-      srcIntf = state->getInterfaces()->getNodeIf(intfID);
-      break;
-  }
-
-  if (!srcIntf) {
-    // srcIntf must/can never be nullptr
-    XLOG(DBG2) << "No interface found " << intfID << ". Skip sending probe";
-    return;
-  }
-
-  folly::MacAddress srcMac = srcIntf->getMac();
-  folly::IPAddressV6 srcIP(folly::IPAddressV6::LINK_LOCAL, srcMac);
-  if (srcIntf->canReachAddress(targetIP)) {
-    srcIP = srcIntf->getAddressToReach(targetIP)->first.asV6();
-  }
-  // unicast solicitation
-  IPv6Handler::sendUnicastNeighborSolicitation(
-      getSw(),
-      targetIP,
-      targetMac,
-      srcIP,
-      srcMac,
-      srcIntf->getVlanIDIf(),
-      port);
+  sendProbe(targetIP, [sw = getSw(), targetIP, targetMac, port]() {
+    sendUnicastProbe(sw, targetIP, targetMac, port);
+  });
 }
 
 inline void NdpCache::probeFor(folly::IPAddressV6 ip) const {
-  // multicast solicitation
-  IPv6Handler::sendMulticastNeighborSolicitation(getSw(), ip);
+  sendProbe(ip, [sw = getSw(), ip]() {
+    // multicast solicitation
+    IPv6Handler::sendMulticastNeighborSolicitation(sw, ip);
+  });
 }
 
 std::list<NdpEntryThrift> NdpCache::getNdpCacheData() {
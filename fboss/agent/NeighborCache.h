@@ -11,6 +11,7 @@
 
 #include "fboss/agent/NeighborCacheEntry.h"
 #include "fboss/agent/NeighborCacheImpl-defs.h"
+#include "fboss/agent/NeighborRefreshEngine.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/state/PortDescriptor.h"
 
@@ -43,7 +44,12 @@ class NeighborCache {
  public:
   typedef typename NTable::Entry::AddressType AddressType;
 
-  virtual ~NeighborCache() {}
+  virtual ~NeighborCache() {
+    if (auto engine = sw_->getNeighborRefreshEngine()) {
+      // queued probes and state updates may refer to this cache
+      engine->cancel(this);
+    }
+  }
 
   bool flushEntryBlocking(AddressType ip) {
     std::lock_guard<std::mutex> g(cacheLock_);
@@ -200,6 +206,17 @@ class NeighborCache {
     return maxNeighborProbes_;
   }
 
+  // Sends a probe now, or queues it with the NeighborRefreshEngine if there
+  // is one. Queued probes are dropped when this cache is destroyed.
+  void sendProbe(AddressType ip, NeighborRefreshEngine::ProbeFn probe) const {
+    if (auto engine = sw_->getNeighborRefreshEngine()) {
+      engine->enqueueProbe(
+          this, getIntfID(), folly::IPAddress(ip), std::move(probe));
+      return;
+    }
+    probe();
+  }
+
  private:
   // This should only be called by a NeighborCacheEntry
   virtual void checkReachability(
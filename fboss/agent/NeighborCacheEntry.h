@@ -12,6 +12,7 @@
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/TimerWheel.h"
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/PortDescriptor.h"
 #include "fboss/agent/types.h"
@@ -78,7 +79,7 @@ template <typename NTable>
 class NeighborCache;
 
 template <typename NTable>
-class NeighborCacheEntry : private folly::AsyncTimeout {
+class NeighborCacheEntry : private TimerWheel::Callback {
  public:
   typedef typename NTable::Entry::AddressType AddressType;
   typedef NeighborCache<NTable> Cache;
@@ -90,7 +91,7 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
       Cache* cache,
       NeighborEntryState state,
       state::NeighborEntryType type)
-      : AsyncTimeout(evb),
+      : TimerWheel::Callback(evb->getTimerWheel()),
         fields_(fields),
         cache_(cache),
         evb_(evb),
@@ -233,6 +234,9 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
   }
 
  private:
+  // spreads out the probes of entries that started probing together
+  static constexpr auto kProbeIntervalJitter = std::chrono::milliseconds(100);
+
   /*
    * We tell the cache that this entry needs to be processed. The cache is
    * responsible for serializing this with other flush or rx events to prevent
@@ -257,12 +261,16 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
         expireTime_ = std::chrono::steady_clock::now() + lifetime;
         scheduleTimeout(lifetime);
         break;
-      case NeighborEntryState::STALE:
-        scheduleTimeout(std::chrono::seconds(cache_->getStaleEntryInterval()));
+      case NeighborEntryState::STALE: {
+        // entries going stale together, e.g. all repopulated at warm boot,
+        // are spread out by the jitter
+        std::chrono::milliseconds interval = cache_->getStaleEntryInterval();
+        scheduleTimeout(interval, interval / 10);
         break;
+      }
       case NeighborEntryState::PROBE:
       case NeighborEntryState::INCOMPLETE:
-        scheduleTimeout(std::chrono::seconds(1));
+        scheduleTimeout(std::chrono::seconds(1), kProbeIntervalJitter);
         break;
       case NeighborEntryState::EXPIRED:
         // This entry is expired and is already flushed. Don't schedule a
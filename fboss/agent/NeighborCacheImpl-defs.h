@@ -21,6 +21,7 @@
 #include "fboss/agent/HwAsicTable.h"
 #include "fboss/agent/IPv6Handler.h"
 #include "fboss/agent/NeighborCacheImpl.h"
+#include "fboss/agent/NeighborRefreshEngine.h"
 #include "fboss/agent/StaticL2ForNeighborSwSwitchUpdater.h"
 #include "fboss/agent/SwitchIdScopeResolver.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
@@ -121,6 +122,25 @@ bool NeighborCacheImpl<NTable>::isHwUpdateProtected() {
       sw_->getHwSwitchHandler()->transactionsSupported());
 }
 
+template <typename NTable>
+void NeighborCacheImpl<NTable>::postStateUpdate(
+    const std::string& name,
+    SwSwitch::StateUpdateFn updateFn,
+    bool allowCoalescing) {
+  if (auto engine = sw_->getNeighborRefreshEngine()) {
+    engine->enqueueUpdate(cache_, std::move(updateFn), allowCoalescing);
+    return;
+  }
+  sw_->updateStateHighPriority(name, std::move(updateFn), allowCoalescing);
+}
+
+template <typename NTable>
+void NeighborCacheImpl<NTable>::flushQueuedStateUpdates() {
+  if (auto engine = sw_->getNeighborRefreshEngine()) {
+    engine->flushUpdates();
+  }
+}
+
 template <typename NTable>
 bool NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
   SwSwitch::StateUpdateFn updateFn;
@@ -144,6 +164,7 @@ bool NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
   }
 
   if (isHwUpdateProtected()) {
+    flushQueuedStateUpdates();
     try {
       sw_->updateStateWithHwFailureProtection(
           folly::to<std::string>(
@@ -158,7 +179,7 @@ bool NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
       return false;
     }
   } else {
-    sw_->updateState(
+    postStateUpdate(
         folly::to<std::string>("add neighbor ", entry->getFields().ip),
         std::move(updateFn));
   }
@@ -396,6 +417,7 @@ bool NeighborCacheImpl<NTable>::programPendingEntry(
   }
 
   if (isHwUpdateProtected()) {
+    flushQueuedStateUpdates();
     try {
       sw_->updateStateWithHwFailureProtection(
           folly::to<std::string>(
@@ -410,9 +432,10 @@ bool NeighborCacheImpl<NTable>::programPendingEntry(
       return false;
     }
   } else {
-    sw_->updateStateNoCoalescing(
+    postStateUpdate(
         folly::to<std::string>("add pending entry ", entry->getFields().ip),
-        std::move(updateFn));
+        std::move(updateFn),
+        false /* allowCoalescing */);
   }
   return true;
 }
@@ -898,6 +921,7 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
   if (flushed) {
     // need a blocking state update if the caller wants to know if an entry
     // was actually flushed
+    flushQueuedStateUpdates();
     if (isHwUpdateProtected()) {
       try {
         sw_->updateStateWithHwFailureProtection(
@@ -911,7 +935,7 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
       sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
     }
   } else {
-    sw_->updateState("remove neighbor entry: " + ip.str(), std::move(updateFn));
+    postStateUpdate("remove neighbor entry: " + ip.str(), std::move(updateFn));
   }
 }
 
@@ -134,6 +134,16 @@ class NeighborCacheImpl {
   bool
   programPendingEntry(Entry* entry, PortDescriptor port, bool force = false);
 
+  // Posts a high priority state update, through the NeighborRefreshEngine if
+  // there is one
+  void postStateUpdate(
+      const std::string& name,
+      SwSwitch::StateUpdateFn updateFn,
+      bool allowCoalescing = true);
+  // Updates queued by the NeighborRefreshEngine go before updates posted
+  // directly
+  void flushQueuedStateUpdates();
+
   SwSwitch::StateUpdateFn getUpdateFnToProgramEntryForVlan(Entry* entry);
   SwSwitch::StateUpdateFn getUpdateFnToProgramEntry(
       Entry* entry,
@@ -0,0 +1,221 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NeighborRefreshEngine.h"
+
+#include "fboss/agent/FbossEventBase.h"
+#include "fboss/agent/SwitchStats.h"
+
+#include <folly/Conv.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+DEFINE_bool(
+    neighbor_refresh_engine,
+    false,
+    "Batch the ARP/NDP probes and neighbor table updates of the neighbor "
+    "caches, sending probes paced per interface and posting one neighbor "
+    "table update per tick");
+
+DEFINE_uint32(
+    neighbor_refresh_interval_ms,
+    100,
+    "Tick of the neighbor refresh engine, probes and neighbor table updates "
+    "queued during a tick are handled together");
+
+DEFINE_uint32(
+    neighbor_refresh_max_probes_per_sec,
+    1000,
+    "Max number of ARP/NDP probes sent per second per interface by the "
+    "neighbor refresh engine, 0 for no limit");
+
+namespace facebook::fboss {
+
+NeighborRefreshEngine::NeighborRefreshEngine(
+    FbossEventBase* evb,
+    Config config,
+    PostUpdateFn postUpdate,
+    StatsFn stats)
+    : TimerWheel::Callback(evb->getTimerWheel()),
+      evb_(evb),
+      config_(config),
+      probesPerTick_(
+          config.maxProbesPerSec
+              ? static_cast<uint32_t>(std::max<uint64_t>(
+                    1,
+                    uint64_t(config.maxProbesPerSec) *
+                        config.interval.count() / 1000))
+              : std::numeric_limits<uint32_t>::max()),
+      postUpdate_(std::move(postUpdate)),
+      stats_(std::move(stats)) {
+  CHECK_GT(config_.interval.count(), 0);
+}
+
+NeighborRefreshEngine::~NeighborRefreshEngine() {}
+
+NeighborRefreshEngine::Config NeighborRefreshEngine::configFromFlags() {
+  Config config;
+  config.interval = std::chrono::milliseconds(
+      std::max<uint32_t>(FLAGS_neighbor_refresh_interval_ms, 1));
+  config.maxProbesPerSec = FLAGS_neighbor_refresh_max_probes_per_sec;
+  return config;
+}
+
+void NeighborRefreshEngine::enqueueProbe(
+    const void* owner,
+    InterfaceID intf,
+    const folly::IPAddress& ip,
+    ProbeFn probe) {
+  DCHECK(evb_->isInEventBaseThread());
+  auto& intfQueue = probes_[intf];
+  auto it = intfQueue.queued.find(ip);
+  if (it != intfQueue.queued.end()) {
+    // e.g. a unicast probe replacing a broadcast one
+    it->second->owner = owner;
+    it->second->probe = std::move(probe);
+  } else {
+    intfQueue.queue.push_back(QueuedProbe{owner, ip, std::move(probe)});
+    intfQueue.queued.emplace(ip, std::prev(intfQueue.queue.end()));
+  }
+  scheduleTick();
+}
+
+void NeighborRefreshEngine::enqueueUpdate(
+    const void* owner,
+    StateUpdateFn fn,
+    bool allowCoalescing) {
+  DCHECK(evb_->isInEventBaseThread());
+  updates_.push_back(QueuedUpdate{
+      owner,
+      std::move(fn),
+      allowCoalescing,
+      std::chrono::steady_clock::now()});
+  scheduleTick();
+}
+
+void NeighborRefreshEngine::flushUpdates() {
+  DCHECK(evb_->isInEventBaseThread());
+  postUpdates();
+}
+
+void NeighborRefreshEngine::cancel(const void* owner) {
+  DCHECK(evb_->isInEventBaseThread());
+  for (auto& [intf, intfQueue] : probes_) {
+    for (auto it = intfQueue.queue.begin(); it != intfQueue.queue.end();) {
+      if (it->owner == owner) {
+        intfQueue.queued.erase(it->ip);
+        it = intfQueue.queue.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  updates_.erase(
+      std::remove_if(
+          updates_.begin(),
+          updates_.end(),
+          [owner](const auto& update) { return update.owner == owner; }),
+      updates_.end());
+}
+
+size_t NeighborRefreshEngine::probesQueued(InterfaceID intf) const {
+  auto it = probes_.find(intf);
+  return it == probes_.end() ? 0 : it->second.queue.size();
+}
+
+void NeighborRefreshEngine::scheduleTick() {
+  if (!isScheduled()) {
+    scheduleTimeout(config_.interval);
+  }
+}
+
+uint32_t NeighborRefreshEngine::sendProbes() {
+  uint32_t sent = 0;
+  for (auto it = probes_.begin(); it != probes_.end();) {
+    auto& intfQueue = it->second;
+    auto& queue = intfQueue.queue;
+    for (uint32_t i = 0; i < probesPerTick_ && !queue.empty(); ++i) {
+      auto probe = std::move(queue.front());
+      intfQueue.queued.erase(probe.ip);
+      queue.pop_front();
+      probe.probe();
+      ++sent;
+    }
+    if (queue.empty()) {
+      it = probes_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return sent;
+}
+
+void NeighborRefreshEngine::postUpdates() {
+  if (updates_.empty()) {
+    return;
+  }
+  auto post = [this](std::vector<QueuedUpdate> batch, bool allowCoalescing) {
+    auto name = folly::to<std::string>(
+        "neighbor refresh: ", batch.size(), " neighbor updates");
+    stats_()->neighborUpdateBatchSize(batch.size());
+    postUpdate_(
+        name,
+        [updates = std::move(batch), stats = stats_](
+            const std::shared_ptr<SwitchState>& state)
+            -> std::shared_ptr<SwitchState> {
+          // apply the updates in order, as the update thread does when
+          // coalescing them
+          std::shared_ptr<SwitchState> newState;
+          auto now = std::chrono::steady_clock::now();
+          for (const auto& update : updates) {
+            auto updated = update.fn(newState ? newState : state);
+            if (updated) {
+              newState = std::move(updated);
+            }
+            stats()->neighborUpdateLatencyMs(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now - update.enqueueTime)
+                    .count());
+          }
+          return newState;
+        },
+        allowCoalescing);
+  };
+
+  std::vector<QueuedUpdate> batch;
+  for (auto& update : updates_) {
+    bool allowCoalescing = update.allowCoalescing;
+    batch.push_back(std::move(update));
+    if (!allowCoalescing) {
+      // later updates must not be merged with this one
+      post(std::move(batch), false);
+      batch.clear();
+    }
+  }
+  if (!batch.empty()) {
+    post(std::move(batch), true);
+  }
+  updates_.clear();
+}
+
+void NeighborRefreshEngine::timeoutExpired() noexcept {
+  auto sent = sendProbes();
+  if (sent) {
+    stats_()->neighborProbesSent(sent);
+    stats_()->neighborProbeBatchSize(sent);
+  }
+  postUpdates();
+  if (!probes_.empty() || !updates_.empty()) {
+    scheduleTick();
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/TimerWheel.h"
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+DECLARE_bool(neighbor_refresh_engine);
+
+namespace facebook::fboss {
+
+class FbossEventBase;
+class SwitchState;
+class SwitchStats;
+
+/*
+ * Batches the ARP/NDP probes and the neighbor table updates of the neighbor
+ * caches, which would otherwise each send a probe and post a state update as
+ * soon as one of their entries changes.
+ *
+ * Probes are queued per interface, at most one per neighbor IP, and every
+ * tick each interface sends at most its share of the per interface probe
+ * rate, leaving the rest for the next ticks. Neighbor table updates are
+ * queued in order and posted as a single state update per tick, ending a
+ * batch early only after an update that must not be coalesced with later
+ * ones.
+ *
+ * Queued probes and updates are tagged with their owner (the neighbor cache),
+ * so they can be dropped when the owner goes away. All methods must be
+ * called from the thread of the event base, i.e. the neighbor cache thread.
+ */
+class NeighborRefreshEngine : private TimerWheel::Callback {
+ public:
+  struct Config {
+    std::chrono::milliseconds interval{100};
+    // per interface, 0 for no limit
+    uint32_t maxProbesPerSec{0};
+  };
+  using ProbeFn = std::function<void()>;
+  using StateUpdateFn = std::function<std::shared_ptr<SwitchState>(
+      const std::shared_ptr<SwitchState>&)>;
+  using PostUpdateFn = std::function<
+      void(const std::string& name, StateUpdateFn fn, bool allowCoalescing)>;
+  // SwitchStats of the calling thread
+  using StatsFn = std::function<SwitchStats*()>;
+
+  NeighborRefreshEngine(
+      FbossEventBase* evb,
+      Config config,
+      PostUpdateFn postUpdate,
+      StatsFn stats);
+  ~NeighborRefreshEngine() override;
+
+  // from the --neighbor_refresh_* flags
+  static Config configFromFlags();
+
+  /*
+   * Queue a probe for ip on interface intf. Replaces the probe already
+   * queued for the same ip, if any, keeping its place in the queue.
+   */
+  void enqueueProbe(
+      const void* owner,
+      InterfaceID intf,
+      const folly::IPAddress& ip,
+      ProbeFn probe);
+
+  void enqueueUpdate(
+      const void* owner,
+      StateUpdateFn fn,
+      bool allowCoalescing = true);
+
+  // post the queued updates now, to keep them ahead of an update the caller
+  // is about to post directly
+  void flushUpdates();
+
+  // drop the probes and updates queued by owner
+  void cancel(const void* owner);
+
+  size_t probesQueued(InterfaceID intf) const;
+  size_t updatesQueued() const {
+    return updates_.size();
+  }
+
+ private:
+  struct QueuedProbe {
+    const void* owner;
+    folly::IPAddress ip;
+    ProbeFn probe;
+  };
+  struct IntfProbeQueue {
+    std::list<QueuedProbe> queue;
+    std::unordered_map<folly::IPAddress, std::list<QueuedProbe>::iterator>
+        queued;
+  };
+  struct QueuedUpdate {
+    const void* owner;
+    StateUpdateFn fn;
+    bool allowCoalescing;
+    std::chrono::steady_clock::time_point enqueueTime;
+  };
+
+  void scheduleTick();
+  uint32_t sendProbes();
+  void postUpdates();
+  void timeoutExpired() noexcept override;
+
+  FbossEventBase* evb_;
+  const Config config_;
+  // probes each interface sends per tick
+  const uint32_t probesPerTick_;
+  PostUpdateFn postUpdate_;
+  StatsFn stats_;
+  std::unordered_map<InterfaceID, IntfProbeQueue> probes_;
+  std::vector<QueuedUpdate> updates_;
+};
+
+} // namespace facebook::fboss
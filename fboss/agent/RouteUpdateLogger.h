@@ -162,6 +162,10 @@ class RouteUpdateLogger : public StateObserver {
   ~RouteUpdateLogger() override;
 
   void stateUpdated(const StateDelta& delta) override;
+  // Trackers are synchronized, loggers are only used from stateUpdated
+  bool isConcurrentSafe() const override {
+    return true;
+  }
   void startLoggingForPrefix(const RouteUpdateLoggingInstance& req);
   void stopLoggingForPrefix(
       const folly::IPAddress& network,
@@ -136,13 +136,15 @@ void RouteUpdateWrapper::printStats(const UpdateStatistics& stats) const {
   XLOG(DBG0) << " Routes added: " << stats.v4RoutesAdded + stats.v6RoutesAdded
              << " Routes deleted: "
              << stats.v4RoutesDeleted + stats.v6RoutesDeleted << " Duration "
-             << stats.duration.count() << " us ";
+             << stats.duration.count() << " us "
+             << " RIB shard: " << stats.shard;
 }
 
 void RouteUpdateWrapper::printMplsStats(const UpdateStatistics& stats) const {
   XLOG(DBG0) << " Mpls Routes added: " << stats.mplsRoutesAdded
              << " Mpls Routes deleted: " << stats.mplsRoutesDeleted
-             << " Duration " << stats.duration.count() << " us ";
+             << " Duration " << stats.duration.count() << " us "
+             << " RIB shard: " << stats.shard;
 }
 
 void RouteUpdateWrapper::programStandAloneRib(const SyncFibFor& syncFibFor) {
@@ -201,6 +203,42 @@ void RouteUpdateWrapper::programStandAloneRib(const SyncFibFor& syncFibFor) {
   }
 }
 
+void RouteUpdateWrapper::beginSyncFib(RouterID rid, ClientID clientId) {
+  getRib()->beginSyncFib(rid, clientId);
+}
+
+RouteUpdateWrapper::SyncFibProgress RouteUpdateWrapper::addSyncFibRoutes(
+    RouterID rid,
+    ClientID clientId,
+    const std::vector<UnicastRoute>& routes) {
+  auto progress = getRib()->addSyncFibRoutes(
+      resolver_,
+      rid,
+      clientId,
+      clientIdToAdminDistance(clientId),
+      routes,
+      *fibUpdateFn_,
+      fibUpdateCookie_);
+  printStats(progress.lastUpdate);
+  updateStats(progress.lastUpdate);
+  return progress;
+}
+
+RouteUpdateWrapper::SyncFibProgress RouteUpdateWrapper::commitSyncFib(
+    RouterID rid,
+    ClientID clientId) {
+  auto progress = getRib()->commitSyncFib(
+      resolver_,
+      rid,
+      clientId,
+      clientIdToAdminDistance(clientId),
+      *fibUpdateFn_,
+      fibUpdateCookie_);
+  printStats(progress.lastUpdate);
+  updateStats(progress.lastUpdate);
+  return progress;
+}
+
 void RouteUpdateWrapper::programClassID(
     RouterID rid,
     const std::vector<folly::CIDRNetwork>& prefixes,
@@ -105,6 +105,17 @@ class RouteUpdateWrapper {
       const RouterIDAndNetworkToInterfaceRoutes& toAdd,
       const RouterIDToPrefixes& toDel);
   void program(const SyncFibInfo& syncFibInfo = {});
+  /*
+   * Chunked syncFib, see RoutingInformationBase::beginSyncFib. Each chunk
+   * is programmed as it is added, independent of program().
+   */
+  using SyncFibProgress = RoutingInformationBase::SyncFibProgress;
+  void beginSyncFib(RouterID rid, ClientID clientId);
+  SyncFibProgress addSyncFibRoutes(
+      RouterID rid,
+      ClientID clientId,
+      const std::vector<UnicastRoute>& routes);
+  SyncFibProgress commitSyncFib(RouterID rid, ClientID clientId);
   void programMinAlpmState();
   void programClassID(
       RouterID rid,
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketClassifier.h"
+
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/ICMPHdr.h"
+#include "fboss/agent/packet/IPProto.h"
+
+#include <folly/io/Cursor.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr size_t kMacLength = 6;
+constexpr size_t kEthertypeOffset = 2 * kMacLength;
+constexpr uint8_t kUntaggedL2HeaderLength = 14;
+constexpr uint8_t kVlanTagLength = 4;
+constexpr size_t kIPv4ProtocolOffset = 9;
+constexpr size_t kIPv6NextHeaderOffset = 6;
+constexpr size_t kIPv6HeaderLength = 40;
+constexpr size_t kL4PortsLength = 4;
+
+static_assert(
+    kUntaggedL2HeaderLength + kVlanTagLength + kIPv6HeaderLength +
+        kL4PortsLength <=
+    RxPacketBurstClassifier::kHeaderBytes);
+
+constexpr uint16_t ethertypeValue(ETHERTYPE ethertype) {
+  return static_cast<uint16_t>(ethertype);
+}
+
+inline uint16_t readBE16(const uint8_t* data) {
+  return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+RxPacketClass
+classOf(uint16_t ethertype, uint8_t ipProtocol, uint8_t icmpType) {
+  switch (ethertype) {
+    case ethertypeValue(ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS):
+      return RxPacketClass::SLOW_PROTOCOLS;
+    case ethertypeValue(ETHERTYPE::ETHERTYPE_LLDP):
+      return RxPacketClass::LLDP;
+    case ethertypeValue(ETHERTYPE::ETHERTYPE_EAPOL):
+      return RxPacketClass::EAPOL;
+    case ethertypeValue(ETHERTYPE::ETHERTYPE_ARP):
+      return RxPacketClass::ARP;
+    case ethertypeValue(ETHERTYPE::ETHERTYPE_IPV4):
+      return RxPacketClass::IPV4;
+    case ethertypeValue(ETHERTYPE::ETHERTYPE_IPV6): {
+      constexpr auto kIcmpV6 =
+          static_cast<uint8_t>(IP_PROTO::IP_PROTO_IPV6_ICMP);
+      constexpr auto kNdpFirst = static_cast<uint8_t>(
+          ICMPv6Type::ICMPV6_TYPE_NDP_ROUTER_SOLICITATION);
+      constexpr auto kNdpLast =
+          static_cast<uint8_t>(ICMPv6Type::ICMPV6_TYPE_NDP_REDIRECT_MESSAGE);
+      bool isNdp = ipProtocol == kIcmpV6 && icmpType >= kNdpFirst &&
+          icmpType <= kNdpLast;
+      return isNdp ? RxPacketClass::NDP : RxPacketClass::IPV6;
+    }
+    case ethertypeValue(ETHERTYPE::ETHERTYPE_MPLS):
+      return RxPacketClass::MPLS;
+    default:
+      break;
+  }
+  return RxPacketClass::OTHER;
+}
+} // namespace
+
+void RxPacketBurstClassifier::classify(
+    const std::vector<std::unique_ptr<RxPacket>>& pkts,
+    uint32_t minLength) {
+  auto numPkts = pkts.size();
+  headers_.resize(numPkts);
+  lengths_.resize(numPkts);
+  ethertypes_.resize(numPkts);
+  vlanTags_.resize(numPkts);
+  l2HeaderLengths_.resize(numPkts);
+  ipProtocols_.resize(numPkts);
+  icmpTypes_.resize(numPkts);
+  l4SrcPorts_.resize(numPkts);
+  l4DstPorts_.resize(numPkts);
+  classes_.resize(numPkts);
+  for (auto& packets : packetsByClass_) {
+    packets.clear();
+  }
+
+  // Gather the headers. Short packets are zero padded, they are classified
+  // BOGUS below, or have zero fields past their end.
+  for (size_t i = 0; i < numPkts; ++i) {
+    auto& header = headers_[i];
+    folly::io::Cursor cursor(pkts[i]->buf());
+    auto copied = cursor.pullAtMost(header.data(), kHeaderBytes);
+    std::memset(header.data() + copied, 0, kHeaderBytes - copied);
+    lengths_[i] = pkts[i]->getLength();
+  }
+
+  // Extract the fields at fixed offsets, selecting between the tagged and
+  // untagged layout rather than branching on it.
+  for (size_t i = 0; i < numPkts; ++i) {
+    const auto* header = headers_[i].data();
+    auto outerEthertype = readBE16(header + kEthertypeOffset);
+    auto innerEthertype = readBE16(header + kEthertypeOffset + kVlanTagLength);
+    bool tagged = outerEthertype == ethertypeValue(ETHERTYPE::ETHERTYPE_VLAN);
+    uint8_t l2HeaderLength =
+        kUntaggedL2HeaderLength + (tagged ? kVlanTagLength : 0);
+    auto ethertype = tagged ? innerEthertype : outerEthertype;
+    const auto* l3Header = header + l2HeaderLength;
+    bool isV4 = ethertype == ethertypeValue(ETHERTYPE::ETHERTYPE_IPV4);
+    bool isV6 = ethertype == ethertypeValue(ETHERTYPE::ETHERTYPE_IPV6);
+
+    ethertypes_[i] = ethertype;
+    vlanTags_[i] =
+        tagged ? readBE16(header + kUntaggedL2HeaderLength) & 0xfff : 0;
+    l2HeaderLengths_[i] = l2HeaderLength;
+    ipProtocols_[i] = isV4 ? l3Header[kIPv4ProtocolOffset]
+        : isV6             ? l3Header[kIPv6NextHeaderOffset]
+                           : 0;
+    icmpTypes_[i] = isV6 ? l3Header[kIPv6HeaderLength] : 0;
+
+    auto ipProtocol = ipProtocols_[i];
+    size_t l4Offset = l2HeaderLength +
+        (isV4 ? (l3Header[0] & 0xf) * 4 : kIPv6HeaderLength);
+    bool hasPorts = (isV4 || isV6) &&
+        (ipProtocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_TCP) ||
+         ipProtocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP)) &&
+        l4Offset + kL4PortsLength <= kHeaderBytes;
+    // clamped, so the loads stay within the row either way
+    const auto* l4Header =
+        header + std::min(l4Offset, kHeaderBytes - kL4PortsLength);
+    l4SrcPorts_[i] = hasPorts ? readBE16(l4Header) : 0;
+    l4DstPorts_[i] = hasPorts ? readBE16(l4Header + 2) : 0;
+  }
+
+  for (size_t i = 0; i < numPkts; ++i) {
+    classes_[i] = lengths_[i] < minLength
+        ? RxPacketClass::BOGUS
+        : classOf(ethertypes_[i], ipProtocols_[i], icmpTypes_[i]);
+    packetsByClass_[static_cast<size_t>(classes_[i])].push_back(i);
+  }
+}
+
+folly::MacAddress RxPacketBurstClassifier::dstMac(size_t idx) const {
+  return folly::MacAddress::fromBinary(
+      folly::ByteRange(headers_[idx].data(), kMacLength));
+}
+
+folly::MacAddress RxPacketBurstClassifier::srcMac(size_t idx) const {
+  return folly::MacAddress::fromBinary(
+      folly::ByteRange(headers_[idx].data() + kMacLength, kMacLength));
+}
+
+} // namespace facebook::fboss
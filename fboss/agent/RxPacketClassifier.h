@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/RxPacket.h"
+
+#include <folly/MacAddress.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Classes of trapped packets, in the order the packets of a burst are
+ * dispatched in: link and neighbor protocols ahead of IP traffic.
+ */
+enum class RxPacketClass : uint8_t {
+  SLOW_PROTOCOLS,
+  LLDP,
+  EAPOL,
+  ARP,
+  NDP,
+  IPV4,
+  IPV6,
+  MPLS,
+  OTHER,
+  // shorter than the minimum ethernet frame length, not dispatched
+  BOGUS,
+};
+constexpr size_t kNumRxPacketClasses =
+    static_cast<size_t>(RxPacketClass::BOGUS) + 1;
+
+/*
+ * Classifies a burst of trapped packets by their headers.
+ *
+ * The leading bytes of every packet are first copied into a fixed size row of
+ * a contiguous header block. Ethertype, 802.1Q tag and L3/L4 protocol are then
+ * extracted from fixed offsets of the rows, with selects rather than data
+ * dependent branches, so the loop over the burst is vectorizable. Finally the
+ * packets are grouped by class, keeping the arrival order within a class, so
+ * each handler gets its packets back to back.
+ */
+class RxPacketBurstClassifier {
+ public:
+  // L2 header with an 802.1Q tag, IPv6 header and the TCP/UDP ports
+  static constexpr size_t kHeaderBytes = 64;
+
+  void classify(
+      const std::vector<std::unique_ptr<RxPacket>>& pkts,
+      uint32_t minLength);
+
+  size_t size() const {
+    return classes_.size();
+  }
+  RxPacketClass packetClass(size_t idx) const {
+    return classes_[idx];
+  }
+  folly::MacAddress dstMac(size_t idx) const;
+  folly::MacAddress srcMac(size_t idx) const;
+  // ethertype after the 802.1Q tag, if any
+  uint16_t ethertype(size_t idx) const {
+    return ethertypes_[idx];
+  }
+  // 0 for untagged packets
+  uint16_t vlanTag(size_t idx) const {
+    return vlanTags_[idx];
+  }
+  // offset of the L3 header, i.e. bytes up to and including the ethertype
+  uint8_t l2HeaderLength(size_t idx) const {
+    return l2HeaderLengths_[idx];
+  }
+  // IPv4 protocol or IPv6 next header, 0 for non IP packets
+  uint8_t ipProtocol(size_t idx) const {
+    return ipProtocols_[idx];
+  }
+  // TCP/UDP ports, 0 for other packets or if the ports are not within the
+  // leading kHeaderBytes (e.g. after IPv4 options)
+  uint16_t l4SrcPort(size_t idx) const {
+    return l4SrcPorts_[idx];
+  }
+  uint16_t l4DstPort(size_t idx) const {
+    return l4DstPorts_[idx];
+  }
+  // indices of the packets of a class, in arrival order
+  const std::vector<uint32_t>& packetsOfClass(RxPacketClass cls) const {
+    return packetsByClass_[static_cast<size_t>(cls)];
+  }
+
+ private:
+  std::vector<std::array<uint8_t, kHeaderBytes>> headers_;
+  std::vector<uint32_t> lengths_;
+  std::vector<uint16_t> ethertypes_;
+  std::vector<uint16_t> vlanTags_;
+  std::vector<uint8_t> l2HeaderLengths_;
+  std::vector<uint8_t> ipProtocols_;
+  std::vector<uint8_t> icmpTypes_;
+  std::vector<uint16_t> l4SrcPorts_;
+  std::vector<uint16_t> l4DstPorts_;
+  std::vector<RxPacketClass> classes_;
+  std::array<std::vector<uint32_t>, kNumRxPacketClasses> packetsByClass_;
+};
+
+} // namespace facebook::fboss
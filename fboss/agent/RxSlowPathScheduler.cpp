@@ -0,0 +1,247 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxSlowPathScheduler.h"
+
+#include "fboss/agent/RxPacketClassifier.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/packet/IPProto.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+DEFINE_bool(
+    rx_slow_path_scheduler,
+    false,
+    "Queue trapped packets per protocol class, with per port and class rate "
+    "limits, and handle them in priority order on a dedicated thread");
+
+DEFINE_double(
+    rx_slow_path_control_pps,
+    0,
+    "Per port rate limit of LACP, LLDP and EAPOL packets, 0 for no limit");
+DEFINE_double(
+    rx_slow_path_bgp_pps,
+    0,
+    "Per port rate limit of BGP packets, 0 for no limit");
+DEFINE_double(
+    rx_slow_path_neighbor_pps,
+    2000,
+    "Per port rate limit of ARP and NDP packets, 0 for no limit");
+DEFINE_double(
+    rx_slow_path_other_pps,
+    2000,
+    "Per port rate limit of other trapped packets, 0 for no limit");
+DEFINE_uint32(
+    rx_slow_path_queue_depth,
+    10000,
+    "Max number of queued trapped packets per class, 0 for no limit");
+
+namespace facebook::fboss {
+
+namespace {
+constexpr uint16_t kBgpPort = 179;
+
+RxSlowPathScheduler::ClassConfig makeClassConfig(double ratePps) {
+  // allow bursts of up to a second worth of packets
+  return {ratePps, ratePps, FLAGS_rx_slow_path_queue_depth};
+}
+} // namespace
+
+const char* rxSlowPathClassToString(RxSlowPathClass rxClass) {
+  switch (rxClass) {
+    case RxSlowPathClass::CONTROL:
+      return "control";
+    case RxSlowPathClass::BGP:
+      return "bgp";
+    case RxSlowPathClass::NEIGHBOR:
+      return "neighbor";
+    case RxSlowPathClass::OTHER:
+      return "other";
+  }
+  return "unknown";
+}
+
+RxSlowPathScheduler::RxSlowPathScheduler(
+    Config config,
+    PacketHandler handler,
+    StatsFn stats)
+    : config_(config), handler_(std::move(handler)), stats_(std::move(stats)) {}
+
+RxSlowPathScheduler::~RxSlowPathScheduler() {
+  stop();
+}
+
+RxSlowPathScheduler::Config RxSlowPathScheduler::configFromFlags() {
+  Config config;
+  config[static_cast<size_t>(RxSlowPathClass::CONTROL)] =
+      makeClassConfig(FLAGS_rx_slow_path_control_pps);
+  config[static_cast<size_t>(RxSlowPathClass::BGP)] =
+      makeClassConfig(FLAGS_rx_slow_path_bgp_pps);
+  config[static_cast<size_t>(RxSlowPathClass::NEIGHBOR)] =
+      makeClassConfig(FLAGS_rx_slow_path_neighbor_pps);
+  config[static_cast<size_t>(RxSlowPathClass::OTHER)] =
+      makeClassConfig(FLAGS_rx_slow_path_other_pps);
+  return config;
+}
+
+RxSlowPathClass RxSlowPathScheduler::classify(
+    const RxPacketBurstClassifier& classifier,
+    size_t idx) {
+  switch (classifier.packetClass(idx)) {
+    case RxPacketClass::SLOW_PROTOCOLS:
+    case RxPacketClass::LLDP:
+    case RxPacketClass::EAPOL:
+      return RxSlowPathClass::CONTROL;
+    case RxPacketClass::ARP:
+    case RxPacketClass::NDP:
+      return RxSlowPathClass::NEIGHBOR;
+    case RxPacketClass::IPV4:
+    case RxPacketClass::IPV6:
+      if (classifier.ipProtocol(idx) ==
+              static_cast<uint8_t>(IP_PROTO::IP_PROTO_TCP) &&
+          (classifier.l4SrcPort(idx) == kBgpPort ||
+           classifier.l4DstPort(idx) == kBgpPort)) {
+        return RxSlowPathClass::BGP;
+      }
+      break;
+    case RxPacketClass::MPLS:
+    case RxPacketClass::OTHER:
+    case RxPacketClass::BOGUS:
+      break;
+  }
+  return RxSlowPathClass::OTHER;
+}
+
+void RxSlowPathScheduler::start() {
+  CHECK(!thread_) << "Rx slow path scheduler already started";
+  stop_ = false;
+  thread_ = std::make_unique<std::thread>([this]() {
+    initThread("fbossRxSlowPath");
+    run();
+  });
+}
+
+void RxSlowPathScheduler::stop() {
+  if (!thread_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  thread_->join();
+  thread_.reset();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& queue : queues_) {
+    queue.clear();
+  }
+  numQueued_ = 0;
+}
+
+void RxSlowPathScheduler::enqueue(std::unique_ptr<RxPacket> pkt) {
+  std::vector<std::unique_ptr<RxPacket>> pkts;
+  pkts.push_back(std::move(pkt));
+  enqueue(std::move(pkts));
+}
+
+void RxSlowPathScheduler::enqueue(
+    std::vector<std::unique_ptr<RxPacket>> pkts) {
+  // reused across calls of the same rx thread, to not reallocate its buffers
+  static thread_local RxPacketBurstClassifier classifier;
+  // bogus packets are classified OTHER, and dropped when handled
+  classifier.classify(pkts, 0);
+
+  auto now = std::chrono::steady_clock::now();
+  std::array<uint64_t, kNumRxSlowPathClasses> rateLimited{};
+  std::array<uint64_t, kNumRxSlowPathClasses> queueFull{};
+  bool queued = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < pkts.size(); ++i) {
+      auto rxClass = classify(classifier, i);
+      auto cls = static_cast<size_t>(rxClass);
+      if (!admitLocked(pkts[i]->getSrcPort(), rxClass)) {
+        ++rateLimited[cls];
+        continue;
+      }
+      auto maxQueueDepth = config_[cls].maxQueueDepth;
+      if (maxQueueDepth && queues_[cls].size() >= maxQueueDepth) {
+        ++queueFull[cls];
+        continue;
+      }
+      queues_[cls].push_back({std::move(pkts[i]), now});
+      ++numQueued_;
+      queued = true;
+    }
+  }
+  if (queued) {
+    cv_.notify_one();
+  }
+
+  auto* stats = stats_();
+  for (size_t cls = 0; cls < kNumRxSlowPathClasses; ++cls) {
+    auto rxClass = static_cast<RxSlowPathClass>(cls);
+    if (rateLimited[cls]) {
+      stats->rxSlowPathRateLimited(rxClass, rateLimited[cls]);
+    }
+    if (queueFull[cls]) {
+      stats->rxSlowPathQueueFull(rxClass, queueFull[cls]);
+    }
+  }
+}
+
+size_t RxSlowPathScheduler::queueDepth(RxSlowPathClass rxClass) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queues_[static_cast<size_t>(rxClass)].size();
+}
+
+bool RxSlowPathScheduler::admitLocked(PortID port, RxSlowPathClass rxClass) {
+  const auto& classConfig = config_[static_cast<size_t>(rxClass)];
+  if (classConfig.ratePps <= 0) {
+    return true;
+  }
+  auto& tokenBucket = tokenBuckets_[port][static_cast<size_t>(rxClass)];
+  return tokenBucket.consume(
+      1.0, classConfig.ratePps, std::max(1.0, classConfig.burstSize));
+}
+
+void RxSlowPathScheduler::run() {
+  while (true) {
+    QueuedPacket queued;
+    RxSlowPathClass rxClass{RxSlowPathClass::OTHER};
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stop_ || numQueued_ > 0; });
+      if (stop_) {
+        return;
+      }
+      // strict priority, the rate limits bound what higher classes take
+      for (size_t cls = 0; cls < kNumRxSlowPathClasses; ++cls) {
+        if (!queues_[cls].empty()) {
+          queued = std::move(queues_[cls].front());
+          queues_[cls].pop_front();
+          rxClass = static_cast<RxSlowPathClass>(cls);
+          break;
+        }
+      }
+      --numQueued_;
+    }
+    auto queueDelay = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - queued.enqueueTime);
+    stats_()->rxSlowPathQueueDelay(rxClass, queueDelay.count());
+    handler_(std::move(queued.pkt));
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/types.h"
+
+#include <folly/TokenBucket.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+DECLARE_bool(rx_slow_path_scheduler);
+
+namespace facebook::fboss {
+
+class RxPacketBurstClassifier;
+class SwitchStats;
+
+/*
+ * Slow path scheduling classes of trapped packets, highest priority first.
+ */
+enum class RxSlowPathClass : uint8_t {
+  // LACP, LLDP and EAPOL
+  CONTROL,
+  // TCP to or from the BGP port
+  BGP,
+  // ARP and NDP
+  NEIGHBOR,
+  OTHER,
+};
+constexpr size_t kNumRxSlowPathClasses =
+    static_cast<size_t>(RxSlowPathClass::OTHER) + 1;
+
+const char* rxSlowPathClassToString(RxSlowPathClass rxClass);
+
+/*
+ * Software queueing discipline between packet rx and the packet handlers.
+ *
+ * Trapped packets are classified and queued per class, after passing a token
+ * bucket of their ingress port and class. A worker thread hands queued
+ * packets to the handler in strict priority order, so a flood of one class
+ * (e.g. ARP from one port) neither starves higher priority protocols nor,
+ * within the rate limits, lower priority ones. Packets over the rate limit,
+ * or beyond the queue depth of their class, are dropped and counted in
+ * SwitchStats.
+ */
+class RxSlowPathScheduler {
+ public:
+  struct ClassConfig {
+    // per port rate limit, 0 for none
+    double ratePps{0};
+    double burstSize{0};
+    // packets of the class queued at most, 0 for no limit
+    size_t maxQueueDepth{0};
+  };
+  using Config = std::array<ClassConfig, kNumRxSlowPathClasses>;
+  using PacketHandler = std::function<void(std::unique_ptr<RxPacket>)>;
+  // SwitchStats of the calling thread
+  using StatsFn = std::function<SwitchStats*()>;
+
+  RxSlowPathScheduler(Config config, PacketHandler handler, StatsFn stats);
+  ~RxSlowPathScheduler();
+
+  // from the --rx_slow_path_* flags
+  static Config configFromFlags();
+  static RxSlowPathClass classify(
+      const RxPacketBurstClassifier& classifier,
+      size_t idx);
+
+  void start();
+  // packets still queued are dropped
+  void stop();
+
+  void enqueue(std::unique_ptr<RxPacket> pkt);
+  void enqueue(std::vector<std::unique_ptr<RxPacket>> pkts);
+
+  size_t queueDepth(RxSlowPathClass rxClass) const;
+
+ private:
+  struct QueuedPacket {
+    std::unique_ptr<RxPacket> pkt;
+    std::chrono::steady_clock::time_point enqueueTime;
+  };
+  using PortTokenBuckets =
+      std::array<folly::DynamicTokenBucket, kNumRxSlowPathClasses>;
+
+  bool admitLocked(PortID port, RxSlowPathClass rxClass);
+  void run();
+
+  const Config config_;
+  PacketHandler handler_;
+  StatsFn stats_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::array<std::deque<QueuedPacket>, kNumRxSlowPathClasses> queues_;
+  size_t numQueued_{0};
+  std::unordered_map<PortID, PortTokenBuckets> tokenBuckets_;
+  bool stop_{false};
+  std::unique_ptr<std::thread> thread_;
+};
+
+} // namespace facebook::fboss
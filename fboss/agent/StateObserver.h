@@ -11,6 +11,9 @@
 
 #include <boost/core/noncopyable.hpp>
 
+#include <string>
+#include <vector>
+
 #include "fboss/agent/state/StateDelta.h"
 
 namespace facebook::fboss {
@@ -19,6 +22,27 @@ class StateObserver : public boost::noncopyable {
  public:
   virtual ~StateObserver() {}
   virtual void stateUpdated(const StateDelta& delta) = 0;
+
+  /*
+   * With --parallel_state_observers, observers returning true here are
+   * notified on a worker thread, concurrently with other such observers.
+   * They must only read the delta, must not expect to run on the update
+   * thread and must guard any state they share with other threads.
+   * All other observers keep being notified serially on the update thread.
+   */
+  virtual bool isConcurrentSafe() const {
+    return false;
+  }
+
+  /*
+   * Names (as passed to registerStateObserver) of the observers that must
+   * finish processing a delta before this observer is notified of it.
+   * Only honored when observers are notified concurrently, names of
+   * observers that are not registered are ignored.
+   */
+  virtual std::vector<std::string> getStateObserverDependencies() const {
+    return {};
+  }
 };
 
 } // namespace facebook::fboss
@@ -0,0 +1,26 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/agent/StateUpdateBatchingPolicy.h"
+
+#include "fboss/agent/AgentFeatures.h"
+
+namespace facebook::fboss {
+
+size_t StateUpdateBatchingPolicy::getMaxBatchSize() const {
+  return FLAGS_state_update_max_batch_size;
+}
+
+std::chrono::milliseconds StateUpdateBatchingPolicy::getMaxBatchDuration()
+    const {
+  return std::chrono::milliseconds(FLAGS_state_update_batch_budget_ms);
+}
+
+std::chrono::milliseconds StateUpdateBatchingPolicy::getLingerDuration() const {
+  return std::chrono::milliseconds(FLAGS_state_update_linger_ms);
+}
+
+bool StateUpdateBatchingPolicy::usePriorityLanes() const {
+  return FLAGS_state_update_priority_lanes;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,49 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace facebook::fboss {
+
+/*
+ * Decides how SwSwitch groups pending StateUpdates into batches. Each batch
+ * results in a single HW programming pass and a single notification of the
+ * state observers.
+ *
+ * The default implementation is driven by the state_update_* flags. With
+ * their default values, every queued coalescing update is applied in one
+ * batch as soon as possible, and all updates share a single queue.
+ */
+class StateUpdateBatchingPolicy {
+ public:
+  virtual ~StateUpdateBatchingPolicy() = default;
+
+  /*
+   * Max number of updates applied in one batch, 0 for no limit.
+   */
+  virtual size_t getMaxBatchSize() const;
+
+  /*
+   * Wall clock budget for preparing a batch. Once exceeded, the updates of
+   * the batch that were not prepared yet are put back at the head of their
+   * queue and applied in a later batch. 0 for no limit.
+   */
+  virtual std::chrono::milliseconds getMaxBatchDuration() const;
+
+  /*
+   * How long a regular update may wait in the queue for more updates to be
+   * batched with. 0 to start processing updates as soon as they are queued.
+   * High priority and non coalescing updates never linger.
+   */
+  virtual std::chrono::milliseconds getLingerDuration() const;
+
+  /*
+   * Whether high priority updates (e.g. link down, neighbor changes) get a
+   * queue of their own, which is drained ahead of regular updates.
+   */
+  virtual bool usePriorityLanes() const;
+};
+
+} // namespace facebook::fboss
@@ -43,6 +43,7 @@
 #if FOLLY_HAS_COROUTINES
 #include "fboss/agent/MKAServiceManager.h"
 #endif
+#include "fboss/agent/AclMatchEngine.h"
 #include "fboss/agent/AclNexthopHandler.h"
 #include "fboss/agent/BuildInfoWrapper.h"
 #include "fboss/agent/DsfSubscriber.h"
@@ -54,6 +55,8 @@
 #include "fboss/agent/MultiHwSwitchHandler.h"
 #include "fboss/agent/MultiSwitchFb303Stats.h"
 #include "fboss/agent/MultiSwitchPacketStreamMap.h"
+#include "fboss/agent/MultiSwitchPacketRings.h"
+#include "fboss/agent/NeighborRefreshEngine.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/PacketLogger.h"
 #include "fboss/agent/PacketObserver.h"
@@ -65,6 +68,8 @@
 #include "fboss/agent/ResolvedNexthopProbeScheduler.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
+#include "fboss/agent/RxPacketClassifier.h"
+#include "fboss/agent/RxSlowPathScheduler.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwSwitchWarmBootHelper.h"
@@ -106,6 +111,9 @@
 #include <folly/MapUtil.h>
 #include <folly/SocketAddress.h>
 #include <folly/String.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
 #include <folly/logging/xlog.h>
 #include <folly/system/ThreadName.h>
 #include <glog/logging.h>
@@ -113,6 +121,7 @@
 #include <thrift/lib/cpp2/async/RequestChannel.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <exception>
@@ -328,6 +337,11 @@ void accumulateFb303GlobalStats(
     hitCount += toAdd.sram_low_buffer_limit_hit_count().value();
     accumulated.sram_low_buffer_limit_hit_count() = hitCount;
   }
+  if (toAdd.rx_pkt_queue_full_drops().has_value()) {
+    int64_t drops = accumulated.rx_pkt_queue_full_drops().value_or(0);
+    drops += toAdd.rx_pkt_queue_full_drops().value();
+    accumulated.rx_pkt_queue_full_drops() = drops;
+  }
 }
 
 void accumulateGlobalCpuStats(
@@ -508,6 +522,45 @@ SwSwitch::SwSwitch(
   }
   fsdbSyncer_.withWLock(
       [this](auto& syncer) { syncer = std::make_unique<FsdbSyncer>(this); });
+  if (FLAGS_parallel_state_observers) {
+    stateObserverExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_state_observer_threads,
+        std::make_shared<folly::NamedThreadFactory>("StateObserver"));
+  }
+  if (FLAGS_shm_packet_transport) {
+    packetRings_ = std::make_unique<MultiSwitchPacketRings>(
+        [this](SwitchID switchId, std::unique_ptr<SwRxPacket> pkt) {
+          stats()->hwAgentRxPktReceived(
+              getSwitchInfoTable().getSwitchIndexFromSwitchId(switchId));
+          if (FLAGS_rx_sw_priority) {
+            rxPacketReceived(std::move(pkt));
+          } else {
+            packetReceived(std::move(pkt));
+          }
+        });
+  }
+  if (FLAGS_rx_slow_path_scheduler) {
+    rxSlowPathScheduler_ = std::make_unique<RxSlowPathScheduler>(
+        RxSlowPathScheduler::configFromFlags(),
+        [this](std::unique_ptr<RxPacket> pkt) {
+          handleScheduledPacket(std::move(pkt));
+        },
+        [this]() { return stats(); });
+    rxSlowPathScheduler_->start();
+  }
+  if (FLAGS_neighbor_refresh_engine) {
+    neighborRefreshEngine_ = std::make_unique<NeighborRefreshEngine>(
+        &neighborCacheEventBase_,
+        NeighborRefreshEngine::configFromFlags(),
+        [this](
+            const std::string& name, StateUpdateFn fn, bool allowCoalescing) {
+          updateStateHighPriority(name, std::move(fn), allowCoalescing);
+        },
+        [this]() { return stats(); });
+  }
+  if (FLAGS_acl_match_engine) {
+    aclMatchEngine_ = std::make_unique<AclMatchEngine>(this);
+  }
   if (initialState) {
     initialState->publish();
     setStateInternal(initialState);
@@ -583,6 +636,14 @@ void SwSwitch::stop(bool isGracefulStop, bool revertToMinAlpmState) {
   if (tunMgr_) {
     tunMgr_->stopProcessing();
   }
+  if (packetRings_) {
+    packetRings_->detachAll();
+  }
+  // Handle no more of the packets queued before the callbacks were
+  // unregistered
+  if (rxSlowPathScheduler_) {
+    rxSlowPathScheduler_->stop();
+  }
 
   resolvedNexthopMonitor_.reset();
   resolvedNexthopProbeScheduler_.reset();
@@ -645,6 +706,9 @@ void SwSwitch::stop(bool isGracefulStop, bool revertToMinAlpmState) {
   // stops the background and update threads.
   stopThreads();
 
+  // No more state updates will be processed, join the observer workers
+  stateObserverExecutor_.reset();
+
   // reset explicitly since it uses observer. Make sure to reset after bg thread
   // is stopped, else we'll race with bg thread sending packets such as route
   // advertisements
@@ -1645,6 +1709,33 @@ void SwSwitch::addStateObserver(StateObserver* observer, const string& name) {
   stateObservers_.emplace(observer, name);
 }
 
+void SwSwitch::notifyStateObserver(
+    StateObserver* observer,
+    const std::string& name,
+    const StateDelta& delta) {
+  auto start = std::chrono::steady_clock::now();
+  try {
+    observer->stateUpdated(delta);
+  } catch (const std::exception& ex) {
+    // TODO: Figure out the best way to handle errors here.
+    XLOG(FATAL) << "error notifying " << name
+                << " of update: " << folly::exceptionStr(ex);
+  }
+  stats()->stateObserverUpdate(
+      name,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start));
+}
+
+void SwSwitch::notifyFsdbSyncer(const StateDelta& delta) {
+  auto start = std::chrono::steady_clock::now();
+  runFsdbSyncFunction([&delta](auto& syncer) { syncer->stateUpdated(delta); });
+  stats()->stateObserverUpdate(
+      "FsdbSyncer",
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start));
+}
+
 void SwSwitch::notifyStateObservers(const StateDelta& delta) {
   CHECK(updateEventBase_.inRunningEventBaseThread());
   if (isExiting()) {
@@ -1655,17 +1746,90 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
   // lookup in rx path.
   updateAddrToLocalIntf(delta);
 
-  for (auto observerName : stateObservers_) {
-    try {
-      auto observer = observerName.first;
-      observer->stateUpdated(delta);
-    } catch (const std::exception& ex) {
-      // TODO: Figure out the best way to handle errors here.
-      XLOG(FATAL) << "error notifying " << observerName.second
-                  << " of update: " << folly::exceptionStr(ex);
+  if (stateObserverExecutor_) {
+    notifyStateObserversConcurrently(delta);
+    return;
+  }
+  for (const auto& [observer, name] : stateObservers_) {
+    notifyStateObserver(observer, name, delta);
+  }
+  notifyFsdbSyncer(delta);
+}
+
+void SwSwitch::notifyStateObserversConcurrently(const StateDelta& delta) {
+  // One completion promise per observer, so that observers can chain on the
+  // observers they depend on. The map is fully populated before any observer
+  // is scheduled and only read afterwards.
+  std::unordered_map<std::string, folly::SharedPromise<folly::Unit>> done;
+  std::unordered_map<std::string, std::vector<std::string>> dependencies;
+  for (const auto& [observer, name] : stateObservers_) {
+    done[name];
+    if (observer->isConcurrentSafe()) {
+      dependencies[name] = observer->getStateObserverDependencies();
     }
   }
-  runFsdbSyncFunction([&delta](auto& syncer) { syncer->stateUpdated(delta); });
+  // Refuse dependency cycles among concurrent observers, these would never
+  // complete. Serial observers never wait, so only concurrent ones matter.
+  std::unordered_map<std::string, int> visitState;
+  std::function<void(const std::string&)> visit =
+      [&](const std::string& name) {
+        auto& state = visitState[name];
+        if (state == 2) {
+          return;
+        }
+        if (state == 1) {
+          XLOG(FATAL) << "State observer dependency cycle through " << name;
+        }
+        state = 1;
+        if (auto deps = dependencies.find(name); deps != dependencies.end()) {
+          for (const auto& dep : deps->second) {
+            visit(dep);
+          }
+        }
+        visitState[name] = 2;
+      };
+  for (const auto& entry : dependencies) {
+    visit(entry.first);
+  }
+
+  std::vector<folly::Future<folly::Unit>> inFlight;
+  for (const auto& [observer, name] : stateObservers_) {
+    if (!observer->isConcurrentSafe()) {
+      continue;
+    }
+    std::vector<folly::SemiFuture<folly::Unit>> waitFor;
+    for (const auto& dep : dependencies[name]) {
+      if (auto depDone = done.find(dep); depDone != done.end()) {
+        waitFor.push_back(depDone->second.getSemiFuture());
+      }
+    }
+    inFlight.push_back(
+        folly::collectAll(std::move(waitFor))
+            .via(stateObserverExecutor_.get())
+            .thenValue([this, observer = observer, &name = name, &delta, &done](
+                           auto&& /* deps */) {
+              notifyStateObserver(observer, name, delta);
+              done.at(name).setValue();
+            }));
+  }
+  inFlight.push_back(
+      folly::via(stateObserverExecutor_.get(), [this, &delta]() {
+        notifyFsdbSyncer(delta);
+      }));
+
+  // Observers which are not safe to run concurrently stay on the update
+  // thread, while the concurrent ones are running.
+  for (const auto& [observer, name] : stateObservers_) {
+    if (observer->isConcurrentSafe()) {
+      continue;
+    }
+    notifyStateObserver(observer, name, delta);
+    done.at(name).setValue();
+  }
+
+  // Barrier, the next update must not be processed before every observer has
+  // seen this one.
+  folly::collectAll(std::move(inFlight)).wait();
 }
 
 void SwSwitch::registerStateModifier(
@@ -1747,7 +1911,12 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
   }
   {
     std::unique_lock guard(pendingUpdatesLock_);
-    pendingUpdates_.push_back(*update.release());
+    update->enqueueTime_ = std::chrono::steady_clock::now();
+    if (update->isHighPriority() && batchingPolicy_->usePriorityLanes()) {
+      highPriorityPendingUpdates_.push_back(*update.release());
+    } else {
+      pendingUpdates_.push_back(*update.release());
+    }
   }
 
   // Signal the update thread that updates are pending.
@@ -1770,6 +1939,33 @@ void SwSwitch::updateStateNoCoalescing(StringPiece name, StateUpdateFn fn) {
   updateState(std::move(update));
 }
 
+void SwSwitch::updateStateHighPriority(
+    StringPiece name,
+    StateUpdateFn fn,
+    bool allowCoalescing) {
+  int behaviorFlags =
+      static_cast<int>(StateUpdate::BehaviorFlags::HIGH_PRIORITY);
+  if (!allowCoalescing) {
+    behaviorFlags |=
+        static_cast<int>(StateUpdate::BehaviorFlags::NON_COALESCING);
+  }
+  auto update =
+      make_unique<FunctionStateUpdate>(name, std::move(fn), behaviorFlags);
+  updateState(std::move(update));
+}
+
+void SwSwitch::setStateUpdateBatchingPolicy(
+    std::shared_ptr<const StateUpdateBatchingPolicy> policy) {
+  CHECK(policy);
+  std::unique_lock guard(pendingUpdatesLock_);
+  if (!policy->usePriorityLanes()) {
+    // Preserve the relative order of already queued updates as best we can
+    pendingUpdates_.splice(
+        pendingUpdates_.begin(), highPriorityPendingUpdates_);
+  }
+  batchingPolicy_ = std::move(policy);
+}
+
 void SwSwitch::updateStateBlocking(folly::StringPiece name, StateUpdateFn fn) {
   auto behaviorFlags = static_cast<int>(StateUpdate::BehaviorFlags::NONE);
   updateStateBlockingImpl(name, fn, behaviorFlags);
@@ -1809,17 +2005,56 @@ void SwSwitch::handlePendingUpdates() {
   // might also end up finding 0 updates to process if a previous
   // handlePendingUpdates() call processed multiple updates.
   StateUpdateList updates;
+  StateUpdateList* lane{nullptr};
+  std::shared_ptr<const StateUpdateBatchingPolicy> policy;
   auto pendingUpdateQueueLength = 0;
   {
     std::unique_lock guard(pendingUpdatesLock_);
-    // When deciding how many elements to pull off the pendingUpdates_
+    policy = batchingPolicy_;
+    // High priority updates are always batched first
+    lane = highPriorityPendingUpdates_.empty() ? &pendingUpdates_
+                                               : &highPriorityPendingUpdates_;
+    auto maxBatchSize = policy->getMaxBatchSize();
+    // Give regular updates a chance to be batched with more updates, unless
+    // we already have a full batch. High priority updates share this lane
+    // without priority lanes, and must not wait either.
+    auto linger = policy->getLingerDuration();
+    if (lane == &pendingUpdates_ && !lane->empty() && linger.count() &&
+        !lane->front().isNonCoalescing() && !isExiting() &&
+        (!maxBatchSize || lane->size() < maxBatchSize) &&
+        std::none_of(lane->begin(), lane->end(), [](const auto& update) {
+          return update.isHighPriority();
+        })) {
+      auto waited =
+          std::chrono::steady_clock::now() - lane->front().enqueueTime_;
+      if (waited < linger) {
+        if (!lingerTimeoutScheduled_) {
+          lingerTimeoutScheduled_ = true;
+          auto remaining =
+              std::chrono::ceil<std::chrono::milliseconds>(linger - waited);
+          updateEventBase_.runAfterDelay(
+              [this] {
+                lingerTimeoutScheduled_ = false;
+                handlePendingUpdates();
+              },
+              static_cast<uint32_t>(remaining.count()));
+        }
+        return;
+      }
+    }
+    // When deciding how many elements to pull off the pending updates
     // list, we pull as many as we can, subject to the following conditions
     // - Non coalescing updates are executed by themselves
-    auto iter = pendingUpdates_.begin();
-    while (iter != pendingUpdates_.end()) {
+    // - No more than maxBatchSize updates, if the policy sets one
+    auto iter = lane->begin();
+    size_t batchSize = 0;
+    while (iter != lane->end()) {
+      if (maxBatchSize && batchSize == maxBatchSize) {
+        break;
+      }
       StateUpdate* update = &(*iter);
       if (update->isNonCoalescing()) {
-        if (iter == pendingUpdates_.begin()) {
+        if (iter == lane->begin()) {
           // First update is non coalescing, splice it onto the updates list
           // and apply transaction by itself
           ++iter;
@@ -1831,12 +2066,19 @@ void SwSwitch::handlePendingUpdates() {
         }
       }
       ++iter;
+      ++batchSize;
     }
-    updates.splice(
-        updates.begin(), pendingUpdates_, pendingUpdates_.begin(), iter);
-    pendingUpdateQueueLength = pendingUpdates_.size();
+    updates.splice(updates.begin(), *lane, lane->begin(), iter);
+    pendingUpdateQueueLength =
+        pendingUpdates_.size() + highPriorityPendingUpdates_.size();
   }
   stats()->pendingStateUpdateCount(pendingUpdateQueueLength);
+  if (!updates.empty() && pendingUpdateQueueLength && !isExiting()) {
+    // Updates left behind by the batch size limit (or by a lingering batch)
+    // may not have a pending handlePendingUpdates() call of their own.
+    updateEventBase_.runInFbossEventBaseThread(
+        handlePendingUpdatesHelper, this);
+  }
 
   // handlePendingUpdates() is invoked once for each update, but a previous
   // call might have already processed everything.  If we don't have anything
@@ -1864,8 +2106,25 @@ void SwSwitch::handlePendingUpdates() {
   auto oldAppliedState = getState();
   // We start with the old state, and apply state updates one at a time.
   auto newDesiredState = oldAppliedState;
+  auto maxBatchDuration = policy->getMaxBatchDuration();
+  auto batchStart = std::chrono::steady_clock::now();
   auto iter = updates.begin();
   while (iter != updates.end()) {
+    if (maxBatchDuration.count() && iter != updates.begin() &&
+        std::chrono::steady_clock::now() - batchStart >= maxBatchDuration) {
+      // Out of budget, put the updates we did not get to back at the head
+      // of their queue so that they are applied in the next batch.
+      {
+        std::unique_lock guard(pendingUpdatesLock_);
+        lane->splice(lane->begin(), updates, iter, updates.end());
+      }
+      stats()->stateUpdateBatchDeferred();
+      if (!isExiting()) {
+        updateEventBase_.runInFbossEventBaseThread(
+            handlePendingUpdatesHelper, this);
+      }
+      break;
+    }
     StateUpdate* update = &(*iter);
     ++iter;
 
@@ -1893,6 +2152,7 @@ void SwSwitch::handlePendingUpdates() {
       newDesiredState = intermediateState;
     }
   }
+  stats()->stateUpdateBatchSize(updates.size());
   // Start newAppliedState as equal to newDesiredState unless
   // we learn otherwise
   auto newAppliedState = newDesiredState;
@@ -2056,8 +2316,15 @@ SwSwitch::applyUpdate(
 
   setStateInternal(newAppliedState);
 
-  // Notifies all observers of the current state update.
-  notifyStateObservers(StateDelta(oldState, newAppliedState));
+  // Notifies all observers of the current state update. When the update was
+  // applied as sent to the HwSwitches, its delta already carries the oper
+  // delta, so observers like the fsdb syncer need not compute it again.
+  if (deltas.size() == 1 && deltas.front().oldState() == oldState &&
+      deltas.front().newState() == newAppliedState) {
+    notifyStateObservers(deltas.front());
+  } else {
+    notifyStateObservers(StateDelta(oldState, newAppliedState));
+  }
 
   // Notifies resource accountant of new applied state.
   resourceAccountant_->stateChanged(
@@ -2222,16 +2489,25 @@ void SwSwitch::setPortActiveStatusCounter(PortID port, bool isActive) {
   portStats(port)->setPortActiveStatus(isActive);
 }
 
+void SwSwitch::recordPacketRxHeartbeat() {
+  auto now = steady_clock::now();
+  auto lastTime = lastPacketRxTime_.load();
+  if (lastTime != std::chrono::steady_clock::time_point::min()) {
+    auto delay = duration_cast<milliseconds>(now - lastPacketRxTime_.load());
+    stats()->packetRxHeartbeatDelay(delay.count());
+  }
+  lastPacketRxTime_ = now;
+}
+
 void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
+  if (rxSlowPathScheduler_) {
+    recordPacketRxHeartbeat();
+    rxSlowPathScheduler_->enqueue(std::move(pkt));
+    return;
+  }
   PortID port = pkt->getSrcPort();
   try {
-    auto now = steady_clock::now();
-    auto lastTime = lastPacketRxTime_.load();
-    if (lastTime != std::chrono::steady_clock::time_point::min()) {
-      auto delay = duration_cast<milliseconds>(now - lastPacketRxTime_.load());
-      stats()->packetRxHeartbeatDelay(delay.count());
-    }
-    lastPacketRxTime_ = now;
+    recordPacketRxHeartbeat();
     handlePacket(std::move(pkt));
   } catch (const std::exception& ex) {
     portStats(port)->pktError();
@@ -2242,6 +2518,17 @@ void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
   }
 }
 
+void SwSwitch::handleScheduledPacket(std::unique_ptr<RxPacket> pkt) noexcept {
+  PortID port = pkt->getSrcPort();
+  try {
+    handlePacket(std::move(pkt));
+  } catch (const std::exception& ex) {
+    portStats(port)->pktError();
+    XLOG(ERR) << "error processing trapped packet: " << folly::exceptionStr(ex)
+              << " from port: " << port;
+  }
+}
+
 void SwSwitch::packetReceivedThrowExceptionOnError(
     std::unique_ptr<RxPacket> pkt) {
   handlePacket(std::move(pkt));
@@ -2313,27 +2600,126 @@ void SwSwitch::handlePacketImpl(
     c += 2; // Advance over the VLAN tag.  We ignore it for now
     ethertype = c.readBE<uint16_t>();
   }
+  dispatchPacket(std::move(pkt), dstMac, srcMac, ethertype, c, vlanOrIntf);
+}
 
-  auto vlanID = getVlanIDFromVlanOrIntf(vlanOrIntf);
-  auto vlanIDStr = vlanID.has_value()
-      ? folly::to<std::string>(static_cast<int>(vlanID.value()))
-      : "None";
+void SwSwitch::packetsReceived(
+    std::vector<std::unique_ptr<RxPacket>> pkts) noexcept {
+  if (pkts.empty()) {
+    return;
+  }
+  recordPacketRxHeartbeat();
+  if (rxSlowPathScheduler_) {
+    rxSlowPathScheduler_->enqueue(std::move(pkts));
+    return;
+  }
+  // See handlePacketImpl()
+  if (!isFullyInitialized()) {
+    XLOG(DBG3) << "Dropping received packets received on UNINITIALIZED switch";
+    return;
+  }
+  if (FLAGS_intf_nbr_tables) {
+    handlePacketBurst<Interface>(pkts);
+  } else {
+    handlePacketBurst<Vlan>(pkts);
+  }
+}
+
+/*
+ * Burst counterpart of handlePacket()/handlePacketImpl(). The switch state is
+ * looked up once per burst rather than per packet, and headers are parsed by
+ * RxPacketBurstClassifier. Packets are then dispatched a class at a time, so
+ * a handler processes its packets back to back.
+ */
+template <typename VlanOrIntfT>
+void SwSwitch::handlePacketBurst(std::vector<std::unique_ptr<RxPacket>>& pkts) {
+  auto state = getState();
+  for (const auto& pkt : pkts) {
+    PortID port = pkt->getSrcPort();
+    try {
+      portStats(port)->trappedPkt();
+      pktObservers_->packetReceived(pkt.get());
+    } catch (const std::exception& ex) {
+      portStats(port)->pktError();
+      XLOG(ERR) << "error processing trapped packet: "
+                << folly::exceptionStr(ex) << " from port: " << port;
+    }
+  }
+
+  RxPacketBurstClassifier classifier;
+  classifier.classify(pkts, FLAGS_minimum_ethernet_packet_length);
+  for (auto idx : classifier.packetsOfClass(RxPacketClass::BOGUS)) {
+    portStats(pkts[idx]->getSrcPort())->pktBogus();
+  }
+
+  for (size_t cls = 0; cls < kNumRxPacketClasses; ++cls) {
+    auto pktClass = static_cast<RxPacketClass>(cls);
+    if (pktClass == RxPacketClass::BOGUS) {
+      continue;
+    }
+    for (auto idx : classifier.packetsOfClass(pktClass)) {
+      auto& pkt = pkts[idx];
+      PortID port = pkt->getSrcPort();
+      try {
+        std::shared_ptr<VlanOrIntfT> vlanOrIntf;
+        if constexpr (std::is_same_v<VlanOrIntfT, Interface>) {
+          vlanOrIntf = state->getInterfaces()->getNodeIf(
+              state->getInterfaceIDForPort(getPortFromPkt(pkt.get())));
+        } else {
+          vlanOrIntf = state->getVlans()->getNodeIf(
+              getVlanIDHelper(pkt->getSrcVlanIf()));
+        }
+        Cursor c(pkt->buf());
+        c += classifier.l2HeaderLength(idx);
+        dispatchPacket(
+            std::move(pkt),
+            classifier.dstMac(idx),
+            classifier.srcMac(idx),
+            classifier.ethertype(idx),
+            c,
+            vlanOrIntf);
+      } catch (const std::exception& ex) {
+        portStats(port)->pktError();
+        XLOG(ERR) << "error processing trapped packet: "
+                  << folly::exceptionStr(ex) << " from port: " << port;
+      }
+    }
+  }
+}
+
+template <typename VlanOrIntfT>
+void SwSwitch::dispatchPacket(
+    std::unique_ptr<RxPacket> pkt,
+    folly::MacAddress dstMac,
+    folly::MacAddress srcMac,
+    uint16_t ethertype,
+    Cursor c,
+    const std::shared_ptr<VlanOrIntfT>& vlanOrIntf) {
+  PortID port = pkt->getSrcPort();
+  auto len = pkt->getLength();
+  // only formatted when logged
+  auto vlanIDStr = [&vlanOrIntf]() -> std::string {
+    auto vlanID = getVlanIDFromVlanOrIntf(vlanOrIntf);
+    return vlanID.has_value()
+        ? folly::to<std::string>(static_cast<int>(vlanID.value()))
+        : "None";
+  };
 
   XLOG(DBG5) << "trapped packet: src_port=" << pkt->getSrcPort()
              << " srcAggPort="
              << (pkt->isFromAggregatePort()
                      ? folly::to<string>(pkt->getSrcAggregatePort())
                      : "None")
-             << " vlan=" << vlanIDStr << " length=" << len << " src=" << srcMac
-             << " dst=" << dstMac << " ethertype=0x" << std::hex << ethertype
-             << " :: " << pkt->describeDetails();
+             << " vlan=" << vlanIDStr() << " length=" << len
+             << " src=" << srcMac << " dst=" << dstMac << " ethertype=0x"
+             << std::hex << ethertype << " :: " << pkt->describeDetails();
   XLOG_EVERY_N(DBG2, 10000)
       << "sampled " << "trapped packet: src_port=" << pkt->getSrcPort()
       << " srcAggPort="
       << (pkt->isFromAggregatePort()
               ? folly::to<string>(pkt->getSrcAggregatePort())
               : "None")
-      << " vlan=" << vlanIDStr << " length=" << len << " src=" << srcMac
+      << " vlan=" << vlanIDStr() << " length=" << len << " src=" << srcMac
       << " dst=" << dstMac << " ethertype=0x" << std::hex << ethertype
       << " :: " << pkt->describeDetails();
 
@@ -2472,8 +2858,10 @@ void SwSwitch::linkStateChanged(
     updateState(
         "Fabric Port OperState (UP/DOWN) Update", std::move(updateOperStateFn));
   } else {
-    updateStateNoCoalescing(
-        "Port OperState (UP/DOWN) Update", std::move(updateOperStateFn));
+    updateStateHighPriority(
+        "Port OperState (UP/DOWN) Update",
+        std::move(updateOperStateFn),
+        false /* allowCoalescing */);
     if (!up && aggPortId.has_value()) {
       XLOG(DBG2) << "set neighbor caches pending for trunk port "
                  << aggPortId.value();
@@ -3063,7 +3451,8 @@ void SwSwitch::stopThreads() {
     handlePendingUpdates();
     {
       std::unique_lock guard(pendingUpdatesLock_);
-      updatesDrained = pendingUpdates_.empty();
+      updatesDrained =
+          pendingUpdates_.empty() && highPriorityPendingUpdates_.empty();
     }
   } while (!updatesDrained);
 }
@@ -3216,6 +3605,13 @@ void SwSwitch::sendPacketOutViaThriftStream(
     SwitchID switchId,
     std::optional<PortID> portID,
     std::optional<uint8_t> queue) noexcept {
+  auto switchIndex =
+      getSwitchInfoTable().getSwitchIndexFromSwitchId(SwitchID(switchId));
+  if (packetRings_ &&
+      packetRings_->sendPacket(switchId, *pkt, portID, queue)) {
+    stats()->hwAgentTxPktSent(switchIndex);
+    return;
+  }
   multiswitch::TxPacket txPacket;
   if (portID) {
     txPacket.port() = portID.value();
@@ -3225,8 +3621,6 @@ void SwSwitch::sendPacketOutViaThriftStream(
   }
   txPacket.length() = pkt->buf()->computeChainDataLength();
   txPacket.data() = Packet::extractIOBuf(std::move(pkt));
-  auto switchIndex =
-      getSwitchInfoTable().getSwitchIndexFromSwitchId(SwitchID(switchId));
   try {
     getPacketStreamMap()->getStream(switchId).next(std::move(txPacket));
     stats()->hwAgentTxPktSent(switchIndex);
@@ -3490,10 +3884,22 @@ void SwSwitch::applyConfigImpl(
   // us.
   auto routeUpdater = getRouteUpdater();
   auto oldConfig = getConfig();
+  // held throughout, so config applies diff against each other in order
+  auto lastAppliedConfig = lastAppliedConfig_.wlock();
+  std::shared_ptr<SwitchState> configState;
   updateStateBlocking(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
         auto originalState = state;
+        configState = state;
+        // anything else that changed the state since the last config apply
+        // (ports built from new transceivers, say) may have touched the
+        // sections an incremental apply skips, so apply the whole config
+        const cfg::SwitchConfig* prevConfig = nullptr;
+        if (FLAGS_incremental_config_apply && lastAppliedConfig->has_value() &&
+            (*lastAppliedConfig)->state.lock() == state) {
+          prevConfig = &(*lastAppliedConfig)->config;
+        }
         auto newState = applyThriftConfig(
             originalState,
             &newConfig,
@@ -3501,7 +3907,8 @@ void SwSwitch::applyConfigImpl(
             platformMapping_.get(),
             hwAsicTable_.get(),
             &routeUpdater,
-            aclNexthopHandler_.get());
+            aclNexthopHandler_.get(),
+            prevConfig);
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -3513,11 +3920,17 @@ void SwSwitch::applyConfigImpl(
           XLOG(WARNING) << "Applying config did not cause state change";
           return nullptr;
         }
+        configState = newState;
         return newState;
       });
   // Since we're using blocking state update, once we reach here, the new
   // config should be already applied and programmed into hardware.
   updateConfigAppliedInfo();
+  if (FLAGS_incremental_config_apply) {
+    *lastAppliedConfig = AppliedConfig{newConfig, configState};
+  } else {
+    lastAppliedConfig->reset();
+  }
 
   /*
    * For RIB always make route programming go through the routeUpdater wrapper
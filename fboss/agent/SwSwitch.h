@@ -16,6 +16,7 @@
 #include "fboss/agent/MultiSwitchFb303Stats.h"
 #include "fboss/agent/PacketObserver.h"
 #include "fboss/agent/SwRxPacket.h"
+#include "fboss/agent/StateUpdateBatchingPolicy.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwitchInfoTable.h"
 #include "fboss/agent/SwitchStats.h"
@@ -40,6 +41,8 @@
 #include <folly/SpinLock.h>
 #include <folly/ThreadLocal.h>
 #include <folly/concurrency/ConcurrentHashMap.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/io/Cursor.h>
 #include <optional>
 
 #if FOLLY_HAS_COROUTINES
@@ -65,6 +68,7 @@ class IPv6Handler;
 class LinkAggregationManager;
 class LldpManager;
 class MPLSHandler;
+class MultiSwitchTransceiverMap;
 class PktCaptureManager;
 class PlatformMapping;
 class PlatformProductInfo;
@@ -73,10 +77,12 @@ class PortDescriptor;
 class PortStats;
 class PortUpdateHandler;
 class RxPacket;
+class RxSlowPathScheduler;
 class SwitchState;
 class SwitchStats;
 class SwitchIdScopeResolver;
 class StateDelta;
+class NeighborRefreshEngine;
 class NeighborUpdater;
 class PacketLogger;
 class RouteUpdateLogger;
@@ -85,6 +91,7 @@ class PreUpdateStateModifier;
 class TunManager;
 class MirrorManager;
 class PhySnapshotManager;
+class AclMatchEngine;
 class AclNexthopHandler;
 class LookupClassUpdater;
 class LookupClassRouteUpdater;
@@ -104,6 +111,7 @@ class MultiHwSwitchHandler;
 class MonolithicHwSwitchHandler;
 class SwitchStatsObserver;
 class MultiSwitchPacketStreamMap;
+class MultiSwitchPacketRings;
 class SwSwitchWarmBootHelper;
 class AgentDirectoryUtil;
 class HwSwitchThriftClientTable;
@@ -355,6 +363,31 @@ class SwSwitch : public HwSwitchCallback {
    */
   void updateStateNoCoalescing(folly::StringPiece name, StateUpdateFn fn);
 
+  /**
+   * Schedule a high priority update to the switch state.
+   *
+   * @param name  A name to identify the source of this update.  This is
+   *              primarily used for logging and debugging purposes.
+   * @param fn    The function that will prepare the new SwitchState.
+   * @param allowCoalescing  Whether the update may be batched with others.
+   *
+   * With priority lanes enabled in the batching policy, high priority updates
+   * are applied ahead of regular updates queued before them. This is meant
+   * for small, latency sensitive updates (link state, neighbor entries) that
+   * should not wait behind a large backlog of route updates. Otherwise
+   * equivalent to updateState() / updateStateNoCoalescing().
+   */
+  void updateStateHighPriority(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      bool allowCoalescing = true);
+
+  /*
+   * Replace the policy used to batch pending state updates.
+   */
+  void setStateUpdateBatchingPolicy(
+      std::shared_ptr<const StateUpdateBatchingPolicy> policy);
+
   /*
    * A version of updateState() that doesn't return until the update has been
    * applied.
@@ -573,6 +606,8 @@ class SwSwitch : public HwSwitchCallback {
 
   // HwSwitchCallback methods
   void packetReceived(std::unique_ptr<RxPacket> pkt) noexcept override;
+  void packetsReceived(
+      std::vector<std::unique_ptr<RxPacket>> pkts) noexcept override;
   void linkStateChanged(
       PortID port,
       bool up,
@@ -727,6 +762,22 @@ class SwSwitch : public HwSwitchCallback {
     return nUpdater_.get();
   }
 
+  /*
+   * Batches the probes and neighbor table updates of the neighbor caches.
+   * nullptr unless --neighbor_refresh_engine is set.
+   */
+  NeighborRefreshEngine* getNeighborRefreshEngine() {
+    return neighborRefreshEngine_.get();
+  }
+
+  /*
+   * Software classifier of the ingress ACLs of the applied state.
+   * nullptr unless --acl_match_engine is set.
+   */
+  const AclMatchEngine* getAclMatchEngine() const {
+    return aclMatchEngine_.get();
+  }
+
   /*
    * Get the PktCaptureManager object.
    */
@@ -952,6 +1003,11 @@ class SwSwitch : public HwSwitchCallback {
     return packetStreamMap_.get();
   }
 
+  // nullptr without --shm_packet_transport
+  MultiSwitchPacketRings* getPacketRings() {
+    return packetRings_.get();
+  }
+
   void updateDsfSubscriberState(
       const std::string& remoteEndpoint,
       fsdb::FsdbSubscriptionState oldState,
@@ -1052,11 +1108,25 @@ class SwSwitch : public HwSwitchCallback {
 
   PortDescriptor getPortFromPkt(const RxPacket* pkt) const;
 
+  void recordPacketRxHeartbeat();
   void handlePacket(std::unique_ptr<RxPacket> pkt);
+  // handler of packets dequeued by rxSlowPathScheduler_
+  void handleScheduledPacket(std::unique_ptr<RxPacket> pkt) noexcept;
   template <typename VlanOrIntfT>
   void handlePacketImpl(
       std::unique_ptr<RxPacket> pkt,
       const std::shared_ptr<VlanOrIntfT>& vlanOrIntf);
+  template <typename VlanOrIntfT>
+  void handlePacketBurst(std::vector<std::unique_ptr<RxPacket>>& pkts);
+  // hand a parsed packet to its handler, c is past the ethertype
+  template <typename VlanOrIntfT>
+  void dispatchPacket(
+      std::unique_ptr<RxPacket> pkt,
+      folly::MacAddress dstMac,
+      folly::MacAddress srcMac,
+      uint16_t ethertype,
+      folly::io::Cursor c,
+      const std::shared_ptr<VlanOrIntfT>& vlanOrIntf);
 
   void updatePtpTcCounter();
   static void handlePendingUpdatesHelper(SwSwitch* sw);
@@ -1093,6 +1163,27 @@ class SwSwitch : public HwSwitchCallback {
    */
   void notifyStateObservers(const StateDelta& delta);
 
+  /*
+   * Notifies observers that opted in to concurrent notification on
+   * stateObserverExecutor_, honoring their declared dependencies, while the
+   * remaining observers are notified on the update thread. Returns only once
+   * every observer has processed the delta.
+   */
+  void notifyStateObserversConcurrently(const StateDelta& delta);
+
+  /*
+   * Notify a single observer and record the time it took.
+   */
+  void notifyStateObserver(
+      StateObserver* observer,
+      const std::string& name,
+      const StateDelta& delta);
+
+  /*
+   * Notify the FSDB syncer and record the time it took.
+   */
+  void notifyFsdbSyncer(const StateDelta& delta);
+
   /*
    * Invoke State modifier to modify state prior to update.
    */
@@ -1230,10 +1321,16 @@ class SwSwitch : public HwSwitchCallback {
   std::unique_ptr<TunManager> tunMgr_;
 
   /*
-   * A list of pending state updates to be applied.
+   * Lists of pending state updates to be applied. High priority updates only
+   * go to their own list if the batching policy uses priority lanes.
    */
   folly::SpinLock pendingUpdatesLock_;
   StateUpdateList pendingUpdates_;
+  StateUpdateList highPriorityPendingUpdates_;
+  std::shared_ptr<const StateUpdateBatchingPolicy> batchingPolicy_{
+      std::make_shared<StateUpdateBatchingPolicy>()};
+  // Only accessed from the update thread
+  bool lingerTimeoutScheduled_{false};
 
   /*
    * The current switch state represented as :  appliedState,
@@ -1324,6 +1421,21 @@ class SwSwitch : public HwSwitchCallback {
    * locking when we access the container during a state update.
    */
   std::map<StateObserver*, std::string> stateObservers_;
+  /*
+   * Worker pool used to notify state observers concurrently. Only created
+   * with --parallel_state_observers.
+   */
+  std::unique_ptr<folly::CPUThreadPoolExecutor> stateObserverExecutor_;
+  /*
+   * Queues trapped packets per class and hands them to the packet handlers in
+   * priority order. Only created with --rx_slow_path_scheduler.
+   */
+  std::unique_ptr<RxSlowPathScheduler> rxSlowPathScheduler_;
+  /*
+   * Runs on the neighbor cache thread. Declared before nUpdater_, whose
+   * neighbor caches drop their queued probes and updates when destroyed.
+   */
+  std::unique_ptr<NeighborRefreshEngine> neighborRefreshEngine_;
   std::unique_ptr<PacketObservers> pktObservers_;
   std::unique_ptr<L2LearnEventObservers> l2LearnEventObservers_;
   std::unordered_map<PreUpdateStateModifier*, std::string> stateModifiers_;
@@ -1360,6 +1472,7 @@ class SwSwitch : public HwSwitchCallback {
 
   std::unique_ptr<PhySnapshotManager> phySnapshotManager_;
   std::unique_ptr<AclNexthopHandler> aclNexthopHandler_;
+  std::unique_ptr<AclMatchEngine> aclMatchEngine_;
   folly::Synchronized<std::unique_ptr<FsdbSyncer>> fsdbSyncer_;
   std::unique_ptr<TeFlowNexthopHandler> teFlowNextHopHandler_;
   std::unique_ptr<DsfSubscriber> dsfSubscriber_;
@@ -1378,12 +1491,25 @@ class SwSwitch : public HwSwitchCallback {
   std::optional<std::chrono::time_point<std::chrono::steady_clock>>
       publishedStatsToFsdbAt_;
   std::unique_ptr<MultiSwitchPacketStreamMap> packetStreamMap_;
+  std::unique_ptr<MultiSwitchPacketRings> packetRings_;
   std::unique_ptr<SwSwitchWarmBootHelper> swSwitchWarmbootHelper_;
   std::unique_ptr<HwSwitchThriftClientTable> hwSwitchThriftClientTable_;
   std::unique_ptr<MultiSwitchFb303Stats> multiSwitchFb303Stats_{nullptr};
   std::atomic<std::chrono::time_point<std::chrono::steady_clock>>
       lastPacketRxTime_{std::chrono::steady_clock::time_point::min()};
   folly::Synchronized<std::unique_ptr<AgentConfig>> agentConfig_;
+  /*
+   * The switch config last applied by applyConfigImpl() with
+   * --incremental_config_apply, and the state it produced. The next config
+   * apply only re-applies the sections that changed since, as long as it
+   * starts from that same state, i.e. no other update got applied in
+   * between. Otherwise it applies the whole config.
+   */
+  struct AppliedConfig {
+    cfg::SwitchConfig config;
+    std::weak_ptr<SwitchState> state;
+  };
+  folly::Synchronized<std::optional<AppliedConfig>> lastAppliedConfig_;
   agent_info::AgentInfo agentInfo_;
   folly::Synchronized<std::map<uint16_t, multiswitch::HwSwitchStats>>
       hwSwitchStats_;
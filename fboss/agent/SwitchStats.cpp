@@ -13,6 +13,7 @@
 #include <folly/Range.h>
 #include <folly/Utility.h>
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/RxSlowPathScheduler.h"
 #include "fboss/lib/CommonUtils.h"
 
 using facebook::fb303::AVG;
@@ -112,6 +113,11 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map, int numSwitches)
           kCounterPrefix + "thrift_request_completion_time.ms",
           facebook::fb303::ExportTypeConsts::kCountAvg,
           facebook::fb303::QuantileConsts::kP50_P95_P99_P100),
+      // key param is the state observer name
+      stateObserverUpdate_(
+          kCounterPrefix + "state_observer.{}.us",
+          facebook::fb303::ExportTypeConsts::kCountAvg,
+          facebook::fb303::QuantileConsts::kP50_P95_P99_P100),
       bgHeartbeatDelay_(
           map,
           kCounterPrefix + "bg_heartbeat_delay.ms",
@@ -261,6 +267,56 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map, int numSwitches)
           0,
           10000,
           AVG),
+      stateUpdateBatchSize_(
+          map,
+          kCounterPrefix + "state_update_batch_size",
+          10,
+          0,
+          10000,
+          AVG,
+          50,
+          95,
+          99),
+      stateUpdateBatchDeferred_(
+          map,
+          kCounterPrefix + "state_update_batch_deferred",
+          SUM,
+          RATE),
+      neighborProbesSent_(
+          map,
+          kCounterPrefix + "neighbor_refresh.probes_sent",
+          SUM,
+          RATE),
+      neighborProbeBatchSize_(
+          map,
+          kCounterPrefix + "neighbor_refresh.probe_batch_size",
+          100,
+          0,
+          10000,
+          AVG,
+          50,
+          95,
+          99),
+      neighborUpdateBatchSize_(
+          map,
+          kCounterPrefix + "neighbor_refresh.update_batch_size",
+          100,
+          0,
+          10000,
+          AVG,
+          50,
+          95,
+          99),
+      neighborUpdateLatencyMs_(
+          map,
+          kCounterPrefix + "neighbor_refresh.update_latency.ms",
+          10,
+          0,
+          1000,
+          AVG,
+          50,
+          95,
+          99),
       linkStateChange_(map, kCounterPrefix + "link_state.flap", SUM),
       linkActiveStateChange_(
           map,
@@ -441,6 +497,48 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map, int numSwitches)
             ".",
             "inactive_ports_with_switch_reachability"));
   }
+  for (size_t cls = 0; cls < kNumRxSlowPathClasses; ++cls) {
+    auto className =
+        rxSlowPathClassToString(static_cast<RxSlowPathClass>(cls));
+    rxSlowPathRateLimited_.emplace_back(
+        map,
+        folly::to<std::string>(
+            kCounterPrefix, "trapped.slow_path.", className, ".rate_limited"),
+        SUM,
+        RATE);
+    rxSlowPathQueueFull_.emplace_back(
+        map,
+        folly::to<std::string>(
+            kCounterPrefix, "trapped.slow_path.", className, ".queue_full"),
+        SUM,
+        RATE);
+    rxSlowPathQueueDelay_.emplace_back(
+        map,
+        folly::to<std::string>(
+            kCounterPrefix, "trapped.slow_path.", className, ".queue_delay.us"),
+        100,
+        0,
+        30000,
+        AVG,
+        50,
+        100);
+  }
+}
+
+void SwitchStats::rxSlowPathRateLimited(
+    RxSlowPathClass rxClass,
+    uint64_t count) {
+  rxSlowPathRateLimited_[static_cast<size_t>(rxClass)].addValue(count);
+  trapPktDrops_.addValue(count);
+}
+
+void SwitchStats::rxSlowPathQueueFull(RxSlowPathClass rxClass, uint64_t count) {
+  rxSlowPathQueueFull_[static_cast<size_t>(rxClass)].addValue(count);
+  trapPktDrops_.addValue(count);
+}
+
+void SwitchStats::rxSlowPathQueueDelay(RxSlowPathClass rxClass, int64_t usecs) {
+  rxSlowPathQueueDelay_[static_cast<size_t>(rxClass)].addValue(usecs);
 }
 
 PortStats* FOLLY_NULLABLE SwitchStats::port(PortID portID) {
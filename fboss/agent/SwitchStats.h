@@ -24,6 +24,7 @@
 namespace facebook::fboss {
 
 class PortStats;
+enum class RxSlowPathClass : uint8_t;
 
 using PortStatsMap =
     folly::ConcurrentHashMap<PortID, std::unique_ptr<PortStats>>;
@@ -270,6 +271,12 @@ class SwitchStats : public boost::noncopyable {
     updateState_.addValue(us.count());
   }
 
+  void stateObserverUpdate(
+      std::string_view observer,
+      std::chrono::microseconds us) {
+    stateObserverUpdate_.addValue(us.count(), observer);
+  }
+
   void bgHeartbeatDelay(int delay) {
     bgHeartbeatDelay_.addValue(delay);
   }
@@ -294,6 +301,11 @@ class SwitchStats : public boost::noncopyable {
     packetRxHeartbeatDelay_.addValue(delay);
   }
 
+  // trapped packets dropped by the RxSlowPathScheduler
+  void rxSlowPathRateLimited(RxSlowPathClass rxClass, uint64_t count);
+  void rxSlowPathQueueFull(RxSlowPathClass rxClass, uint64_t count);
+  void rxSlowPathQueueDelay(RxSlowPathClass rxClass, int64_t usecs);
+
   void dsfSubReconnectThreadHeartbeatDelay(int delay) {
     dsfSubReconnectThreadHeartbeatDelay_.addValue(delay);
   }
@@ -337,6 +349,26 @@ class SwitchStats : public boost::noncopyable {
   void pendingStateUpdateCount(int value) {
     pendingStateUpdateCount_.addValue(value);
   }
+  void stateUpdateBatchSize(int value) {
+    stateUpdateBatchSize_.addValue(value);
+  }
+  void stateUpdateBatchDeferred() {
+    stateUpdateBatchDeferred_.addValue(1);
+  }
+
+  // NeighborRefreshEngine
+  void neighborProbesSent(int count) {
+    neighborProbesSent_.addValue(count);
+  }
+  void neighborProbeBatchSize(int value) {
+    neighborProbeBatchSize_.addValue(value);
+  }
+  void neighborUpdateBatchSize(int value) {
+    neighborUpdateBatchSize_.addValue(value);
+  }
+  void neighborUpdateLatencyMs(int value) {
+    neighborUpdateLatencyMs_.addValue(value);
+  }
 
   void thriftRequestCompletionTimeMs(std::chrono::milliseconds ms) {
     thriftRequestCompletionTimeMs_.addValue(ms.count());
@@ -923,6 +955,12 @@ class SwitchStats : public boost::noncopyable {
    */
   fb303::detail::QuantileStatWrapper thriftRequestCompletionTimeMs_;
 
+  /**
+   * Histogram for time used by each StateObserver to process a state update
+   * (in microsecond), keyed by observer name
+   */
+  fb303::detail::DynamicQuantileStatWrapper<1> stateObserverUpdate_;
+
   /**
    * Background thread heartbeat delay (ms)
    */
@@ -994,6 +1032,28 @@ class SwitchStats : public boost::noncopyable {
    * Number of state updates queued in state update queue
    */
   TLHistogram pendingStateUpdateCount_;
+  /**
+   * Number of state updates applied in a single batch
+   */
+  TLHistogram stateUpdateBatchSize_;
+  /**
+   * Number of times a batch ran out of its time budget and left updates for
+   * the next batch
+   */
+  TLTimeseries stateUpdateBatchDeferred_;
+
+  /**
+   * ARP/NDP probes sent by the neighbor refresh engine, and the number of
+   * probes and neighbor entry updates it handles per tick
+   */
+  TLTimeseries neighborProbesSent_;
+  TLHistogram neighborProbeBatchSize_;
+  TLHistogram neighborUpdateBatchSize_;
+  /**
+   * Time from a neighbor entry change to its state update being applied,
+   * with the neighbor refresh engine
+   */
+  TLHistogram neighborUpdateLatencyMs_;
 
   /**
    * Link state up/down change count
@@ -1116,6 +1176,10 @@ class SwitchStats : public boost::noncopyable {
   std::vector<TLTimeseries> switchReachabilityInconsistencyDetected_;
   std::vector<TLCounter> activePortsWithoutSwitchReachability_;
   std::vector<TLCounter> inactivePortsWithSwitchReachability_;
+  // per RxSlowPathClass
+  std::vector<TLTimeseries> rxSlowPathRateLimited_;
+  std::vector<TLTimeseries> rxSlowPathQueueFull_;
+  std::vector<TLHistogram> rxSlowPathQueueDelay_;
 };
 
 } // namespace facebook::fboss
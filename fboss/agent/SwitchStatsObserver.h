@@ -13,6 +13,9 @@ class SwitchStatsObserver : public StateObserver {
   explicit SwitchStatsObserver(SwSwitch* sw);
   ~SwitchStatsObserver() override;
   void stateUpdated(const StateDelta& delta) override;
+  bool isConcurrentSafe() const override {
+    return true;
+  }
 
  private:
   template <typename NTableT>
@@ -609,6 +609,18 @@ void translateToFibError(const FbossHwUpdateError& updError) {
   throw fibError;
 }
 
+SyncFibProgress toSyncFibProgressThrift(
+    const RoutingInformationBase::SyncFibProgress& progress) {
+  SyncFibProgress syncFibProgress;
+  syncFibProgress.chunksReceived() = progress.chunks;
+  syncFibProgress.routesReceived() =
+      progress.total.v4RoutesAdded + progress.total.v6RoutesAdded;
+  syncFibProgress.routesDeleted() =
+      progress.total.v4RoutesDeleted + progress.total.v6RoutesDeleted;
+  syncFibProgress.elapsedUs() = progress.elapsed.count();
+  return syncFibProgress;
+}
+
 cfg::PortLoopbackMode toLoopbackMode(PortLoopbackMode mode) {
   switch (mode) {
     case PortLoopbackMode::NONE:
@@ -843,6 +855,80 @@ void ThriftHandler::syncFibInVrf(
   syncedFibClients.emplace(client);
 }
 
+void ThriftHandler::beginSyncFib(int16_t client, int32_t vrf) {
+  auto clientId = static_cast<ClientID>(client);
+  auto clientName = apache::thrift::util::enumNameSafe(clientId);
+  auto log = LOG_THRIFT_CALL_WITH_STATS(DBG1, sw_->stats(), clientName);
+  ensureConfigured(__func__);
+  if (!sw_->getSwitchInfoTable().haveL3Switches()) {
+    // Like syncFibInVrf(), only an empty sync is accepted
+    return;
+  }
+  // Like syncFibInVrf(), route updates of the first sync of each client are
+  // logged, until commitSyncFib()
+  if (syncedFibClients.find(client) == syncedFibClients.end() &&
+      sw_->getBootType() == BootType::WARM_BOOT) {
+    auto clientIdentifier = "fboss-agent-warmboot-" + clientName;
+    sw_->logRouteUpdates("::", 0, clientIdentifier);
+    sw_->logRouteUpdates("0.0.0.0", 0, clientIdentifier);
+  }
+  sw_->getRouteUpdater().beginSyncFib(RouterID(vrf), clientId);
+}
+
+void ThriftHandler::addSyncFibRoutes(
+    SyncFibProgress& progress,
+    int16_t client,
+    int32_t vrf,
+    std::unique_ptr<std::vector<UnicastRoute>> routes) {
+  auto clientId = static_cast<ClientID>(client);
+  auto clientName = apache::thrift::util::enumNameSafe(clientId);
+  auto log = LOG_THRIFT_CALL_WITH_STATS(DBG1, sw_->stats(), clientName);
+  ensureConfigured(__func__);
+  if (!sw_->getSwitchInfoTable().haveL3Switches()) {
+    if (routes->size()) {
+      throw FbossError("No ASIC found with L3 functionality");
+    }
+    return;
+  }
+  try {
+    progress = toSyncFibProgressThrift(
+        sw_->getRouteUpdater().addSyncFibRoutes(
+            RouterID(vrf), clientId, *routes));
+  } catch (const FbossHwUpdateError& ex) {
+    translateToFibError(ex);
+  }
+}
+
+void ThriftHandler::commitSyncFib(
+    SyncFibProgress& progress,
+    int16_t client,
+    int32_t vrf) {
+  auto clientId = static_cast<ClientID>(client);
+  auto clientName = apache::thrift::util::enumNameSafe(clientId);
+  auto log = LOG_THRIFT_CALL_WITH_STATS(DBG1, sw_->stats(), clientName);
+  ensureConfigured(__func__);
+  if (!sw_->getSwitchInfoTable().haveL3Switches()) {
+    return;
+  }
+  auto firstClientSync =
+      syncedFibClients.find(client) == syncedFibClients.end();
+  SCOPE_EXIT {
+    if (firstClientSync && sw_->getBootType() == BootType::WARM_BOOT) {
+      sw_->stopLoggingRouteUpdates("fboss-agent-warmboot-" + clientName);
+    }
+  };
+  try {
+    progress = toSyncFibProgressThrift(
+        sw_->getRouteUpdater().commitSyncFib(RouterID(vrf), clientId));
+  } catch (const FbossHwUpdateError& ex) {
+    translateToFibError(ex);
+  }
+  if (firstClientSync) {
+    sw_->setFibSyncTimeForClient(clientId);
+  }
+  syncedFibClients.emplace(client);
+}
+
 void ThriftHandler::syncFib(
     int16_t client,
     std::unique_ptr<std::vector<UnicastRoute>> routes) {
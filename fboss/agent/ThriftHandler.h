@@ -97,6 +97,14 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       int16_t client,
       std::unique_ptr<std::vector<UnicastRoute>> routes,
       int32_t vrf) override;
+  void beginSyncFib(int16_t client, int32_t vrf) override;
+  void addSyncFibRoutes(
+      SyncFibProgress& progress,
+      int16_t client,
+      int32_t vrf,
+      std::unique_ptr<std::vector<UnicastRoute>> routes) override;
+  void commitSyncFib(SyncFibProgress& progress, int16_t client, int32_t vrf)
+      override;
 
   /* MPLS routes */
   void addMplsRoutes(
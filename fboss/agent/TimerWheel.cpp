@@ -0,0 +1,215 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/TimerWheel.h"
+
+#include <folly/Random.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <optional>
+
+DEFINE_uint32(
+    timer_wheel_tick_ms,
+    10,
+    "Granularity of the timer wheels of the neighbor cache and LACP timers");
+
+DEFINE_uint32(
+    timer_wheel_max_expiries_per_loop,
+    1024,
+    "Max number of timers a timer wheel runs per event base loop, the rest "
+    "of the expired timers run in the next loops");
+
+namespace facebook::fboss {
+
+TimerWheel::Callback::~Callback() {
+  cancelTimeout();
+}
+
+void TimerWheel::Callback::scheduleTimeout(
+    std::chrono::milliseconds timeout,
+    std::chrono::milliseconds maxJitter) {
+  if (maxJitter.count() > 0) {
+    timeout += std::chrono::milliseconds(
+        folly::Random::rand64(maxJitter.count() + 1));
+  }
+  wheel_->schedule(this, timeout);
+}
+
+void TimerWheel::Callback::cancelTimeout() {
+  if (isScheduled()) {
+    wheel_->cancel(this);
+  }
+}
+
+TimerWheel::TimerWheel(
+    folly::EventBase* evb,
+    std::chrono::milliseconds tick,
+    uint32_t maxExpiriesPerLoop)
+    : folly::AsyncTimeout(evb),
+      evb_(evb),
+      tick_(tick),
+      maxExpiriesPerLoop_(std::max<uint32_t>(maxExpiriesPerLoop, 1)),
+      start_(std::chrono::steady_clock::now()) {
+  CHECK_GT(tick_.count(), 0);
+}
+
+TimerWheel::~TimerWheel() {
+  cancelLoopCallback();
+  // unlink the timers still scheduled, they can no longer fire
+  for (auto& level : slots_) {
+    for (auto& slot : level) {
+      slot.clear();
+    }
+  }
+  expired_.clear();
+}
+
+uint64_t TimerWheel::tickOf(std::chrono::steady_clock::time_point time) const {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(time - start_)
+             .count() /
+      tick_.count();
+}
+
+void TimerWheel::schedule(
+    Callback* callback,
+    std::chrono::milliseconds timeout) {
+  DCHECK(evb_->isInEventBaseThread());
+  cancel(callback);
+  auto now = std::chrono::steady_clock::now();
+  if (count_ == 0) {
+    // nothing to expire in the ticks the wheel slept through
+    currentTick_ = std::max(currentTick_, tickOf(now));
+  }
+  // round up, a timer never fires before its timeout
+  auto expiry = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now + timeout - start_)
+                    .count();
+  callback->expiryTick_ = std::max<uint64_t>(
+      (expiry + tick_.count() - 1) / tick_.count(), currentTick_ + 1);
+  insert(callback);
+  ++count_;
+  if (!folly::AsyncTimeout::isScheduled() ||
+      callback->expiryTick_ < nextWakeTick_) {
+    scheduleNextTick();
+  }
+}
+
+void TimerWheel::cancel(Callback* callback) {
+  if (callback->isScheduled()) {
+    callback->hook_.unlink();
+    --count_;
+  }
+}
+
+void TimerWheel::insert(Callback* callback) {
+  constexpr uint64_t kMaxTicks = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+  auto delta = std::min(callback->expiryTick_ - currentTick_, kMaxTicks);
+  callback->expiryTick_ = currentTick_ + delta;
+  size_t level = 0;
+  while (level < kLevels - 1 &&
+         delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+  auto slot = (callback->expiryTick_ >> (kSlotBits * level)) & kSlotMask;
+  slots_[level][slot].push_back(*callback);
+}
+
+void TimerWheel::advanceTo(uint64_t tick) {
+  while (currentTick_ < tick) {
+    ++currentTick_;
+    // move the timers of the higher level slots starting at this tick down,
+    // highest level first as its timers may land in a lower level slot
+    // starting at this tick too
+    for (size_t level = kLevels - 1; level > 0; --level) {
+      if (currentTick_ & ((uint64_t(1) << (kSlotBits * level)) - 1)) {
+        continue;
+      }
+      auto& slot =
+          slots_[level][(currentTick_ >> (kSlotBits * level)) & kSlotMask];
+      CallbackList cascaded;
+      cascaded.splice(cascaded.end(), slot);
+      while (!cascaded.empty()) {
+        auto& callback = cascaded.front();
+        cascaded.pop_front();
+        insert(&callback);
+      }
+    }
+    expired_.splice(expired_.end(), slots_[0][currentTick_ & kSlotMask]);
+  }
+}
+
+void TimerWheel::scheduleNextTick() {
+  if (count_ == 0) {
+    folly::AsyncTimeout::cancelTimeout();
+    return;
+  }
+  // the first level 0 slot with timers, which may lie past the next cascade
+  // as level 0 spans the kSlots ticks after currentTick_, or the next cascade
+  // if it comes first and any of the higher level slots has timers
+  std::optional<uint64_t> nextTick;
+  for (auto tick = currentTick_ + 1; tick <= currentTick_ + kSlots; ++tick) {
+    if (!slots_[0][tick & kSlotMask].empty()) {
+      nextTick = tick;
+      break;
+    }
+  }
+  auto nextCascade = ((currentTick_ >> kSlotBits) + 1) << kSlotBits;
+  if (!nextTick || *nextTick > nextCascade) {
+    bool cascades = false;
+    for (size_t level = 1; level < kLevels && !cascades; ++level) {
+      cascades = std::any_of(
+          slots_[level].begin(), slots_[level].end(), [](const auto& slot) {
+            return !slot.empty();
+          });
+    }
+    if (cascades) {
+      nextTick = nextCascade;
+    }
+  }
+  if (!nextTick) {
+    // only timers expired but not run yet are left
+    folly::AsyncTimeout::cancelTimeout();
+    return;
+  }
+  nextWakeTick_ = *nextTick;
+  auto wakeTime = start_ + tick_ * static_cast<int64_t>(*nextTick);
+  auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+      wakeTime - std::chrono::steady_clock::now());
+  folly::AsyncTimeout::scheduleTimeout(
+      std::max(delay, std::chrono::milliseconds(0)));
+}
+
+void TimerWheel::runExpired() {
+  uint32_t expiries = 0;
+  while (!expired_.empty() && expiries < maxExpiriesPerLoop_) {
+    auto& callback = expired_.front();
+    expired_.pop_front();
+    --count_;
+    ++expiries;
+    // may reschedule or destroy the callback
+    callback.timeoutExpired();
+  }
+  if (!expired_.empty() && !isLoopCallbackScheduled()) {
+    evb_->runInLoop(this);
+  }
+}
+
+void TimerWheel::timeoutExpired() noexcept {
+  advanceTo(tickOf(std::chrono::steady_clock::now()));
+  // before running the timers, so rescheduling them rarely moves the wake up
+  scheduleNextTick();
+  runExpired();
+}
+
+void TimerWheel::runLoopCallback() noexcept {
+  runExpired();
+}
+
+} // namespace facebook::fboss
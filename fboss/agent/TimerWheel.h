@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <boost/intrusive/list.hpp>
+#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/EventBase.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <chrono>
+
+DECLARE_uint32(timer_wheel_tick_ms);
+DECLARE_uint32(timer_wheel_max_expiries_per_loop);
+
+namespace facebook::fboss {
+
+/*
+ * Hierarchical timing wheel shared by the many long lived timers of an event
+ * base, e.g. one per neighbor cache entry and four per LACP member port,
+ * which would otherwise each sit in the event base's timer heap.
+ *
+ * Timers are rounded up to the tick, scheduling and cancelling them is O(1),
+ * and the event base only wakes up for ticks with expiring timers. Expired
+ * timers run in batches of at most maxExpiriesPerLoop, with the rest deferred
+ * to the next event base loop so that a herd of expiring timers does not
+ * starve the other events of the event base. Timers may ask for a random
+ * jitter to be added to their timeout, to spread out timers started together.
+ *
+ * All methods, including those of Callback, must be called from the thread
+ * of the event base.
+ */
+class TimerWheel : private folly::AsyncTimeout,
+                   private folly::EventBase::LoopCallback {
+ public:
+  class Callback {
+   public:
+    explicit Callback(TimerWheel* wheel) : wheel_(wheel) {}
+    virtual ~Callback();
+
+    Callback(const Callback&) = delete;
+    Callback& operator=(const Callback&) = delete;
+
+    // (re)schedules the timer, in timeout plus a random jitter of up to
+    // maxJitter
+    void scheduleTimeout(
+        std::chrono::milliseconds timeout,
+        std::chrono::milliseconds maxJitter = std::chrono::milliseconds(0));
+    void cancelTimeout();
+    bool isScheduled() const {
+      return hook_.is_linked();
+    }
+
+   protected:
+    virtual void timeoutExpired() noexcept = 0;
+
+   private:
+    friend class TimerWheel;
+
+    TimerWheel* wheel_;
+    boost::intrusive::list_member_hook<
+        boost::intrusive::link_mode<boost::intrusive::auto_unlink>>
+        hook_;
+    uint64_t expiryTick_{0};
+  };
+
+  TimerWheel(
+      folly::EventBase* evb,
+      std::chrono::milliseconds tick,
+      uint32_t maxExpiriesPerLoop);
+  ~TimerWheel() override;
+
+  size_t count() const {
+    return count_;
+  }
+
+ private:
+  using CallbackList = boost::intrusive::list<
+      Callback,
+      boost::intrusive::member_hook<
+          Callback,
+          boost::intrusive::list_member_hook<
+              boost::intrusive::link_mode<boost::intrusive::auto_unlink>>,
+          &Callback::hook_>,
+      boost::intrusive::constant_time_size<false>>;
+
+  static constexpr size_t kLevels = 4;
+  static constexpr size_t kSlotBits = 8;
+  static constexpr size_t kSlots = 1 << kSlotBits;
+  static constexpr uint64_t kSlotMask = kSlots - 1;
+
+  void schedule(Callback* callback, std::chrono::milliseconds timeout);
+  void cancel(Callback* callback);
+  void insert(Callback* callback);
+  uint64_t tickOf(std::chrono::steady_clock::time_point time) const;
+  void advanceTo(uint64_t tick);
+  void runExpired();
+  void scheduleNextTick();
+
+  void timeoutExpired() noexcept override;
+  void runLoopCallback() noexcept override;
+
+  folly::EventBase* evb_;
+  const std::chrono::milliseconds tick_;
+  const uint32_t maxExpiriesPerLoop_;
+  const std::chrono::steady_clock::time_point start_;
+  // last tick whose timers were moved to expired_
+  uint64_t currentTick_{0};
+  // tick the event base wakes the wheel up at, if scheduled
+  uint64_t nextWakeTick_{0};
+  // timers scheduled, including those expired but not run yet
+  size_t count_{0};
+  // level 0 holds the timers of the next kSlots ticks, every further level
+  // kSlots times as many ticks per slot
+  std::array<std::array<CallbackList, kSlots>, kLevels> slots_;
+  CallbackList expired_;
+};
+
+} // namespace facebook::fboss
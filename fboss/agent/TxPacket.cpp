@@ -1,5 +1,6 @@
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/TxPacketObserver.h"
+#include "fboss/agent/TxPacketPool.h"
 
 namespace facebook::fboss {
 
@@ -9,8 +10,7 @@ std::unique_ptr<TxPacket> TxPacket::allocateTxPacket(size_t size) {
 }
 
 TxPacket::TxPacket(size_t size) {
-  buf_ = folly::IOBuf::create(size);
-  buf_->append(size);
+  buf_ = TxPacketPool::allocateTxBuffer(size);
   buf_->appendSharedInfoObserver(TxPacketObserver());
 }
 
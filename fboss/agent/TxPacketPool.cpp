@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/TxPacketPool.h"
+
+#include <folly/Indestructible.h>
+
+#include <algorithm>
+
+DEFINE_bool(
+    tx_packet_pool,
+    false,
+    "Allocate TX packet buffers from a pool of recycled buffers, and in split "
+    "mode hand TX packets to the HwSwitch without copying them");
+
+DEFINE_uint32(
+    tx_packet_pool_buffers_per_class,
+    1024,
+    "Max number of free buffers kept per size class of the TX packet pool");
+
+namespace facebook::fboss {
+
+TxPacketPool::TxPacketPool(size_t maxFreeBuffersPerClass)
+    : maxFreeBuffersPerClass_(maxFreeBuffersPerClass) {
+  for (size_t i = 0; i < kBufferSizes.size(); ++i) {
+    sizeClasses_[i].pool = this;
+    sizeClasses_[i].bufferSize = kBufferSizes[i];
+    sizeClasses_[i].freeBuffers.reserve(maxFreeBuffersPerClass);
+  }
+}
+
+TxPacketPool::~TxPacketPool() {
+  for (auto& sizeClass : sizeClasses_) {
+    for (auto* buf : sizeClass.freeBuffers) {
+      delete[] buf;
+    }
+  }
+}
+
+TxPacketPool& TxPacketPool::getInstance() {
+  static folly::Indestructible<TxPacketPool> pool(
+      FLAGS_tx_packet_pool_buffers_per_class);
+  return *pool;
+}
+
+std::unique_ptr<folly::IOBuf> TxPacketPool::allocateTxBuffer(uint32_t size) {
+  if (FLAGS_tx_packet_pool) {
+    return getInstance().allocate(size);
+  }
+  // keep the allocation count comparable with and without the pool
+  getInstance().recordHeapAllocation();
+  auto buf = folly::IOBuf::create(size);
+  buf->append(size);
+  return buf;
+}
+
+std::unique_ptr<folly::IOBuf> TxPacketPool::allocate(uint32_t size) {
+  auto it = std::lower_bound(kBufferSizes.begin(), kBufferSizes.end(), size);
+  if (it == kBufferSizes.end()) {
+    recordHeapAllocation();
+    auto buf = folly::IOBuf::create(size);
+    buf->append(size);
+    return buf;
+  }
+  auto& sizeClass = sizeClasses_[it - kBufferSizes.begin()];
+  uint8_t* data = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    if (!sizeClass.freeBuffers.empty()) {
+      data = sizeClass.freeBuffers.back();
+      sizeClass.freeBuffers.pop_back();
+    }
+  }
+  if (data) {
+    reusedBuffers_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    recordHeapAllocation();
+    data = new uint8_t[sizeClass.bufferSize];
+  }
+  return folly::IOBuf::takeOwnership(
+      data, sizeClass.bufferSize, size, &TxPacketPool::freeBuffer, &sizeClass);
+}
+
+size_t TxPacketPool::freeBuffers(size_t sizeClass) const {
+  std::lock_guard<std::mutex> lock(sizeClasses_[sizeClass].mutex);
+  return sizeClasses_[sizeClass].freeBuffers.size();
+}
+
+void TxPacketPool::freeBuffer(void* buf, void* userData) {
+  auto* data = static_cast<uint8_t*>(buf);
+  auto* sizeClass = static_cast<SizeClass*>(userData);
+  {
+    std::lock_guard<std::mutex> lock(sizeClass->mutex);
+    if (sizeClass->freeBuffers.size() <
+        sizeClass->pool->maxFreeBuffersPerClass_) {
+      sizeClass->freeBuffers.push_back(data);
+      return;
+    }
+  }
+  delete[] data;
+}
+
+} // namespace facebook::fboss
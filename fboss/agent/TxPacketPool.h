@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/io/IOBuf.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+DECLARE_bool(tx_packet_pool);
+
+namespace facebook::fboss {
+
+/*
+ * Pool of TX packet buffers, recycled rather than freed once a packet is
+ * sent (or dropped) and its IOBuf released.
+ *
+ * Buffers come in a few size classes, from small control frames (ARP, LACP)
+ * up to jumbo frames. Each class keeps at most maxFreeBuffersPerClass free
+ * buffers, anything beyond that goes back to the heap. Requests larger than
+ * the largest class are always heap allocated.
+ *
+ * Buffers returned by allocate() refer back to their pool, which therefore
+ * has to outlive them. The process wide instance is never destroyed.
+ */
+class TxPacketPool {
+ public:
+  static constexpr std::array<uint32_t, 4> kBufferSizes = {
+      128,
+      512,
+      2048,
+      9728};
+
+  explicit TxPacketPool(size_t maxFreeBuffersPerClass);
+  ~TxPacketPool();
+
+  static TxPacketPool& getInstance();
+
+  /*
+   * Buffer for a TX packet of size bytes, from the pool of getInstance() with
+   * --tx_packet_pool, or freshly allocated otherwise.
+   */
+  static std::unique_ptr<folly::IOBuf> allocateTxBuffer(uint32_t size);
+
+  // buffer of length size, with at least size bytes of capacity
+  std::unique_ptr<folly::IOBuf> allocate(uint32_t size);
+
+  // buffers allocated from the heap, rather than reused
+  uint64_t heapAllocations() const {
+    return heapAllocations_.load(std::memory_order_relaxed);
+  }
+  // buffers handed out from a free list
+  uint64_t reusedBuffers() const {
+    return reusedBuffers_.load(std::memory_order_relaxed);
+  }
+  size_t freeBuffers(size_t sizeClass) const;
+
+ private:
+  struct SizeClass {
+    TxPacketPool* pool{nullptr};
+    uint32_t bufferSize{0};
+    mutable std::mutex mutex;
+    std::vector<uint8_t*> freeBuffers;
+  };
+
+  static void freeBuffer(void* buf, void* userData);
+  void recordHeapAllocation() {
+    heapAllocations_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const size_t maxFreeBuffersPerClass_;
+  std::array<SizeClass, kBufferSizes.size()> sizeClasses_;
+  std::atomic<uint64_t> heapAllocations_{0};
+  std::atomic<uint64_t> reusedBuffers_{0};
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Time to find the ACL entry a packet hits in a large ACL table, with entries
+ * qualifying on different sets of fields as production tables do. Compares
+ * walking the entries in priority order to the compiled AclClassifier.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/AclMatchEngine.h"
+#include "fboss/agent/state/AclEntry.h"
+
+#include <algorithm>
+#include <random>
+
+DEFINE_int32(acl_match_packets, 1024, "Number of distinct packets matched");
+
+using namespace facebook::fboss;
+
+namespace {
+
+std::shared_ptr<AclEntry> makeAcl(int index, std::mt19937& gen) {
+  auto pick = [&gen](int n) {
+    return std::uniform_int_distribution<int>(0, n - 1)(gen);
+  };
+  auto acl =
+      std::make_shared<AclEntry>(index, folly::to<std::string>("acl", index));
+  acl->setActionType(cfg::AclActionType::DENY);
+  switch (pick(4)) {
+    case 0:
+      acl->setDstIp(folly::IPAddress::createNetwork(folly::to<std::string>(
+          "2401:db00:", pick(0x10000), ":", pick(0x10000), "::/64")));
+      break;
+    case 1:
+      acl->setDstIp(folly::IPAddress::createNetwork(folly::to<std::string>(
+          "10.", pick(256), ".", pick(256), ".0/24")));
+      acl->setProto(6);
+      acl->setL4DstPort(pick(1024));
+      break;
+    case 2:
+      acl->setSrcIp(folly::IPAddress::createNetwork(folly::to<std::string>(
+          "2401:db00:", pick(0x10000), "::/48")));
+      acl->setDscp(pick(64));
+      break;
+    case 3:
+      acl->setLookupClassNeighbor(
+          cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0);
+      acl->setSrcPort(pick(64));
+      break;
+  }
+  return acl;
+}
+
+AclPacketHeaders makePacket(std::mt19937& gen) {
+  auto pick = [&gen](int n) {
+    return std::uniform_int_distribution<int>(0, n - 1)(gen);
+  };
+  AclPacketHeaders headers;
+  headers.etherType = static_cast<uint16_t>(cfg::EtherType::IPv6);
+  headers.srcIp = folly::IPAddress(
+      folly::to<std::string>("2401:db00:", pick(0x10000), "::1"));
+  headers.dstIp = folly::IPAddress(
+      folly::to<std::string>("2401:db00:", pick(0x10000), "::1"));
+  headers.proto = 6;
+  headers.ttl = 64;
+  headers.dscp = pick(64);
+  headers.l4SrcPort = 1000 + pick(1000);
+  headers.l4DstPort = pick(1024);
+  headers.srcPort = PortID(pick(64));
+  return headers;
+}
+
+void AclMatch(uint32_t iters, int numAcls, bool classifier) {
+  folly::BenchmarkSuspender suspender;
+  std::mt19937 gen(numAcls);
+  std::vector<std::shared_ptr<AclEntry>> acls;
+  AclClassifier aclClassifier;
+  for (int i = 0; i < numAcls; ++i) {
+    acls.push_back(makeAcl(i, gen));
+    aclClassifier.addEntry(acls.back());
+  }
+  // by priority, the order the ASIC evaluates them in
+  std::sort(acls.begin(), acls.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs->getPriority() < rhs->getPriority();
+  });
+  // the linear walk gets the same precompiled rules as the classifier
+  using Rules = std::vector<AclClassifier::Rule>;
+  std::vector<std::pair<Rules, std::shared_ptr<AclEntry>>> compiled;
+  for (const auto& acl : acls) {
+    compiled.emplace_back(AclClassifier::compile(*acl), acl);
+  }
+  std::vector<AclPacketHeaders> packets;
+  for (int i = 0; i < FLAGS_acl_match_packets; ++i) {
+    packets.push_back(makePacket(gen));
+  }
+  suspender.dismiss();
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    const auto& packet = packets[i % packets.size()];
+    std::shared_ptr<AclEntry> matched;
+    if (classifier) {
+      matched = aclClassifier.match(packet);
+    } else {
+      auto key = AclClassifier::packetKey(packet);
+      for (const auto& [rules, acl] : compiled) {
+        if (std::any_of(rules.begin(), rules.end(), [&key](const auto& rule) {
+              return rule.matches(key);
+            })) {
+          matched = acl;
+          break;
+        }
+      }
+    }
+    folly::doNotOptimizeAway(matched);
+  }
+}
+} // namespace
+
+BENCHMARK_NAMED_PARAM(AclMatch, linear_1k, 1024, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(AclMatch, classifier_1k, 1024, true);
+BENCHMARK_NAMED_PARAM(AclMatch, linear_4k, 4096, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(AclMatch, classifier_4k, 4096, true);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Time to apply a config push that adds a single ACL to a large VOQ switch
+ * config: many remote DSF nodes, and so system ports and remote interfaces,
+ * plus a large ACL table. Compares applying the whole config to applying
+ * only the config sections that changed since the previous config.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/Format.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+DEFINE_int32(
+    config_apply_acls,
+    2000,
+    "Number of ACLs in the config the single ACL change is applied to");
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr auto kSwitchIdGap = 4;
+
+cfg::AclEntry makeAcl(int index) {
+  cfg::AclEntry acl;
+  acl.name() = folly::to<std::string>("acl", index);
+  acl.actionType() = cfg::AclActionType::DENY;
+  acl.dstIp() = folly::sformat(
+      "2401:db00:{:x}:{:x}::/64", index / 0x10000, index % 0x10000);
+  return acl;
+}
+
+cfg::SwitchConfig largeVoqConfig(int numRemoteNodes) {
+  auto config = testConfigA(cfg::SwitchType::VOQ);
+  for (int i = 1; i <= numRemoteNodes; ++i) {
+    auto remoteNode = makeDsfNodeCfg(kVoqSwitchIdBegin + i * kSwitchIdGap);
+    config.dsfNodes()->insert({*remoteNode.switchId(), remoteNode});
+  }
+  for (int i = 0; i < FLAGS_config_apply_acls; ++i) {
+    config.acls()->push_back(makeAcl(i));
+  }
+  return config;
+}
+
+void ConfigApplySingleAclChange(
+    uint32_t iters,
+    int numRemoteNodes,
+    bool incremental) {
+  folly::BenchmarkSuspender suspender;
+  auto platform = createMockPlatform(cfg::SwitchType::VOQ, kVoqSwitchIdBegin);
+  auto state = std::make_shared<SwitchState>();
+  addSwitchInfo(state, cfg::SwitchType::VOQ, kVoqSwitchIdBegin);
+  auto config = largeVoqConfig(numRemoteNodes);
+  state = publishAndApplyConfig(state, &config, platform.get());
+  CHECK(state);
+  auto newConfig = config;
+  newConfig.acls()->push_back(makeAcl(FLAGS_config_apply_acls));
+  // keep the new states alive, freeing them is not part of the apply
+  std::vector<std::shared_ptr<SwitchState>> newStates;
+  newStates.reserve(iters);
+  suspender.dismiss();
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    newStates.push_back(publishAndApplyConfig(
+        state,
+        &newConfig,
+        platform.get(),
+        nullptr /* rib */,
+        nullptr /* platformMapping */,
+        incremental ? &config : nullptr));
+  }
+
+  suspender.rehire();
+  CHECK(newStates.back());
+  newStates.clear();
+}
+} // namespace
+
+BENCHMARK_NAMED_PARAM(ConfigApplySingleAclChange, full_64, 64, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    ConfigApplySingleAclChange,
+    incremental_64,
+    64,
+    true);
+BENCHMARK_NAMED_PARAM(ConfigApplySingleAclChange, full_192, 192, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    ConfigApplySingleAclChange,
+    incremental_192,
+    192,
+    true);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Latency of adding a single route to a published FIB of 100k, 500k and 1M
+ * routes: clone the FIB, add the route and publish the new FIB, as a FIB
+ * update does. Compares the FIB, whose routes are kept in a
+ * PersistentSortedMap, to the same map node storing its routes in std::map.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV6.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/Route.h"
+
+using namespace facebook::fboss;
+
+namespace {
+
+class StdMapFib;
+
+struct StdMapFibTraits : ThriftMapNodeTraits<
+                             StdMapFib,
+                             ForwardingInformationBaseClass,
+                             ForwardingInformationBaseType,
+                             RouteV6> {};
+
+// FIB as it was before routes moved to persistent storage
+class StdMapFib : public ThriftMapNode<StdMapFib, StdMapFibTraits> {
+ public:
+  using Base = ThriftMapNode<StdMapFib, StdMapFibTraits>;
+  using Base::Base;
+
+ private:
+  friend class CloneAllocator;
+};
+
+std::shared_ptr<RouteV6> makeRoute(uint32_t index) {
+  auto route = std::make_shared<RouteV6>(RouteV6::makeThrift(RoutePrefixV6{
+      folly::IPAddressV6::fromHighLow(
+          0x2401db0000000000ULL | (uint64_t(index) << 16), 0),
+      64}));
+  route->publish();
+  return route;
+}
+
+template <typename Fib>
+void fibRouteAdd(uint32_t iters, uint32_t numRoutes) {
+  folly::BenchmarkSuspender suspender;
+  auto fib = std::make_shared<Fib>();
+  for (uint32_t i = 0; i < numRoutes; ++i) {
+    auto route = makeRoute(i);
+    fib->addNode(route->getID(), std::move(route));
+  }
+  fib->publish();
+  std::vector<std::shared_ptr<RouteV6>> routes;
+  routes.reserve(iters);
+  for (uint32_t i = 0; i < iters; ++i) {
+    routes.push_back(makeRoute(numRoutes + i));
+  }
+  // keep every version alive, as a FIB update holds the old and new state
+  std::vector<std::shared_ptr<Fib>> versions;
+  versions.reserve(iters);
+  suspender.dismiss();
+
+  for (auto& route : routes) {
+    auto newFib = fib->clone();
+    newFib->addNode(route->getID(), std::move(route));
+    newFib->publish();
+    versions.push_back(fib);
+    fib = std::move(newFib);
+  }
+
+  suspender.rehire();
+  versions.clear();
+}
+
+void FibRouteAdd(uint32_t iters, uint32_t numRoutes, bool persistent) {
+  if (persistent) {
+    fibRouteAdd<ForwardingInformationBaseV6>(iters, numRoutes);
+  } else {
+    fibRouteAdd<StdMapFib>(iters, numRoutes);
+  }
+}
+} // namespace
+
+BENCHMARK_NAMED_PARAM(FibRouteAdd, stdMap_100k, 100'000, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(FibRouteAdd, persistent_100k, 100'000, true);
+BENCHMARK_NAMED_PARAM(FibRouteAdd, stdMap_500k, 500'000, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(FibRouteAdd, persistent_500k, 500'000, true);
+BENCHMARK_NAMED_PARAM(FibRouteAdd, stdMap_1M, 1'000'000, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(FibRouteAdd, persistent_1M, 1'000'000, true);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
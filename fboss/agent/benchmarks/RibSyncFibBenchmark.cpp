@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Full table resync of a RIB holding --sync_fib_routes routes of a client,
+ * once with syncFib semantics over the entire route set (update() with
+ * resetClientsRoutes) and once streamed through the chunked syncFib API. A
+ * small fraction of the routes is replaced, so the sync both adds and
+ * deletes routes. Time to commit is the benchmark time. The peak RSS growth
+ * during the sync and the time until the first FIB update are logged for
+ * every run.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV6.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/rib/FibUpdateHelpers.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/state/RouteNextHop.h"
+
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+
+DEFINE_int32(sync_fib_routes, 2000000, "Number of routes synced");
+DEFINE_int32(sync_fib_chunk_size, 10000, "Routes per chunked syncFib call");
+
+using namespace facebook::fboss;
+
+namespace {
+
+const RouterID kRid(0);
+const ClientID kClient = ClientID::BGPD;
+// Every kChurnInterval'th route of the client is replaced by the sync
+constexpr auto kChurnInterval = 100;
+const auto kNexthop = folly::IPAddressV6("2401:db00:ffff::1");
+
+UnicastRoute makeRoute(uint32_t index) {
+  folly::ByteArray16 bytes{};
+  bytes[0] = 0x24;
+  bytes[1] = 0x01;
+  for (auto i = 0; i < 4; ++i) {
+    bytes[2 + i] = (index >> (24 - 8 * i)) & 0xff;
+  }
+  UnicastRoute route;
+  route.dest()->ip() = facebook::network::toBinaryAddress(
+      folly::IPAddress(folly::IPAddressV6(bytes)));
+  route.dest()->prefixLength() = 64;
+  NextHopThrift nexthop;
+  nexthop.address() = facebook::network::toBinaryAddress(kNexthop);
+  nexthop.weight() = ECMP_WEIGHT;
+  route.nextHops()->push_back(std::move(nexthop));
+  return route;
+}
+
+// Route indices before and after the sync
+uint32_t initialIndex(uint32_t i) {
+  return i;
+}
+uint32_t syncedIndex(uint32_t i) {
+  return i % kChurnInterval ? i : i + FLAGS_sync_fib_routes;
+}
+
+std::vector<UnicastRoute> makeChunk(
+    uint32_t begin,
+    uint32_t end,
+    uint32_t (*index)(uint32_t)) {
+  std::vector<UnicastRoute> chunk;
+  chunk.reserve(end - begin);
+  for (auto i = begin; i < end; ++i) {
+    chunk.push_back(makeRoute(index(i)));
+  }
+  return chunk;
+}
+
+int64_t readProcStatusKb(const std::string& field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind(field + ":", 0) == 0) {
+      return std::stoll(line.substr(field.size() + 1));
+    }
+  }
+  return 0;
+}
+
+void resetPeakRss() {
+  std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+struct SyncFibRun {
+  std::unique_ptr<RoutingInformationBase> rib;
+  std::chrono::steady_clock::time_point start;
+  std::optional<std::chrono::steady_clock::time_point> firstFibUpdate;
+  FibUpdateFunction fibUpdate;
+};
+
+std::unique_ptr<SyncFibRun> setupRun() {
+  auto run = std::make_unique<SyncFibRun>();
+  run->rib = std::make_unique<RoutingInformationBase>();
+  run->rib->ensureVrf(kRid);
+  run->fibUpdate = [run = run.get()](
+                       const SwitchIdScopeResolver* resolver,
+                       RouterID vrf,
+                       const IPv4NetworkToRouteMap& v4NetworkToRoute,
+                       const IPv6NetworkToRouteMap& v6NetworkToRoute,
+                       const LabelToRouteMap& labelToRoute,
+                       void* cookie) {
+    if (!run->firstFibUpdate) {
+      run->firstFibUpdate = std::chrono::steady_clock::now();
+    }
+    return noopFibUpdate(
+        resolver,
+        vrf,
+        v4NetworkToRoute,
+        v6NetworkToRoute,
+        labelToRoute,
+        cookie);
+  };
+  // Next hop of the synced routes resolves through a static route
+  UnicastRoute nexthopRoute;
+  nexthopRoute.dest()->ip() = facebook::network::toBinaryAddress(
+      folly::IPAddress("2401:db00:ffff::"));
+  nexthopRoute.dest()->prefixLength() = 48;
+  nexthopRoute.action() = RouteForwardAction::DROP;
+  run->rib->update(
+      nullptr,
+      kRid,
+      ClientID::STATIC_ROUTE,
+      AdminDistance::STATIC_ROUTE,
+      {nexthopRoute},
+      {},
+      false,
+      "nexthop route",
+      noopFibUpdate,
+      nullptr);
+  for (auto begin = 0; begin < FLAGS_sync_fib_routes;
+       begin += FLAGS_sync_fib_chunk_size) {
+    auto end =
+        std::min(begin + FLAGS_sync_fib_chunk_size, FLAGS_sync_fib_routes);
+    run->rib->update(
+        nullptr,
+        kRid,
+        kClient,
+        AdminDistance::EBGP,
+        makeChunk(begin, end, initialIndex),
+        {},
+        false,
+        "initial routes",
+        noopFibUpdate,
+        nullptr);
+  }
+  return run;
+}
+
+void syncFib(bool chunked) {
+  folly::BenchmarkSuspender suspender;
+  auto run = setupRun();
+  resetPeakRss();
+  auto baselineKb = readProcStatusKb("VmRSS");
+  run->start = std::chrono::steady_clock::now();
+  suspender.dismiss();
+
+  if (chunked) {
+    run->rib->beginSyncFib(kRid, kClient);
+    for (auto begin = 0; begin < FLAGS_sync_fib_routes;
+         begin += FLAGS_sync_fib_chunk_size) {
+      auto end =
+          std::min(begin + FLAGS_sync_fib_chunk_size, FLAGS_sync_fib_routes);
+      run->rib->addSyncFibRoutes(
+          nullptr,
+          kRid,
+          kClient,
+          AdminDistance::EBGP,
+          makeChunk(begin, end, syncedIndex),
+          run->fibUpdate,
+          nullptr);
+    }
+    run->rib->commitSyncFib(
+        nullptr, kRid, kClient, AdminDistance::EBGP, run->fibUpdate, nullptr);
+  } else {
+    run->rib->update(
+        nullptr,
+        kRid,
+        kClient,
+        AdminDistance::EBGP,
+        makeChunk(0, FLAGS_sync_fib_routes, syncedIndex),
+        {},
+        true,
+        "syncFib",
+        run->fibUpdate,
+        nullptr);
+  }
+
+  suspender.rehire();
+  auto toFirstFibUpdate = run->firstFibUpdate
+      ? std::chrono::duration_cast<std::chrono::milliseconds>(
+            *run->firstFibUpdate - run->start)
+      : std::chrono::milliseconds(0);
+  XLOG(INFO) << (chunked ? "chunked" : "full") << " syncFib of "
+             << FLAGS_sync_fib_routes << " routes, peak RSS growth: "
+             << (readProcStatusKb("VmHWM") - baselineKb) / 1024
+             << " MB, first FIB update after: " << toFirstFibUpdate.count()
+             << " ms";
+  run.reset();
+}
+} // namespace
+
+BENCHMARK(RibFullSyncFib) {
+  syncFib(false);
+}
+
+BENCHMARK(RibChunkedSyncFib) {
+  syncFib(true);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Packets per second and p99 latency of the packets exchanged between the
+ * HwAgent and the SwSwitch, in both directions: trapped packets handed from
+ * the HwAgent to the SwSwitch (RX) and packets handed from the SwSwitch to
+ * the HwAgent to be sent (TX). They go through the thrift packet path
+ * (serialize a multiswitch::RxPacket or TxPacket, hand it to the receiving
+ * thread, deserialize it) or through a shared memory packet ring. Producer
+ * and consumer are threads of one process, so the thrift numbers leave out
+ * the socket and stream overhead and are a lower bound of the real cost.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/MPMCQueue.h>
+#include <gflags/gflags.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "fboss/agent/SwRxPacket.h"
+#include "fboss/agent/TxPacket.h"
+#include "fboss/agent/if/gen-cpp2/multiswitch_ctrl_types.h"
+#include "fboss/agent/mnpu/SharedMemPacketRing.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+DEFINE_uint32(
+    transport_benchmark_pkt_size,
+    128,
+    "Size of the packets sent by the packet transport benchmark");
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr uint32_t kNumPackets = 1000000;
+constexpr uint32_t kQueueDepth = 1024;
+using Direction = SharedMemPacketRing::Direction;
+
+int64_t nowNsecs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+size_t packetSize() {
+  return std::max<size_t>(FLAGS_transport_benchmark_pkt_size, sizeof(int64_t));
+}
+
+// packet carrying its send time in its first bytes
+std::unique_ptr<folly::IOBuf> makePacket() {
+  auto size = packetSize();
+  auto buf = folly::IOBuf::create(size);
+  memset(buf->writableData(), 0, size);
+  buf->append(size);
+  auto sent = nowNsecs();
+  memcpy(buf->writableData(), &sent, sizeof(sent));
+  return buf;
+}
+
+// the SwSwitch side of TX packets
+std::unique_ptr<TxPacket> makeTxPacket() {
+  auto pkt = TxPacket::allocateTxPacket(packetSize());
+  auto* data = pkt->buf()->writableData();
+  memset(data, 0, packetSize());
+  auto sent = nowNsecs();
+  memcpy(data, &sent, sizeof(sent));
+  return pkt;
+}
+
+int64_t latencyNsecs(const folly::IOBuf& buf) {
+  int64_t sent;
+  memcpy(&sent, buf.data(), sizeof(sent));
+  return nowNsecs() - sent;
+}
+
+void reportCounters(
+    folly::UserCounters& counters,
+    std::vector<int64_t>& latencies,
+    std::chrono::steady_clock::duration elapsed) {
+  std::sort(latencies.begin(), latencies.end());
+  auto usecs =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  counters["pps"] = latencies.size() * 1000000 / std::max<int64_t>(usecs, 1);
+  counters["p99_latency_us"] = latencies[latencies.size() * 99 / 100] / 1000;
+}
+
+// serialized packet of the thrift packet path, see
+// SplitAgentThriftSyncer::packetReceived() and
+// SwSwitch::sendPacketOutViaThriftStream()
+std::unique_ptr<folly::IOBuf> serializePacket(Direction direction) {
+  folly::IOBufQueue serialized;
+  if (direction == Direction::RX) {
+    auto pkt = makePacket();
+    multiswitch::RxPacket rxPkt;
+    rxPkt.port() = 1;
+    rxPkt.vlan() = 2000;
+    rxPkt.cosQueue() = CpuCosQueueId::HIPRI;
+    rxPkt.length() = pkt->computeChainDataLength();
+    rxPkt.data() = folly::IOBuf::copyBuffer(pkt->data(), pkt->length());
+    apache::thrift::CompactSerializer::serialize(rxPkt, &serialized);
+  } else {
+    auto pkt = makeTxPacket();
+    multiswitch::TxPacket txPkt;
+    txPkt.port() = 1;
+    txPkt.queue() = 7;
+    txPkt.length() = pkt->buf()->computeChainDataLength();
+    txPkt.data() = Packet::extractIOBuf(std::move(pkt));
+    apache::thrift::CompactSerializer::serialize(txPkt, &serialized);
+  }
+  return serialized.move();
+}
+
+// latency of a deserialized packet, see
+// MultiSwitchThriftHandler::co_notifyRxPacket() and
+// TxPktEventSyncer::TxPacketEventHandler()
+int64_t deserializePacket(Direction direction, const folly::IOBuf* buf) {
+  if (direction == Direction::RX) {
+    auto rxPkt = apache::thrift::CompactSerializer::deserialize<
+        multiswitch::RxPacket>(buf);
+    auto pkt = std::make_unique<SwRxPacket>(std::move(*rxPkt.data()));
+    pkt->setSrcPort(PortID(*rxPkt.port()));
+    pkt->setSrcVlan(VlanID(*rxPkt.vlan()));
+    pkt->setCosQueue(static_cast<uint8_t>(*rxPkt.cosQueue()));
+    pkt->buf()->coalesce();
+    return latencyNsecs(*pkt->buf());
+  }
+  auto txPkt =
+      apache::thrift::CompactSerializer::deserialize<multiswitch::TxPacket>(
+          buf);
+  // stands in for the packet the HwAgent allocates and sends
+  auto data = std::move(*txPkt.data());
+  data->coalesce();
+  return latencyNsecs(*data);
+}
+
+void thriftTransport(Direction direction, folly::UserCounters& counters) {
+  folly::BenchmarkSuspender suspender;
+  // stands in for the RX packet sink or the TX packet stream
+  folly::MPMCQueue<std::unique_ptr<folly::IOBuf>> queue(kQueueDepth);
+  std::vector<int64_t> latencies;
+  latencies.reserve(kNumPackets);
+  suspender.dismiss();
+
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&queue, direction]() {
+    for (uint32_t i = 0; i < kNumPackets; ++i) {
+      queue.blockingWrite(serializePacket(direction));
+    }
+  });
+  for (uint32_t i = 0; i < kNumPackets; ++i) {
+    std::unique_ptr<folly::IOBuf> serialized;
+    queue.blockingRead(serialized);
+    latencies.push_back(deserializePacket(direction, serialized.get()));
+  }
+  producer.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  suspender.rehire();
+  reportCounters(counters, latencies, elapsed);
+}
+
+void shmTransport(Direction direction, folly::UserCounters& counters) {
+  folly::BenchmarkSuspender suspender;
+  auto name = folly::to<std::string>(
+      "/fboss_pkt_transport_benchmark_",
+      getpid(),
+      direction == Direction::RX ? "_rx" : "_tx");
+  // the HwAgent creates the rings of both directions
+  auto hwAgentRing = SharedMemPacketRing::create(name, kQueueDepth);
+  auto swSwitchRing = SharedMemPacketRing::attach(name);
+  auto* producerRing =
+      direction == Direction::RX ? hwAgentRing.get() : swSwitchRing.get();
+  auto* consumerRing =
+      direction == Direction::RX ? swSwitchRing.get() : hwAgentRing.get();
+  std::vector<int64_t> latencies;
+  latencies.reserve(kNumPackets);
+  suspender.dismiss();
+
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([producerRing, direction]() {
+    SharedMemPacketRing::PacketMeta meta;
+    meta.port = 1;
+    if (direction == Direction::RX) {
+      meta.vlan = 2000;
+      meta.queue = static_cast<int32_t>(CpuCosQueueId::HIPRI);
+    } else {
+      meta.queue = 7;
+    }
+    for (uint32_t i = 0; i < kNumPackets; ++i) {
+      // See MultiSwitchPacketRings::sendPacket() for TX packets
+      std::unique_ptr<folly::IOBuf> rxPkt;
+      std::unique_ptr<TxPacket> txPkt;
+      if (direction == Direction::RX) {
+        rxPkt = makePacket();
+      } else {
+        txPkt = makeTxPacket();
+      }
+      const auto& buf = rxPkt ? *rxPkt : *txPkt->buf();
+      while (!producerRing->push(meta, buf)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  auto handlePacket = [&latencies, direction](
+                          const SharedMemPacketRing::PacketMeta& meta,
+                          folly::ByteRange data) {
+    if (direction == Direction::RX) {
+      // See MultiSwitchPacketRings::rxLoop()
+      auto pkt = std::make_unique<SwRxPacket>(
+          folly::IOBuf::copyBuffer(data.data(), data.size()));
+      pkt->setSrcPort(PortID(meta.port));
+      pkt->setSrcVlan(VlanID(meta.vlan));
+      pkt->setCosQueue(static_cast<uint8_t>(meta.queue));
+      latencies.push_back(latencyNsecs(*pkt->buf()));
+    } else {
+      // See SplitAgentThriftSyncer::sendTxPktFromRing(), the packet the
+      // HwAgent allocates and sends
+      auto buf = folly::IOBuf::create(data.size());
+      memcpy(buf->writableData(), data.data(), data.size());
+      buf->append(data.size());
+      latencies.push_back(latencyNsecs(*buf));
+    }
+  };
+  while (latencies.size() < kNumPackets) {
+    while (consumerRing->pop(handlePacket)) {
+    }
+    if (latencies.size() == kNumPackets) {
+      break;
+    }
+    consumerRing->wait(std::chrono::milliseconds(100));
+  }
+  producer.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  suspender.rehire();
+  reportCounters(counters, latencies, elapsed);
+}
+} // namespace
+
+BENCHMARK_COUNTERS(SplitAgentRxPacketThrift, counters) {
+  thriftTransport(Direction::RX, counters);
+}
+
+BENCHMARK_COUNTERS(SplitAgentRxPacketSharedMemRing, counters) {
+  shmTransport(Direction::RX, counters);
+}
+
+BENCHMARK_COUNTERS(SplitAgentTxPacketThrift, counters) {
+  thriftTransport(Direction::TX, counters);
+}
+
+BENCHMARK_COUNTERS(SplitAgentTxPacketSharedMemRing, counters) {
+  shmTransport(Direction::TX, counters);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Replays a mixed stream of state updates through SwSwitch: a large number
+ * of coalescing "route" updates, interleaved with high priority "neighbor"
+ * updates and non coalescing "link flap" updates, and reports the time to
+ * drain the stream for a few batching policies. The number of batches and
+ * the worst case queueing latency of the neighbor updates are logged for
+ * every run.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/StateUpdateBatchingPolicy.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/single/MonolithicHwSwitchHandler.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <atomic>
+#include <chrono>
+
+DEFINE_int32(
+    replay_route_updates,
+    10000,
+    "Number of route updates in the replayed stream");
+DEFINE_int32(
+    replay_neighbor_update_interval,
+    50,
+    "Queue a neighbor update after every N route updates");
+DEFINE_int32(
+    replay_link_flap_interval,
+    1000,
+    "Queue a link flap update after every N route updates");
+
+using namespace facebook::fboss;
+using folly::MacAddress;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+unique_ptr<SimPlatform> simPlatform;
+unique_ptr<SwSwitch> sw;
+
+class ReplayBatchingPolicy : public StateUpdateBatchingPolicy {
+ public:
+  ReplayBatchingPolicy(
+      size_t maxBatchSize,
+      std::chrono::milliseconds maxBatchDuration,
+      std::chrono::milliseconds linger,
+      bool priorityLanes)
+      : maxBatchSize_(maxBatchSize),
+        maxBatchDuration_(maxBatchDuration),
+        linger_(linger),
+        priorityLanes_(priorityLanes) {}
+
+  size_t getMaxBatchSize() const override {
+    return maxBatchSize_;
+  }
+  std::chrono::milliseconds getMaxBatchDuration() const override {
+    return maxBatchDuration_;
+  }
+  std::chrono::milliseconds getLingerDuration() const override {
+    return linger_;
+  }
+  bool usePriorityLanes() const override {
+    return priorityLanes_;
+  }
+
+ private:
+  size_t maxBatchSize_;
+  std::chrono::milliseconds maxBatchDuration_;
+  std::chrono::milliseconds linger_;
+  bool priorityLanes_;
+};
+
+class BatchCounter : public StateObserver {
+ public:
+  void stateUpdated(const StateDelta& /*delta*/) override {
+    ++batches;
+  }
+  std::atomic<int> batches{0};
+};
+
+unique_ptr<SwSwitch> setupSwitch() {
+  MacAddress localMac("02:00:01:00:00:01");
+  simPlatform = make_unique<SimPlatform>(localMac, 10);
+  auto sw = make_unique<SwSwitch>(
+      [platform = simPlatform.get()](
+          const SwitchID& switchId, const cfg::SwitchInfo& info, SwSwitch* sw) {
+        return std::make_unique<facebook::fboss::MonolithicHwSwitchHandler>(
+            platform, switchId, info, sw);
+      },
+      simPlatform->getDirectoryUtil(),
+      simPlatform->supportsAddRemovePort(),
+      nullptr);
+  sw->init(nullptr /* No custom TunManager */, mockHwSwitchInitFn(sw.get()));
+  return sw;
+}
+
+SwSwitch::StateUpdateFn addAclFn(int priority) {
+  return [priority](const shared_ptr<SwitchState>& state) {
+    auto newState = state->clone();
+    auto acls = newState->getAcls()->modify(&newState);
+    auto name = folly::to<std::string>("acl", priority);
+    if (acls->getNodeIf(name)) {
+      acls->removeNode(name);
+    }
+    acls->addNode(
+        std::make_shared<AclEntry>(priority, name),
+        HwSwitchMatcher::defaultHwSwitchMatcher());
+    return newState;
+  };
+}
+
+void replayMixedStream(std::shared_ptr<const StateUpdateBatchingPolicy> policy) {
+  shared_ptr<SwitchState> origState;
+  BatchCounter batchCounter;
+  // Updated from the update thread only
+  std::chrono::microseconds maxNeighborLatency{0};
+  BENCHMARK_SUSPEND {
+    origState = sw->getState();
+    sw->setStateUpdateBatchingPolicy(std::move(policy));
+    sw->registerStateObserver(&batchCounter, "BatchCounter");
+  }
+
+  constexpr int kNeighborPriorityBase = 1000000;
+  constexpr int kLinkPriorityBase = 2000000;
+  for (int i = 0; i < FLAGS_replay_route_updates; ++i) {
+    sw->updateState("route update", addAclFn(i));
+    if (i % FLAGS_replay_neighbor_update_interval == 0) {
+      auto queuedAt = std::chrono::steady_clock::now();
+      auto addNeighborFn = addAclFn(kNeighborPriorityBase + i % 64);
+      sw->updateStateHighPriority(
+          "neighbor update",
+          [queuedAt, addNeighborFn, &maxNeighborLatency](
+              const shared_ptr<SwitchState>& state) {
+            maxNeighborLatency = std::max(
+                maxNeighborLatency,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - queuedAt));
+            return addNeighborFn(state);
+          });
+    }
+    if (i % FLAGS_replay_link_flap_interval == 0) {
+      sw->updateStateHighPriority(
+          "link flap",
+          addAclFn(kLinkPriorityBase + i % 2),
+          false /* allowCoalescing */);
+    }
+  }
+  waitForStateUpdates(sw.get());
+
+  BENCHMARK_SUSPEND {
+    sw->unregisterStateObserver(&batchCounter);
+    XLOG(INFO) << "Replayed " << FLAGS_replay_route_updates
+               << " route updates in " << batchCounter.batches.load()
+               << " batches, max neighbor update latency: "
+               << maxNeighborLatency.count() << "us";
+    sw->updateStateBlocking(
+        "restore state", [origState](const shared_ptr<SwitchState>&) {
+          return origState;
+        });
+    sw->setStateUpdateBatchingPolicy(
+        std::make_shared<StateUpdateBatchingPolicy>());
+  }
+}
+
+} // unnamed namespace
+
+BENCHMARK(MixedUpdateStreamUnbounded) {
+  replayMixedStream(std::make_shared<ReplayBatchingPolicy>(
+      0, std::chrono::milliseconds(0), std::chrono::milliseconds(0), false));
+}
+
+BENCHMARK(MixedUpdateStreamBatch256) {
+  replayMixedStream(std::make_shared<ReplayBatchingPolicy>(
+      256, std::chrono::milliseconds(0), std::chrono::milliseconds(0), false));
+}
+
+BENCHMARK(MixedUpdateStreamBatch256PriorityLanes) {
+  replayMixedStream(std::make_shared<ReplayBatchingPolicy>(
+      256, std::chrono::milliseconds(0), std::chrono::milliseconds(0), true));
+}
+
+BENCHMARK(MixedUpdateStreamBudget10msPriorityLanes) {
+  replayMixedStream(std::make_shared<ReplayBatchingPolicy>(
+      0, std::chrono::milliseconds(10), std::chrono::milliseconds(0), true));
+}
+
+BENCHMARK(MixedUpdateStreamBatch256Linger2msPriorityLanes) {
+  replayMixedStream(std::make_shared<ReplayBatchingPolicy>(
+      256, std::chrono::milliseconds(0), std::chrono::milliseconds(2), true));
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  sw = setupSwitch();
+  folly::runBenchmarks();
+  sw.reset();
+  return 0;
+}
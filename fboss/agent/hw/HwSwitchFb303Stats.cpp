@@ -55,6 +55,11 @@ HwSwitchFb303Stats::HwSwitchFb303Stats(
           getCounterPrefix() + vendor + ".tx.pkt.allocation.errors",
           SUM,
           RATE),
+      rxPktQueueFullDrops_(
+          map,
+          getCounterPrefix() + vendor + ".rx.pkt.queue_full.drops",
+          SUM,
+          RATE),
       txQueued_(
           map,
           getCounterPrefix() + vendor + ".tx.pkt.queued_us",
@@ -1116,6 +1121,8 @@ HwSwitchFb303GlobalStats HwSwitchFb303Stats::getAllFb303Stats() const {
   hwFb303Stats.tx_errors() = getCumulativeValue(txErrors_);
   hwFb303Stats.tx_pkt_allocation_errors() =
       getCumulativeValue(txPktAllocErrors_);
+  hwFb303Stats.rx_pkt_queue_full_drops() =
+      getCumulativeValue(rxPktQueueFullDrops_);
   hwFb303Stats.parity_errors() = getCumulativeValue(parityErrors_);
   hwFb303Stats.parity_corr() = getCumulativeValue(corrParityErrors_);
   hwFb303Stats.parity_uncorr() = getCumulativeValue(uncorrParityErrors_);
@@ -1165,6 +1172,10 @@ void HwSwitchFb303Stats::updateStats(HwSwitchFb303GlobalStats& globalStats) {
   updateValue(txSentDone_, *globalStats.tx_pkt_sent_done());
   updateValue(txErrors_, *globalStats.tx_errors());
   updateValue(txPktAllocErrors_, *globalStats.tx_pkt_allocation_errors());
+  if (globalStats.rx_pkt_queue_full_drops().has_value()) {
+    updateValue(
+        rxPktQueueFullDrops_, *globalStats.rx_pkt_queue_full_drops());
+  }
   updateValue(parityErrors_, *globalStats.parity_errors());
   updateValue(corrParityErrors_, *globalStats.parity_corr());
   updateValue(uncorrParityErrors_, *globalStats.parity_uncorr());
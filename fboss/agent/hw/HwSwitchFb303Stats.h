@@ -48,6 +48,9 @@ class HwSwitchFb303Stats {
     txErrors_.addValue(1);
     txPktAllocErrors_.addValue(1);
   }
+  void rxPktQueueFullDrop() {
+    rxPktQueueFullDrops_.addValue(1);
+  }
 
   void corrParityError() {
     parityErrors_.addValue(1);
@@ -308,6 +311,9 @@ class HwSwitchFb303Stats {
   int64_t getTxPktAllocErrorsCount() const {
     return txPktAllocErrors_.count();
   }
+  int64_t getRxPktQueueFullDropsCount() const {
+    return rxPktQueueFullDrops_.count();
+  }
   int64_t getCorrParityErrorCount() const {
     return corrParityErrors_.count();
   }
@@ -434,6 +440,8 @@ class HwSwitchFb303Stats {
   // Errors in sending packets
   TLTimeseries txErrors_;
   TLTimeseries txPktAllocErrors_;
+  // Trapped packets dropped as the rx burst queue was full
+  TLTimeseries rxPktQueueFullDrops_;
 
   // Time spent for each Tx packet queued in HW
   TLHistogram txQueued_;
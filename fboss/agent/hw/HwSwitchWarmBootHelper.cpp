@@ -22,6 +22,7 @@
 
 #include <utility>
 #include "fboss/agent/state/SwitchState.h"
+#include "fboss/lib/BinaryDynamic.h"
 #include "fboss/lib/CommonFileUtils.h"
 #include "fboss/lib/WarmBootFileUtils.h"
 
@@ -30,6 +31,13 @@ DEFINE_string(
     "switch_state",
     "File for dumping switch state JSON in on exit, it maintains only hardware switch");
 
+DEFINE_bool(
+    hw_switch_state_binary,
+    false,
+    "Store hardware switch warm boot state in a binary encoding that can be "
+    "memory mapped and partially decoded on warm boot, instead of JSON. "
+    "Either encoding is read back on warm boot");
+
 namespace {
 constexpr auto wbFlagPrefix = "can_warm_boot_";
 constexpr auto forceColdBootPrefix = "hw_cold_boot_once_";
@@ -81,8 +89,25 @@ HwSwitchWarmBootHelper::~HwSwitchWarmBootHelper() {
 }
 
 std::string HwSwitchWarmBootHelper::warmBootHwSwitchStateFile() const {
+  return warmBootHwSwitchStateFile(warmBootDir_, switchId_);
+}
+
+std::string HwSwitchWarmBootHelper::warmBootHwSwitchBinaryStateFile() const {
+  return warmBootHwSwitchBinaryStateFile(warmBootDir_, switchId_);
+}
+
+std::string HwSwitchWarmBootHelper::warmBootHwSwitchStateFile(
+    const std::string& warmBootDir,
+    int switchId) {
+  return folly::to<std::string>(
+      warmBootDir, "/", FLAGS_switch_state_file, "_", switchId);
+}
+
+std::string HwSwitchWarmBootHelper::warmBootHwSwitchBinaryStateFile(
+    const std::string& warmBootDir,
+    int switchId) {
   return folly::to<std::string>(
-      warmBootDir_, "/", FLAGS_switch_state_file, "_", switchId_);
+      warmBootHwSwitchStateFile(warmBootDir, switchId), ".bin");
 }
 
 std::string HwSwitchWarmBootHelper::warmBootThriftSwitchStateFile() const {
@@ -150,11 +175,26 @@ void HwSwitchWarmBootHelper::storeHwSwitchWarmBootState(
                   << file;
     }
   };
-  dumpStateToFileFn(warmBootHwSwitchStateFile(), switchState);
+  // only one encoding is kept, so a stale file of the other is never read
+  if (FLAGS_hw_switch_state_binary) {
+    try {
+      BinaryDynamicFile::write(warmBootHwSwitchBinaryStateFile(), switchState);
+    } catch (const std::exception& ex) {
+      XLOG(FATAL) << "Error while storing switch state to binary state file: "
+                  << warmBootHwSwitchBinaryStateFile() << ": " << ex.what();
+    }
+    removeFile(warmBootHwSwitchStateFile());
+  } else {
+    dumpStateToFileFn(warmBootHwSwitchStateFile(), switchState);
+    removeFile(warmBootHwSwitchBinaryStateFile());
+  }
   setCanWarmBoot();
 }
 
 folly::dynamic HwSwitchWarmBootHelper::getHwSwitchWarmBootState() const {
+  if (auto binaryState = getBinaryHwSwitchWarmBootState()) {
+    return binaryState->root().toDynamic();
+  }
   bool wbStateFileExists = checkFileExists(warmBootHwSwitchStateFile());
   if (wbStateFileExists) {
     return getHwSwitchWarmBootState(warmBootHwSwitchStateFile());
@@ -162,6 +202,16 @@ folly::dynamic HwSwitchWarmBootHelper::getHwSwitchWarmBootState() const {
   throw FbossError("No hw switch warm boot state file found");
 }
 
+std::unique_ptr<BinaryDynamicFile>
+HwSwitchWarmBootHelper::getBinaryHwSwitchWarmBootState() const {
+  auto fileName = warmBootHwSwitchBinaryStateFile();
+  if (!checkFileExists(fileName)) {
+    return nullptr;
+  }
+  XLOG(INFO) << "mapping binary hw switch warm boot state from : " << fileName;
+  return std::make_unique<BinaryDynamicFile>(fileName);
+}
+
 folly::dynamic HwSwitchWarmBootHelper::getHwSwitchWarmBootState(
     const std::string& fileName) const {
   std::string warmBootJson;
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <folly/json/dynamic.h>
+#include <memory>
 #include <string>
 #include "fboss/agent/gen-cpp2/switch_state_types.h"
 
@@ -24,6 +25,7 @@ namespace facebook::fboss {
  */
 
 class SwitchState;
+class BinaryDynamicFile;
 
 class HwSwitchWarmBootHelper {
  public:
@@ -51,6 +53,22 @@ class HwSwitchWarmBootHelper {
 
   folly::dynamic getHwSwitchWarmBootState() const;
 
+  /*
+   * Memory mapped hw switch state, when it was stored in binary form, so
+   * callers can decode just the parts they need. Null if the state was
+   * stored as JSON.
+   */
+  std::unique_ptr<BinaryDynamicFile> getBinaryHwSwitchWarmBootState() const;
+
+  std::string warmBootHwSwitchStateFile() const;
+  std::string warmBootHwSwitchBinaryStateFile() const;
+  static std::string warmBootHwSwitchStateFile(
+      const std::string& warmBootDir,
+      int switchId);
+  static std::string warmBootHwSwitchBinaryStateFile(
+      const std::string& warmBootDir,
+      int switchId);
+
   // bcm switch specific
   std::string startupSdkDumpFile() const;
   // bcm switch specific
@@ -81,7 +99,6 @@ class HwSwitchWarmBootHelper {
 
   std::string warmBootFlag() const;
   std::string forceColdBootOnceFlag() const;
-  std::string warmBootHwSwitchStateFile() const;
   std::string warmBootThriftSwitchStateFile() const;
 
   void setupWarmBootFile();
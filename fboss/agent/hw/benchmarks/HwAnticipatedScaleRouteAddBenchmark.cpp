@@ -17,4 +17,9 @@ namespace facebook::fboss {
 ROUTE_ADD_BENCHMARK(
     HwHgridUUAnticipatedScaleRouteAddBenchmark,
     utility::AnticipatedRouteScaleGenerator);
+
+ROUTE_ADD_DEL_BULK_BENCHMARK(
+    HwHgridUUAnticipatedScaleRouteAddBulkBenchmark,
+    utility::AnticipatedRouteScaleGenerator,
+    true /* measureAdd */);
 } // namespace facebook::fboss
@@ -17,4 +17,9 @@ namespace facebook::fboss {
 ROUTE_DEL_BENCHMARK(
     HwHgridUUAnticipatedScaleRouteDelBenchmark,
     utility::AnticipatedRouteScaleGenerator);
+
+ROUTE_ADD_DEL_BULK_BENCHMARK(
+    HwHgridUUAnticipatedScaleRouteDelBulkBenchmark,
+    utility::AnticipatedRouteScaleGenerator,
+    false /* measureAdd */);
 } // namespace facebook::fboss
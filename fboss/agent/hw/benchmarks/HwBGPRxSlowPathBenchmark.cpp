@@ -11,4 +11,9 @@ BENCHMARK(BgpRxSlowPathRouteChangePortFlapBenchmark) {
   rxSlowPathBGPRouteChangeBenchmark(
       utility::BgpRxMode::routeProgrammingWithPortFlap);
 }
+
+BENCHMARK(BgpRxSlowPathRouteChangeArpFloodBenchmark) {
+  rxSlowPathBGPRouteChangeBenchmark(
+      utility::BgpRxMode::routeProgrammingWithArpFlood);
+}
 } // namespace facebook::fboss
@@ -1,6 +1,7 @@
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/benchmarks/AgentBenchmarks.h"
 #include "fboss/agent/packet/PktFactory.h"
+#include "fboss/agent/state/StateUtils.h"
 #include "fboss/agent/test/AgentEnsemble.h"
 #include "fboss/agent/test/EcmpSetupHelper.h"
 #include "fboss/agent/test/RouteScaleGenerators.h"
@@ -14,7 +15,12 @@ const std::string kDstIp = "2620:0:1cfe:face:b00c::4";
 }; // namespace
 
 namespace facebook::fboss::utility {
-enum BgpRxMode { routeProgramming, routeProgrammingWithPortFlap };
+enum BgpRxMode {
+  routeProgramming,
+  routeProgrammingWithPortFlap,
+  // concurrent ARP request flood on the high priority CPU queue
+  routeProgrammingWithArpFlood,
+};
 
 void rxSlowPathBGPRouteChangeBenchmark(BgpRxMode mode) {
   auto ensemble = createAgentEnsemble(
@@ -62,6 +68,23 @@ void rxSlowPathBGPRouteChangeBenchmark(BgpRxMode mode) {
     ensemble->getSw()->sendPacketSwitchedAsync(std::move(txPacket));
   }
 
+  if (mode == routeProgrammingWithArpFlood) {
+    // broadcast ARP requests flood the vlan and loop back to the CPU
+    auto intf =
+        utility::firstInterfaceWithPorts(ensemble->getProgrammedState());
+    for (int i = 0; i < kPacketToSend; i++) {
+      auto txPacket = utility::makeARPTxPacket(
+          ensemble->getSw(),
+          vlanId,
+          intf->getMac(),
+          folly::MacAddress::BROADCAST,
+          folly::IPAddressV4("8.8.8.7"),
+          folly::IPAddressV4("8.8.8.8"),
+          ARP_OPER::ARP_OPER_REQUEST);
+      ensemble->getSw()->sendPacketSwitchedAsync(std::move(txPacket));
+    }
+  }
+
   constexpr auto kBurnIntevalInSeconds = 10;
   // Let the packet flood warm up
   std::this_thread::sleep_for(std::chrono::seconds(kBurnIntevalInSeconds));
@@ -84,6 +107,10 @@ void rxSlowPathBGPRouteChangeBenchmark(BgpRxMode mode) {
   auto statsBefore = cpuStatsBefore[0];
   auto [pktsBefore, bytesBefore] = utility::getCpuQueueOutPacketsAndBytes(
       *statsBefore.portStats_(), kCpuQueue);
+  auto arpCpuQueue = utility::getCoppHighPriQueueId(ensemble->getL3Asics());
+  auto arpPktsBefore = utility::getCpuQueueOutPacketsAndBytes(
+                           *statsBefore.portStats_(), arpCpuQueue)
+                           .first;
   auto timeBefore = std::chrono::steady_clock::now();
   CHECK_NE(pktsBefore, 0);
 
@@ -101,6 +128,9 @@ void rxSlowPathBGPRouteChangeBenchmark(BgpRxMode mode) {
   auto statsAfter = cpuStatsAfter[0];
   auto [pktsAfter, bytesAfter] = utility::getCpuQueueOutPacketsAndBytes(
       *statsAfter.portStats_(), kCpuQueue);
+  auto arpPktsAfter = utility::getCpuQueueOutPacketsAndBytes(
+                          *statsAfter.portStats_(), arpCpuQueue)
+                          .first;
   auto timeAfter = std::chrono::steady_clock::now();
   std::chrono::duration<double, std::milli> durationMillseconds =
       timeAfter - timeBefore;
@@ -111,6 +141,9 @@ void rxSlowPathBGPRouteChangeBenchmark(BgpRxMode mode) {
       (static_cast<double>(bytesAfter - bytesBefore) /
        durationMillseconds.count()) *
       1000;
+  uint32_t arpPPS = (static_cast<double>(arpPktsAfter - arpPktsBefore) /
+                     durationMillseconds.count()) *
+      1000;
 
   if (mode == routeProgrammingWithPortFlap) {
     CHECK(portFlapHelper);
@@ -121,12 +154,16 @@ void rxSlowPathBGPRouteChangeBenchmark(BgpRxMode mode) {
     folly::dynamic cpuRxRateJson = folly::dynamic::object;
     cpuRxRateJson["cpu_rx_pps"] = bgpRouteAddPPS;
     cpuRxRateJson["cpu_rx_bytes_per_sec"] = bgpRouteAddBytesPerSec;
+    if (mode == routeProgrammingWithArpFlood) {
+      cpuRxRateJson["arp_cpu_rx_pps"] = arpPPS;
+    }
     std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   } else {
     XLOG(DBG2) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
                << " pps: " << bgpRouteAddPPS
-               << " bytes per sec: " << bgpRouteAddBytesPerSec;
+               << " bytes per sec: " << bgpRouteAddBytesPerSec
+               << " arp pps: " << arpPPS;
     XLOG(DBG2) << " BGP route add worst case lookup msecs: "
                << bgpRouteAddWorstCaseLookupMsecs
                << " BGP route add worst case bulk lookup msecs: "
@@ -18,13 +18,33 @@
 
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
+#include <folly/logging/xlog.h>
 
+#include <atomic>
 #include <thread>
 
+DEFINE_bool(
+    ecmp_shrink_competing_stats_collection,
+    false,
+    "Also collect stats continuously while routes are programmed, and report "
+    "SAI api lock contention");
+
 namespace facebook::fboss {
 
+namespace {
+void reportApiLockContention() {
+  // published by stats collection on SAI switches
+  for (const auto& [name, value] : fb303::fbData->getCounters()) {
+    if (name.find("sai_api_lock.") == 0) {
+      XLOG(INFO) << name << " : " << value;
+    }
+  }
+}
+} // namespace
+
 using utility::getEcmpSizeInHw;
 
 BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
@@ -67,9 +87,19 @@ BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
                          RouterID(0))
                          .getThriftRoutes();
 
-  std::thread t([&ensemble, &routeChunks]() {
+  std::atomic<bool> routesProgrammed{false};
+  std::thread t([&ensemble, &routeChunks, &routesProgrammed]() {
     ensemble->programRoutes(RouterID(0), ClientID::BGPD, routeChunks);
+    routesProgrammed = true;
   });
+  std::thread statsThread;
+  if (FLAGS_ecmp_shrink_competing_stats_collection) {
+    statsThread = std::thread([&ensemble, &routesProgrammed]() {
+      while (!routesProgrammed) {
+        ensemble->getSw()->updateStats();
+      }
+    });
+  }
 
   // Toggle loopback mode via direct SDK calls rathe than going through
   // applyState interface. We want to start the clock ASAP post the link toggle,
@@ -110,6 +140,10 @@ BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
     suspender.rehire();
   }
   t.join();
+  if (statsThread.joinable()) {
+    statsThread.join();
+    reportApiLockContention();
+  }
 }
 
 } // namespace facebook::fboss
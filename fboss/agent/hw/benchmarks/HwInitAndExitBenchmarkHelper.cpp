@@ -14,6 +14,7 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/benchmarks/AgentBenchmarks.h"
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwTestCoppUtils.h"
@@ -25,10 +26,16 @@
 #include "fboss/agent/test/utils/FabricTestUtils.h"
 #include "fboss/agent/test/utils/VoqTestUtils.h"
 
+#include "fboss/lib/BinaryDynamic.h"
+#include "fboss/lib/CommonFileUtils.h"
 #include "fboss/lib/FunctionCallTimeReporter.h"
 
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 
+#include <folly/FileUtil.h>
+#include <folly/json/json.h>
+#include <folly/logging/xlog.h>
+
 using namespace facebook::fboss;
 
 namespace facebook::fboss::utility {
@@ -159,6 +166,49 @@ utility::RouteDistributionGenerator::ThriftRouteChunks getRoutes(
   }
 }
 
+/*
+ * Time decoding the hw switch warm boot state this run warm booted from, both
+ * as JSON and in the binary encoding, from copies written in each encoding.
+ */
+void reportHwSwitchStateLoadTimes(const AgentEnsemble* ensemble) {
+  auto switchIds = ensemble->getSw()->getHwAsicTable()->getSwitchIDs();
+  CHECK_GE(switchIds.size(), 1);
+  auto switchIndex =
+      ensemble->getSw()->getSwitchInfoTable().getSwitchIndexFromSwitchId(
+          *switchIds.cbegin());
+  auto warmBootDir = ensemble->getSw()->getDirUtil()->getWarmBootDir();
+  auto jsonFile = HwSwitchWarmBootHelper::warmBootHwSwitchStateFile(
+      warmBootDir, switchIndex);
+  auto binaryFile = HwSwitchWarmBootHelper::warmBootHwSwitchBinaryStateFile(
+      warmBootDir, switchIndex);
+
+  folly::dynamic state;
+  std::string contents;
+  if (checkFileExists(binaryFile)) {
+    state = BinaryDynamicFile(binaryFile).root().toDynamic();
+  } else if (folly::readFile(jsonFile.c_str(), contents)) {
+    state = folly::parseJson(contents);
+  } else {
+    XLOG(WARN) << "No hw switch warm boot state found in " << warmBootDir;
+    return;
+  }
+  auto jsonCopy = folly::to<std::string>(jsonFile, ".benchmark");
+  auto binaryCopy = folly::to<std::string>(binaryFile, ".benchmark");
+  CHECK(dumpStateToFile(jsonCopy, state));
+  BinaryDynamicFile::write(binaryCopy, state);
+  {
+    StopWatch timer("hw_switch_state_load_json_msecs", FLAGS_json);
+    CHECK(folly::readFile(jsonCopy.c_str(), contents));
+    folly::parseJson(contents);
+  }
+  {
+    StopWatch timer("hw_switch_state_load_binary_msecs", FLAGS_json);
+    BinaryDynamicFile(binaryCopy).root().toDynamic();
+  }
+  removeFile(jsonCopy);
+  removeFile(binaryCopy);
+}
+
 void initAndExitBenchmarkHelper(
     cfg::PortSpeed uplinkSpeed,
     cfg::PortSpeed downlinkSpeed,
@@ -338,6 +388,9 @@ void initAndExitBenchmarkHelper(
     auto updater = ensemble->getSw()->getRouteUpdater();
     ensemble->programRoutes(RouterID(0), ClientID::BGPD, routeChunks);
   }
+  if (ensemble->getBootType() == BootType::WARM_BOOT) {
+    reportHwSwitchStateLoadTimes(ensemble.get());
+  }
 
   // Block until the stats thread exits. This can take ~0.7s, so pull it
   // outside the stopwatch.
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/rib/FibUpdateHelpers.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/test/RouteGeneratorTestUtils.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+
+#include "fboss/agent/benchmarks/AgentBenchmarks.h"
+
+#include <folly/Benchmark.h>
+
+namespace facebook::fboss {
+
+namespace {
+const folly::CIDRNetwork kAnchorPrefix{folly::IPAddress("100.0.0.0"), 24};
+
+UnicastRoute makeRoute(
+    const folly::CIDRNetwork& network,
+    const folly::IPAddress& nexthop) {
+  UnicastRoute route;
+  route.dest() = toIpPrefix(network);
+  route.action() = RouteForwardAction::NEXTHOPS;
+  route.adminDistance() = AdminDistance::EBGP;
+  route.nextHops() = {
+      NextHop(UnresolvedNextHop(nexthop, ECMP_WEIGHT)).toThrift()};
+  return route;
+}
+
+struct ScaleRib {
+  std::unique_ptr<AgentEnsemble> ensemble;
+  std::map<int32_t, state::RouteTableFields> initialRib;
+  utility::RouteDistributionGenerator::ThriftRouteChunks routeChunks;
+};
+
+const ScaleRib& getScaleRib() {
+  static const auto scaleRib = []() {
+    ScaleRib rib;
+    AgentEnsembleSwitchConfigFn initialConfigFn =
+        [](const AgentEnsemble& ensemble) {
+          auto ports = ensemble.masterLogicalPortIds();
+          CHECK_GT(ports.size(), 0);
+          return utility::onePortPerInterfaceConfig(ensemble.getSw(), ports);
+        };
+    rib.ensemble = createAgentEnsemble(
+        initialConfigFn, false /*disableLinkStateToggler*/);
+    utility::THAlpmRouteScaleGenerator gen(
+        rib.ensemble->getSw()->getState(),
+        rib.ensemble->getSw()->needL2EntryForNeighbor());
+    rib.routeChunks = gen.getThriftRoutes();
+    rib.initialRib = rib.ensemble->getSw()->getRib()->toThrift();
+    return rib;
+  }();
+  return scaleRib;
+}
+} // namespace
+
+/*
+ * Resolution cost of flapping a single route, as a function of the number
+ * of routes recursively resolving through it. The table also holds the TH
+ * ALPM scale routes, which are unaffected by the flap. With incremental
+ * resolution the cost should track numAffected rather than the table size.
+ */
+void RibIncrementalResolution(
+    uint32_t /* iters */,
+    bool incremental,
+    uint32_t numAffected) {
+  folly::BenchmarkSuspender suspender;
+  FLAGS_rib_incremental_resolution = incremental;
+  const auto& scaleRib = getScaleRib();
+  // Resolution only, leave FIB programming out of the measurement
+  auto rib =
+      RoutingInformationBase::fromThrift(scaleRib.initialRib, nullptr, nullptr);
+  auto resolver = scaleRib.ensemble->getSw()->getScopeResolver();
+  auto update = [&](const std::vector<UnicastRoute>& toAdd,
+                    const std::vector<IpPrefix>& toDel) {
+    rib->update(
+        resolver,
+        RouterID(0),
+        ClientID::BGPD,
+        AdminDistance::EBGP,
+        toAdd,
+        toDel,
+        false,
+        "incremental resolution",
+        noopFibUpdate,
+        nullptr);
+  };
+  for (const auto& routeChunk : scaleRib.routeChunks) {
+    update(routeChunk, {});
+  }
+  // Anchor resolves via the next hop of a scale route, dependents via the
+  // anchor
+  auto anchorNexthop = network::toIPAddress(
+      *scaleRib.routeChunks.front().front().nextHops()->front().address());
+  auto anchor = makeRoute(kAnchorPrefix, anchorNexthop);
+  std::vector<UnicastRoute> dependents;
+  dependents.reserve(numAffected);
+  for (uint32_t i = 0; i < numAffected; ++i) {
+    auto network = folly::IPAddressV4::fromLongHBO((101u << 24) + (i << 8));
+    auto nexthop = folly::IPAddressV4::fromLongHBO((100u << 24) + 1 + i % 254);
+    dependents.push_back(makeRoute({network, 24}, nexthop));
+  }
+  update({anchor}, {});
+  update(dependents, {});
+
+  suspender.dismiss();
+  update({}, {toIpPrefix(kAnchorPrefix)});
+  update({anchor}, {});
+  suspender.rehire();
+  FLAGS_rib_incremental_resolution = false;
+}
+
+BENCHMARK_NAMED_PARAM(RibIncrementalResolution, full_10, false, 10);
+BENCHMARK_NAMED_PARAM(RibIncrementalResolution, incremental_10, true, 10);
+BENCHMARK_NAMED_PARAM(RibIncrementalResolution, full_1000, false, 1000);
+BENCHMARK_NAMED_PARAM(RibIncrementalResolution, incremental_1000, true, 1000);
+BENCHMARK_NAMED_PARAM(RibIncrementalResolution, full_10000, false, 10000);
+BENCHMARK_NAMED_PARAM(
+    RibIncrementalResolution,
+    incremental_10000,
+    true,
+    10000);
+
+} // namespace facebook::fboss
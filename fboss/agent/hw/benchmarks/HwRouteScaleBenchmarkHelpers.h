@@ -21,6 +21,7 @@
 #include "fboss/agent/test/utils/VoqTestUtils.h"
 
 #include <folly/Benchmark.h>
+#include <gflags/gflags.h>
 #include <iostream>
 #include "fboss/agent/FibHelpers.h"
 #include "fboss/agent/Utils.h"
@@ -275,4 +276,15 @@ voqRouteBenchmark(bool add, uint32_t ecmpGroup, uint32_t ecmpWidth) {
     routeAddDelBenchmarker<RouteScaleGeneratorT>(false); \
   }
 
+/*
+ * Same with routes programmed through SAI bulk calls. The flag is set by name
+ * as it only exists in SAI switches, for others this is the plain benchmark.
+ */
+#define ROUTE_ADD_DEL_BULK_BENCHMARK(name, RouteScaleGeneratorT, measureAdd) \
+  BENCHMARK(name) {                                                          \
+    gflags::FlagSaver flagSaver;                                             \
+    gflags::SetCommandLineOption("sai_bulk_route_programming", "true");      \
+    routeAddDelBenchmarker<RouteScaleGeneratorT>(measureAdd);                \
+  }
+
 } // namespace facebook::fboss
@@ -8,6 +8,7 @@
  *
  */
 
+#include "fboss/agent/AgentFeatures.h"
 #include "fboss/agent/AsicUtils.h"
 #include "fboss/agent/HwAsicTable.h"
 #include "fboss/agent/IPv6Handler.h"
@@ -27,16 +28,38 @@
 
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
+#include <folly/String.h>
 #include <folly/json/dynamic.h>
 #include <folly/json/json.h>
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <thread>
 
+DEFINE_string(
+    rx_slow_path_burst_sizes,
+    "",
+    "Comma separated rx packet burst sizes to measure the rx rate with, one "
+    "after the other, e.g. 1,8,32. Empty to measure once with "
+    "--rx_packet_burst_size");
+
 namespace facebook::fboss {
 
 const std::string kDstIp = "2620:0:1cfe:face:b00c::4";
 
+namespace {
+std::vector<uint32_t> rxBurstSizes() {
+  std::vector<uint32_t> burstSizes;
+  folly::splitTo<uint32_t>(
+      ',',
+      FLAGS_rx_slow_path_burst_sizes,
+      std::back_inserter(burstSizes),
+      true);
+  return burstSizes;
+}
+} // namespace
+
 BENCHMARK(RxSlowPathBenchmark) {
   AgentEnsembleSwitchConfigFn initialConfigFn = [](const AgentEnsemble&
                                                        ensemble) {
@@ -77,6 +100,13 @@ BENCHMARK(RxSlowPathBenchmark) {
     return config;
   };
 
+  auto burstSizes = rxBurstSizes();
+  if (!burstSizes.empty()) {
+    // rx bursts are only collected if enabled at init, the burst size can
+    // then be changed between measurements
+    FLAGS_rx_packet_burst_size = std::max<uint32_t>(
+        *std::max_element(burstSizes.begin(), burstSizes.end()), 2);
+  }
   auto ensemble =
       createAgentEnsemble(initialConfigFn, false /*disableLinkStateToggler*/);
 
@@ -123,38 +153,55 @@ BENCHMARK(RxSlowPathBenchmark) {
   // Let the packet flood warm up
   std::this_thread::sleep_for(std::chrono::seconds(kBurnIntevalInSeconds));
   constexpr uint8_t kCpuQueue = 0;
-  std::map<int, CpuPortStats> cpuStatsBefore;
-  ensemble->getSw()->getAllCpuPortStats(cpuStatsBefore);
-  auto statsBefore = cpuStatsBefore[0];
-  auto [pktsBefore, bytesBefore] = utility::getCpuQueueOutPacketsAndBytes(
-      *statsBefore.portStats_(), kCpuQueue);
-  auto timeBefore = std::chrono::steady_clock::now();
-  CHECK_NE(pktsBefore, 0);
-  std::this_thread::sleep_for(std::chrono::seconds(kBurnIntevalInSeconds));
-  std::map<int, CpuPortStats> cpuStatsAfter;
-  ensemble->getSw()->getAllCpuPortStats(cpuStatsAfter);
-  auto statsAfter = cpuStatsAfter[0];
-  auto [pktsAfter, bytesAfter] = utility::getCpuQueueOutPacketsAndBytes(
-      *statsAfter.portStats_(), kCpuQueue);
-  auto timeAfter = std::chrono::steady_clock::now();
-  std::chrono::duration<double, std::milli> durationMillseconds =
-      timeAfter - timeBefore;
-  uint32_t pps = (static_cast<double>(pktsAfter - pktsBefore) /
-                  durationMillseconds.count()) *
-      1000;
-  uint32_t bytesPerSec = (static_cast<double>(bytesAfter - bytesBefore) /
-                          durationMillseconds.count()) *
-      1000;
+  // cpu rx rate in packets and bytes per second
+  auto measureRxRate = [&]() -> std::pair<uint32_t, uint32_t> {
+    std::map<int, CpuPortStats> cpuStatsBefore;
+    ensemble->getSw()->getAllCpuPortStats(cpuStatsBefore);
+    auto statsBefore = cpuStatsBefore[0];
+    auto [pktsBefore, bytesBefore] = utility::getCpuQueueOutPacketsAndBytes(
+        *statsBefore.portStats_(), kCpuQueue);
+    auto timeBefore = std::chrono::steady_clock::now();
+    CHECK_NE(pktsBefore, 0);
+    std::this_thread::sleep_for(std::chrono::seconds(kBurnIntevalInSeconds));
+    std::map<int, CpuPortStats> cpuStatsAfter;
+    ensemble->getSw()->getAllCpuPortStats(cpuStatsAfter);
+    auto statsAfter = cpuStatsAfter[0];
+    auto [pktsAfter, bytesAfter] = utility::getCpuQueueOutPacketsAndBytes(
+        *statsAfter.portStats_(), kCpuQueue);
+    auto timeAfter = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> durationMillseconds =
+        timeAfter - timeBefore;
+    uint32_t pps = (static_cast<double>(pktsAfter - pktsBefore) /
+                    durationMillseconds.count()) *
+        1000;
+    uint32_t bytesPerSec = (static_cast<double>(bytesAfter - bytesBefore) /
+                            durationMillseconds.count()) *
+        1000;
+    XLOG(DBG2) << " Pkts before: " << pktsBefore
+               << " Pkts after: " << pktsAfter
+               << " interval ms: " << durationMillseconds.count()
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+    return {pps, bytesPerSec};
+  };
 
-  if (FLAGS_json) {
-    folly::dynamic cpuRxRateJson = folly::dynamic::object;
+  folly::dynamic cpuRxRateJson = folly::dynamic::object;
+  if (burstSizes.empty()) {
+    auto [pps, bytesPerSec] = measureRxRate();
     cpuRxRateJson["cpu_rx_pps"] = pps;
     cpuRxRateJson["cpu_rx_bytes_per_sec"] = bytesPerSec;
-    std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   } else {
-    XLOG(DBG2) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
-               << " interval ms: " << durationMillseconds.count()
-               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+    for (auto burstSize : burstSizes) {
+      FLAGS_rx_packet_burst_size = burstSize;
+      // let the rx thread settle on the new burst size
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      auto [pps, bytesPerSec] = measureRxRate();
+      auto suffix = folly::to<std::string>("_burst_", burstSize);
+      cpuRxRateJson["cpu_rx_pps" + suffix] = pps;
+      cpuRxRateJson["cpu_rx_bytes_per_sec" + suffix] = bytesPerSec;
+    }
+  }
+  if (FLAGS_json) {
+    std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   }
 }
 } // namespace facebook::fboss
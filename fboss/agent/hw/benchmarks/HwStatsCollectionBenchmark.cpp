@@ -11,6 +11,7 @@
 #include "fboss/agent/AgentFeatures.h"
 
 #include "fboss/agent/SwAgentInitializer.h"
+#include "fboss/agent/Utils.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/test/AgentEnsemble.h"
 #include "fboss/agent/test/utils/CoppTestUtils.h"
@@ -21,6 +22,18 @@
 
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
+#include <folly/logging/xlog.h>
+
+#include <iostream>
+#include <utility>
+
+DEFINE_int32(
+    stats_collection_num_ports,
+    48,
+    "Number of ports to collect stats for on NPU switches, to report the "
+    "stats collection cycle time per port count");
+
+DECLARE_bool(json);
 
 namespace facebook::fboss {
 
@@ -47,10 +60,10 @@ RouteNextHopSet makeNextHops(const std::vector<std::string>& ipsAsStrings) {
 BENCHMARK(HwStatsCollection) {
   folly::BenchmarkSuspender suspender;
   std::unique_ptr<AgentEnsemble> ensemble{};
-  // maximum 48 master logical ports (taken from wedge400) to get
+  // maximum 48 master logical ports (taken from wedge400) by default to get
   // consistent performance results across platforms with different
   // number of ports but same ASIC, e.g. wedge400 and minipack
-  int numPortsToCollectStats = 48;
+  int numPortsToCollectStats = FLAGS_stats_collection_num_ports;
   // route counters in hardware is currently limited to 255.
   // this is due to the fact that in some platforms, route class id
   // (8 bits) is overloaded to support counter id.
@@ -144,11 +157,30 @@ BENCHMARK(HwStatsCollection) {
     updater.program();
   }
 
+  // stats are collected for enabled ports only
+  int numPorts = 0;
+  for (const auto& portMap :
+       std::as_const(*ensemble->getProgrammedState()->getPorts())) {
+    for (const auto& port : std::as_const(*portMap.second)) {
+      numPorts += port.second->isEnabled() ? 1 : 0;
+    }
+  }
   suspender.dismiss();
+  StopWatch timer(std::nullopt, FLAGS_json);
   for (auto i = 0; i < iterations; ++i) {
     ensemble->getSw()->updateStats();
   }
+  auto cycleMsecs = timer.msecsElapsed().count() / iterations;
   suspender.rehire();
+  auto cycleTimeName =
+      folly::sformat("stats_collection_cycle_msecs_{}_ports", numPorts);
+  if (FLAGS_json) {
+    folly::dynamic cycleTime = folly::dynamic::object;
+    cycleTime[cycleTimeName] = cycleMsecs;
+    std::cout << cycleTime << std::endl;
+  } else {
+    XLOG(INFO) << cycleTimeName << " : " << cycleMsecs;
+  }
 }
 
 } // namespace facebook::fboss
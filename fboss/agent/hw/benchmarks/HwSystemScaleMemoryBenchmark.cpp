@@ -1,8 +1,11 @@
+#include "fboss/agent/state/RouteNextHopEntry.h"
+#include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/AgentEnsemble.h"
 #include "fboss/agent/test/utils/AgentFsdbIntegrationBenchmarkHelper.h"
 #include "fboss/agent/test/utils/SystemScaleTestUtils.h"
 
 #include <folly/Benchmark.h>
+#include <folly/logging/xlog.h>
 
 namespace facebook::fboss {
 
@@ -16,6 +19,14 @@ BENCHMARK(SystemScaleMemoryBenchmark) {
   // benchmark test: max scale agent state
   utility::initSystemScaleTest(ensemble.get());
 
+  // max_rss is reported by the benchmark main, compare runs with and without
+  // --intern_route_nexthops for the forwarding info share of it
+  auto [v4Routes, v6Routes] =
+      ensemble->getSw()->getState()->getFibs()->getRouteCount();
+  XLOG(INFO) << "Routes: " << v4Routes + v6Routes
+             << ", interned forwarding entries: "
+             << RouteNextHopEntry::numInterned();
+
   helper.awaitCompletion(ensemble.get());
 }
 
@@ -14,6 +14,7 @@
 #include "fboss/agent/test/EcmpSetupHelper.h"
 
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/TxPacketPool.h"
 #include "fboss/agent/benchmarks/AgentBenchmarks.h"
 
 #include <folly/IPAddressV6.h>
@@ -66,7 +67,8 @@ BENCHMARK(runTxSlowPathBenchmark) {
   auto cpuMac = ensemble->getSw()->getLocalMac(SwitchID(0));
   auto vlanId = ensemble->getVlanIDForTx();
   std::atomic<bool> packetTxDone{false};
-  std::thread t([cpuMac, vlanId, swSwitch, &packetTxDone]() {
+  uint64_t pktsSent{0};
+  std::thread t([cpuMac, vlanId, swSwitch, &packetTxDone, &pktsSent]() {
     const auto kSrcIp = folly::IPAddressV6("2620:0:1cfe:face:b00c::3");
     const auto kDstIp = folly::IPAddressV6("2620:0:1cfe:face:b00c::4");
     const auto kSrcMac = folly::MacAddress{"fa:ce:b0:00:00:0c"};
@@ -84,17 +86,25 @@ BENCHMARK(runTxSlowPathBenchmark) {
             kDstIp);
         swSwitch->sendPacketSwitchedAsync(std::move(txPacket));
       }
+      pktsSent += 1'000;
     }
   });
 
   auto [pktsBefore, bytesBefore] =
       getOutPktsAndBytes(ensemble.get(), PortID(portUsed));
+  auto allocsBefore = TxPacketPool::getInstance().heapAllocations();
   auto timeBefore = std::chrono::steady_clock::now();
   // Let the packet flood warm up
   std::this_thread::sleep_for(std::chrono::seconds(30));
   packetTxDone = true;
   t.join();
   auto timeAfter = std::chrono::steady_clock::now();
+  // TX buffers taken from the heap rather than reused, with --tx_packet_pool
+  // or without it for a baseline
+  auto allocsAfter = TxPacketPool::getInstance().heapAllocations();
+  double allocsPerPkt = pktsSent
+      ? static_cast<double>(allocsAfter - allocsBefore) / pktsSent
+      : 0;
   std::chrono::duration<double, std::milli> durationMillseconds =
       timeAfter - timeBefore;
   auto pktsAfter = pktsBefore;
@@ -128,11 +138,13 @@ BENCHMARK(runTxSlowPathBenchmark) {
     folly::dynamic cpuTxRateJson = folly::dynamic::object;
     cpuTxRateJson["cpu_tx_pps"] = pps;
     cpuTxRateJson["cpu_tx_bytes_per_sec"] = bytesPerSec;
+    cpuTxRateJson["tx_buffer_allocs_per_pkt"] = allocsPerPkt;
     std::cout << toPrettyJson(cpuTxRateJson) << std::endl;
   } else {
     XLOG(DBG2) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
-               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec
+               << " tx buffer allocs per pkt: " << allocsPerPkt;
   }
 }
 } // namespace facebook::fboss
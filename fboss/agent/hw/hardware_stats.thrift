@@ -441,6 +441,8 @@ struct HwSwitchFb303GlobalStats {
   35: optional i64 interrupt_masked_events;
   36: optional i64 asic_revision;
   37: optional i64 sram_low_buffer_limit_hit_count;
+  // Trapped packets dropped as the rx burst queue was full
+  38: optional i64 rx_pkt_queue_full_drops;
 }
 
 struct HwFlowletStats {
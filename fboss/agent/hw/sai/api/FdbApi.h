@@ -105,6 +105,7 @@ struct IsSaiEntryStruct<SaiFdbTraits::FdbEntry> : public std::true_type {};
 class FdbApi : public SaiApi<FdbApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_FDB;
+  static constexpr SaiApiLockDomain LockDomain = SaiApiLockDomain::FDB;
   FdbApi() {
     sai_status_t status =
         sai_api_query(ApiType, reinterpret_cast<void**>(&api_));
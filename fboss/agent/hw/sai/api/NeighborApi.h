@@ -128,12 +128,21 @@ struct IsSaiEntryStruct<SaiNeighborTraits::NeighborEntry>
 class NeighborApi : public SaiApi<NeighborApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_NEIGHBOR;
+  static constexpr SaiApiLockDomain LockDomain = SaiApiLockDomain::NEIGHBOR;
   NeighborApi() {
     sai_status_t status =
         sai_api_query(ApiType, reinterpret_cast<void**>(&api_));
     saiApiCheckError(status, ApiType, "Failed to query for neighbor api");
   }
 
+  bool bulkSupported() const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    return api_->create_neighbor_entries && api_->remove_neighbor_entries;
+#else
+    return false;
+#endif
+  }
+
  private:
   sai_status_t _create(
       const SaiNeighborTraits::NeighborEntry& neighborEntry,
@@ -145,6 +154,50 @@ class NeighborApi : public SaiApi<NeighborApi> {
       const SaiNeighborTraits::NeighborEntry& neighborEntry) const {
     return api_->remove_neighbor_entry(neighborEntry.entry());
   }
+  sai_status_t _bulkCreate(
+      const SaiNeighborTraits::NeighborEntry* neighborEntries,
+      size_t objectCount,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    auto entries = rawEntries(neighborEntries, objectCount);
+    return api_->create_neighbor_entries(
+        objectCount,
+        entries.data(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+  sai_status_t _bulkRemove(
+      const SaiNeighborTraits::NeighborEntry* neighborEntries,
+      size_t objectCount,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    auto entries = rawEntries(neighborEntries, objectCount);
+    return api_->remove_neighbor_entries(
+        objectCount,
+        entries.data(),
+        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+  static std::vector<sai_neighbor_entry_t> rawEntries(
+      const SaiNeighborTraits::NeighborEntry* neighborEntries,
+      size_t objectCount) {
+    std::vector<sai_neighbor_entry_t> entries;
+    entries.reserve(objectCount);
+    for (auto idx = 0; idx < objectCount; ++idx) {
+      entries.push_back(*neighborEntries[idx].entry());
+    }
+    return entries;
+  }
   sai_status_t _getAttribute(
       const SaiNeighborTraits::NeighborEntry& neighborEntry,
       sai_attribute_t* attr) const {
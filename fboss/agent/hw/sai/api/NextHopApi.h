@@ -170,12 +170,21 @@ SAI_ATTRIBUTE_NAME(IpNextHop, DisableTtlDecrement);
 class NextHopApi : public SaiApi<NextHopApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_NEXT_HOP;
+  static constexpr SaiApiLockDomain LockDomain = SaiApiLockDomain::ROUTE;
   NextHopApi() {
     sai_status_t status =
         sai_api_query(ApiType, reinterpret_cast<void**>(&api_));
     saiApiCheckError(status, ApiType, "Failed to query for next hop api");
   }
 
+  bool bulkSupported() const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+    return api_->create_next_hops && api_->remove_next_hops;
+#else
+    return false;
+#endif
+  }
+
  private:
   sai_status_t _create(
       NextHopSaiId* id,
@@ -187,6 +196,45 @@ class NextHopApi : public SaiApi<NextHopApi> {
   sai_status_t _remove(NextHopSaiId next_hop_id) const {
     return api_->remove_next_hop(next_hop_id);
   }
+  sai_status_t _bulkCreate(
+      sai_object_id_t* ids,
+      sai_object_id_t switch_id,
+      size_t objectCount,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+    return api_->create_next_hops(
+        switch_id,
+        objectCount,
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+        ids,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+  sai_status_t _bulkRemove(
+      const NextHopSaiId* ids,
+      size_t objectCount,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+    std::vector<sai_object_id_t> rawIds;
+    rawIds.reserve(objectCount);
+    for (auto idx = 0; idx < objectCount; ++idx) {
+      rawIds.push_back(ids[idx]);
+    }
+    return api_->remove_next_hops(
+        objectCount,
+        rawIds.data(),
+        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
   sai_status_t _getAttribute(NextHopSaiId id, sai_attribute_t* attr) const {
     return api_->get_next_hop_attribute(id, 1, attr);
   }
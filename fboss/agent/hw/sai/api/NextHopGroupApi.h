@@ -135,6 +135,7 @@ SAI_ATTRIBUTE_NAME(NextHopGroupMember, Weight)
 class NextHopGroupApi : public SaiApi<NextHopGroupApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_NEXT_HOP_GROUP;
+  static constexpr SaiApiLockDomain LockDomain = SaiApiLockDomain::ROUTE;
   NextHopGroupApi() {
     sai_status_t status =
         sai_api_query(ApiType, reinterpret_cast<void**>(&api_));
@@ -116,12 +116,18 @@ SAI_ATTRIBUTE_NAME(Route, CounterID)
 class RouteApi : public SaiApi<RouteApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_ROUTE;
+  static constexpr SaiApiLockDomain LockDomain = SaiApiLockDomain::ROUTE;
   RouteApi() {
     sai_status_t status =
         sai_api_query(ApiType, reinterpret_cast<void**>(&api_));
     saiApiCheckError(status, ApiType, "Failed to query for route api");
   }
 
+  // adapters that don't implement the bulk calls leave them unset
+  bool bulkSupported() const {
+    return api_->create_route_entries && api_->remove_route_entries;
+  }
+
  private:
   sai_status_t _create(
       const typename SaiRouteTraits::RouteEntry& routeEntry,
@@ -132,6 +138,42 @@ class RouteApi : public SaiApi<RouteApi> {
   sai_status_t _remove(const SaiRouteTraits::RouteEntry& routeEntry) const {
     return api_->remove_route_entry(routeEntry.entry());
   }
+  sai_status_t _bulkCreate(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      size_t objectCount,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus) const {
+    auto entries = rawEntries(routeEntries, objectCount);
+    return api_->create_route_entries(
+        objectCount,
+        entries.data(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+        retStatus);
+  }
+  sai_status_t _bulkRemove(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      size_t objectCount,
+      sai_status_t* retStatus) const {
+    auto entries = rawEntries(routeEntries, objectCount);
+    return api_->remove_route_entries(
+        objectCount,
+        entries.data(),
+        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+        retStatus);
+  }
+  static std::vector<sai_route_entry_t> rawEntries(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      size_t objectCount) {
+    std::vector<sai_route_entry_t> entries;
+    entries.reserve(objectCount);
+    for (auto idx = 0; idx < objectCount; ++idx) {
+      entries.push_back(*routeEntries[idx].entry());
+    }
+    return entries;
+  }
   sai_status_t _getAttribute(
       const SaiRouteTraits::RouteEntry& routeEntry,
       sai_attribute_t* attr) const {
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <exception>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -45,6 +46,10 @@ class SaiApi {
   SaiApi(const SaiApi& other) = delete;
   SaiApi& operator=(const SaiApi& other) = delete;
 
+  // Lock domain of the calls of an api, apis override it to let their calls
+  // run concurrently with calls of other domains
+  static constexpr SaiApiLockDomain LockDomain = SaiApiLockDomain::GLOBAL;
+
   // Currently, create is not clever enough to have totally deducible
   // template parameters. It can be done, but I think it would reduce
   // the value of the CreateAttributes pattern. That is something that
@@ -85,7 +90,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are not expected",
           createAttributes);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock()};
     sai_status_t status;
     {
       TIME_CALL;
@@ -127,7 +132,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are not expected",
           createAttributes);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock()};
     sai_status_t status;
     {
       TIME_CALL;
@@ -159,7 +164,7 @@ class SaiApi {
           "Attempting to remove SAI obj {} while hw writes are not expected",
           key);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock()};
     sai_status_t status;
     {
       TIME_CALL;
@@ -172,6 +177,134 @@ class SaiApi {
     XLOGF(DBG5, "removed SAI object: {}", key);
   }
 
+  /*
+   * Bulk create and remove. All objects are submitted in one SAI call,
+   * which goes on past failed objects. The status of each object is returned
+   * for the caller to handle, only a failure of the call itself throws.
+   */
+
+  // sai_object_id_t case, fills in adapterKeys of the created objects
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsObjectId<SaiObjectTraits>::value,
+      std::vector<sai_status_t>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes,
+      sai_object_id_t switch_id,
+      std::vector<typename SaiObjectTraits::AdapterKey>& adapterKeys) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    if (UNLIKELY(failHwWrites() || skipHwWrites())) {
+      // as with create, adapter keys can't be made up on skip
+      XLOG(
+          FATAL,
+          "Attempting bulk create SAI objs while hw writes are blocked");
+    }
+    if (UNLIKELY(logFailHwWrites())) {
+      XLOG(
+          WARNING,
+          "Attempting bulk create SAI objs while hw writes are not expected");
+    }
+    BulkAttributes bulkAttributes(createAttributes);
+    std::vector<sai_object_id_t> ids(
+        createAttributes.size(), SAI_NULL_OBJECT_ID);
+    std::vector<sai_status_t> statuses(createAttributes.size());
+    auto g{apiLock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkCreate(
+          ids.data(),
+          switch_id,
+          createAttributes.size(),
+          bulkAttributes.counts.data(),
+          bulkAttributes.lists.data(),
+          statuses.data());
+    }
+    checkBulkError(status, "Failed to bulk create sai objects");
+    adapterKeys.clear();
+    adapterKeys.reserve(ids.size());
+    for (auto id : ids) {
+      adapterKeys.emplace_back(id);
+    }
+    logBulkResults("created", adapterKeys, statuses);
+    return statuses;
+  }
+
+  // entry struct case
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+      std::vector<sai_status_t>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    XCHECK_EQ(entries.size(), createAttributes.size());
+    std::vector<sai_status_t> statuses(entries.size(), SAI_STATUS_SUCCESS);
+    if (UNLIKELY(skipHwWrites())) {
+      return statuses;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOG(
+          FATAL,
+          "Attempting bulk create SAI objs while hw writes are blocked");
+    }
+    if (UNLIKELY(logFailHwWrites())) {
+      XLOG(
+          WARNING,
+          "Attempting bulk create SAI objs while hw writes are not expected");
+    }
+    BulkAttributes bulkAttributes(createAttributes);
+    auto g{apiLock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkCreate(
+          entries.data(),
+          entries.size(),
+          bulkAttributes.counts.data(),
+          bulkAttributes.lists.data(),
+          statuses.data());
+    }
+    checkBulkError(status, "Failed to bulk create sai entities");
+    logBulkResults("created", entries, statuses);
+    return statuses;
+  }
+
+  template <typename AdapterKeyT>
+  std::vector<sai_status_t> bulkRemove(
+      const std::vector<AdapterKeyT>& keys) const {
+    std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_SUCCESS);
+    if (UNLIKELY(skipHwWrites())) {
+      return statuses;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOG(
+          FATAL,
+          "Attempting bulk remove SAI objs while hw writes are blocked");
+    }
+    if (UNLIKELY(logFailHwWrites())) {
+      XLOG(
+          WARNING,
+          "Attempting bulk remove SAI objs while hw writes are not expected");
+    }
+    auto g{apiLock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkRemove(keys.data(), keys.size(), statuses.data());
+    }
+    checkBulkError(status, "Failed to bulk remove sai objects");
+    logBulkResults("removed", keys, statuses);
+    return statuses;
+  }
+
   /*
    * We can do getAttribute on top of more complicated types than just
    * attributes. For example, if we overload on tuples and optionals, we
@@ -193,7 +326,7 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock()};
     sai_status_t status;
     {
       TIME_CALL;
@@ -331,7 +464,7 @@ class SaiApi {
     // to retrieve txReadyStatusChange. However, this can be enhanced in the
     // future.
 
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock()};
 
     // We only support querying 1 attr per SAI Object today
     constexpr auto kMaxNumAttrsPerObject = 1;
@@ -434,7 +567,7 @@ class SaiApi {
   }
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) const {
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock()};
     setAttributeUnlocked(key, attr);
   }
 
@@ -497,7 +630,7 @@ class SaiApi {
   void bulkSetAttributes(
       std::vector<AdapterKeyT>& adapterKeys,
       std::vector<AttrT>& attributes) const {
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock()};
     return bulkSetAttributesUnlocked(adapterKeys, attributes);
   }
 
@@ -509,7 +642,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock(SaiApiLockDomain::STATS)};
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size(), mode);
   }
@@ -520,7 +653,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock(SaiApiLockDomain::STATS)};
     XLOGF(DBG6, "got SAI stats for {}", key);
     return mode == SAI_STATS_MODE_READ
         ? getStatsImpl<SaiObjectTraits>(
@@ -535,6 +668,75 @@ class SaiApi {
               mode);
   }
 
+  /*
+   * Read the same counters of several objects of one type in a single bulk
+   * stats call. Counters are returned object by object, in the order of the
+   * keys, and statuses tells which objects were read. The counters of
+   * objects which failed are left at 0, callers read them with getStats.
+   * Returns nullopt if the adapter does not support bulk stats, in which
+   * case callers fall back to getStats per object.
+   */
+  template <typename SaiObjectTraits>
+  std::optional<std::vector<uint64_t>> bulkGetStats(
+      sai_object_id_t switchId,
+      const std::vector<typename SaiObjectTraits::AdapterKey>& keys,
+      const std::vector<sai_stat_id_t>& counterIds,
+      sai_stats_mode_t mode,
+      std::vector<sai_status_t>& statuses) const {
+    static_assert(
+        SaiObjectHasStats<SaiObjectTraits>::value,
+        "bulkGetStats only supported for Sai objects with stats");
+    static_assert(
+        AdapterKeyIsObjectId<SaiObjectTraits>::value,
+        "bulkGetStats only supported for object id keyed Sai objects");
+#if SAI_API_VERSION >= SAI_VERSION(1, 11, 0)
+    std::vector<uint64_t> counters(keys.size() * counterIds.size());
+    statuses.assign(keys.size(), SAI_STATUS_SUCCESS);
+    if (counters.empty()) {
+      return counters;
+    }
+    std::vector<sai_object_key_t> objectKeys(keys.size());
+    for (auto i = 0; i < keys.size(); ++i) {
+      objectKeys[i].key.object_id = keys[i];
+    }
+    auto g{apiLock(SaiApiLockDomain::STATS)};
+    sai_status_t status;
+    {
+      TIME_CALL
+      status = sai_bulk_object_get_stats(
+          switchId,
+          SaiObjectTraits::ObjectType,
+          objectKeys.size(),
+          objectKeys.data(),
+          counterIds.size(),
+          counterIds.data(),
+          mode,
+          statuses.data(),
+          counters.data());
+    }
+    if (status == SAI_STATUS_NOT_IMPLEMENTED ||
+        status == SAI_STATUS_NOT_SUPPORTED) {
+      return std::nullopt;
+    }
+    // FAILURE only says some objects failed. Their counters stay in the
+    // adapter, while those of the other objects were read and, with
+    // SAI_STATS_MODE_READ_AND_CLEAR, cleared, so they must not be dropped
+    checkBulkError(status, "Failed to bulk get stats");
+    for (auto i = 0; i < keys.size(); ++i) {
+      if (statuses[i] != SAI_STATUS_SUCCESS) {
+        XLOGF(
+            DBG2,
+            "Failed to bulk get stats {}: {}",
+            keys[i],
+            saiStatusToString(statuses[i]));
+      }
+    }
+    return counters;
+#else
+    return std::nullopt;
+#endif
+  }
+
   template <typename SaiObjectTraits>
   void clearStats(
       const typename SaiObjectTraits::AdapterKey& key,
@@ -542,7 +744,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock(SaiApiLockDomain::STATS)};
     clearStatsImpl<SaiObjectTraits>(key, counterIds.data(), counterIds.size());
   }
   template <typename SaiObjectTraits>
@@ -550,7 +752,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{apiLock(SaiApiLockDomain::STATS)};
     clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIdsToRead.data(),
@@ -565,6 +767,9 @@ class SaiApi {
   }
 
  private:
+  auto apiLock(SaiApiLockDomain domain = ApiT::LockDomain) const {
+    return SaiApiLock::getInstance()->lock(domain);
+  }
   bool failHwWrites() const {
     return getHwWriteBehavior() == HwWriteBehavior::FAIL;
   }
@@ -574,6 +779,47 @@ class SaiApi {
   bool logFailHwWrites() const {
     return getHwWriteBehavior() == HwWriteBehavior::LOG_FAIL;
   }
+  // per object attribute lists in the layout SAI bulk create expects
+  struct BulkAttributes {
+    template <typename CreateAttributes>
+    explicit BulkAttributes(const std::vector<CreateAttributes>& attributes) {
+      attrs.reserve(attributes.size());
+      counts.reserve(attributes.size());
+      lists.reserve(attributes.size());
+      for (const auto& createAttributes : attributes) {
+        attrs.push_back(saiAttrs(createAttributes));
+        counts.push_back(attrs.back().size());
+        lists.push_back(attrs.back().data());
+      }
+    }
+    std::vector<std::vector<sai_attribute_t>> attrs;
+    std::vector<uint32_t> counts;
+    std::vector<const sai_attribute_t*> lists;
+  };
+  void checkBulkError(sai_status_t status, const std::string& msg) const {
+    // FAILURE only says some objects failed, their statuses tell which
+    if (status != SAI_STATUS_FAILURE) {
+      saiApiCheckError(status, apiType(), msg);
+    }
+  }
+  template <typename AdapterKeyT>
+  void logBulkResults(
+      const char* op,
+      const std::vector<AdapterKeyT>& keys,
+      const std::vector<sai_status_t>& statuses) const {
+    for (auto idx = 0; idx < keys.size(); ++idx) {
+      if (statuses[idx] == SAI_STATUS_SUCCESS) {
+        XLOGF(DBG5, "bulk {} SAI object: {}", op, keys[idx]);
+      } else {
+        XLOGF(
+            ERR,
+            "bulk {} of SAI object {} failed: {}",
+            op,
+            keys[idx],
+            statuses[idx]);
+      }
+    }
+  }
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStatsImpl(
       const typename SaiObjectTraits::AdapterKey& key,
@@ -15,6 +15,10 @@
 
 namespace {
 struct singleton_tag_type {};
+
+size_t domainIndex(facebook::fboss::SaiApiLockDomain domain) {
+  return static_cast<size_t>(domain);
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -24,4 +28,90 @@ std::shared_ptr<SaiApiLock> SaiApiLock::getInstance() {
   return saiApiLockSingleton.try_get();
 }
 
+const char* saiApiLockDomainToString(SaiApiLockDomain domain) {
+  switch (domain) {
+    case SaiApiLockDomain::GLOBAL:
+      return "global";
+    case SaiApiLockDomain::ROUTE:
+      return "route";
+    case SaiApiLockDomain::NEIGHBOR:
+      return "neighbor";
+    case SaiApiLockDomain::FDB:
+      return "fdb";
+    case SaiApiLockDomain::STATS:
+      return "stats";
+  }
+  return "unknown";
+}
+
+SaiApiLock::ScopedApiLock::ScopedApiLock(
+    const SaiApiLock& apiLock,
+    SaiApiLockDomain domain)
+    : apiLock_(apiLock),
+      noopLock_(apiLock.adaptorIsThreadSafe_),
+      domain_(
+          apiLock.lockDomainsEnabled_ ? domain : SaiApiLockDomain::GLOBAL) {
+  if (noopLock_) {
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+  if (domain_ == SaiApiLockDomain::GLOBAL) {
+    apiLock_.globalMutex_.lock();
+  } else {
+    apiLock_.globalMutex_.lock_shared();
+    apiLock_.domainMutexes_[domainIndex(domain_)].lock();
+  }
+  acquired_ = std::chrono::steady_clock::now();
+  apiLock_.recordWait(domain_, acquired_ - start);
+}
+
+SaiApiLock::ScopedApiLock::~ScopedApiLock() {
+  if (noopLock_) {
+    return;
+  }
+  auto held = std::chrono::steady_clock::now() - acquired_;
+  if (domain_ == SaiApiLockDomain::GLOBAL) {
+    apiLock_.globalMutex_.unlock();
+  } else {
+    apiLock_.domainMutexes_[domainIndex(domain_)].unlock();
+    apiLock_.globalMutex_.unlock_shared();
+  }
+  apiLock_.recordHold(domain_, held);
+}
+
+void SaiApiLock::recordWait(
+    SaiApiLockDomain domain,
+    std::chrono::nanoseconds wait) const {
+  auto& counters = domainCounters_[domainIndex(domain)];
+  uint64_t waitNsecs = wait.count();
+  counters.acquisitions.fetch_add(1, std::memory_order_relaxed);
+  counters.waitNsecs.fetch_add(waitNsecs, std::memory_order_relaxed);
+  auto maxWaitNsecs = counters.maxWaitNsecs.load(std::memory_order_relaxed);
+  while (waitNsecs > maxWaitNsecs &&
+         !counters.maxWaitNsecs.compare_exchange_weak(
+             maxWaitNsecs, waitNsecs, std::memory_order_relaxed)) {
+  }
+}
+
+void SaiApiLock::recordHold(
+    SaiApiLockDomain domain,
+    std::chrono::nanoseconds hold) const {
+  domainCounters_[domainIndex(domain)].holdNsecs.fetch_add(
+      hold.count(), std::memory_order_relaxed);
+}
+
+SaiApiLock::DomainStats SaiApiLock::getDomainStats(
+    SaiApiLockDomain domain) const {
+  const auto& counters = domainCounters_[domainIndex(domain)];
+  DomainStats stats;
+  stats.acquisitions = counters.acquisitions.load(std::memory_order_relaxed);
+  stats.waitTime = std::chrono::nanoseconds(
+      counters.waitNsecs.load(std::memory_order_relaxed));
+  stats.holdTime = std::chrono::nanoseconds(
+      counters.holdNsecs.load(std::memory_order_relaxed));
+  stats.maxWaitTime = std::chrono::nanoseconds(
+      counters.maxWaitNsecs.load(std::memory_order_relaxed));
+  return stats;
+}
+
 } // namespace facebook::fboss
@@ -9,25 +9,65 @@
  */
 #pragma once
 
+#include <folly/SharedMutex.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 
 namespace facebook::fboss {
 
+/*
+ * Domains SAI calls are serialized in. A SaiApi subclass declares the domain
+ * of its calls with a LockDomain member, and stats calls of every api are in
+ * the STATS domain.
+ *
+ * GLOBAL calls exclude calls of every other domain, while calls of different
+ * non GLOBAL domains may run concurrently. Route, neighbor and fdb calls are
+ * all made under saiSwitchMutex_ while applying state updates, so in practice
+ * what runs concurrently with them are the port and queue stats reads, which
+ * stats collection makes without holding saiSwitchMutex_. Other stats are
+ * still read under it. Domains are only used once enabled, since the adaptor
+ * has to support concurrent calls into different apis. Until then every call
+ * is in the GLOBAL domain, i.e. serialized on a single lock.
+ */
+enum class SaiApiLockDomain : uint8_t {
+  GLOBAL,
+  ROUTE,
+  NEIGHBOR,
+  FDB,
+  STATS,
+};
+constexpr size_t kNumSaiApiLockDomains =
+    static_cast<size_t>(SaiApiLockDomain::STATS) + 1;
+
+const char* saiApiLockDomainToString(SaiApiLockDomain domain);
+
 class SaiApiLock {
-  struct ScopedApiLock {
-    ScopedApiLock(std::mutex& m, bool noopLock) : mutex(m), noopLock(noopLock) {
-      if (!noopLock) {
-        mutex.lock();
-      }
-    }
-    ~ScopedApiLock() {
-      if (!noopLock) {
-        mutex.unlock();
-      }
-    }
-    std::mutex& mutex;
-    bool noopLock{false};
+ public:
+  // cumulative since start
+  struct DomainStats {
+    uint64_t acquisitions{0};
+    std::chrono::nanoseconds waitTime{0};
+    std::chrono::nanoseconds holdTime{0};
+    std::chrono::nanoseconds maxWaitTime{0};
+  };
+
+ private:
+  class ScopedApiLock {
+   public:
+    ScopedApiLock(const SaiApiLock& apiLock, SaiApiLockDomain domain);
+    ~ScopedApiLock();
+    ScopedApiLock(const ScopedApiLock&) = delete;
+    ScopedApiLock& operator=(const ScopedApiLock&) = delete;
+
+   private:
+    const SaiApiLock& apiLock_;
+    bool noopLock_;
+    SaiApiLockDomain domain_;
+    std::chrono::steady_clock::time_point acquired_;
   };
 
  public:
@@ -35,12 +75,31 @@ class SaiApiLock {
   void setAdaptorIsThreadSafe(bool isThreadSafe) {
     adaptorIsThreadSafe_ = isThreadSafe;
   }
-  ScopedApiLock lock() const {
-    return {mutex_, adaptorIsThreadSafe_};
+  void setLockDomainsEnabled(bool enabled) {
+    lockDomainsEnabled_ = enabled;
   }
+  ScopedApiLock lock(SaiApiLockDomain domain = SaiApiLockDomain::GLOBAL) const {
+    return {*this, domain};
+  }
+  DomainStats getDomainStats(SaiApiLockDomain domain) const;
 
  private:
+  struct DomainCounters {
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> waitNsecs{0};
+    std::atomic<uint64_t> holdNsecs{0};
+    std::atomic<uint64_t> maxWaitNsecs{0};
+  };
+  void recordWait(SaiApiLockDomain domain, std::chrono::nanoseconds wait)
+      const;
+  void recordHold(SaiApiLockDomain domain, std::chrono::nanoseconds hold)
+      const;
+
   bool adaptorIsThreadSafe_{false};
-  mutable std::mutex mutex_;
+  std::atomic<bool> lockDomainsEnabled_{false};
+  // held exclusively by GLOBAL calls, shared by calls of other domains
+  mutable folly::SharedMutex globalMutex_;
+  mutable std::array<std::mutex, kNumSaiApiLockDomains> domainMutexes_;
+  mutable std::array<DomainCounters, kNumSaiApiLockDomains> domainCounters_;
 };
 } // namespace facebook::fboss
@@ -233,6 +233,49 @@ TEST_F(RouteApiTest, routeKeys) {
   EXPECT_EQ(routeKeys[0], r);
 }
 
+TEST_F(RouteApiTest, bulkCreateRemoveRoutes) {
+  SaiRouteTraits::Attributes::PacketAction packetActionAttribute{
+      SAI_PACKET_ACTION_FORWARD};
+  SaiRouteTraits::Attributes::NextHopId nextHopIdAttribute(5);
+  std::vector<SaiRouteTraits::RouteEntry> entries{
+      SaiRouteTraits::RouteEntry(0, 0, folly::CIDRNetwork(ip4, 24)),
+      SaiRouteTraits::RouteEntry(0, 0, folly::CIDRNetwork(ip6, 64))};
+  std::vector<SaiRouteTraits::CreateAttributes> attributes(
+      entries.size(),
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+      {packetActionAttribute, nextHopIdAttribute, std::nullopt, std::nullopt}
+#else
+      {packetActionAttribute, nextHopIdAttribute, std::nullopt}
+#endif
+  );
+  EXPECT_TRUE(routeApi->bulkSupported());
+  auto statuses = routeApi->bulkCreate<SaiRouteTraits>(entries, attributes);
+  EXPECT_EQ(
+      statuses,
+      std::vector<sai_status_t>(entries.size(), SAI_STATUS_SUCCESS));
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 2);
+  for (const auto& entry : entries) {
+    EXPECT_EQ(
+        routeApi->getAttribute(entry, SaiRouteTraits::Attributes::NextHopId()),
+        5);
+  }
+
+  // an already existing route fails on its own, the others still get created
+  entries.emplace_back(0, 0, folly::CIDRNetwork(ip4, 16));
+  attributes.push_back(attributes.front());
+  statuses = routeApi->bulkCreate<SaiRouteTraits>(entries, attributes);
+  EXPECT_EQ(statuses[0], SAI_STATUS_ITEM_ALREADY_EXISTS);
+  EXPECT_EQ(statuses[1], SAI_STATUS_ITEM_ALREADY_EXISTS);
+  EXPECT_EQ(statuses[2], SAI_STATUS_SUCCESS);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 3);
+
+  statuses = routeApi->bulkRemove(entries);
+  EXPECT_EQ(
+      statuses,
+      std::vector<sai_status_t>(entries.size(), SAI_STATUS_SUCCESS));
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
 TEST_F(RouteApiTest, formatRouteNextHopId) {
   SaiRouteTraits::Attributes::NextHopId nhid{42};
   std::string expected("NextHopId: 42");
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace facebook::fboss;
+
+TEST(SaiApiLockTest, domainsDisabled) {
+  SaiApiLock apiLock;
+  { auto g{apiLock.lock(SaiApiLockDomain::ROUTE)}; }
+  { auto g{apiLock.lock(SaiApiLockDomain::STATS)}; }
+  // every call is serialized on the global lock
+  EXPECT_EQ(apiLock.getDomainStats(SaiApiLockDomain::GLOBAL).acquisitions, 2);
+  EXPECT_EQ(apiLock.getDomainStats(SaiApiLockDomain::ROUTE).acquisitions, 0);
+  EXPECT_EQ(apiLock.getDomainStats(SaiApiLockDomain::STATS).acquisitions, 0);
+}
+
+TEST(SaiApiLockTest, concurrentDomains) {
+  SaiApiLock apiLock;
+  apiLock.setLockDomainsEnabled(true);
+  {
+    auto g{apiLock.lock(SaiApiLockDomain::ROUTE)};
+    // stats calls are not blocked by route programming
+    std::thread statsThread([&apiLock]() {
+      auto statsLock{apiLock.lock(SaiApiLockDomain::STATS)};
+    });
+    statsThread.join();
+  }
+  EXPECT_EQ(apiLock.getDomainStats(SaiApiLockDomain::ROUTE).acquisitions, 1);
+  EXPECT_EQ(apiLock.getDomainStats(SaiApiLockDomain::STATS).acquisitions, 1);
+  EXPECT_EQ(apiLock.getDomainStats(SaiApiLockDomain::GLOBAL).acquisitions, 0);
+}
+
+TEST(SaiApiLockTest, globalExcludesDomains) {
+  SaiApiLock apiLock;
+  apiLock.setLockDomainsEnabled(true);
+  std::atomic<bool> statsLocked{false};
+  std::thread statsThread;
+  {
+    auto g{apiLock.lock()};
+    statsThread = std::thread([&apiLock, &statsLocked]() {
+      auto statsLock{apiLock.lock(SaiApiLockDomain::STATS)};
+      statsLocked = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(statsLocked);
+  }
+  statsThread.join();
+  EXPECT_TRUE(statsLocked);
+  auto stats = apiLock.getDomainStats(SaiApiLockDomain::STATS);
+  EXPECT_EQ(stats.acquisitions, 1);
+  EXPECT_GT(stats.waitTime.count(), 0);
+  EXPECT_EQ(stats.waitTime, stats.maxWaitTime);
+}
@@ -115,6 +115,32 @@ struct FakeSai {
   sai_object_id_t getCpuSystemPort();
 };
 
+/*
+ * Runs a bulk call by programming each object with op(index). With
+ * SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, objects after the first failure are
+ * not executed. The call fails if any object failed.
+ */
+template <typename Op>
+sai_status_t fakeBulkOp(
+    uint32_t object_count,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses,
+    Op op) {
+  sai_status_t status = SAI_STATUS_SUCCESS;
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    object_statuses[i] = op(i);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+
 } // namespace facebook::fboss
 
 sai_status_t sai_api_initialize(
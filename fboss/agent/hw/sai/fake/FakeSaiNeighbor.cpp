@@ -16,6 +16,7 @@
 
 using facebook::fboss::FakeNeighbor;
 using facebook::fboss::FakeSai;
+using facebook::fboss::fakeBulkOp;
 
 sai_status_t create_neighbor_entry_fn(
     const sai_neighbor_entry_t* neighbor_entry,
@@ -132,6 +133,40 @@ sai_status_t get_neighbor_entry_attribute_fn(
   return SAI_STATUS_SUCCESS;
 }
 
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+sai_status_t create_neighbor_entries_fn(
+    uint32_t object_count,
+    const sai_neighbor_entry_t* neighbor_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto fs = FakeSai::getInstance();
+  return fakeBulkOp(
+      object_count, mode, object_statuses, [&](uint32_t i) -> sai_status_t {
+        auto ip =
+            facebook::fboss::fromSaiIpAddress(neighbor_entry[i].ip_address);
+        if (fs->neighborManager.exists(std::make_tuple(
+                neighbor_entry[i].switch_id, neighbor_entry[i].rif_id, ip))) {
+          return SAI_STATUS_ITEM_ALREADY_EXISTS;
+        }
+        return create_neighbor_entry_fn(
+            &neighbor_entry[i], attr_count[i], attr_list[i]);
+      });
+}
+
+sai_status_t remove_neighbor_entries_fn(
+    uint32_t object_count,
+    const sai_neighbor_entry_t* neighbor_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return fakeBulkOp(
+      object_count, mode, object_statuses, [&](uint32_t i) -> sai_status_t {
+        return remove_neighbor_entry_fn(&neighbor_entry[i]);
+      });
+}
+#endif
+
 namespace facebook::fboss {
 
 static sai_neighbor_api_t _neighbor_api;
@@ -141,6 +176,10 @@ void populate_neighbor_api(sai_neighbor_api_t** neighbor_api) {
   _neighbor_api.remove_neighbor_entry = &remove_neighbor_entry_fn;
   _neighbor_api.set_neighbor_entry_attribute = &set_neighbor_entry_attribute_fn;
   _neighbor_api.get_neighbor_entry_attribute = &get_neighbor_entry_attribute_fn;
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  _neighbor_api.create_neighbor_entries = &create_neighbor_entries_fn;
+  _neighbor_api.remove_neighbor_entries = &remove_neighbor_entries_fn;
+#endif
   *neighbor_api = &_neighbor_api;
 }
 
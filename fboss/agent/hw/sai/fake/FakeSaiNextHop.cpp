@@ -15,6 +15,7 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::fakeBulkOp;
 
 sai_status_t create_next_hop_fn(
     sai_object_id_t* next_hop_id,
@@ -122,6 +123,37 @@ sai_status_t get_next_hop_attribute_fn(
   return SAI_STATUS_SUCCESS;
 }
 
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+sai_status_t create_next_hops_fn(
+    sai_object_id_t switch_id,
+    uint32_t object_count,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_object_id_t* object_id,
+    sai_status_t* object_statuses) {
+  return fakeBulkOp(
+      object_count, mode, object_statuses, [&](uint32_t i) -> sai_status_t {
+        return create_next_hop_fn(
+            &object_id[i], switch_id, attr_count[i], attr_list[i]);
+      });
+}
+
+sai_status_t remove_next_hops_fn(
+    uint32_t object_count,
+    const sai_object_id_t* object_id,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto fs = FakeSai::getInstance();
+  return fakeBulkOp(
+      object_count, mode, object_statuses, [&](uint32_t i) -> sai_status_t {
+        return fs->nextHopManager.remove(object_id[i])
+            ? SAI_STATUS_SUCCESS
+            : SAI_STATUS_ITEM_NOT_FOUND;
+      });
+}
+#endif
+
 namespace facebook::fboss {
 
 static sai_next_hop_api_t _next_hop_api;
@@ -131,6 +163,10 @@ void populate_next_hop_api(sai_next_hop_api_t** next_hop_api) {
   _next_hop_api.remove_next_hop = &remove_next_hop_fn;
   _next_hop_api.set_next_hop_attribute = &set_next_hop_attribute_fn;
   _next_hop_api.get_next_hop_attribute = &get_next_hop_attribute_fn;
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+  _next_hop_api.create_next_hops = &create_next_hops_fn;
+  _next_hop_api.remove_next_hops = &remove_next_hops_fn;
+#endif
   *next_hop_api = &_next_hop_api;
 }
 
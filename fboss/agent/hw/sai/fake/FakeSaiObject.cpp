@@ -11,6 +11,8 @@
 #include "fboss/agent/hw/sai/api/AddressUtil.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
+#include <functional>
+
 sai_status_t sai_get_object_count(
     sai_object_id_t /* switch_id */,
     sai_object_type_t object_type,
@@ -612,3 +614,50 @@ sai_status_t sai_get_object_key(
   }
   return SAI_STATUS_SUCCESS;
 }
+
+#if SAI_API_VERSION >= SAI_VERSION(1, 11, 0)
+sai_status_t sai_bulk_object_get_stats(
+    sai_object_id_t /* switch_id */,
+    sai_object_type_t object_type,
+    uint32_t object_count,
+    const sai_object_key_t* object_key,
+    uint32_t number_of_counters,
+    const sai_stat_id_t* counter_ids,
+    sai_stats_mode_t mode,
+    sai_status_t* object_statuses,
+    uint64_t* counters) {
+  // Read object by object through the per object stats apis
+  std::function<sai_status_t(sai_object_id_t, uint64_t*)> getStats;
+  switch (object_type) {
+    case SAI_OBJECT_TYPE_PORT: {
+      sai_port_api_t* portApi;
+      sai_api_query(SAI_API_PORT, reinterpret_cast<void**>(&portApi));
+      getStats = [=](sai_object_id_t id, uint64_t* objectCounters) {
+        return portApi->get_port_stats_ext(
+            id, number_of_counters, counter_ids, mode, objectCounters);
+      };
+      break;
+    }
+    case SAI_OBJECT_TYPE_QUEUE: {
+      sai_queue_api_t* queueApi;
+      sai_api_query(SAI_API_QUEUE, reinterpret_cast<void**>(&queueApi));
+      getStats = [=](sai_object_id_t id, uint64_t* objectCounters) {
+        return queueApi->get_queue_stats_ext(
+            id, number_of_counters, counter_ids, mode, objectCounters);
+      };
+      break;
+    }
+    default:
+      return SAI_STATUS_NOT_SUPPORTED;
+  }
+  sai_status_t status = SAI_STATUS_SUCCESS;
+  for (auto i = 0; i < object_count; ++i) {
+    object_statuses[i] = getStats(
+        object_key[i].key.object_id, counters + i * number_of_counters);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+#endif
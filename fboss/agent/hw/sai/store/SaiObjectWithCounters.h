@@ -9,20 +9,32 @@
  */
 #pragma once
 
+#include "fboss/agent/hw/sai/api/SaiApiError.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
 #include "fboss/agent/hw/sai/store/SaiObject.h"
 #include "fboss/lib/RefMap.h"
 #include "fboss/lib/TupleUtils.h"
 
+#include <folly/Synchronized.h>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
 #include <variant>
+#include <vector>
 
 namespace facebook::fboss {
 
+template <typename SaiObjectTraits>
+class SaiStatsReadPlan;
+
 template <typename SaiObjectTraits>
 class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
  public:
   friend class SaiObjectStore<SaiObjectTraits>;
+  friend class SaiStatsReadPlan<SaiObjectTraits>;
   friend class SaiStoreTest;
   // Load from adapter key
   explicit SaiObjectWithCounters(
@@ -100,11 +112,138 @@ class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
   void fillInStats(
       const sai_stat_id_t* ids,
       const std::vector<uint64_t>& counters) {
-    for (auto i = 0; i < counters.size(); ++i) {
+    fillInStats(ids, counters.data(), counters.size());
+  }
+  void fillInStats(
+      const sai_stat_id_t* ids,
+      const uint64_t* counters,
+      size_t numCounters) {
+    for (auto i = 0; i < numCounters; ++i) {
       counterId2Value_[ids[i]] = counters[i];
     }
   }
   StatsMap counterId2Value_;
 };
 
+/*
+ * Counter reads of one stats collection cycle for objects of one type,
+ * grouped by the counter ids and mode read, so that objects reading the
+ * same counters are read together with bulk stats calls.
+ *
+ * Reading only uses the adapter keys of the objects and keeps the counters
+ * in the plan, so it may run without the lock guarding the objects. The
+ * counters are then filled into the objects still alive, under that lock.
+ */
+template <typename SaiObjectTraits>
+class SaiStatsReadPlan {
+ public:
+  using ObjectType = SaiObjectWithCounters<SaiObjectTraits>;
+  using AdapterKey = typename SaiObjectTraits::AdapterKey;
+
+  void add(
+      ObjectType* object,
+      const std::vector<sai_stat_id_t>& counterIds,
+      sai_stats_mode_t mode) {
+    if (!counterIds.empty()) {
+      reads_[std::make_pair(counterIds, mode)].push_back(
+          {object, object->adapterKey(), std::nullopt});
+    }
+  }
+
+  /*
+   * Read the counters with bulk stats calls of up to maxBulkSize objects,
+   * falling back to reading object by object when the adapter does not
+   * support bulk stats for these counters, or failed to read some of the
+   * objects. Objects which can't be read at all, e.g. since they were
+   * removed meanwhile, are skipped.
+   */
+  void read(sai_object_id_t switchId, size_t maxBulkSize) {
+    auto& api = SaiApiTable::getInstance()
+                    ->getApi<typename SaiObjectTraits::SaiApiT>();
+    maxBulkSize = std::max<size_t>(maxBulkSize, 1);
+    std::vector<AdapterKey> keys;
+    std::vector<sai_status_t> statuses;
+    for (auto& [counterSet, objectReads] : reads_) {
+      const auto& [counterIds, mode] = counterSet;
+      bool tryBulk =
+          maxBulkSize > 1 && !bulkUnsupported().rlock()->count(counterSet);
+      for (size_t begin = 0; begin < objectReads.size();
+           begin += maxBulkSize) {
+        auto end = std::min(begin + maxBulkSize, objectReads.size());
+        std::optional<std::vector<uint64_t>> counters;
+        if (tryBulk) {
+          keys.clear();
+          for (auto i = begin; i < end; ++i) {
+            keys.push_back(objectReads[i].key);
+          }
+          counters = api.template bulkGetStats<SaiObjectTraits>(
+              switchId, keys, counterIds, mode, statuses);
+          if (!counters) {
+            tryBulk = false;
+            bulkUnsupported().wlock()->insert(counterSet);
+          }
+        }
+        for (auto i = begin; i < end; ++i) {
+          auto& objectRead = objectReads[i];
+          if (counters && statuses[i - begin] == SAI_STATUS_SUCCESS) {
+            auto first = counters->begin() + (i - begin) * counterIds.size();
+            objectRead.counters.emplace(first, first + counterIds.size());
+            continue;
+          }
+          try {
+            objectRead.counters = api.template getStats<SaiObjectTraits>(
+                objectRead.key, counterIds, mode);
+          } catch (const SaiApiError& e) {
+            XLOGF(
+                DBG2, "Failed to get stats {}: {}", objectRead.key, e.what());
+          }
+        }
+      }
+    }
+  }
+
+  /*
+   * Fill the counters read into the objects isAlive(object) is true for,
+   * and clear the plan. Objects are only dereferenced once isAlive said so.
+   */
+  template <typename IsAliveFn>
+  void fillIn(IsAliveFn isAlive) {
+    for (const auto& [counterSet, objectReads] : reads_) {
+      const auto& counterIds = counterSet.first;
+      for (const auto& objectRead : objectReads) {
+        if (objectRead.counters && isAlive(objectRead.object) &&
+            objectRead.object->adapterKey() == objectRead.key) {
+          objectRead.object->fillInStats(
+              counterIds.data(),
+              objectRead.counters->data(),
+              counterIds.size());
+        }
+      }
+    }
+    reads_.clear();
+  }
+
+  void execute(sai_object_id_t switchId, size_t maxBulkSize) {
+    read(switchId, maxBulkSize);
+    fillIn([](const ObjectType* /*object*/) { return true; });
+  }
+
+ private:
+  using CounterSet = std::pair<std::vector<sai_stat_id_t>, sai_stats_mode_t>;
+  struct ObjectRead {
+    ObjectType* object;
+    AdapterKey key;
+    std::optional<std::vector<uint64_t>> counters;
+  };
+
+  // counter sets the adapter turned out not to support bulk stats for, an
+  // adapter may support them for some counters of a type only
+  static folly::Synchronized<std::set<CounterSet>>& bulkUnsupported() {
+    static folly::Synchronized<std::set<CounterSet>> counterSets;
+    return counterSets;
+  }
+
+  std::map<CounterSet, std::vector<ObjectRead>> reads_;
+};
+
 } // namespace facebook::fboss
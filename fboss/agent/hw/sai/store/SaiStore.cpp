@@ -10,6 +10,8 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include "fboss/lib/BinaryDynamic.h"
+
 namespace facebook::fboss {
 
 SaiStore::SaiStore(sai_object_id_t switchId) {
@@ -25,16 +27,50 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
     const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+  auto jsonLookup = [](const folly::dynamic* json) {
+    return [json](folly::StringPiece objectTypeName, folly::dynamic& /*storage*/)
+               -> const folly::dynamic* {
+      return json ? json->get_ptr(objectTypeName) : nullptr;
+    };
+  };
+  reloadImpl(
+      jsonLookup(adapterKeysJson), jsonLookup(adapterKeys2AdapterHostKeyJson));
+}
+
+void SaiStore::reload(
+    const BinaryDynamicView* adapterKeysBinary,
+    const BinaryDynamicView* adapterKeys2AdapterHostKeyBinary) {
+  auto binaryLookup = [](const BinaryDynamicView* binary) {
+    return [binary](folly::StringPiece objectTypeName, folly::dynamic& storage)
+               -> const folly::dynamic* {
+      auto keys = binary ? binary->find(objectTypeName) : std::nullopt;
+      if (!keys) {
+        return nullptr;
+      }
+      storage = keys->toDynamic();
+      return &storage;
+    };
+  };
+  reloadImpl(
+      binaryLookup(adapterKeysBinary),
+      binaryLookup(adapterKeys2AdapterHostKeyBinary));
+}
+
+void SaiStore::reloadImpl(
+    const WarmbootKeysLookup& adapterKeysLookup,
+    const WarmbootKeysLookup& adapterKeys2AdapterHostKeyLookup) {
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
+      [&adapterKeysLookup, &adapterKeys2AdapterHostKeyLookup](auto& store) {
         using ObjectTraits =
             typename std::decay_t<decltype(store)>::ObjectTraits;
-        const folly::dynamic* adapterKeys = adapterKeysJson
-            ? adapterKeysJson->get_ptr(store.objectTypeName())
-            : nullptr;
-        const folly::dynamic* adapterHostKeys = adapterKeys2AdapterHostKeyJson
-            ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
-            : nullptr;
+        folly::dynamic adapterKeysStorage;
+        folly::dynamic adapterHostKeysStorage;
+        folly::dynamic newAdapterHostKeysStorage;
+        const folly::dynamic* adapterKeys =
+            adapterKeysLookup(store.objectTypeName(), adapterKeysStorage);
+        const folly::dynamic* adapterHostKeys =
+            adapterKeys2AdapterHostKeyLookup(
+                store.objectTypeName(), adapterHostKeysStorage);
         // Refer to D75845886 for details
         // In the adapterKey2AdapterHostKey map in warm boot file,
         // Pre D75845886, adapterHostKey for nhop-group is a simple list of
@@ -54,9 +90,8 @@ void SaiStore::reload(
         // If it is present, prefer the new map with the new format
         if (ObjectTraits::ObjectType == SAI_OBJECT_TYPE_NEXT_HOP_GROUP) {
           const folly::dynamic* newAdapterHostKeys =
-              adapterKeys2AdapterHostKeyJson
-              ? adapterKeys2AdapterHostKeyJson->get_ptr(kNhopGroupWithModeName)
-              : nullptr;
+              adapterKeys2AdapterHostKeyLookup(
+                  kNhopGroupWithModeName, newAdapterHostKeysStorage);
           if (newAdapterHostKeys) {
             adapterHostKeys = newAdapterHostKeys;
           }
@@ -27,6 +27,7 @@
 
 #include <folly/json/dynamic.h>
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -38,6 +39,8 @@ extern "C" {
 
 namespace facebook::fboss {
 
+class BinaryDynamicView;
+
 inline constexpr auto kAdapterKey2AdapterHostKey = "adapterKey2AdapterHostKey";
 inline constexpr auto kNhopGroupWithModeName = "nhop-group-with-mode";
 
@@ -280,6 +283,134 @@ class SaiObjectStore {
     }
   }
 
+  /*
+   * Program a batch of objects with one SAI bulk create for the ones not in
+   * the store yet, existing objects get their attributes updated one by one
+   * as in setObject. Adapter host keys in a batch must be unique. Objects
+   * failing to create come back as nullptr and their SAI status is reported
+   * through statuses.
+   */
+  std::vector<std::shared_ptr<ObjectType>> bulkSetObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes,
+      std::vector<sai_status_t>* statuses = nullptr,
+      bool notify = true) {
+    if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+      static_assert(
+          !IsPublisherKeyCustomType<SaiObjectTraits>::value,
+          "method not available for objects with publisher attributes of custom types");
+    }
+    CHECK_EQ(adapterHostKeys.size(), attributes.size());
+    std::vector<std::shared_ptr<ObjectType>> objects(adapterHostKeys.size());
+    if (statuses) {
+      statuses->assign(adapterHostKeys.size(), SAI_STATUS_SUCCESS);
+    }
+    std::vector<size_t> toCreate;
+    std::vector<typename SaiObjectTraits::AdapterHostKey> createHostKeys;
+    std::vector<typename SaiObjectTraits::CreateAttributes> createAttributes;
+    for (auto idx = 0; idx < adapterHostKeys.size(); ++idx) {
+      if (objects_.ref(adapterHostKeys[idx])) {
+        objects[idx] = setObject(adapterHostKeys[idx], attributes[idx], notify);
+        continue;
+      }
+      toCreate.push_back(idx);
+      createHostKeys.push_back(adapterHostKeys[idx]);
+      createAttributes.push_back(attributes[idx]);
+    }
+    if (toCreate.empty()) {
+      return objects;
+    }
+    XLOGF(
+        DBG5,
+        "SaiStore bulk creating {} {} objects",
+        toCreate.size(),
+        objectTypeName());
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    std::vector<sai_status_t> createStatuses;
+    if constexpr (AdapterKeyIsObjectId<SaiObjectTraits>::value) {
+      createStatuses = api.template bulkCreate<SaiObjectTraits>(
+          createAttributes, saiSwitchId_.value(), adapterKeys);
+    } else {
+      adapterKeys = createHostKeys;
+      createStatuses = api.template bulkCreate<SaiObjectTraits>(
+          adapterKeys, createAttributes);
+    }
+    for (auto i = 0; i < toCreate.size(); ++i) {
+      auto idx = toCreate[i];
+      if (createStatuses[i] != SAI_STATUS_SUCCESS) {
+        if (statuses) {
+          (*statuses)[idx] = createStatuses[i];
+        }
+        continue;
+      }
+      auto ins = objects_.refOrInsert(
+          createHostKeys[i],
+          ObjectType(adapterKeys[i], createHostKeys[i], createAttributes[i]),
+          true /*force*/);
+      if (notify) {
+        if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+          ins.first->notifyAfterCreate(ins.first);
+        }
+      }
+      XLOGF(DBG5, "SaiStore bulk created object {}", *ins.first);
+      objects[idx] = ins.first;
+    }
+    return objects;
+  }
+
+  /*
+   * Remove a batch of objects with one SAI bulk remove. objects must hold the
+   * last references to them, objects still referenced elsewhere are dropped
+   * without being removed, as releasing the reference would do. Returns the
+   * adapter keys which failed to be removed, those objects are no longer
+   * tracked by the store either way.
+   */
+  std::vector<typename SaiObjectTraits::AdapterKey> bulkRemoveObjects(
+      std::vector<std::shared_ptr<ObjectType>> objects) {
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    std::vector<ObjectType*> toRemove;
+    for (auto& object : objects) {
+      if (!object || object.use_count() > 1) {
+        continue;
+      }
+      if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+        object->notifyBeforeDestroy();
+      }
+      if (object->isOwnedByAdapter() || object->skipRemove_ ||
+          IsSaiObjectOwnedByAdapter<SaiObjectTraits>::value) {
+        object->release();
+        continue;
+      }
+      adapterKeys.push_back(object->adapterKey());
+      toRemove.push_back(object.get());
+    }
+    std::vector<typename SaiObjectTraits::AdapterKey> failed;
+    if (!adapterKeys.empty()) {
+      XLOGF(
+          DBG5,
+          "SaiStore bulk removing {} {} objects",
+          adapterKeys.size(),
+          objectTypeName());
+      auto& api = SaiApiTable::getInstance()
+                      ->getApi<typename SaiObjectTraits::SaiApiT>();
+      auto removeStatuses = api.bulkRemove(adapterKeys);
+      for (auto idx = 0; idx < toRemove.size(); ++idx) {
+        auto status = removeStatuses[idx];
+        if (status != SAI_STATUS_SUCCESS &&
+            !(toRemove[idx]->ignoreMissingInHwOnDelete_ &&
+              status == SAI_STATUS_ITEM_NOT_FOUND)) {
+          failed.push_back(adapterKeys[idx]);
+        }
+        toRemove[idx]->release();
+      }
+    }
+    return failed;
+  }
+
   std::shared_ptr<ObjectType> get(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
     XLOGF(DBG5, "SaiStore get object {}", adapterHostKey);
@@ -548,6 +679,14 @@ class SaiStore {
       const folly::dynamic* adapterKeys = nullptr,
       const folly::dynamic* adapterKeys2AdapterHostKey = nullptr);
 
+  /*
+   * Reload from warm boot state stored in binary form. Keys are decoded one
+   * object type at a time, rather than holding the whole state decoded.
+   */
+  void reload(
+      const BinaryDynamicView* adapterKeys,
+      const BinaryDynamicView* adapterKeys2AdapterHostKey);
+
   /*
    *
    */
@@ -576,6 +715,18 @@ class SaiStore {
   void printWarmbootHandles() const;
 
  private:
+  /*
+   * Looks up the warm boot keys of an object type by name, returning null if
+   * absent. Decoded keys may be placed in the passed in storage.
+   */
+  using WarmbootKeysLookup = std::function<const folly::dynamic*(
+      folly::StringPiece objectTypeName,
+      folly::dynamic& storage)>;
+
+  void reloadImpl(
+      const WarmbootKeysLookup& adapterKeys,
+      const WarmbootKeysLookup& adapterKeys2AdapterHostKey);
+
   /*
    * Set the switch id on all the SaiObjectStores
    * Useful for the singleton mode of operation, which is constructed
@@ -35,6 +35,7 @@
 #include <folly/logging/xlog.h>
 
 #include <chrono>
+#include <unordered_set>
 
 #include <fmt/ranges.h>
 
@@ -56,6 +57,18 @@ DEFINE_int32(
     10,
     "Interval in seconds for reading fec counters");
 
+DEFINE_bool(
+    sai_bulk_stats_collection,
+    false,
+    "Read port and queue counters of several ports with SAI bulk stats calls, "
+    "where the adapter supports them");
+
+DEFINE_int32(
+    sai_stats_bulk_size,
+    64,
+    "Number of ports whose stats are collected together, and maximum number "
+    "of objects read by a single SAI bulk stats call");
+
 using namespace std::chrono;
 
 namespace facebook::fboss {
@@ -1925,81 +1938,171 @@ void SaiPortManager::updateStats(
     PortID portId,
     bool updateWatermarks,
     bool updateCableLengths) {
-  auto handlesItr = handles_.find(portId);
-  if (handlesItr == handles_.end()) {
-    return;
+  updateStats(
+      std::vector<PortID>{portId}, updateWatermarks, updateCableLengths);
+}
+
+void SaiPortManager::updateStats(
+    const std::vector<PortID>& portIds,
+    bool updateWatermarks,
+    bool updateCableLengths) {
+  auto collection = planStatsCollection(portIds, updateWatermarks);
+  collection.read();
+  updateStats(collection, updateCableLengths);
+}
+
+SaiPortStatsCollection SaiPortManager::planStatsCollection(
+    const std::vector<PortID>& portIds,
+    bool updateWatermarks) {
+  SaiPortStatsCollection collection;
+  collection.switchId = managerTable_->switchManager().getSwitchSaiId();
+  collection.maxBulkSize =
+      FLAGS_sai_bulk_stats_collection ? FLAGS_sai_stats_bulk_size : 1;
+  collection.now =
+      duration_cast<seconds>(system_clock::now().time_since_epoch());
+  collection.updateWatermarks = updateWatermarks;
+  // Plan the counter reads of all the ports first, so that ports and queues
+  // reading the same counters are read together.
+  for (auto portId : portIds) {
+    auto handlesItr = handles_.find(portId);
+    if (handlesItr == handles_.end() ||
+        portStats_.find(portId) == portStats_.end()) {
+      // We don't maintain port stats for disabled ports.
+      continue;
+    }
+    auto* handle = handlesItr->second.get();
+    auto updateFecStats = addStatsReads(
+        portId,
+        handle,
+        collection.now,
+        updateWatermarks,
+        collection.portReads);
+    managerTable_->queueManager().addStatsReads(
+        handle->configuredQueues, updateWatermarks, collection.queueReads);
+    collection.ports.push_back(
+        {portId, handle->port.get(), handle->configuredQueues, updateFecStats});
   }
-  auto portType = getPortType(portId);
-  auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
-  auto* handle = handlesItr->second.get();
-  auto portStatItr = portStats_.find(portId);
-  if (portStatItr == portStats_.end()) {
-    // We don't maintain port stats for disabled ports.
-    return;
+  return collection;
+}
+
+void SaiPortManager::updateStats(
+    SaiPortStatsCollection& collection,
+    bool updateCableLengths) {
+  // ports and queues still the ones the counters were read for
+  std::vector<const SaiPortStatsCollection::PortToUpdate*> portsToUpdate;
+  std::unordered_set<const SaiPort*> alivePorts;
+  std::unordered_set<const SaiQueue*> aliveQueues;
+  for (const auto& portToUpdate : collection.ports) {
+    auto handlesItr = handles_.find(portToUpdate.portId);
+    if (handlesItr == handles_.end() ||
+        portStats_.find(portToUpdate.portId) == portStats_.end() ||
+        handlesItr->second->port.get() != portToUpdate.port ||
+        handlesItr->second->configuredQueues != portToUpdate.queues) {
+      continue;
+    }
+    portsToUpdate.push_back(&portToUpdate);
+    alivePorts.insert(portToUpdate.port);
+    for (auto queueHandle : portToUpdate.queues) {
+      aliveQueues.insert(queueHandle->queue.get());
+    }
   }
-  const auto& prevPortStats = portStatItr->second->portStats();
-  HwPortStats curPortStats{prevPortStats};
-  // All stats start with a unitialized (-1) value. If there are no in
-  // discards (first collection) we will just report that -1 as the monotonic
-  // counter. Instead set it to 0 if uninintialized
-  setUninitializedStatsToZero(*curPortStats.inCongestionDiscards_());
-  setUninitializedStatsToZero(*curPortStats.inDiscards_());
-  setUninitializedStatsToZero(*curPortStats.fecCorrectableErrors());
-  setUninitializedStatsToZero(*curPortStats.fecUncorrectableErrors());
-  // For fabric ports the following counters would never be collected
-  // Set them to 0
-  setUninitializedStatsToZero(*curPortStats.inDstNullDiscards_());
-  setUninitializedStatsToZero(*curPortStats.inDiscardsRaw_());
-  setUninitializedStatsToZero(*curPortStats.inPause_());
+  collection.portReads.fillIn(
+      [&alivePorts](const SaiPort* port) { return alivePorts.contains(port); });
+  collection.queueReads.fillIn([&aliveQueues](const SaiQueue* queue) {
+    return aliveQueues.contains(queue);
+  });
+  for (const auto* portToUpdate : portsToUpdate) {
+    updateStatsFromCounters(
+        portToUpdate->portId,
+        collection.now,
+        collection.updateWatermarks,
+        updateCableLengths,
+        portToUpdate->updateFecStats);
+  }
+}
 
-  curPortStats.timestamp_() = now.count();
-  handle->port->updateStats(supportedStats(portId), SAI_STATS_MODE_READ);
+bool SaiPortManager::addStatsReads(
+    PortID portId,
+    SaiPortHandle* handle,
+    std::chrono::seconds now,
+    bool updateWatermarks,
+    SaiStatsReadPlan<SaiPortTraits>& plan) {
+  auto* port = handle->port.get();
+  plan.add(port, supportedStats(portId), SAI_STATS_MODE_READ);
 #if defined(BRCM_SAI_SDK_DNX_GTE_12_0)
   if (updateWatermarks &&
       platform_->getAsic()->isSupported(HwAsic::Feature::FAST_LLFC_COUNTER)) {
-    handle->port->updateStats(
+    plan.add(
+        port,
         {SAI_PORT_STAT_FAST_LLFC_TRIGGER_STATUS},
         SAI_STATS_MODE_READ_AND_CLEAR);
   }
 #endif
 
-  bool updateFecStats = false;
   auto lastFecReadTimeIt = lastFecCounterReadTime_.find(portId);
-  if (lastFecReadTimeIt == lastFecCounterReadTime_.end() ||
-      (now.count() - lastFecReadTimeIt->second) >=
+  if (lastFecReadTimeIt != lastFecCounterReadTime_.end() &&
+      (now.count() - lastFecReadTimeIt->second) <
           FLAGS_fec_counters_update_interval_s) {
-    lastFecCounterReadTime_[portId] = now.count();
-    updateFecStats = true;
-    if (fecStatsSupported(portId)) {
-      handle->port->updateStats(
-          {SAI_PORT_STAT_IF_IN_FEC_CORRECTABLE_FRAMES,
-           SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES},
-          SAI_STATS_MODE_READ_AND_CLEAR);
-    }
+    return false;
+  }
+  lastFecCounterReadTime_[portId] = now.count();
+  if (fecStatsSupported(portId)) {
+    plan.add(
+        port,
+        {SAI_PORT_STAT_IF_IN_FEC_CORRECTABLE_FRAMES,
+         SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES},
+        SAI_STATS_MODE_READ_AND_CLEAR);
+  }
 #if SAI_API_VERSION >= SAI_VERSION(1, 13, 0)
-    if (fecCorrectedBitsSupported(portId)) {
-      handle->port->updateStats(
-          {SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS}, SAI_STATS_MODE_READ);
-    }
+  if (fecCorrectedBitsSupported(portId)) {
+    plan.add(
+        port, {SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS}, SAI_STATS_MODE_READ);
+  }
 #endif
 #if SAI_API_VERSION >= SAI_VERSION(1, 11, 0)
-    if (fecCodewordsStatsSupported(portId)) {
-      // maxFecCounterId should ideally be derived from SAI attribute
-      // SAI_PORT_ATTR_MAX_FEC_SYMBOL_ERRORS_DETECTABLE but this attribute isn't
-      // supported yet
-      sai_stat_id_t maxFecCounterId = getFECMode(portId) == phy::FecMode::RS528
-          ? SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S8
-          : SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S15;
-      std::vector<sai_stat_id_t> fecCodewordsToRead;
-      for (int counterId = SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S0;
-           counterId <= (int)maxFecCounterId;
-           counterId++) {
-        fecCodewordsToRead.push_back(static_cast<sai_stat_id_t>(counterId));
-      }
-      handle->port->updateStats(fecCodewordsToRead, SAI_STATS_MODE_READ);
+  if (fecCodewordsStatsSupported(portId)) {
+    // maxFecCounterId should ideally be derived from SAI attribute
+    // SAI_PORT_ATTR_MAX_FEC_SYMBOL_ERRORS_DETECTABLE but this attribute isn't
+    // supported yet
+    sai_stat_id_t maxFecCounterId = getFECMode(portId) == phy::FecMode::RS528
+        ? SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S8
+        : SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S15;
+    std::vector<sai_stat_id_t> fecCodewordsToRead;
+    for (int counterId = SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S0;
+         counterId <= (int)maxFecCounterId;
+         counterId++) {
+      fecCodewordsToRead.push_back(static_cast<sai_stat_id_t>(counterId));
     }
-#endif
+    plan.add(port, fecCodewordsToRead, SAI_STATS_MODE_READ);
   }
+#endif
+  return true;
+}
+
+void SaiPortManager::updateStatsFromCounters(
+    PortID portId,
+    std::chrono::seconds now,
+    bool updateWatermarks,
+    bool updateCableLengths,
+    bool updateFecStats) {
+  auto portType = getPortType(portId);
+  auto* handle = handles_.find(portId)->second.get();
+  const auto& prevPortStats = portStats_.find(portId)->second->portStats();
+  HwPortStats curPortStats{prevPortStats};
+  // All stats start with a unitialized (-1) value. If there are no in
+  // discards (first collection) we will just report that -1 as the monotonic
+  // counter. Instead set it to 0 if uninintialized
+  setUninitializedStatsToZero(*curPortStats.inCongestionDiscards_());
+  setUninitializedStatsToZero(*curPortStats.inDiscards_());
+  setUninitializedStatsToZero(*curPortStats.fecCorrectableErrors());
+  setUninitializedStatsToZero(*curPortStats.fecUncorrectableErrors());
+  // For fabric ports the following counters would never be collected
+  // Set them to 0
+  setUninitializedStatsToZero(*curPortStats.inDstNullDiscards_());
+  setUninitializedStatsToZero(*curPortStats.inDiscardsRaw_());
+  setUninitializedStatsToZero(*curPortStats.inPause_());
+
+  curPortStats.timestamp_() = now.count();
   const auto& counters = handle->port->getStats();
   fillHwPortStats(
       counters,
@@ -2026,7 +2129,10 @@ void SaiPortManager::updateStats(
       {*prevPortStats.inDiscardsRaw_(), *curPortStats.inDiscardsRaw_()},
       toSubtractFromInDiscardsRaw);
   managerTable_->queueManager().updateStats(
-      handle->configuredQueues, curPortStats, updateWatermarks);
+      handle->configuredQueues,
+      curPortStats,
+      updateWatermarks,
+      true /* statsPrefetched */);
   managerTable_->macsecManager().updateStats(portId, curPortStats);
   managerTable_->bufferManager().updateIngressPriorityGroupStats(
       portId, curPortStats, updateWatermarks);
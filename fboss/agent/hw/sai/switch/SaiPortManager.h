@@ -30,7 +30,11 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 DECLARE_bool(sai_configure_six_tap);
+DECLARE_bool(sai_bulk_stats_collection);
+DECLARE_int32(sai_stats_bulk_size);
 
 namespace facebook::fboss {
 
@@ -121,6 +125,33 @@ struct SaiPortHandle {
       configuredIngressPriorityGroups;
 };
 
+/*
+ * Port and queue counter reads of several ports for one stats collection
+ * cycle. Planned and filled in under saiSwitchMutex_, while the counters
+ * are read without it, see SaiPortManager::planStatsCollection().
+ */
+struct SaiPortStatsCollection {
+  struct PortToUpdate {
+    PortID portId;
+    SaiPort* port;
+    std::vector<SaiQueueHandle*> queues;
+    bool updateFecStats;
+  };
+
+  void read() {
+    portReads.read(switchId, maxBulkSize);
+    queueReads.read(switchId, maxBulkSize);
+  }
+
+  sai_object_id_t switchId{};
+  size_t maxBulkSize{1};
+  std::chrono::seconds now{};
+  bool updateWatermarks{false};
+  SaiStatsReadPlan<SaiPortTraits> portReads;
+  SaiStatsReadPlan<SaiQueueTraits> queueReads;
+  std::vector<PortToUpdate> ports;
+};
+
 class SaiPortManager {
   using Handles = folly::F14FastMap<PortID, std::unique_ptr<SaiPortHandle>>;
   using Stats = folly::F14FastMap<PortID, std::unique_ptr<HwPortFb303Stats>>;
@@ -228,6 +259,27 @@ class SaiPortManager {
       PortID portID,
       bool updateWatermarks = false,
       bool updateCableLengths = false);
+  /*
+   * Collect stats of several ports together. Port and queue counters of all
+   * the ports are planned first, then read per counter set, in bulk where
+   * enabled by --sai_bulk_stats_collection.
+   */
+  void updateStats(
+      const std::vector<PortID>& portIDs,
+      bool updateWatermarks = false,
+      bool updateCableLengths = false);
+  /*
+   * The same in steps, so that the counters can be read without holding
+   * saiSwitchMutex_: plan the reads under the mutex, read() the collection
+   * without it, then update the stats from it under the mutex again. Ports
+   * and queues removed or changed in between are left out.
+   */
+  SaiPortStatsCollection planStatsCollection(
+      const std::vector<PortID>& portIDs,
+      bool updateWatermarks);
+  void updateStats(
+      SaiPortStatsCollection& collection,
+      bool updateCableLengths = false);
 
   void updateConnectivityStats(PortID portID);
 
@@ -338,6 +390,19 @@ class SaiPortManager {
       PortID portID,
       std::vector<std::pair<sai_qos_map_type_t, QosMapSaiId>>& qosMaps);
   const std::vector<sai_stat_id_t>& supportedStats(PortID port);
+  // returns whether FEC counters are due and were added
+  bool addStatsReads(
+      PortID portID,
+      SaiPortHandle* handle,
+      std::chrono::seconds now,
+      bool updateWatermarks,
+      SaiStatsReadPlan<SaiPortTraits>& plan);
+  void updateStatsFromCounters(
+      PortID portID,
+      std::chrono::seconds now,
+      bool updateWatermarks,
+      bool updateCableLengths,
+      bool updateFecStats);
   void fillInSupportedStats(PortID port);
   bool fecStatsSupported(PortID portID) const;
   SaiPortHandle* getPortHandleImpl(PortID swId) const;
@@ -561,11 +561,10 @@ SaiQueueManager::supportedWatermarkCounterIdsReadAndClear(int queueType) const {
   return watermarkStats;
 }
 
-void SaiQueueManager::updateStats(
+void SaiQueueManager::addStatsReads(
     const std::vector<SaiQueueHandle*>& queueHandles,
-    HwPortStats& hwPortStats,
-    bool updateWatermarks) {
-  hwPortStats.outCongestionDiscardPkts_() = 0;
+    bool updateWatermarks,
+    SaiStatsReadPlan<SaiQueueTraits>& plan) {
   static std::vector<sai_stat_id_t> nonWatermarkStatsReadAndClear(
       SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.begin(),
       SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.end());
@@ -576,22 +575,39 @@ void SaiQueueManager::updateStats(
      * care of in the API supportedNonWatermarkCounterIdsRead().
      * Hence, not using queueHandle->queue->updateStats() directly.
      */
-    auto queueType = SaiApiTable::getInstance()->queueApi().getAttribute(
-        queueHandle->queue->adapterKey(), SaiQueueTraits::Attributes::Type{});
-
-    queueHandle->queue->updateStats(
+    auto queueType = GET_ATTR(Queue, Type, queueHandle->queue->attributes());
+    plan.add(
+        queueHandle->queue.get(),
         supportedNonWatermarkCounterIdsRead(queueType, queueHandle),
         SAI_STATS_MODE_READ);
-    queueHandle->queue->updateStats(
-        nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
+    plan.add(
+        queueHandle->queue.get(),
+        nonWatermarkStatsReadAndClear,
+        SAI_STATS_MODE_READ_AND_CLEAR);
     if (updateWatermarks) {
-      queueHandle->queue->updateStats(
+      plan.add(
+          queueHandle->queue.get(),
           supportedWatermarkCounterIdsReadAndClear(queueType),
           SAI_STATS_MODE_READ_AND_CLEAR);
     }
+  }
+}
+
+void SaiQueueManager::updateStats(
+    const std::vector<SaiQueueHandle*>& queueHandles,
+    HwPortStats& hwPortStats,
+    bool updateWatermarks,
+    bool statsPrefetched) {
+  hwPortStats.outCongestionDiscardPkts_() = 0;
+  if (!statsPrefetched) {
+    SaiStatsReadPlan<SaiQueueTraits> plan;
+    addStatsReads(queueHandles, updateWatermarks, plan);
+    plan.execute(
+        managerTable_->switchManager().getSwitchSaiId(), 1 /* maxBulkSize */);
+  }
+  for (auto queueHandle : queueHandles) {
     const auto& counters = queueHandle->queue->getStats();
-    auto queueId = SaiApiTable::getInstance()->queueApi().getAttribute(
-        queueHandle->queue->adapterKey(), SaiQueueTraits::Attributes::Index{});
+    auto queueId = GET_ATTR(Queue, Index, queueHandle->queue->attributes());
     fillHwQueueStats(queueId, counters, hwPortStats);
   }
 }
@@ -90,10 +90,20 @@ class SaiQueueManager {
       const SaiQueueHandles& queueHandles,
       const QueueConfig& queues,
       const facebook::fboss::Port* swPort);
+  /*
+   * Add the counter reads of a stats collection cycle for these queues, so
+   * they can be read together with those of other ports.
+   */
+  void addStatsReads(
+      const std::vector<SaiQueueHandle*>& queues,
+      bool updateWatermarks,
+      SaiStatsReadPlan<SaiQueueTraits>& plan);
+  // statsPrefetched if the reads added by addStatsReads were executed
   void updateStats(
       const std::vector<SaiQueueHandle*>& queues,
       HwPortStats& stats,
-      bool updateWatermarks);
+      bool updateWatermarks,
+      bool statsPrefetched = false);
   void updateStats(
       const std::vector<SaiQueueHandle*>& queues,
       HwSysPortStats& stats,
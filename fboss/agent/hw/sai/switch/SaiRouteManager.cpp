@@ -31,6 +31,16 @@ DEFINE_bool(
     false,
     "Disable valid route check when creating or changing routes in SAI switches");
 
+DEFINE_bool(
+    sai_bulk_route_programming,
+    false,
+    "Program routes added and removed by a state update with SAI bulk calls");
+
+DEFINE_int32(
+    sai_route_bulk_size,
+    1024,
+    "Maximum number of routes programmed by a single SAI bulk call");
+
 namespace facebook::fboss {
 
 sai_object_id_t SaiRouteHandle::nextHopAdapterKey() const {
@@ -439,6 +449,17 @@ void SaiRouteManager::addOrUpdateRoute(
 
     XLOG(DBG3) << "Route action DROP: " << newRoute->str();
   }
+  if (!routeHandle->route && bulkProgramming()) {
+    routeHandle->nexthopHandle_ = nextHopHandle;
+    routeHandle->counterHandle_ = counterHandle;
+    pendingCreates_.push_back(
+        {entry, attributes.value(), !newRoute->isConnected()});
+    pendingCreateEntries_.insert(entry);
+    if (pendingCreates_.size() >= FLAGS_sai_route_bulk_size) {
+      flushRouteCreates();
+    }
+    return;
+  }
   auto& store = saiStore_->get<SaiRouteTraits>();
   auto route = store.setObject(entry, attributes.value());
   routeHandle->route = route;
@@ -487,10 +508,20 @@ void SaiRouteManager::addRoute(
     XLOG(DBG3) << "Not a valid route, don't add: " << swRoute->str();
     return;
   }
+  if (!pendingRemoves_.empty()) {
+    // a queued removal may be freeing up space in the route table
+    flushRouteRemoves();
+  }
   auto routeHandle = std::make_unique<SaiRouteHandle>();
-  addOrUpdateRoute(
-      routeHandle.get(), routerId, std::shared_ptr<Route<AddrT>>{}, swRoute);
+  auto routeHandlePtr = routeHandle.get();
   handles_.emplace(entry, std::move(routeHandle));
+  try {
+    addOrUpdateRoute(
+        routeHandlePtr, routerId, std::shared_ptr<Route<AddrT>>{}, swRoute);
+  } catch (const std::exception&) {
+    handles_.erase(entry);
+    throw;
+  }
 }
 
 template <typename AddrT>
@@ -503,11 +534,23 @@ void SaiRouteManager::removeRoute(
   }
   XLOG(DBG3) << "Remove route: " << swRoute->str();
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
-  size_t count = handles_.erase(entry);
-  if (!count) {
+  auto itr = handles_.find(entry);
+  if (itr == handles_.end()) {
     throw FbossError(
         "Failed to remove non-existent route to ", swRoute->prefix().str());
   }
+  if (bulkProgramming()) {
+    if (pendingCreateEntries_.count(entry)) {
+      flushRouteCreates();
+    }
+    pendingRemoves_.push_back(std::move(itr->second));
+    handles_.erase(itr);
+    if (pendingRemoves_.size() >= FLAGS_sai_route_bulk_size) {
+      flushRouteRemoves();
+    }
+    return;
+  }
+  handles_.erase(itr);
 }
 
 template <typename AddrT>
@@ -542,14 +585,108 @@ SaiRouteHandle* SaiRouteManager::getRouteHandleImpl(
 }
 
 void SaiRouteManager::clear() {
+  pendingCreates_.clear();
+  pendingCreateEntries_.clear();
+  pendingRemoves_.clear();
   handles_.clear();
 }
 
 std::shared_ptr<SaiObject<SaiRouteTraits>> SaiRouteManager::getRouteObject(
     SaiRouteTraits::AdapterHostKey routeKey) {
+  if (pendingCreateEntries_.count(routeKey)) {
+    // route is queued to be created, create it so it can be updated
+    flushRouteCreates();
+  }
   return saiStore_->get<SaiRouteTraits>().get(routeKey);
 }
 
+bool SaiRouteManager::bulkProgramming() const {
+  // Adapters without the bulk route calls fall back to per route calls
+  return FLAGS_sai_bulk_route_programming &&
+      SaiApiTable::getInstance()->routeApi().bulkSupported();
+}
+
+void SaiRouteManager::flushRouteBatch() {
+  flushRouteRemoves();
+  flushRouteCreates();
+}
+
+void SaiRouteManager::flushRouteRemoves() {
+  if (pendingRemoves_.empty()) {
+    return;
+  }
+  auto handles = std::move(pendingRemoves_);
+  pendingRemoves_.clear();
+  std::vector<std::shared_ptr<SaiRoute>> routes;
+  routes.reserve(handles.size());
+  for (auto& handle : handles) {
+    routes.push_back(std::move(handle->route));
+  }
+  XLOG(DBG3) << "Bulk remove " << routes.size() << " routes";
+  auto failed =
+      saiStore_->get<SaiRouteTraits>().bulkRemoveObjects(std::move(routes));
+  // release next hops and counters now that no route points to them
+  handles.clear();
+  if (!failed.empty()) {
+    throw FbossError(
+        "Failed to remove ",
+        failed.size(),
+        " routes, including ",
+        failed.front().toString());
+  }
+}
+
+void SaiRouteManager::flushRouteCreates() {
+  if (pendingCreates_.empty()) {
+    return;
+  }
+  auto pending = std::move(pendingCreates_);
+  pendingCreates_.clear();
+  pendingCreateEntries_.clear();
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  std::vector<SaiRouteHandle*> routeHandles;
+  for (auto& create : pending) {
+    auto routeHandle = getRouteHandleImpl(create.entry);
+    if (!routeHandle || routeHandle->route) {
+      // removed or already programmed since being queued
+      continue;
+    }
+    entries.push_back(create.entry);
+    attributes.push_back(std::move(create.attributes));
+    routeHandles.push_back(routeHandle);
+  }
+  XLOG(DBG3) << "Bulk create " << entries.size() << " routes";
+  std::vector<sai_status_t> statuses;
+  auto routes = saiStore_->get<SaiRouteTraits>().bulkSetObjects(
+      entries, attributes, &statuses);
+  std::optional<SaiRouteTraits::RouteEntry> firstFailed;
+  size_t numFailed = 0;
+  for (auto idx = 0; idx < routes.size(); ++idx) {
+    if (!routes[idx]) {
+      // as a failed addRoute, leave no handle behind
+      handles_.erase(entries[idx]);
+      if (!numFailed++) {
+        firstFailed = entries[idx];
+      }
+      continue;
+    }
+    routeHandles[idx]->route = routes[idx];
+  }
+  for (const auto& create : pending) {
+    if (create.checkMetadata) {
+      checkMetadata(create.entry);
+    }
+  }
+  if (numFailed) {
+    throw FbossError(
+        "Failed to create ",
+        numFailed,
+        " routes, including ",
+        firstFailed->toString());
+  }
+}
+
 template <typename AddrT>
 std::shared_ptr<SaiCounterHandle> SaiRouteManager::getCounterHandleForRoute(
     const std::shared_ptr<Route<AddrT>>& newRoute,
@@ -720,6 +857,12 @@ void ManagedRouteNextHop<NextHopTraitsT>::beforeRemove() {
              << routeKey_.toString();
 
   auto route = routeManager_->getRouteObject(routeKey_);
+  if (!route) {
+    XLOG(DBG2) << "ManagedRouteNextHop beforeRemove, route not yet created: "
+               << routeKey_.toString();
+    this->setPublisherObject(nullptr);
+    return;
+  }
   auto attributes = route->attributes();
   auto& api = SaiApiTable::getInstance()->routeApi();
 
@@ -17,6 +17,7 @@
 #include "fboss/agent/types.h"
 
 #include "folly/container/F14Map.h"
+#include "folly/container/F14Set.h"
 
 #include "fboss/agent/hw/sai/store/SaiObjectEventSubscriber.h"
 
@@ -25,6 +26,8 @@
 
 DECLARE_bool(disable_valid_route_check);
 DECLARE_bool(classid_for_unresolved_routes);
+DECLARE_bool(sai_bulk_route_programming);
+DECLARE_int32(sai_route_bulk_size);
 
 namespace facebook::fboss {
 
@@ -141,7 +144,26 @@ class SaiRouteManager {
 
   void checkMetadata(SaiRouteTraits::RouteEntry entry);
 
+  /*
+   * With FLAGS_sai_bulk_route_programming, routes added and removed are
+   * queued rather than programmed one by one, and go to the adapter in SAI
+   * bulk calls of up to FLAGS_sai_route_bulk_size routes. Programs whatever
+   * is queued; the switch calls it once done with the route removals and
+   * again with the route additions of a state delta.
+   */
+  void flushRouteBatch();
+
  private:
+  struct PendingRouteCreate {
+    SaiRouteTraits::RouteEntry entry;
+    SaiRouteTraits::CreateAttributes attributes;
+    bool checkMetadata;
+  };
+
+  bool bulkProgramming() const;
+  void flushRouteCreates();
+  void flushRouteRemoves();
+
   SaiRouteHandle* getRouteHandleImpl(
       const SaiRouteTraits::RouteEntry& entry) const;
   template <typename AddrT>
@@ -176,6 +198,12 @@ class SaiRouteManager {
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+  // routes whose handle is in handles_ but which are yet to be created
+  std::vector<PendingRouteCreate> pendingCreates_;
+  folly::F14FastSet<SaiRouteTraits::RouteEntry> pendingCreateEntries_;
+  // handles of removed routes, kept until their routes are removed so that
+  // next hops and counters are not released while still in use
+  std::vector<std::unique_ptr<SaiRouteHandle>> pendingRemoves_;
 };
 
 } // namespace facebook::fboss
@@ -9,6 +9,7 @@
  */
 
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
+#include "fboss/agent/AgentFeatures.h"
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/LockPolicy.h"
@@ -25,6 +26,7 @@
 #include "fboss/agent/hw/sai/api/FdbApi.h"
 #include "fboss/agent/hw/sai/api/HostifApi.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/api/Types.h"
@@ -62,6 +64,7 @@
 #include "fboss/agent/packet/EthHdr.h"
 #include "fboss/agent/packet/PktUtil.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
+#include "fboss/lib/BinaryDynamic.h"
 #include "fboss/lib/HwWriteBehavior.h"
 
 #include "fboss/agent/AsicUtils.h"
@@ -137,6 +140,13 @@ DEFINE_bool(
     false,
     "Fail if untagged packet is transmitted on platform where tagged packet is required");
 
+DEFINE_bool(
+    sai_api_lock_domains,
+    false,
+    "Serialize SAI calls per lock domain (e.g. route programming, stats) "
+    "rather than all on one lock. Needs an adaptor that supports concurrent "
+    "calls into different apis");
+
 namespace {
 /*
  * For the devices/SDK we use, the only events we should get (and process)
@@ -322,6 +332,7 @@ HwInitResult SaiSwitch::initImpl(
           HwAsic::Feature::ZERO_SDK_WRITE_WARMBOOT)) {
     behavior = HwWriteBehavior::FAIL;
   }
+  SaiApiLock::getInstance()->setLockDomainsEnabled(FLAGS_sai_api_lock_domains);
   HwInitResult ret;
   {
     std::lock_guard<std::mutex> lock(saiSwitchMutex_);
@@ -353,6 +364,8 @@ void SaiSwitch::unregisterCallbacks() noexcept {
     std::lock_guard<std::mutex> lock(saiSwitchMutex_);
     unregisterCallbacksLocked(lock);
   }
+  // rx is unregistered, hand over the packets still queued
+  stopRxBurstThread();
 
   // linkscan is turned off and the evb loop is set to break
   // just need to block until the last event is processed
@@ -805,6 +818,10 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
         &SaiRouteManager::removeRoute<folly::IPAddressV6>,
         routerID);
   }
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().flushRouteBatch();
+  }
 
   for (const auto& vlanDelta : delta.getVlansDelta()) {
     processRemovedDelta(
@@ -1156,6 +1173,10 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
     processV6RoutesChangedAndAddedDelta(
         routerID, routeDelta.getFibDelta<folly::IPAddressV6>());
   }
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().flushRouteBatch();
+  }
   {
     auto multiSwitchControlPlaneDelta = delta.getControlPlaneDelta();
     [[maybe_unused]] const auto& lock = lockPolicy.lock();
@@ -1782,6 +1803,12 @@ std::unique_ptr<TxPacket> SaiSwitch::allocatePacket(uint32_t size) const {
   return std::make_unique<SaiTxPacket>(size);
 }
 
+std::unique_ptr<TxPacket> SaiSwitch::allocatePacketFromBuf(
+    std::unique_ptr<folly::IOBuf> buf) const {
+  getSwitchStats()->txPktAlloc();
+  return std::make_unique<SaiTxPacket>(std::move(buf));
+}
+
 bool SaiSwitch::sendPacketSwitchedAsync(
     std::unique_ptr<TxPacket> pkt) noexcept {
   return sendPacketSwitchedSync(std::move(pkt));
@@ -2969,7 +2996,39 @@ HwInitResult SaiSwitch::initLocked(
   callback_ = callback;
   __gSaiIdToSwitch.insert_or_assign(saiSwitchId_, this);
   SaiApiTable::getInstance()->enableLogging(FLAGS_enable_sai_log);
+  std::unique_ptr<BinaryDynamicFile> binaryState;
+  std::optional<BinaryDynamicView> adapterKeysBinary;
+  std::optional<BinaryDynamicView> adapterKeys2AdapterHostKeysBinary;
   if (bootType_ == BootType::WARM_BOOT) {
+    binaryState =
+        platform_->getWarmBootHelper()->getBinaryHwSwitchWarmBootState();
+  }
+  if (binaryState) {
+    // Binary state is mapped rather than decoded up front, the store decodes
+    // adapter keys one object type at a time as it reloads
+    ret.switchState = std::make_shared<SwitchState>();
+    auto stateRoot = binaryState->root();
+    auto hwSwitch = stateRoot.find(kHwSwitch);
+    if (!hwSwitch) {
+      throw FbossError("No hw switch in binary warm boot state");
+    }
+    if (platform_->getAsic()->isSupported(HwAsic::Feature::OBJECT_KEY_CACHE)) {
+      adapterKeysBinary = hwSwitch->find(kAdapterKeys);
+      CHECK(adapterKeysBinary.has_value());
+      auto switchKeys = adapterKeysBinary->find(
+          saiObjectTypeToString(SaiSwitchTraits::ObjectType));
+      CHECK(switchKeys.has_value());
+      CHECK_EQ(1, switchKeys->size());
+    }
+    adapterKeys2AdapterHostKeysBinary =
+        hwSwitch->find(kAdapterKey2AdapterHostKey);
+    if (getSwitchType() == cfg::SwitchType::VOQ) {
+      if (auto shelState = stateRoot.find(kSysPortShelState)) {
+        reconstructSysPortShelStateLocked(
+            lock, shelState->toDynamic(), concurrentIndices_->sysPortShelState);
+      }
+    }
+  } else if (bootType_ == BootType::WARM_BOOT) {
     auto switchStateJson = platform_->getWarmBootHelper()->getWarmBootState();
     ret.switchState = std::make_shared<SwitchState>();
     if (platform_->getAsic()->isSupported(HwAsic::Feature::OBJECT_KEY_CACHE)) {
@@ -3000,7 +3059,10 @@ HwInitResult SaiSwitch::initLocked(
       lock,
       behavior,
       adapterKeysJson.get(),
-      adapterKeys2AdapterHostKeysJson.get());
+      adapterKeys2AdapterHostKeysJson.get(),
+      adapterKeysBinary ? &*adapterKeysBinary : nullptr,
+      adapterKeys2AdapterHostKeysBinary ? &*adapterKeys2AdapterHostKeysBinary
+                                        : nullptr);
   if (bootType_ != BootType::WARM_BOOT) {
     if (getSwitchType() == cfg::SwitchType::FABRIC) {
       auto& switchApi = SaiApiTable::getInstance()->switchApi();
@@ -3073,9 +3135,15 @@ void SaiSwitch::initStoreAndManagersLocked(
     const std::lock_guard<std::mutex>& /*lock*/,
     HwWriteBehavior behavior,
     const folly::dynamic* adapterKeys,
-    const folly::dynamic* adapterKeys2AdapterHostKeys) {
+    const folly::dynamic* adapterKeys2AdapterHostKeys,
+    const BinaryDynamicView* adapterKeysBinary,
+    const BinaryDynamicView* adapterKeys2AdapterHostKeysBinary) {
   saiStore_ = std::make_unique<SaiStore>(saiSwitchId_);
-  saiStore_->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  if (adapterKeysBinary || adapterKeys2AdapterHostKeysBinary) {
+    saiStore_->reload(adapterKeysBinary, adapterKeys2AdapterHostKeysBinary);
+  } else {
+    saiStore_->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  }
   managerTable_->createSaiTableManagers(
       saiStore_.get(), platform_, concurrentIndices_.get());
   /*
@@ -3554,7 +3622,7 @@ void SaiSwitch::packetRxCallbackPort(
 
   folly::io::Cursor c0(rxPacket->buf());
   XLOG(DBG6) << PktUtil::hexDump(c0);
-  callback_->packetReceived(std::move(rxPacket));
+  deliverRxPacket(std::move(rxPacket));
 }
 
 void SaiSwitch::packetRxCallbackLag(
@@ -3606,7 +3674,68 @@ void SaiSwitch::packetRxCallbackLag(
              << " queue: " << (uint16_t)queueId;
   folly::io::Cursor c0(rxPacket->buf());
   XLOG(DBG6) << PktUtil::hexDump(c0);
-  callback_->packetReceived(std::move(rxPacket));
+  deliverRxPacket(std::move(rxPacket));
+}
+
+void SaiSwitch::deliverRxPacket(std::unique_ptr<SaiRxPacket> rxPacket) {
+  if (rxBurstThread_) {
+    if (!rxPacketQueue_.write(std::move(rxPacket))) {
+      getSwitchStats()->rxPktQueueFullDrop();
+    }
+  } else {
+    callback_->packetReceived(std::move(rxPacket));
+  }
+}
+
+void SaiSwitch::startRxBurstThread() {
+  rxPacketQueue_ = folly::MPMCQueue<std::unique_ptr<SaiRxPacket>>(
+      std::max<uint32_t>(FLAGS_rx_packet_burst_queue_size, 1));
+  rxBurstThread_ = std::make_unique<std::thread>([this]() {
+    initThread("fbossSaiRxBurst");
+    rxBurstLoop();
+  });
+}
+
+void SaiSwitch::stopRxBurstThread() {
+  if (!rxBurstThread_) {
+    return;
+  }
+  // packets queued ahead of the stop marker are still handed over
+  rxPacketQueue_.blockingWrite(nullptr);
+  rxBurstThread_->join();
+  rxBurstThread_.reset();
+}
+
+void SaiSwitch::rxBurstLoop() {
+  std::vector<std::unique_ptr<RxPacket>> burst;
+  bool stop = false;
+  while (!stop) {
+    // burst size is read per burst, so it can be tuned at runtime
+    size_t burstSize = std::max<uint32_t>(FLAGS_rx_packet_burst_size, 1);
+    burst.reserve(burstSize);
+    // block for the first packet of a burst, then take whatever else is
+    // already queued, up to the burst size
+    std::unique_ptr<SaiRxPacket> rxPacket;
+    rxPacketQueue_.blockingRead(rxPacket);
+    stop = !rxPacket;
+    if (rxPacket) {
+      burst.push_back(std::move(rxPacket));
+    }
+    while (!stop && burst.size() < burstSize) {
+      std::unique_ptr<SaiRxPacket> next;
+      if (!rxPacketQueue_.read(next)) {
+        break;
+      }
+      stop = !next;
+      if (next) {
+        burst.push_back(std::move(next));
+      }
+    }
+    if (!burst.empty()) {
+      callback_->packetsReceived(std::move(burst));
+      burst = std::vector<std::unique_ptr<RxPacket>>();
+    }
+  }
 }
 
 bool SaiSwitch::isFeatureSetupLocked(
@@ -3810,6 +3939,8 @@ bool SaiSwitch::sendPacketSwitchedSync(std::unique_ptr<TxPacket> pkt) noexcept {
           HwAsic::Feature::SMAC_EQUALS_DMAC_CHECK_ENABLED)) {
     EthHdr ethHdr{cursor};
     if (ethHdr.getSrcMac() == ethHdr.getDstMac()) {
+      // the buffer may be shared, e.g. with the rpc it was received in
+      pkt->buf()->unshare();
       auto* pktData = pkt->buf()->writableData();
       /* pktData[6]...pktData[11] is src mac */
       folly::MacAddress hackedMac{"fa:ce:b0:00:00:0c"};
@@ -4056,6 +4187,9 @@ void SaiSwitch::switchRunStateChangedImplLocked(
         initLinkScanLocked(lock);
       }
       if (getFeaturesDesired() & FeaturesDesired::PACKET_RX_DESIRED) {
+        if (FLAGS_rx_packet_burst_size > 1) {
+          startRxBurstThread();
+        }
         auto& switchApi = SaiApiTable::getInstance()->switchApi();
         switchApi.registerRxCallback(saiSwitchId_, __gPacketRxCallback);
       }
@@ -27,6 +27,7 @@
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 
 #include <folly/concurrency/ConcurrentHashMap.h>
+#include <folly/MPMCQueue.h>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -40,6 +41,7 @@ namespace facebook::fboss {
 
 struct ConcurrentIndices;
 class SaiStore;
+class BinaryDynamicView;
 
 /*
  * This is equivalent to sai_fdb_event_notification_data_t. Copy only the
@@ -101,6 +103,8 @@ class SaiSwitch : public HwSwitch {
   bool isValidStateUpdate(const StateDelta& delta) const override;
 
   std::unique_ptr<TxPacket> allocatePacket(uint32_t size) const override;
+  std::unique_ptr<TxPacket> allocatePacketFromBuf(
+      std::unique_ptr<folly::IOBuf> buf) const override;
 
   bool sendPacketSwitchedAsync(std::unique_ptr<TxPacket> pkt) noexcept override;
 
@@ -332,7 +336,9 @@ class SaiSwitch : public HwSwitch {
       const std::lock_guard<std::mutex>& lk,
       HwWriteBehavior behavior,
       const folly::dynamic* adapterKeys,
-      const folly::dynamic* adapterKeys2AdapterHostKeys);
+      const folly::dynamic* adapterKeys2AdapterHostKeys,
+      const BinaryDynamicView* adapterKeysBinary = nullptr,
+      const BinaryDynamicView* adapterKeys2AdapterHostKeysBinary = nullptr);
 
   void unregisterCallbacksLocked(
       const std::lock_guard<std::mutex>& lock) noexcept;
@@ -606,6 +612,12 @@ class SaiSwitch : public HwSwitch {
       cfg::PacketRxReason rxReason,
       uint8_t queueId);
 
+  // hand a trapped packet to the callback, or queue it for rxBurstThread_
+  void deliverRxPacket(std::unique_ptr<SaiRxPacket> rxPacket);
+  void startRxBurstThread();
+  void stopRxBurstThread();
+  void rxBurstLoop();
+
   std::shared_ptr<SwitchState> getColdBootSwitchState();
 
   std::optional<L2Entry> getL2Entry(
@@ -706,6 +718,16 @@ class SaiSwitch : public HwSwitch {
   std::unique_ptr<std::thread> switchReachabilityChangeProcessThread_;
   FbossEventBase switchReachabilityChangeProcessEventBase_{
       "SwitchReachabilityChangeBottomHalfEventBase"};
+  /*
+   * With --rx_packet_burst_size > 1, the rx callback only queues trapped
+   * packets. rxBurstThread_ drains the queue and hands the packets to the
+   * callback in bursts of up to that many packets, so per packet work in the
+   * SwSwitch is amortized over a burst. A null packet stops the thread. The
+   * queue is bounded by --rx_packet_burst_queue_size, packets received while
+   * it is full are dropped rather than piling up during a trap storm.
+   */
+  std::unique_ptr<std::thread> rxBurstThread_;
+  folly::MPMCQueue<std::unique_ptr<SaiRxPacket>> rxPacketQueue_;
 #if SAI_API_VERSION >= SAI_VERSION(1, 13, 0)
   std::unique_ptr<std::thread> switchAsicSdkHealthNotificationBHThread_;
   FbossEventBase switchAsicSdkHealthNotificationBHEventBase_{
@@ -12,14 +12,20 @@
 #include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
 
 #include "fboss/agent/TxPacket.h"
+#include "fboss/agent/TxPacketPool.h"
 
 namespace facebook::fboss {
 
 class SaiTxPacket : public TxPacket {
  public:
   explicit SaiTxPacket(uint32_t size) {
-    buf_ = folly::IOBuf::createCombined(size);
-    buf_->append(size);
+    buf_ = TxPacketPool::allocateTxBuffer(size);
+  }
+  // takes over a packet received from the SwSwitch, sai sends from a single
+  // contiguous buffer
+  explicit SaiTxPacket(std::unique_ptr<folly::IOBuf> buf) {
+    buf_ = std::move(buf);
+    buf_->coalesce();
   }
 };
 
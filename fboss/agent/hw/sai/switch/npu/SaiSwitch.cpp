@@ -12,6 +12,7 @@
 
 #include "fboss/agent/FabricConnectivityManager.h"
 #include "fboss/agent/hw/HwResourceStatsPublisher.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/switch/ConcurrentIndices.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableManager.h"
 #include "fboss/agent/hw/sai/switch/SaiBufferManager.h"
@@ -25,10 +26,39 @@
 #include "fboss/agent/hw/sai/switch/SaiSystemPortManager.h"
 #include "fboss/agent/hw/sai/switch/SaiVendorSwitchManager.h"
 
+#include <fb303/ServiceData.h>
+
 DECLARE_int32(update_cable_length_stats_s);
 
 namespace facebook::fboss {
 
+namespace {
+// SAI api lock contention, cumulative per lock domain
+void publishSaiApiLockStats() {
+  auto apiLock = SaiApiLock::getInstance();
+  for (size_t i = 0; i < kNumSaiApiLockDomains; ++i) {
+    auto domain = static_cast<SaiApiLockDomain>(i);
+    auto stats = apiLock->getDomainStats(domain);
+    auto prefix =
+        std::string("sai_api_lock.") + saiApiLockDomainToString(domain);
+    fb303::fbData->setCounter(prefix + ".acquisitions", stats.acquisitions);
+    fb303::fbData->setCounter(
+        prefix + ".wait_usecs",
+        std::chrono::duration_cast<std::chrono::microseconds>(stats.waitTime)
+            .count());
+    fb303::fbData->setCounter(
+        prefix + ".hold_usecs",
+        std::chrono::duration_cast<std::chrono::microseconds>(stats.holdTime)
+            .count());
+    fb303::fbData->setCounter(
+        prefix + ".max_wait_usecs",
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            stats.maxWaitTime)
+            .count());
+  }
+}
+} // namespace
+
 void SaiSwitch::updateStatsImpl() {
   if (FLAGS_skip_stats_update_for_debug) {
     // Skip collecting any ASIC stats while debugs are in progress
@@ -74,45 +104,59 @@ void SaiSwitch::updateStatsImpl() {
   }
 
   int64_t missingCount = 0, mismatchCount = 0, bogusCount = 0;
-  auto portsIter = concurrentIndices_->portSaiId2PortInfo.begin();
+  std::vector<PortID> portIds;
+  for (auto portsIter = concurrentIndices_->portSaiId2PortInfo.begin();
+       portsIter != concurrentIndices_->portSaiId2PortInfo.end();
+       ++portsIter) {
+    portIds.push_back(portsIter->second.portID);
+  }
   std::map<PortID, multiswitch::FabricConnectivityDelta> connectivityDelta;
-  while (portsIter != concurrentIndices_->portSaiId2PortInfo.end()) {
+  // Collect port stats a batch of ports at a time, so port and queue
+  // counters of the batch can be read together with bulk stats reads. The
+  // counters are read without holding saiSwitchMutex_, so state updates
+  // (route programming say) only wait for the bookkeeping around the reads.
+  size_t batchSize = FLAGS_sai_bulk_stats_collection
+      ? std::max(FLAGS_sai_stats_bulk_size, 1)
+      : 1;
+  for (size_t begin = 0; begin < portIds.size(); begin += batchSize) {
+    std::vector<PortID> batch(
+        portIds.begin() + begin,
+        portIds.begin() + std::min(begin + batchSize, portIds.size()));
+    SaiPortStatsCollection collection;
     {
       std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-      auto endpointOpt = managerTable_->portManager().getFabricConnectivity(
-          portsIter->second.portID);
-      if (endpointOpt.has_value()) {
-        auto delta = fabricConnectivityManager_->processConnectivityInfoForPort(
-            portsIter->second.portID, *endpointOpt);
-        if (delta) {
-          XLOG(DBG5) << "Connectivity delta found for port ID "
-                     << portsIter->second.portID;
-          connectivityDelta.insert({portsIter->second.portID, *delta});
-        } else {
-          XLOG(DBG5) << "No connectivity delta for port ID "
-                     << portsIter->second.portID;
-        }
-        if (fabricConnectivityManager_->isConnectivityInfoMissing(
-                portsIter->second.portID)) {
-          missingCount++;
-          XLOG(DBG5) << "Connectivity missing for port ID "
-                     << portsIter->second.portID;
-        }
-        if (fabricConnectivityManager_->isConnectivityInfoMismatch(
-                portsIter->second.portID)) {
-          mismatchCount++;
-          XLOG(DBG5) << "Connectivity mismatch for port ID "
-                     << portsIter->second.portID;
-        }
-        if (fabricConnectivityManager_->isConnectivityInfoBogus(
-                portsIter->second.portID)) {
-          bogusCount++;
+      for (auto portId : batch) {
+        auto endpointOpt =
+            managerTable_->portManager().getFabricConnectivity(portId);
+        if (endpointOpt.has_value()) {
+          auto delta =
+              fabricConnectivityManager_->processConnectivityInfoForPort(
+                  portId, *endpointOpt);
+          if (delta) {
+            XLOG(DBG5) << "Connectivity delta found for port ID " << portId;
+            connectivityDelta.insert({portId, *delta});
+          } else {
+            XLOG(DBG5) << "No connectivity delta for port ID " << portId;
+          }
+          if (fabricConnectivityManager_->isConnectivityInfoMissing(portId)) {
+            missingCount++;
+            XLOG(DBG5) << "Connectivity missing for port ID " << portId;
+          }
+          if (fabricConnectivityManager_->isConnectivityInfoMismatch(portId)) {
+            mismatchCount++;
+            XLOG(DBG5) << "Connectivity mismatch for port ID " << portId;
+          }
+          if (fabricConnectivityManager_->isConnectivityInfoBogus(portId)) {
+            bogusCount++;
+          }
         }
       }
-      managerTable_->portManager().updateStats(
-          portsIter->second.portID, updateWatermarks, updateCableLengths);
+      collection = managerTable_->portManager().planStatsCollection(
+          batch, updateWatermarks);
     }
-    ++portsIter;
+    collection.read();
+    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    managerTable_->portManager().updateStats(collection, updateCableLengths);
   }
 
   getSwitchStats()->fabricConnectivityMissingCount(missingCount);
@@ -185,6 +229,7 @@ void SaiSwitch::updateStatsImpl() {
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
     managerTable_->routerInterfaceManager().updateStats();
   }
+  publishSaiApiLockStats();
   if (updateWatermarks &&
       platform_->getAsic()->isSupported(
           HwAsic::Feature::VENDOR_SWITCH_CONGESTION_MANAGEMENT_ERRORS)) {
@@ -21,6 +21,7 @@
 
 #include <string>
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::fboss;
@@ -397,6 +398,49 @@ TEST_F(PortManagerTest, updateStats) {
   }
 }
 
+TEST_F(PortManagerTest, bulkUpdateStats) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_bulk_stats_collection = true;
+  std::vector<std::shared_ptr<Port>> swPorts{makePort(p0), makePort(p1)};
+  std::vector<PortID> portIds;
+  for (const auto& swPort : swPorts) {
+    saiManagerTable->portManager().addPort(swPort);
+    portIds.push_back(swPort->getID());
+  }
+  saiManagerTable->portManager().updateStats(portIds);
+  for (const auto& swPort : swPorts) {
+    auto portStat =
+        saiManagerTable->portManager().getLastPortStat(swPort->getID());
+    ASSERT_NE(portStat, nullptr);
+    for (auto statKey :
+         HwPortFb303Stats("dummy").kPortMonotonicCounterStatKeys()) {
+      EXPECT_EQ(
+          portStat->getCounterLastIncrement(
+              HwPortFb303Stats::statName(statKey, swPort->getName())),
+          0);
+    }
+  }
+}
+
+TEST_F(PortManagerTest, updateStatsSkipsPortsRemovedWhileReading) {
+  std::vector<std::shared_ptr<Port>> swPorts{makePort(p0), makePort(p1)};
+  std::vector<PortID> portIds;
+  for (const auto& swPort : swPorts) {
+    saiManagerTable->portManager().addPort(swPort);
+    portIds.push_back(swPort->getID());
+  }
+  auto collection = saiManagerTable->portManager().planStatsCollection(
+      portIds, false /* updateWatermarks */);
+  // counters are read without the switch mutex, the second port may be
+  // removed before or after that
+  saiManagerTable->portManager().removePort(swPorts[1]);
+  collection.read();
+  saiManagerTable->portManager().updateStats(collection);
+  auto portStats = saiManagerTable->portManager().getPortStats();
+  ASSERT_EQ(portStats.size(), 1);
+  EXPECT_EQ(*portStats.at(portIds[0]).timestamp_(), collection.now.count());
+}
+
 TEST_F(PortManagerTest, portDisableStopsCounterExport) {
   std::shared_ptr<Port> swPort = makePort(p0);
   CHECK(swPort->isEnabled());
@@ -217,6 +217,42 @@ TEST_F(RouteManagerTest, removeRoute) {
   EXPECT_FALSE(saiRouteHandle);
 }
 
+TEST_F(RouteManagerTest, bulkAddRemoveRoutes) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_bulk_route_programming = true;
+  auto& routeManager = saiManagerTable->routeManager();
+  auto& store = saiStore->get<SaiRouteTraits>();
+  tr2.nextHopInterfaces = tr1.nextHopInterfaces;
+  auto r1 = makeRoute(tr1);
+  auto r2 = makeRoute(tr2);
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  auto entry1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto entry2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  // queued until the batch is flushed
+  EXPECT_FALSE(store.get(entry1));
+  EXPECT_FALSE(store.get(entry2));
+
+  routeManager.flushRouteBatch();
+  for (const auto& entry : {entry1, entry2}) {
+    auto handle = routeManager.getRouteHandle(entry);
+    ASSERT_TRUE(handle);
+    ASSERT_TRUE(handle->route);
+    EXPECT_EQ(store.get(entry), handle->route);
+    EXPECT_EQ(
+        GET_OPT_ATTR(Route, NextHopId, handle->route->attributes()),
+        handle->nextHopAdapterKey());
+  }
+
+  routeManager.removeRoute(r1, RouterID(0));
+  routeManager.removeRoute(r2, RouterID(0));
+  EXPECT_FALSE(routeManager.getRouteHandle(entry1));
+  EXPECT_TRUE(store.get(entry1));
+  routeManager.flushRouteBatch();
+  EXPECT_FALSE(store.get(entry1));
+  EXPECT_FALSE(store.get(entry2));
+}
+
 TEST_F(RouteManagerTest, addDupRoute) {
   auto r = makeRoute(tr1);
   saiManagerTable->routeManager().addRoute<folly::IPAddressV4>(r, RouterID(0));
@@ -140,6 +140,15 @@ struct MplsRouteDetails {
   6: optional common.NamedRouteDestination namedRouteDestination;
 }
 
+// Progress of a chunked syncFib, see beginSyncFib
+struct SyncFibProgress {
+  1: i64 chunksReceived;
+  2: i64 routesReceived;
+  // Routes not resent, deleted on commit
+  3: i64 routesDeleted;
+  4: i64 elapsedUs;
+}
+
 struct ArpEntryThrift {
   1: string mac;
   2: i32 port;
@@ -861,6 +870,25 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
     3: i32 vrf,
   ) throws (1: fboss.FbossBaseError error, 2: FbossFibUpdateError fibError);
 
+  /*
+   * Chunked alternative to syncFibInVrf, for full table syncs. Routes are
+   * programmed as each chunk is added. commitSyncFib deletes the client's
+   * routes which were not added since beginSyncFib. Calling beginSyncFib
+   * again restarts the sync.
+   */
+  void beginSyncFib(1: i16 clientId, 2: i32 vrf) throws (
+    1: fboss.FbossBaseError error,
+  );
+  SyncFibProgress addSyncFibRoutes(
+    1: i16 clientId,
+    2: i32 vrf,
+    3: list<UnicastRoute> routes,
+  ) throws (1: fboss.FbossBaseError error, 2: FbossFibUpdateError fibError);
+  SyncFibProgress commitSyncFib(1: i16 clientId, 2: i32 vrf) throws (
+    1: fboss.FbossBaseError error,
+    2: FbossFibUpdateError fibError,
+  );
+
   // Get route counter values
   map<string, i64> getRouteCounterBytes(1: list<string> counters) throws (
     1: fboss.FbossBaseError error,
@@ -113,7 +113,7 @@ std::pair<fsdb::OperDelta, HwSwitchStateUpdateStatus>
 MultiSwitchHwSwitchHandler::stateChanged(
     const std::vector<fsdb::OperDelta>& deltas,
     bool transaction,
-    const std::shared_ptr<SwitchState>& oldState,
+    const std::shared_ptr<SwitchState>& /*oldState*/,
     const std::shared_ptr<SwitchState>& newState,
     const HwWriteBehavior& hwWriteBehavior) {
   multiswitch::StateOperDelta stateDelta;
@@ -131,7 +131,7 @@ MultiSwitchHwSwitchHandler::stateChanged(
         checkOperSyncStateLocked(HwSwitchOperDeltaSyncState::CANCELLED, lk)) {
       // return incoming delta to indicate that none of the changes were applied
       return {
-          StateDelta(oldState, newState).getOperDelta(),
+          getCombinedOperDelta(deltas),
           HwSwitchStateUpdateStatus::HWSWITCH_STATE_UPDATE_CANCELLED};
     }
     // block state update till hwswitch resync is complete
@@ -143,7 +143,7 @@ MultiSwitchHwSwitchHandler::stateChanged(
         setOperSyncStateLocked(HwSwitchOperDeltaSyncState::CANCELLED, lk);
         // initial sync was cancelled
         return {
-            StateDelta(oldState, newState).getOperDelta(),
+            getCombinedOperDelta(deltas),
             HwSwitchStateUpdateStatus::HWSWITCH_STATE_UPDATE_CANCELLED};
       }
     }
@@ -180,7 +180,7 @@ MultiSwitchHwSwitchHandler::stateChanged(
       setOperSyncStateLocked(HwSwitchOperDeltaSyncState::CANCELLED, lk);
       // return incoming delta to indicate that none of the changes were applied
       return {
-          StateDelta(oldState, newState).getOperDelta(),
+          getCombinedOperDelta(deltas),
           HwSwitchStateUpdateStatus::HWSWITCH_STATE_UPDATE_CANCELLED};
     }
   }
@@ -0,0 +1,267 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/mnpu/SharedMemPacketRing.h"
+
+#include "fboss/agent/FbossError.h"
+
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/io/Cursor.h>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+
+DEFINE_bool(
+    shm_packet_transport,
+    false,
+    "In split mode, exchange packets between HwAgent and SwSwitch through "
+    "shared memory rings rather than thrift streams, when on the same host");
+DEFINE_uint32(
+    shm_packet_ring_slots,
+    1024,
+    "Number of packet slots of each shared memory packet ring");
+
+namespace facebook::fboss {
+
+namespace {
+constexpr uint32_t kMagic = 0xFB055A6E;
+constexpr uint32_t kVersion = 2;
+constexpr size_t kCacheLineSize = 64;
+
+long futex(std::atomic<uint32_t>* addr, int op, uint32_t val, timespec* ts) {
+  // not FUTEX_PRIVATE_FLAG, waiter and waker are in different processes
+  return syscall(
+      SYS_futex, reinterpret_cast<uint32_t*>(addr), op, val, ts, nullptr, 0);
+}
+} // namespace
+
+struct SharedMemPacketRing::Header {
+  // written last by create(), checked by attach()
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t numSlots;
+  uint32_t slotSize;
+  alignas(kCacheLineSize) std::atomic<uint64_t> head;
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail;
+  // generation of the attached peer mapping, 0 if none
+  alignas(kCacheLineSize) std::atomic<uint32_t> peerGeneration;
+  std::atomic<uint32_t> lastPeerGeneration;
+  std::atomic<uint32_t> consumerWaiting;
+  // futex the consumer sleeps on, bumped by every wake up
+  std::atomic<uint32_t> wakeSeq;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+SharedMemPacketRing::SharedMemPacketRing(
+    std::string name,
+    void* region,
+    size_t regionSize,
+    bool owner)
+    : name_(std::move(name)),
+      region_(region),
+      regionSize_(regionSize),
+      owner_(owner),
+      header_(static_cast<Header*>(region)),
+      slots_(static_cast<uint8_t*>(region) + sizeof(Header)) {}
+
+SharedMemPacketRing::~SharedMemPacketRing() {
+  if (!owner_) {
+    // unless a later mapping attached since
+    auto generation = peerGeneration_;
+    header_->peerGeneration.compare_exchange_strong(
+        generation, 0, std::memory_order_acq_rel);
+  }
+  munmap(region_, regionSize_);
+  if (owner_) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+std::string SharedMemPacketRing::ringName(
+    SwitchID switchId,
+    Direction direction) {
+  return folly::to<std::string>(
+      "/fboss_agent_pkts_",
+      switchId,
+      direction == Direction::RX ? "_rx" : "_tx");
+}
+
+size_t SharedMemPacketRing::regionSize(uint32_t numSlots) {
+  return sizeof(Header) + static_cast<size_t>(numSlots) * kSlotSize;
+}
+
+std::unique_ptr<SharedMemPacketRing> SharedMemPacketRing::create(
+    const std::string& name,
+    uint32_t numSlots) {
+  if (numSlots == 0) {
+    throw FbossError("Shared memory packet ring ", name, " needs slots");
+  }
+  // a previous instance may have exited without removing its region
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw FbossError(
+        "Failed to create shared memory ", name, ": ", folly::errnoStr(errno));
+  }
+  auto size = regionSize(numSlots);
+  if (ftruncate(fd, size) < 0) {
+    auto err = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    throw FbossError(
+        "Failed to size shared memory ", name, ": ", folly::errnoStr(err));
+  }
+  auto* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  auto err = errno;
+  close(fd);
+  if (region == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw FbossError(
+        "Failed to map shared memory ", name, ": ", folly::errnoStr(err));
+  }
+  // the region is zero filled, which initializes the indices and flags
+  auto* header = new (region) Header();
+  header->version = kVersion;
+  header->numSlots = numSlots;
+  header->slotSize = kSlotSize;
+  header->magic.store(kMagic, std::memory_order_release);
+  return std::unique_ptr<SharedMemPacketRing>(
+      new SharedMemPacketRing(name, region, size, true /* owner */));
+}
+
+std::unique_ptr<SharedMemPacketRing> SharedMemPacketRing::attach(
+    const std::string& name) {
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    throw FbossError(
+        "Failed to open shared memory ", name, ": ", folly::errnoStr(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(Header)) {
+    close(fd);
+    throw FbossError("Shared memory ", name, " is not a packet ring");
+  }
+  size_t size = st.st_size;
+  auto* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  auto err = errno;
+  close(fd);
+  if (region == MAP_FAILED) {
+    throw FbossError(
+        "Failed to map shared memory ", name, ": ", folly::errnoStr(err));
+  }
+  auto* header = static_cast<Header*>(region);
+  if (header->magic.load(std::memory_order_acquire) != kMagic ||
+      header->version != kVersion || header->slotSize != kSlotSize ||
+      regionSize(header->numSlots) > size) {
+    munmap(region, size);
+    throw FbossError("Shared memory ", name, " is not a compatible ring");
+  }
+  auto ring = std::unique_ptr<SharedMemPacketRing>(
+      new SharedMemPacketRing(name, region, size, false /* owner */));
+  auto generation =
+      header->lastPeerGeneration.fetch_add(1, std::memory_order_acq_rel) + 1;
+  if (generation == 0) {
+    // wrapped around, 0 means detached
+    generation =
+        header->lastPeerGeneration.fetch_add(1, std::memory_order_acq_rel) + 1;
+  }
+  ring->peerGeneration_ = generation;
+  header->peerGeneration.store(generation, std::memory_order_release);
+  return ring;
+}
+
+bool SharedMemPacketRing::peerAttached() const {
+  return header_->peerGeneration.load(std::memory_order_acquire) != 0;
+}
+
+uint32_t SharedMemPacketRing::numSlots() const {
+  return header_->numSlots;
+}
+
+uint8_t* SharedMemPacketRing::slot(uint64_t index) const {
+  return slots_ + (index % header_->numSlots) * kSlotSize;
+}
+
+bool SharedMemPacketRing::empty() const {
+  return header_->tail.load(std::memory_order_relaxed) ==
+      header_->head.load(std::memory_order_seq_cst);
+}
+
+bool SharedMemPacketRing::push(
+    const PacketMeta& meta,
+    const folly::IOBuf& buf) {
+  auto length = buf.computeChainDataLength();
+  if (length > kMaxPacketSize) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(producerMutex_);
+    auto head = header_->head.load(std::memory_order_relaxed);
+    if (head - header_->tail.load(std::memory_order_acquire) >=
+        header_->numSlots) {
+      return false;
+    }
+    auto* dst = slot(head);
+    auto* slotMeta = reinterpret_cast<PacketMeta*>(dst);
+    *slotMeta = meta;
+    slotMeta->length = length;
+    folly::io::Cursor cursor(&buf);
+    cursor.pull(dst + sizeof(PacketMeta), length);
+    // seq_cst, to be ordered with the load of consumerWaiting below
+    header_->head.store(head + 1, std::memory_order_seq_cst);
+  }
+  if (header_->consumerWaiting.load(std::memory_order_seq_cst)) {
+    wake();
+  }
+  return true;
+}
+
+const uint8_t* SharedMemPacketRing::frontSlot() const {
+  auto tail = header_->tail.load(std::memory_order_relaxed);
+  if (tail == header_->head.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return slot(tail);
+}
+
+void SharedMemPacketRing::popFront() {
+  header_->tail.fetch_add(1, std::memory_order_release);
+}
+
+void SharedMemPacketRing::wait(std::chrono::milliseconds timeout) {
+  auto seq = header_->wakeSeq.load(std::memory_order_acquire);
+  header_->consumerWaiting.store(1, std::memory_order_seq_cst);
+  if (empty()) {
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    timespec ts{};
+    ts.tv_sec = secs.count();
+    ts.tv_nsec =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - secs)
+            .count();
+    futex(&header_->wakeSeq, FUTEX_WAIT, seq, &ts);
+  }
+  header_->consumerWaiting.store(0, std::memory_order_relaxed);
+}
+
+void SharedMemPacketRing::wake() {
+  header_->wakeSeq.fetch_add(1, std::memory_order_release);
+  futex(&header_->wakeSeq, FUTEX_WAKE, INT_MAX, nullptr);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/types.h"
+
+#include <folly/Range.h>
+#include <folly/io/IOBuf.h>
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+DECLARE_bool(shm_packet_transport);
+DECLARE_uint32(shm_packet_ring_slots);
+
+namespace facebook::fboss {
+
+/*
+ * Ring of packets in a POSIX shared memory region, the split agent packet
+ * path between the HwAgent and the SwSwitch of the same host.
+ *
+ * The HwAgent creates one ring per direction: RX rings carry trapped packets
+ * to the SwSwitch, TX rings carry packets to be sent by the HwAgent. The
+ * SwSwitch attaches to both when the HwAgent connects over thrift, which
+ * remains the control channel, and the packet path whenever a ring is not
+ * attached, full, or a packet does not fit into a slot.
+ *
+ * Every ring has a single consumer thread. Producer threads of one process
+ * serialize on a mutex, there is one producing process per ring. Packets are
+ * copied into and out of fixed size slots; a consumer sleeps on a process
+ * shared futex in the ring header while the ring is empty.
+ */
+class SharedMemPacketRing {
+ public:
+  enum class Direction : uint8_t {
+    RX,
+    TX,
+  };
+  // per packet metadata, -1 for unset fields
+  struct PacketMeta {
+    int32_t port{-1};
+    int32_t aggPort{-1};
+    int32_t vlan{-1};
+    // CPU cos queue of RX packets, egress queue of TX packets
+    int32_t queue{-1};
+    uint32_t length{0};
+  };
+  static constexpr uint32_t kSlotSize = 10 * 1024;
+  static constexpr uint32_t kMaxPacketSize = kSlotSize - sizeof(PacketMeta);
+
+  ~SharedMemPacketRing();
+
+  static std::string ringName(SwitchID switchId, Direction direction);
+  // (re)creates the region of a ring, removing any of a previous instance
+  static std::unique_ptr<SharedMemPacketRing> create(
+      const std::string& name,
+      uint32_t numSlots);
+  // maps the region of a ring created by another process
+  static std::unique_ptr<SharedMemPacketRing> attach(const std::string& name);
+
+  /*
+   * Whether the SwSwitch is attached. Every attach() takes a new generation
+   * of the ring, and destroying its mapping only detaches if no later
+   * attach() took over, so replacing the mapping of a ring by a new one keeps
+   * it attached. The HwAgent only produces into its RX rings while the
+   * SwSwitch is attached.
+   */
+  bool peerAttached() const;
+
+  // copies a packet into the next slot, false if full or the packet too long
+  bool push(const PacketMeta& meta, const folly::IOBuf& buf);
+
+  // hands the oldest packet to fn(meta, payload) and frees its slot, false
+  // if the ring is empty
+  template <typename Fn>
+  bool pop(Fn&& fn) {
+    auto* slot = frontSlot();
+    if (!slot) {
+      return false;
+    }
+    const auto* meta = reinterpret_cast<const PacketMeta*>(slot);
+    fn(*meta, folly::ByteRange(slot + sizeof(PacketMeta), meta->length));
+    popFront();
+    return true;
+  }
+
+  // sleep until a packet is pushed, wake() is called or timeout expires
+  void wait(std::chrono::milliseconds timeout);
+  void wake();
+
+  uint32_t numSlots() const;
+  bool empty() const;
+
+ private:
+  struct Header;
+
+  SharedMemPacketRing(
+      std::string name,
+      void* region,
+      size_t regionSize,
+      bool owner);
+  static size_t regionSize(uint32_t numSlots);
+  const uint8_t* frontSlot() const;
+  void popFront();
+  uint8_t* slot(uint64_t index) const;
+
+  const std::string name_;
+  void* region_;
+  const size_t regionSize_;
+  const bool owner_;
+  // generation taken by attach(), 0 for the owner
+  uint32_t peerGeneration_{0};
+  Header* header_;
+  uint8_t* slots_;
+  std::mutex producerMutex_;
+};
+
+} // namespace facebook::fboss
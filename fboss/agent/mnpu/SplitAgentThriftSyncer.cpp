@@ -16,6 +16,13 @@
 #include "fboss/agent/mnpu/RxPktEventSyncer.h"
 #include "fboss/agent/mnpu/SwitchReachabilityChangeEventSyncer.h"
 #include "fboss/agent/mnpu/TxPktEventSyncer.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/TxPacket.h"
+#include "fboss/agent/Utils.h"
+
+#include <cstring>
+
 namespace {
 DEFINE_int32(
     hwagent_watchdog_interval_ms,
@@ -25,6 +32,10 @@ DEFINE_int32(
 
 namespace facebook::fboss {
 
+namespace {
+constexpr auto kPktRingWaitTimeout = std::chrono::milliseconds(100);
+} // namespace
+
 SplitAgentThriftSyncer::SplitAgentThriftSyncer(
     HwSwitch* hw,
     uint16_t serverPort,
@@ -35,6 +46,8 @@ SplitAgentThriftSyncer::SplitAgentThriftSyncer(
           "SplitAgentThriftRetryThread")),
       switchId_(switchId),
       hwSwitch_(hw),
+      rxPktRing_(createPktRing(switchId, SharedMemPacketRing::Direction::RX)),
+      txPktRing_(createPktRing(switchId, SharedMemPacketRing::Direction::TX)),
       linkChangeEventSinkClient_(std::make_unique<LinkChangeEventSyncer>(
           serverPort,
           switchId_,
@@ -94,8 +107,44 @@ SplitAgentThriftSyncer::SplitAgentThriftSyncer(
   thriftClientWatchdog_->start();
 }
 
+std::unique_ptr<SharedMemPacketRing> SplitAgentThriftSyncer::createPktRing(
+    SwitchID switchId,
+    SharedMemPacketRing::Direction direction) {
+  if (!FLAGS_shm_packet_transport) {
+    return nullptr;
+  }
+  try {
+    return SharedMemPacketRing::create(
+        SharedMemPacketRing::ringName(switchId, direction),
+        FLAGS_shm_packet_ring_slots);
+  } catch (const FbossError& ex) {
+    XLOG(ERR) << "Exchanging packets via thrift, " << ex.what();
+    return nullptr;
+  }
+}
+
 void SplitAgentThriftSyncer::packetReceived(
     std::unique_ptr<RxPacket> pkt) noexcept {
+  if (rxPktRing_ && rxPktRing_->peerAttached()) {
+    SharedMemPacketRing::PacketMeta meta;
+    meta.port = pkt->getSrcPort();
+    if (auto vlan = pkt->getSrcVlanIf()) {
+      meta.vlan = *vlan;
+    }
+    if (pkt->isFromAggregatePort()) {
+      meta.aggPort = pkt->getSrcAggregatePort();
+    }
+    if (pkt->cosQueue()) {
+      meta.queue = static_cast<int32_t>(hwQueueIdToCpuCosQueueId(
+          *pkt->cosQueue(),
+          hwSwitch_->getPlatform()->getAsic(),
+          hwSwitch_->getSwitchStats()));
+    }
+    // a full ring, or a packet too large for its slots, goes via thrift
+    if (rxPktRing_->push(meta, *pkt->buf())) {
+      return;
+    }
+  }
   multiswitch::RxPacket rxPkt;
   rxPkt.port() = pkt->getSrcPort();
   if (auto vlan = pkt->getSrcVlanIf()) {
@@ -244,9 +293,59 @@ void SplitAgentThriftSyncer::unregisterStateObserver(
 void SplitAgentThriftSyncer::start() {
   // Start any required services
   operDeltaClient_->startOperSync();
+  startTxPktRingThread();
   isRunning_ = true;
 }
 
+void SplitAgentThriftSyncer::startTxPktRingThread() {
+  if (!txPktRingThread_ && txPktRing_) {
+    txPktRingStop_ = false;
+    txPktRingThread_ = std::make_unique<std::thread>([this]() {
+      initThread("fbossTxPktRing");
+      while (!txPktRingStop_) {
+        while (txPktRing_->pop([this](const auto& meta, auto data) {
+          sendTxPktFromRing(meta, data);
+        })) {
+        }
+        txPktRing_->wait(kPktRingWaitTimeout);
+      }
+    });
+  }
+}
+
+void SplitAgentThriftSyncer::stopTxPktRingThread() {
+  if (txPktRingThread_) {
+    txPktRingStop_ = true;
+    txPktRing_->wake();
+    txPktRingThread_->join();
+    txPktRingThread_.reset();
+  }
+}
+
+void SplitAgentThriftSyncer::sendTxPktFromRing(
+    const SharedMemPacketRing::PacketMeta& meta,
+    folly::ByteRange data) {
+  // See TxPktEventSyncer::TxPacketEventHandler()
+  if (hwSwitch_->getRunState() != SwitchRunState::CONFIGURED) {
+    XLOG_EVERY_MS(DBG2, 5000)
+        << "Tx packet ring: hwswitch not in configured state, dropping packet";
+    return;
+  }
+  // copied straight from the ring into the packet sent
+  auto pkt = hwSwitch_->allocatePacket(data.size());
+  std::memcpy(pkt->buf()->writableData(), data.data(), data.size());
+  if (meta.port >= 0) {
+    std::optional<uint8_t> queue;
+    if (meta.queue >= 0) {
+      queue = meta.queue;
+    }
+    hwSwitch_->sendPacketOutOfPortAsync(
+        std::move(pkt), PortID(meta.port), queue);
+  } else {
+    hwSwitch_->sendPacketSwitchedAsync(std::move(pkt));
+  }
+}
+
 void SplitAgentThriftSyncer::stop() {
   // Stop any started services
   if (thriftClientWatchdog_) {
@@ -261,6 +360,7 @@ void SplitAgentThriftSyncer::stop() {
   rxPktEventSinkClient_->cancel();
   hwSwitchStatsSinkClient_->cancel();
   switchReachabilityChangeEventSinkClient_->cancel();
+  stopTxPktRingThread();
 
   isRunning_ = false;
 }
@@ -18,6 +18,9 @@
 
 #include "fboss/agent/HwSwitchCallback.h"
 #include "fboss/agent/MultiSwitchThriftHandler.h"
+#include "fboss/agent/mnpu/SharedMemPacketRing.h"
+
+#include <thread>
 
 namespace facebook::fboss {
 
@@ -82,6 +85,15 @@ class SplitAgentThriftSyncer : public HwSwitchCallback {
   std::shared_ptr<folly::ScopedEventBaseThread> retryThread_;
   SwitchID switchId_;
   HwSwitch* hwSwitch_;
+  /*
+   * Shared memory packet rings, with --shm_packet_transport. Created before
+   * the thrift clients, so they exist once the SwSwitch sees the TX packet
+   * stream connect and attaches to them.
+   */
+  std::unique_ptr<SharedMemPacketRing> rxPktRing_;
+  std::unique_ptr<SharedMemPacketRing> txPktRing_;
+  std::unique_ptr<std::thread> txPktRingThread_;
+  std::atomic<bool> txPktRingStop_{false};
   std::unique_ptr<LinkChangeEventSyncer> linkChangeEventSinkClient_;
   std::unique_ptr<TxPktEventSyncer> txPktEventStreamClient_;
   std::unique_ptr<OperDeltaSyncer> operDeltaClient_;
@@ -94,5 +106,13 @@ class SplitAgentThriftSyncer : public HwSwitchCallback {
   folly::Synchronized<uint64_t> rxPktEventsDropped_{0};
 
   void updateWatchdogMissedCount();
+  static std::unique_ptr<SharedMemPacketRing> createPktRing(
+      SwitchID switchId,
+      SharedMemPacketRing::Direction direction);
+  void startTxPktRingThread();
+  void stopTxPktRingThread();
+  void sendTxPktFromRing(
+      const SharedMemPacketRing::PacketMeta& meta,
+      folly::ByteRange data);
 };
 } // namespace facebook::fboss
@@ -10,6 +10,7 @@
 #include "fboss/agent/mnpu/TxPktEventSyncer.h"
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/TxPacket.h"
+#include "fboss/agent/TxPacketPool.h"
 
 #if FOLLY_HAS_COROUTINES
 #include <folly/coro/BlockingWait.h>
@@ -72,17 +73,23 @@ void TxPktEventSyncer::TxPacketEventHandler(
     return;
   }
   auto len = (*txPkt.data())->computeChainDataLength();
-  auto pkt = hw->allocatePacket(len);
-  folly::io::Cursor inCursor(txPkt.data()->get());
-  folly::io::RWPrivateCursor outCursor(pkt->buf());
-  outCursor.pushAtMost(inCursor, len);
-
   if (*txPkt.length() != len) {
     XLOG(ERR) << "Tx packet length mismatch for switch " << *hw->getSwitchId();
     getBadPacketCounter().add(1);
     return;
   }
 
+  std::unique_ptr<TxPacket> pkt;
+  if (FLAGS_tx_packet_pool) {
+    // send straight from the buffer the packet was received in
+    pkt = hw->allocatePacketFromBuf(std::move(*txPkt.data()));
+  } else {
+    pkt = hw->allocatePacket(len);
+    folly::io::Cursor inCursor(txPkt.data()->get());
+    folly::io::RWPrivateCursor outCursor(pkt->buf());
+    outCursor.pushAtMost(inCursor, len);
+  }
+
   if (txPkt.port().has_value()) {
     PortID portId(*txPkt.port());
     hw->sendPacketOutOfPortAsync(
@@ -11,6 +11,7 @@
 
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/types.h"
+#include "fboss/lib/MultibitTrie.h"
 #include "fboss/lib/RadixTree.h"
 
 #include <folly/IPAddress.h>
@@ -38,14 +39,15 @@ class NetworkToRouteMap
           std::is_same_v<LabelID, AddressT>,
           std::unordered_map<LabelID, std::shared_ptr<Route<LabelID>>>,
           facebook::network::
-              RadixTree<AddressT, std::shared_ptr<Route<AddressT>>>> {
+              LpmCachedRadixTree<AddressT, std::shared_ptr<Route<AddressT>>>> {
   static constexpr auto kRoutes = "routes";
 
  public:
   using Base = std::conditional_t<
       std::is_same_v<LabelID, AddressT>,
       std::unordered_map<LabelID, std::shared_ptr<Route<LabelID>>>,
-      facebook::network::RadixTree<AddressT, std::shared_ptr<Route<AddressT>>>>;
+      facebook::network::
+          LpmCachedRadixTree<AddressT, std::shared_ptr<Route<AddressT>>>>;
   using Base::Base;
   /* implicit */ NetworkToRouteMap(Base&& radixTree)
       : Base(std::move(radixTree)) {}
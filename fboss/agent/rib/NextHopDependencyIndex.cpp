@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+
+#include <deque>
+
+namespace facebook::fboss {
+
+void NextHopDependencyIndex::invalidate() {
+  v4NextHops_.clear();
+  v6NextHops_.clear();
+  routeToNextHops_.clear();
+  valid_ = false;
+}
+
+void NextHopDependencyIndex::setDependencies(
+    const folly::CIDRNetwork& route,
+    const std::vector<NextHopResolution>& nexthops) {
+  removeRoute(route);
+  if (nexthops.empty()) {
+    return;
+  }
+  auto& recorded = routeToNextHops_[route];
+  recorded.reserve(nexthops.size());
+  for (const auto& nhop : nexthops) {
+    auto& dependents = nhop.nexthop.isV4()
+        ? v4NextHops_[nhop.nexthop.asV4()]
+        : v6NextHops_[nhop.nexthop.asV6()];
+    // All routes using a next hop resolve it the same way, so the latest
+    // resolution is the current one
+    dependents.resolvedMask = nhop.resolvedMask;
+    dependents.routes.insert(route);
+    recorded.push_back(nhop.nexthop);
+  }
+}
+
+void NextHopDependencyIndex::removeRoute(const folly::CIDRNetwork& route) {
+  auto itr = routeToNextHops_.find(route);
+  if (itr == routeToNextHops_.end()) {
+    return;
+  }
+  for (const auto& nexthop : itr->second) {
+    removeDependent(nexthop, route);
+  }
+  routeToNextHops_.erase(itr);
+}
+
+void NextHopDependencyIndex::removeDependent(
+    const folly::IPAddress& nexthop,
+    const folly::CIDRNetwork& route) {
+  auto remove = [&route](auto& nextHops, const auto& addr) {
+    auto itr = nextHops.find(addr);
+    if (itr == nextHops.end()) {
+      return;
+    }
+    itr->second.routes.erase(route);
+    if (itr->second.routes.empty()) {
+      nextHops.erase(itr);
+    }
+  };
+  if (nexthop.isV4()) {
+    remove(v4NextHops_, nexthop.asV4());
+  } else {
+    remove(v6NextHops_, nexthop.asV6());
+  }
+}
+
+template <typename AddrT>
+void NextHopDependencyIndex::getAffectedRoutes(
+    const std::map<AddrT, Dependents>& nextHops,
+    const AddrT& network,
+    uint8_t mask,
+    std::set<folly::CIDRNetwork>& affected) {
+  // Addresses within a prefix are contiguous in the ordered map
+  for (auto itr = nextHops.lower_bound(network.mask(mask));
+       itr != nextHops.end() && itr->first.inSubnet(network, mask);
+       ++itr) {
+    const auto& resolvedMask = itr->second.resolvedMask;
+    if (resolvedMask && *resolvedMask > mask) {
+      // Resolves through a more specific prefix, unaffected
+      continue;
+    }
+    affected.insert(itr->second.routes.begin(), itr->second.routes.end());
+  }
+}
+
+void NextHopDependencyIndex::getAffectedRoutes(
+    const folly::CIDRNetwork& changedPrefix,
+    std::set<folly::CIDRNetwork>& affected) const {
+  const auto& [network, mask] = changedPrefix;
+  if (network.isV4()) {
+    getAffectedRoutes(v4NextHops_, network.asV4(), mask, affected);
+  } else {
+    getAffectedRoutes(v6NextHops_, network.asV6(), mask, affected);
+  }
+}
+
+std::set<folly::CIDRNetwork> NextHopDependencyIndex::getAffectedRoutesClosure(
+    const std::vector<folly::CIDRNetwork>& changedPrefixes) const {
+  std::set<folly::CIDRNetwork> closure(
+      changedPrefixes.begin(), changedPrefixes.end());
+  std::deque<folly::CIDRNetwork> toVisit(closure.begin(), closure.end());
+  std::set<folly::CIDRNetwork> affected;
+  while (!toVisit.empty()) {
+    affected.clear();
+    getAffectedRoutes(toVisit.front(), affected);
+    toVisit.pop_front();
+    for (const auto& route : affected) {
+      if (closure.insert(route).second) {
+        toVisit.push_back(route);
+      }
+    }
+  }
+  return closure;
+}
+
+} // namespace facebook::fboss
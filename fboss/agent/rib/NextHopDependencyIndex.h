@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Reverse index from the next hop addresses of IP routes to the routes using
+ * them. For every next hop we also track the mask of the prefix it last
+ * resolved through. This is what allows RibRouteUpdater to re-resolve only
+ * the routes a prefix change can affect, rather than the entire table.
+ *
+ * The index is only meaningful if every resolution of the table it
+ * describes went through it. Anything that rewrites a route table behind
+ * RibRouteUpdater's back (rollback, config application) must invalidate it,
+ * the next update then falls back to resolving the full table and rebuilds
+ * the index as it goes.
+ */
+class NextHopDependencyIndex {
+ public:
+  struct NextHopResolution {
+    NextHopResolution(folly::IPAddress nhop, std::optional<uint8_t> mask)
+        : nexthop(std::move(nhop)), resolvedMask(mask) {}
+    folly::IPAddress nexthop;
+    // Mask of the prefix nexthop resolved through, none if unresolved
+    std::optional<uint8_t> resolvedMask;
+  };
+
+  bool isValid() const {
+    return valid_;
+  }
+  // Mark index as describing the table after a full resolution pass
+  void setValid() {
+    valid_ = true;
+  }
+  // Drop all dependencies, the next update must resolve the full table
+  void invalidate();
+
+  // Replace recorded next hops of route
+  void setDependencies(
+      const folly::CIDRNetwork& route,
+      const std::vector<NextHopResolution>& nexthops);
+  void removeRoute(const folly::CIDRNetwork& route);
+
+  /*
+   * Add routes which may resolve differently once changedPrefix is added,
+   * removed or changes its forwarding info. These are the routes with a next
+   * hop inside changedPrefix that resolved through a prefix no more specific
+   * than changedPrefix (or did not resolve at all).
+   */
+  void getAffectedRoutes(
+      const folly::CIDRNetwork& changedPrefix,
+      std::set<folly::CIDRNetwork>& affected) const;
+
+  /*
+   * Expand changedPrefixes to all routes which need re-resolution. Routes
+   * which (recursively) resolve through an affected route are affected too.
+   */
+  std::set<folly::CIDRNetwork> getAffectedRoutesClosure(
+      const std::vector<folly::CIDRNetwork>& changedPrefixes) const;
+
+  size_t numRoutes() const {
+    return routeToNextHops_.size();
+  }
+  size_t numNextHops() const {
+    return v4NextHops_.size() + v6NextHops_.size();
+  }
+
+ private:
+  struct Dependents {
+    std::optional<uint8_t> resolvedMask;
+    std::set<folly::CIDRNetwork> routes;
+  };
+
+  template <typename AddrT>
+  static void getAffectedRoutes(
+      const std::map<AddrT, Dependents>& nextHops,
+      const AddrT& network,
+      uint8_t mask,
+      std::set<folly::CIDRNetwork>& affected);
+
+  void removeDependent(
+      const folly::IPAddress& nexthop,
+      const folly::CIDRNetwork& route);
+
+  std::map<folly::IPAddressV4, Dependents> v4NextHops_;
+  std::map<folly::IPAddressV6, Dependents> v6NextHops_;
+  std::map<folly::CIDRNetwork, std::vector<folly::IPAddress>> routeToNextHops_;
+  bool valid_{false};
+};
+
+} // namespace facebook::fboss
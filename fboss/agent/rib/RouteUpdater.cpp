@@ -15,6 +15,7 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
 #include <boost/integer/common_factor.hpp>
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
 #include "fboss/agent/FbossError.h"
@@ -35,6 +36,11 @@ DEFINE_bool(
     enable_capacity_pruning,
     false,
     "Enable path pruning based on capacity");
+DEFINE_bool(
+    rib_incremental_resolution,
+    false,
+    "Only re-resolve RIB routes affected by an update, using the next hop "
+    "dependency index maintained per route table");
 
 using boost::container::flat_map;
 using boost::container::flat_set;
@@ -65,14 +71,23 @@ RibRouteUpdater::RibRouteUpdater(
 RibRouteUpdater::RibRouteUpdater(
     IPv4NetworkToRouteMap* v4Routes,
     IPv6NetworkToRouteMap* v6Routes,
-    LabelToRouteMap* mplsRoutes)
+    LabelToRouteMap* mplsRoutes,
+    NextHopDependencyIndex* nhopDependencies)
     : v4Routes_(v4Routes),
       v6Routes_(v6Routes),
       mplsRoutes_(mplsRoutes),
+      nhopDependencies_(nhopDependencies),
       weightNormalizer_(
           FLAGS_nsf_num_racks_per_pod,
           FLAGS_nsf_num_parallel_rack_links,
-          FLAGS_nsf_rack_id) {}
+          FLAGS_nsf_rack_id) {
+  if (nhopDependencies_ && !FLAGS_rib_incremental_resolution) {
+    // Don't pay for maintaining the index unless it is used. Invalidate it
+    // so it gets rebuilt if incremental resolution is turned on later.
+    nhopDependencies_->invalidate();
+    nhopDependencies_ = nullptr;
+  }
+}
 
 void RibRouteUpdater::update(
     const std::map<ClientID, std::vector<RouteEntry>>& toAdd,
@@ -151,12 +166,14 @@ void RibRouteUpdater::addOrReplaceRouteImpl(
     if (!existingRouteForClient || !(*existingRouteForClient == entry)) {
       route = writableRoute<AddressT>(it);
       route->update(clientID, entry);
+      markChanged(prefix.toCidrNetwork());
     }
     return;
   }
 
   routes->insert(
       prefix, std::make_shared<Route<AddressT>>(prefix, clientID, entry));
+  markChanged(prefix.toCidrNetwork());
 }
 
 void RibRouteUpdater::addOrReplaceRoute(
@@ -211,10 +228,14 @@ void RibRouteUpdater::delRouteImpl(
   if (!clientNhopEntry) {
     return;
   }
+  markChanged(prefix.toCidrNetwork());
   if (route->numClientEntries() == 1) {
     // If this client's the only entry, simply erase
     XLOG(DBG3) << "Deleting route: " << route->str();
     routes->erase(it);
+    if (nhopDependencies_) {
+      nhopDependencies_->removeRoute(prefix.toCidrNetwork());
+    }
   } else {
     route = writableRoute<AddressT>(it);
     route->delEntryForClient(clientID);
@@ -277,6 +298,9 @@ void RibRouteUpdater::removeAllRoutesFromClientImpl(
     if (!nhopEntry) {
       continue;
     }
+    if constexpr (!std::is_same_v<LabelID, AddressT>) {
+      markChanged(route->prefix().toCidrNetwork());
+    }
     if (route->numClientEntries() == 1) {
       // This client's is the only entry avoid unnecessary cloning
       // we are going to prune the route anyways
@@ -293,6 +317,12 @@ void RibRouteUpdater::removeAllRoutesFromClientImpl(
 
   // Now, delete whatever routes went from 1 nexthoplist to 0.
   for (auto it : toDelete) {
+    if constexpr (!std::is_same_v<LabelID, AddressT>) {
+      if (nhopDependencies_) {
+        nhopDependencies_->removeRoute(
+            value<AddressT>(it)->prefix().toCidrNetwork());
+      }
+    }
     routes->erase(it);
   }
 }
@@ -617,6 +647,11 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
   const auto action = bestEntry->getAction();
   const auto counterID = bestEntry->getCounterID();
   const auto classID = bestEntry->getClassID();
+  if constexpr (!std::is_same_v<LabelID, AddressT>) {
+    if (nhopDependencies_) {
+      recordNextHopDependencies(route, *bestEntry);
+    }
+  }
   if (action == RouteForwardAction::DROP) {
     hasDrop = true;
   } else if (action == RouteForwardAction::TO_CPU) {
@@ -799,26 +834,121 @@ bool RibRouteUpdater::needResolve(
   return needsResolution_.find(route.get()) != needsResolution_.end();
 }
 
+template <typename AddressT>
+std::optional<uint8_t> RibRouteUpdater::resolvingMask(
+    NetworkToRouteMap<AddressT>* routes,
+    const AddressT& nh) const {
+  auto it = routes->longestMatch(nh, nh.bitCount());
+  if (it == routes->end()) {
+    return std::nullopt;
+  }
+  return it->masklen();
+}
+
+template <typename AddressT>
+void RibRouteUpdater::recordNextHopDependencies(
+    const std::shared_ptr<Route<AddressT>>& route,
+    const RouteNextHopEntry& bestEntry) {
+  std::vector<NextHopDependencyIndex::NextHopResolution> nexthops;
+  if (bestEntry.getAction() != RouteForwardAction::DROP &&
+      bestEntry.getAction() != RouteForwardAction::TO_CPU) {
+    for (const auto& nh : bestEntry.getNextHopSet()) {
+      // Interface and link local next hops are resolved as is, neither are
+      // pop and lookup next hops. None of these depend on other routes.
+      if (nh.intfID().has_value() ||
+          (nh.labelForwardingAction().has_value() &&
+           nh.labelForwardingAction()->type() ==
+               MplsActionCode::POP_AND_LOOKUP)) {
+        continue;
+      }
+      const auto& addr = nh.addr();
+      nexthops.emplace_back(
+          addr,
+          addr.isV4() ? resolvingMask(v4Routes_, addr.asV4())
+                      : resolvingMask(v6Routes_, addr.asV6()));
+    }
+  }
+  nhopDependencies_->setDependencies(
+      route->prefix().toCidrNetwork(), nexthops);
+}
+
+bool RibRouteUpdater::canResolveIncrementally() const {
+  return nhopDependencies_ && nhopDependencies_->isValid();
+}
+
+void RibRouteUpdater::resolveAffectedRoutes() {
+  auto affected = nhopDependencies_->getAffectedRoutesClosure(changedPrefixes_);
+  XLOG(DBG3) << "Incrementally resolving " << affected.size()
+             << " routes affected by " << changedPrefixes_.size()
+             << " changed prefixes";
+  std::vector<IPv4NetworkToRouteMap::Iterator> v4Affected;
+  std::vector<IPv6NetworkToRouteMap::Iterator> v6Affected;
+  for (const auto& [network, mask] : affected) {
+    if (network.isV4()) {
+      auto it = v4Routes_->exactMatch(network.asV4(), mask);
+      if (it != v4Routes_->end()) {
+        needsResolution_.insert(it->value().get());
+        v4Affected.push_back(it);
+      }
+    } else {
+      auto it = v6Routes_->exactMatch(network.asV6(), mask);
+      if (it != v6Routes_->end()) {
+        needsResolution_.insert(it->value().get());
+        v6Affected.push_back(it);
+      }
+    }
+  }
+  // Resolving one affected route may recursively resolve others first
+  for (auto& it : v4Affected) {
+    if (needResolve(it->value())) {
+      resolveOne<IPAddressV4>(it);
+    }
+  }
+  for (auto& it : v6Affected) {
+    if (needResolve(it->value())) {
+      resolveOne<IPAddressV6>(it);
+    }
+  }
+}
+
 void RibRouteUpdater::updateDone() {
+  SCOPE_EXIT {
+    needsResolution_.clear();
+    unresolvedToResolvedNhops_.clear();
+    changedPrefixes_.clear();
+  };
+  SCOPE_FAIL {
+    if (nhopDependencies_) {
+      nhopDependencies_->invalidate();
+    }
+  };
   // Record all routes as needing resolution
   auto markForResolution = [this](const auto& routes) {
     std::for_each(routes->begin(), routes->end(), [this](auto& route) {
       needsResolution_.insert(value(route).get());
     });
   };
-  markForResolution(v4Routes_);
-  markForResolution(v6Routes_);
   if (mplsRoutes_) {
+    // MPLS routes are not tracked in the dependency index, always resolve
     markForResolution(mplsRoutes_);
   }
-  SCOPE_EXIT {
-    needsResolution_.clear();
-    unresolvedToResolvedNhops_.clear();
-  };
-  resolve(v4Routes_);
-  resolve(v6Routes_);
+  if (canResolveIncrementally()) {
+    resolveAffectedRoutes();
+  } else {
+    if (nhopDependencies_) {
+      // Full resolution below rebuilds the index from scratch
+      nhopDependencies_->invalidate();
+    }
+    markForResolution(v4Routes_);
+    markForResolution(v6Routes_);
+    resolve(v4Routes_);
+    resolve(v6Routes_);
+  }
   if (mplsRoutes_) {
     resolve(mplsRoutes_);
   }
+  if (nhopDependencies_) {
+    nhopDependencies_->setValid();
+  }
 }
 } // namespace facebook::fboss
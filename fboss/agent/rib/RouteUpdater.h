@@ -13,11 +13,13 @@
 #include "fboss/agent/types.h"
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
 #include "fboss/agent/rib/RibRouteWeightNormalizer.h"
 
 #include <folly/IPAddress.h>
 
 DECLARE_bool(enable_capacity_pruning);
+DECLARE_bool(rib_incremental_resolution);
 
 namespace facebook::fboss {
 
@@ -44,6 +46,11 @@ namespace facebook::fboss {
  *    only IP nexthops will be in the final ECMP group.
  * 5. If and only if TO_CPU is the only nexthop (directly or indirectly) of
  *    a route, TO_CPU action will be only path in the resolved ECMP group.
+ *
+ * If a NextHopDependencyIndex is supplied and valid, only routes affected by
+ * the prefixes this update changed are re-resolved (see
+ * NextHopDependencyIndex), all other routes retain their resolution.
+ * Otherwise all routes are re-resolved and the index, if any, is rebuilt.
  */
 class RibRouteUpdater {
  public:
@@ -54,7 +61,8 @@ class RibRouteUpdater {
   RibRouteUpdater(
       IPv4NetworkToRouteMap* v4Routes,
       IPv6NetworkToRouteMap* v6Routes,
-      LabelToRouteMap* mplsRoutes);
+      LabelToRouteMap* mplsRoutes,
+      NextHopDependencyIndex* nhopDependencies = nullptr);
 
   struct RouteEntry {
     folly::CIDRNetwork prefix;
@@ -174,12 +182,30 @@ class RibRouteUpdater {
   template <typename AddressT>
   bool needResolve(const std::shared_ptr<Route<AddressT>>& route) const;
 
+  template <typename AddressT>
+  void recordNextHopDependencies(
+      const std::shared_ptr<Route<AddressT>>& route,
+      const RouteNextHopEntry& bestEntry);
+  template <typename AddressT>
+  std::optional<uint8_t> resolvingMask(
+      NetworkToRouteMap<AddressT>* routes,
+      const AddressT& nh) const;
+
+  void markChanged(const folly::CIDRNetwork& prefix) {
+    changedPrefixes_.push_back(prefix);
+  }
+  bool canResolveIncrementally() const;
+  void resolveAffectedRoutes();
+
   using NextHopIpToForwardInfo =
       std::unordered_map<folly::IPAddress, RouteNextHopSet>;
 
   IPv4NetworkToRouteMap* v4Routes_{nullptr};
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
   LabelToRouteMap* mplsRoutes_{nullptr};
+  NextHopDependencyIndex* nhopDependencies_{nullptr};
+  // IP prefixes added, removed or modified by this update
+  std::vector<folly::CIDRNetwork> changedPrefixes_;
   std::unordered_set<void*> needsResolution_;
   /*
    * Cache for next hop to FWD information. For our use case
@@ -24,7 +24,9 @@
 
 #include "fboss/agent/rib/RouteUpdater.h"
 
+#include <algorithm>
 #include <exception>
+#include <future>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -32,6 +34,18 @@
 #include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
+DEFINE_bool(
+    rib_lpm_cache,
+    false,
+    "Maintain a multibit trie alongside the RIB radix trees to speed up "
+    "nexthop resolution lookups. The trie is an extra index, costing memory "
+    "per route, which RadixTreeBenchmark reports");
+DEFINE_uint32(
+    rib_update_shards,
+    1,
+    "Number of RIB update threads. VRFs are assigned to threads by RouterID, "
+    "updates to VRFs on different threads are processed in parallel");
+
 namespace facebook::fboss {
 
 namespace {
@@ -103,6 +117,18 @@ class RibMplsRouteUpdate {
   }
 };
 
+void accumulate(
+    RoutingInformationBase::UpdateStatistics& total,
+    const RoutingInformationBase::UpdateStatistics& stats) {
+  total.v4RoutesAdded += stats.v4RoutesAdded;
+  total.v4RoutesDeleted += stats.v4RoutesDeleted;
+  total.v6RoutesAdded += stats.v6RoutesAdded;
+  total.v6RoutesDeleted += stats.v6RoutesDeleted;
+  total.mplsRoutesAdded += stats.mplsRoutesAdded;
+  total.mplsRoutesDeleted += stats.mplsRoutesDeleted;
+  total.duration += stats.duration;
+}
+
 class Timer {
  public:
   explicit Timer(std::chrono::microseconds* duration)
@@ -160,13 +186,13 @@ void reconstructRibFromFib(
 
 template <typename RibUpdateFn>
 void RibRouteTables::updateRib(RouterID vrf, const RibUpdateFn& updateRibFn) {
-  auto lockedRouteTables = synchronizedRouteTables_.wlock();
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
   auto it = lockedRouteTables->find(vrf);
   if (it == lockedRouteTables->end()) {
     throw FbossError("VRF ", vrf, " not configured");
   }
-  auto& routeTable = it->second;
-  updateRibFn(routeTable);
+  auto routeTable = it->second->wlock();
+  updateRibFn(*routeTable);
 }
 
 void RibRouteTables::reconfigure(
@@ -234,8 +260,10 @@ void RibRouteTables::reconfigure(
               staticMplsRoutesToNull.cbegin(), staticMplsRoutesToNull.cend()),
           folly::range(
               staticMplsRoutesToCpu.cbegin(), staticMplsRoutesToCpu.cend()));
-      // Apply config
+      // Apply config. Config application resolves the full table without
+      // the dependency index, so it no longer describes the table.
       configApplier.apply();
+      routeTable.nhopDependencies.invalidate();
     });
     updateFib(resolver, vrf, updateFibCallback, cookie);
   };
@@ -304,7 +332,8 @@ void RibRouteTables::updateRemoteInterfaceRoutes(
         RibRouteUpdater updater(
             &(routeTable.v4NetworkToRoute),
             &(routeTable.v6NetworkToRoute),
-            &(routeTable.labelToRoute));
+            &(routeTable.labelToRoute),
+            &(routeTable.nhopDependencies));
         updater.update(
             {{ClientID::REMOTE_INTERFACE_ROUTE, toAddRoutes}},
             {{ClientID::REMOTE_INTERFACE_ROUTE, toDelRoutes}},
@@ -331,7 +360,8 @@ void RibRouteTables::update(
     RibRouteUpdater updater(
         &(routeTable.v4NetworkToRoute),
         &(routeTable.v6NetworkToRoute),
-        &(routeTable.labelToRoute));
+        &(routeTable.labelToRoute),
+        &(routeTable.nhopDependencies));
     updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
   });
   updateFib(resolver, routerID, fibUpdateCallback, cookie);
@@ -344,13 +374,13 @@ void RibRouteTables::updateFib(
     void* cookie) {
   try {
     auto lockedRouteTables = synchronizedRouteTables_.rlock();
-    auto& routeTable = lockedRouteTables->find(vrf)->second;
+    auto routeTable = lockedRouteTables->find(vrf)->second->rlock();
     fibUpdateCallback(
         resolver,
         vrf,
-        routeTable.v4NetworkToRoute,
-        routeTable.v6NetworkToRoute,
-        routeTable.labelToRoute,
+        routeTable->v4NetworkToRoute,
+        routeTable->v6NetworkToRoute,
+        routeTable->labelToRoute,
         cookie);
   } catch (const FbossHwUpdateError& hwUpdateError) {
     {
@@ -358,8 +388,10 @@ void RibRouteTables::updateFib(
         XLOG(FATAL) << " RIB Rollback failed, aborting program";
       };
       auto fib = hwUpdateError.appliedState->getFibs()->getNode(vrf);
-      auto lockedRouteTables = synchronizedRouteTables_.wlock();
-      auto& routeTable = lockedRouteTables->find(vrf)->second;
+      auto lockedRouteTables = synchronizedRouteTables_.rlock();
+      auto lockedRouteTable = lockedRouteTables->find(vrf)->second->wlock();
+      auto& routeTable = *lockedRouteTable;
+      routeTable.nhopDependencies.invalidate();
       reconstructRibFromFib<
           folly::IPAddressV4,
           ForwardingInformationBase<folly::IPAddressV4>>(
@@ -382,7 +414,8 @@ void RibRouteTables::updateFib(
 void RibRouteTables::ensureVrf(RouterID rid) {
   auto lockedRouteTables = synchronizedRouteTables_.wlock();
   if (lockedRouteTables->find(rid) == lockedRouteTables->end()) {
-    lockedRouteTables->insert(std::make_pair(rid, RouteTable()));
+    lockedRouteTables->insert(
+        std::make_pair(rid, std::make_shared<SynchronizedRouteTable>()));
   }
 }
 
@@ -480,8 +513,9 @@ std::shared_ptr<Route<AddressT>> RibRouteTables::longestMatch(
   StopWatch lookupTimer(std::nullopt, false);
   auto ribTables = synchronizedRouteTables_.rlock();
   auto vrfIt = ribTables->find(vrf);
-  auto rt =
-      vrfIt == ribTables->end() ? nullptr : vrfIt->second.longestMatch(address);
+  auto rt = vrfIt == ribTables->end()
+      ? nullptr
+      : vrfIt->second->rlock()->longestMatch(address);
   if (lookupTimer.msecsElapsed().count() > 1000) {
     XLOG(WARNING) << " Lookup for : " << address
                   << " took: " << lookupTimer.msecsElapsed().count() << " ms ";
@@ -501,7 +535,9 @@ RibRouteTables::RouterIDToRouteTable RibRouteTables::constructRouteTables(
     const RouterID configVrf = routerIDAndInterfaceRoutes.first;
 
     newRouteTablesIter = newRouteTables.emplace_hint(
-        newRouteTables.cend(), configVrf, RouteTable());
+        newRouteTables.cend(),
+        configVrf,
+        std::make_shared<SynchronizedRouteTable>());
 
     auto oldRouteTablesIter = lockedRouteTables->find(configVrf);
     if (oldRouteTablesIter == lockedRouteTables->end()) {
@@ -519,10 +555,18 @@ RibRouteTables::RouterIDToRouteTable RibRouteTables::constructRouteTables(
 }
 
 RoutingInformationBase::RoutingInformationBase() {
-  ribUpdateThread_ = std::make_unique<std::thread>([this] {
-    initThread("ribUpdateThread");
-    ribUpdateEventBase_.loopForever();
-  });
+  auto numShards = std::max(FLAGS_rib_update_shards, 1u);
+  for (uint32_t i = 0; i < numShards; ++i) {
+    // Keep the original names for the first shard
+    auto suffix = i ? std::to_string(i) : std::string();
+    auto shard = std::make_unique<UpdateShard>("RibUpdateEventBase" + suffix);
+    shard->thread = std::make_unique<std::thread>(
+        [eventBase = &shard->eventBase, name = "ribUpdateThread" + suffix] {
+          initThread(name);
+          eventBase->loopForever();
+        });
+    shards_.push_back(std::move(shard));
+  }
 }
 
 RoutingInformationBase::~RoutingInformationBase() {
@@ -530,16 +574,18 @@ RoutingInformationBase::~RoutingInformationBase() {
 }
 
 void RoutingInformationBase::stop() {
-  if (ribUpdateThread_) {
-    ribUpdateEventBase_.runInFbossEventBaseThread(
-        [this] { ribUpdateEventBase_.terminateLoopSoon(); });
-    ribUpdateThread_->join();
-    ribUpdateThread_.reset();
+  for (auto& shard : shards_) {
+    if (shard->thread) {
+      shard->eventBase.runInFbossEventBaseThread(
+          [eventBase = &shard->eventBase] { eventBase->terminateLoopSoon(); });
+      shard->thread->join();
+      shard->thread.reset();
+    }
   }
 }
 
 void RoutingInformationBase::ensureRunning() const {
-  if (!ribUpdateThread_) {
+  if (!shards_.front()->thread) {
     throw FbossError(
         "RIB thread is not yet running or is in the process of exiting");
   }
@@ -573,7 +619,8 @@ void RoutingInformationBase::reconfigure(
         updateFibCallback,
         cookie);
   };
-  ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(updateFn);
+  // Config application adds and removes VRFs, keep all shards out of the way
+  runExclusive(updateFn);
 }
 
 void RoutingInformationBase::updateRemoteInterfaceRoutes(
@@ -642,14 +689,167 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::updateImpl(
       updateException = std::current_exception();
     }
   };
-  ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(updateFn);
+  auto& shard = getShard(routerID);
+  shard.eventBase.runInFbossEventBaseThreadAndWait(updateFn);
   if (updateException) {
     std::rethrow_exception(updateException);
   }
+  if constexpr (std::is_same_v<TraitsType, RibIpRouteUpdate>) {
+    markSyncFibRoutesResent(routerID, clientID, toAdd);
+  }
   stats.duration = duration;
+  stats.shard = getShardIndex(routerID);
+  accumulate(*shard.stats.wlock(), stats);
   return stats;
 }
 
+void RoutingInformationBase::beginSyncFib(
+    RouterID routerID,
+    ClientID clientID) {
+  ensureRunning();
+  SyncFibSession session;
+  session.prefixes = ribTables_.getClientPrefixes(routerID, clientID);
+  session.resent.resize(session.prefixes.size(), false);
+  session.start = std::chrono::steady_clock::now();
+  XLOG(DBG2) << "Begin syncFib for client " << static_cast<int>(clientID)
+             << " in VRF " << routerID << " with " << session.prefixes.size()
+             << " existing routes";
+  syncFibSessions_.wlock()->insert_or_assign(
+      std::make_pair(routerID, clientID),
+      std::make_shared<SynchronizedSyncFibSession>(std::move(session)));
+}
+
+RoutingInformationBase::SyncFibProgress
+RoutingInformationBase::addSyncFibRoutes(
+    const SwitchIdScopeResolver* resolver,
+    RouterID routerID,
+    ClientID clientID,
+    AdminDistance adminDistanceFromClientID,
+    const std::vector<UnicastRoute>& toAdd,
+    FibUpdateFunction fibUpdateCallback,
+    void* cookie) {
+  auto session = syncFibSessions_.withRLock([&](const auto& sessions) {
+    auto it = sessions.find(std::make_pair(routerID, clientID));
+    if (it == sessions.end()) {
+      throw FbossError(
+          "No syncFib in progress for client ",
+          static_cast<int>(clientID),
+          " in VRF ",
+          routerID);
+    }
+    return it->second;
+  });
+  auto stats = updateImpl<RibIpRouteUpdate>(
+      resolver,
+      routerID,
+      clientID,
+      adminDistanceFromClientID,
+      toAdd,
+      {},
+      false,
+      "syncFib chunk",
+      std::move(fibUpdateCallback),
+      cookie);
+  auto lockedSession = session->wlock();
+  auto& progress = lockedSession->progress;
+  progress.lastUpdate = stats;
+  accumulate(progress.total, stats);
+  ++progress.chunks;
+  progress.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - lockedSession->start);
+  return progress;
+}
+
+void RoutingInformationBase::markSyncFibRoutesResent(
+    RouterID routerID,
+    ClientID clientID,
+    const std::vector<UnicastRoute>& added) {
+  if (added.empty()) {
+    return;
+  }
+  auto session = syncFibSessions_.withRLock(
+      [&](const auto& sessions) -> std::shared_ptr<SynchronizedSyncFibSession> {
+        auto it = sessions.find(std::make_pair(routerID, clientID));
+        return it == sessions.end() ? nullptr : it->second;
+      });
+  if (!session) {
+    return;
+  }
+  auto lockedSession = session->wlock();
+  const auto& prefixes = lockedSession->prefixes;
+  for (const auto& route : added) {
+    auto network = facebook::network::toIPAddress(*route.dest()->ip());
+    auto mask = static_cast<uint8_t>(*route.dest()->prefixLength());
+    folly::CIDRNetwork prefix{network.mask(mask), mask};
+    auto it = std::lower_bound(prefixes.begin(), prefixes.end(), prefix);
+    if (it != prefixes.end() && *it == prefix) {
+      lockedSession->resent[it - prefixes.begin()] = true;
+    }
+  }
+}
+
+RoutingInformationBase::SyncFibProgress RoutingInformationBase::commitSyncFib(
+    const SwitchIdScopeResolver* resolver,
+    RouterID routerID,
+    ClientID clientID,
+    AdminDistance adminDistanceFromClientID,
+    FibUpdateFunction fibUpdateCallback,
+    void* cookie) {
+  auto sessionKey = std::make_pair(routerID, clientID);
+  auto session = syncFibSessions_.withRLock([&](const auto& sessions) {
+    auto it = sessions.find(sessionKey);
+    if (it == sessions.end()) {
+      throw FbossError(
+          "No syncFib in progress for client ",
+          static_cast<int>(clientID),
+          " in VRF ",
+          routerID);
+    }
+    return it->second;
+  });
+  // The session stays registered, and locked, until the deletes are
+  // applied, so routes resent meanwhile are still marked before toDel is
+  // computed, or wait for the commit to finish.
+  auto lockedSession = session->wlock();
+  std::vector<IpPrefix> toDel;
+  for (std::size_t i = 0; i < lockedSession->prefixes.size(); ++i) {
+    if (!lockedSession->resent[i]) {
+      toDel.push_back(toIpPrefix(lockedSession->prefixes[i]));
+    }
+  }
+  auto stats = updateImpl<RibIpRouteUpdate>(
+      resolver,
+      routerID,
+      clientID,
+      adminDistanceFromClientID,
+      {},
+      toDel,
+      false,
+      "syncFib commit",
+      std::move(fibUpdateCallback),
+      cookie);
+  lockedSession->prefixes = {};
+  lockedSession->resent = {};
+  syncFibSessions_.withWLock([&](auto& sessions) {
+    // unless a new syncFib began meanwhile
+    auto it = sessions.find(sessionKey);
+    if (it != sessions.end() && it->second == session) {
+      sessions.erase(it);
+    }
+  });
+  auto& progress = lockedSession->progress;
+  progress.lastUpdate = stats;
+  accumulate(progress.total, stats);
+  progress.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - lockedSession->start);
+  XLOG(DBG2) << "Committed syncFib for client " << static_cast<int>(clientID)
+             << " in VRF " << routerID << ", " << progress.chunks << " chunks, "
+             << progress.total.v4RoutesAdded + progress.total.v6RoutesAdded
+             << " routes added, " << toDel.size() << " routes deleted in "
+             << progress.elapsed.count() << " us";
+  return progress;
+}
+
 void RoutingInformationBase::setClassIDImpl(
     const SwitchIdScopeResolver* resolver,
     RouterID rid,
@@ -663,10 +863,11 @@ void RoutingInformationBase::setClassIDImpl(
     ribTables_.setClassID(
         resolver, rid, prefixes, fibUpdateCallback, classId, cookie);
   };
+  auto& eventBase = getShard(rid).eventBase;
   if (async) {
-    ribUpdateEventBase_.runInFbossEventBaseThread(updateFn);
+    eventBase.runInFbossEventBaseThread(updateFn);
   } else {
-    ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(updateFn);
+    eventBase.runInFbossEventBaseThreadAndWait(updateFn);
   }
 }
 
@@ -682,7 +883,7 @@ void RoutingInformationBase::setOverrideEcmpModeAsync(
     ribTables_.setOverrideEcmpMode(
         resolver, rid, prefix2EcmpMode, fibUpdateCallback, cookie);
   };
-  ribUpdateEventBase_.runInFbossEventBaseThread(updateFn);
+  getShard(rid).eventBase.runInFbossEventBaseThread(updateFn);
 }
 
 RibRouteTables RibRouteTables::fromThrift(
@@ -693,9 +894,11 @@ RibRouteTables RibRouteTables::fromThrift(
   auto lockedRouteTables = rib.synchronizedRouteTables_.wlock();
 
   for (const auto& [rid, table] : ribThrift) {
-    RouteTable rtable = RouteTable::fromThrift(table);
     auto vrf = RouterID(rid);
-    lockedRouteTables->emplace(vrf, std::move(rtable));
+    lockedRouteTables->emplace(
+        vrf,
+        std::make_shared<SynchronizedRouteTable>(
+            RouteTable::fromThrift(table)));
   }
 
   if (fibs) {
@@ -718,8 +921,9 @@ std::vector<MplsRouteDetails> RibRouteTables::getMplsRouteTableDetails() const {
   synchronizedRouteTables_.withRLock([&](const auto& synchronizedRouteTables) {
     const auto it = synchronizedRouteTables.find(RouterID(0));
     if (it != synchronizedRouteTables.end()) {
-      for (auto rit = it->second.labelToRoute.begin();
-           rit != it->second.labelToRoute.end();
+      auto routeTable = it->second->rlock();
+      for (auto rit = routeTable->labelToRoute.begin();
+           rit != routeTable->labelToRoute.end();
            ++rit) {
         MplsRouteDetails mplsRouteDetail;
         auto routeDetails = rit->second->toRouteDetails();
@@ -736,19 +940,44 @@ std::vector<MplsRouteDetails> RibRouteTables::getMplsRouteTableDetails() const {
   return mplsRouteDetails;
 }
 
+std::vector<folly::CIDRNetwork> RibRouteTables::getClientPrefixes(
+    RouterID rid,
+    ClientID clientID) const {
+  std::vector<folly::CIDRNetwork> prefixes;
+  synchronizedRouteTables_.withRLock([&](const auto& synchronizedRouteTables) {
+    const auto it = synchronizedRouteTables.find(rid);
+    if (it == synchronizedRouteTables.end()) {
+      return;
+    }
+    auto routeTable = it->second->rlock();
+    auto addClientPrefixes = [&](const auto& routes) {
+      for (const auto& entry : routes) {
+        if (entry.value()->getEntryForClient(clientID)) {
+          prefixes.push_back(entry.value()->prefix().toCidrNetwork());
+        }
+      }
+    };
+    addClientPrefixes(routeTable->v4NetworkToRoute);
+    addClientPrefixes(routeTable->v6NetworkToRoute);
+  });
+  std::sort(prefixes.begin(), prefixes.end());
+  return prefixes;
+}
+
 std::vector<RouteDetails> RibRouteTables::getRouteTableDetails(
     RouterID rid) const {
   std::vector<RouteDetails> routeDetails;
   synchronizedRouteTables_.withRLock([&](const auto& synchronizedRouteTables) {
     const auto it = synchronizedRouteTables.find(rid);
     if (it != synchronizedRouteTables.end()) {
-      for (auto rit = it->second.v4NetworkToRoute.begin();
-           rit != it->second.v4NetworkToRoute.end();
+      auto routeTable = it->second->rlock();
+      for (auto rit = routeTable->v4NetworkToRoute.begin();
+           rit != routeTable->v4NetworkToRoute.end();
            ++rit) {
         routeDetails.emplace_back(rit->value()->toRouteDetails());
       }
-      for (auto rit = it->second.v6NetworkToRoute.begin();
-           rit != it->second.v6NetworkToRoute.end();
+      for (auto rit = routeTable->v6NetworkToRoute.begin();
+           rit != routeTable->v6NetworkToRoute.end();
            ++rit) {
         routeDetails.emplace_back(rit->value()->toRouteDetails());
       }
@@ -808,7 +1037,52 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
 void RoutingInformationBase::updateStateInRibThread(
     const std::function<void()>& fn) {
   ensureRunning();
-  ribUpdateEventBase_.runInEventBaseThreadAndWait([fn] { fn(); });
+  runExclusive(fn);
+}
+
+void RoutingInformationBase::runExclusive(const std::function<void()>& fn) {
+  // A shard thread would wait on itself, either for fn to run or to park
+  for (const auto& shard : shards_) {
+    CHECK(!shard->eventBase.isInEventBaseThread())
+        << "Exclusive RIB updates can't be run from a RIB shard thread";
+  }
+  auto& firstShard = shards_.front()->eventBase;
+  if (shards_.size() == 1) {
+    firstShard.runInEventBaseThreadAndWait([&fn] { fn(); });
+    return;
+  }
+  // Park all other shards until fn is done. Exclusive callers are serialized,
+  // otherwise two callers could each park a subset of shards and deadlock.
+  std::lock_guard<std::mutex> guard(exclusiveLock_);
+  std::promise<void> done;
+  auto doneFuture = done.get_future().share();
+  std::vector<std::future<void>> parked;
+  SCOPE_EXIT {
+    done.set_value();
+  };
+  for (std::size_t i = 1; i < shards_.size(); ++i) {
+    auto parkedPromise = std::make_shared<std::promise<void>>();
+    parked.push_back(parkedPromise->get_future());
+    shards_[i]->eventBase.runInEventBaseThread([parkedPromise, doneFuture] {
+      parkedPromise->set_value();
+      doneFuture.wait();
+    });
+  }
+  for (auto& shardParked : parked) {
+    shardParked.wait();
+  }
+  firstShard.runInEventBaseThreadAndWait([&fn] { fn(); });
+}
+
+std::vector<RoutingInformationBase::UpdateStatistics>
+RoutingInformationBase::getShardStatistics() const {
+  std::vector<UpdateStatistics> shardStats;
+  shardStats.reserve(shards_.size());
+  for (std::size_t i = 0; i < shards_.size(); ++i) {
+    shardStats.push_back(shards_[i]->stats.copy());
+    shardStats.back().shard = i;
+  }
+  return shardStats;
 }
 
 state::RouteTableFields RibRouteTables::RouteTable ::toThrift() const {
@@ -827,6 +1101,11 @@ state::RouteTableFields RibRouteTables::RouteTable::warmBootState() const {
   return obj;
 }
 
+RibRouteTables::RouteTable::RouteTable() {
+  v4NetworkToRoute.setLpmCacheEnabled(FLAGS_rib_lpm_cache);
+  v6NetworkToRoute.setLpmCacheEnabled(FLAGS_rib_lpm_cache);
+}
+
 RibRouteTables::RouteTable RibRouteTables::RouteTable::fromThrift(
     const state::RouteTableFields& obj) {
   RouteTable routeTable;
@@ -842,7 +1121,7 @@ std::map<int32_t, state::RouteTableFields> RibRouteTables::toThrift() const {
   std::map<int32_t, state::RouteTableFields> obj{};
   auto routeTables = synchronizedRouteTables_.rlock();
   for (const auto& [rid, routeTable] : *routeTables) {
-    obj.emplace(rid, routeTable.toThrift());
+    obj.emplace(rid, routeTable->rlock()->toThrift());
   }
   return obj;
 }
@@ -852,7 +1131,7 @@ std::map<int32_t, state::RouteTableFields> RibRouteTables::warmBootState()
   std::map<int32_t, state::RouteTableFields> obj{};
   const auto& routeTables = *synchronizedRouteTables_.rlock();
   for (const auto& [rid, routeTable] : routeTables) {
-    obj.emplace(rid, routeTable.warmBootState());
+    obj.emplace(rid, routeTable->rlock()->warmBootState());
   }
   return obj;
 }
@@ -865,7 +1144,8 @@ RibRouteTables RibRouteTables::fromThrift(
     // @lint-ignore CLANGTIDY
     routeTables->emplace(
         RouterID(rid),
-        RibRouteTables::RouteTable::fromThrift(routeTableFields));
+        std::make_shared<SynchronizedRouteTable>(
+            RibRouteTables::RouteTable::fromThrift(routeTableFields)));
   }
   return ribRouteTables;
 }
@@ -907,10 +1187,14 @@ void RibRouteTables::importFibs(
   for (const auto& [_, fibs] : std::as_const(*multiSwitchfibs)) {
     for (const auto& iter : std::as_const(*fibs)) {
       const auto& fib = iter.second;
-      auto& routeTables = (*lockedRouteTables)[fib->getID()];
-      importRoutes(fib->getFibV6(), &routeTables.v6NetworkToRoute);
-      importRoutes(fib->getFibV4(), &routeTables.v4NetworkToRoute);
-      auto mplsTable = &routeTables.labelToRoute;
+      auto& synchronizedRouteTable = (*lockedRouteTables)[fib->getID()];
+      if (!synchronizedRouteTable) {
+        synchronizedRouteTable = std::make_shared<SynchronizedRouteTable>();
+      }
+      auto routeTables = synchronizedRouteTable->wlock();
+      importRoutes(fib->getFibV6(), &routeTables->v6NetworkToRoute);
+      importRoutes(fib->getFibV4(), &routeTables->v4NetworkToRoute);
+      auto mplsTable = &routeTables->labelToRoute;
       if (FLAGS_mpls_rib && labelFibs) {
         for (const auto& [_, labelFib] : std::as_const(*labelFibs)) {
           for (const auto& entry : std::as_const(*labelFib)) {
@@ -19,12 +19,17 @@
 
 #include <folly/Synchronized.h>
 
+#include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
 DECLARE_bool(mpls_rib);
+DECLARE_bool(rib_lpm_cache);
+DECLARE_uint32(rib_update_shards);
 
 namespace facebook::fboss {
 class SwitchState;
@@ -127,6 +132,10 @@ class RibRouteTables {
   std::vector<RouterID> getVrfList() const;
   std::vector<RouteDetails> getRouteTableDetails(RouterID rid) const;
   std::vector<MplsRouteDetails> getMplsRouteTableDetails() const;
+  // Sorted prefixes of IP routes with an entry from clientID
+  std::vector<folly::CIDRNetwork> getClientPrefixes(
+      RouterID rid,
+      ClientID clientID) const;
 
   template <typename AddressT>
   std::shared_ptr<Route<AddressT>> longestMatch(
@@ -140,9 +149,13 @@ class RibRouteTables {
 
  private:
   struct RouteTable {
+    RouteTable();
+
     IPv4NetworkToRouteMap v4NetworkToRoute;
     IPv6NetworkToRouteMap v6NetworkToRoute;
     LabelToRouteMap labelToRoute;
+    // Not serialized, rebuilt by the first full resolution after load
+    NextHopDependencyIndex nhopDependencies;
 
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
@@ -175,13 +188,14 @@ class RibRouteTables {
   void updateRib(RouterID vrf, const RibUpdateFn& updateRib);
 
   /*
-   * Currently, route updates to separate VRFs are made to be sequential. In the
-   * event FBOSS has to operate in a routing architecture with numerous VRFs,
-   * we can avoid a slow down by a factor of number of VRFs by parallelizing
-   * route updates across VRFs. This can be accomplished simply by associating
-   * the mutex implicit in folly::Synchronized with an individual RouteTable.
+   * Every RouteTable has its own lock, so that route updates to separate VRFs
+   * (issued from separate RIB update shards) can proceed in parallel. The
+   * outer lock only guards the set of VRFs, it is always acquired before a
+   * RouteTable lock.
    */
-  using RouterIDToRouteTable = boost::container::flat_map<RouterID, RouteTable>;
+  using SynchronizedRouteTable = folly::Synchronized<RouteTable>;
+  using RouterIDToRouteTable = boost::container::
+      flat_map<RouterID, std::shared_ptr<SynchronizedRouteTable>>;
   using SynchronizedRouteTables = folly::Synchronized<RouterIDToRouteTable>;
 
   void importFibs(
@@ -212,6 +226,17 @@ class RoutingInformationBase {
     std::size_t mplsRoutesAdded{0};
     std::size_t mplsRoutesDeleted{0};
     std::chrono::microseconds duration{0};
+    // RIB update shard which handled the update
+    std::size_t shard{0};
+  };
+
+  struct SyncFibProgress {
+    // Statistics of the chunk (or commit) just processed
+    UpdateStatistics lastUpdate;
+    // Accumulated since beginSyncFib
+    UpdateStatistics total;
+    std::size_t chunks{0};
+    std::chrono::microseconds elapsed{0};
   };
 
   /*
@@ -261,6 +286,34 @@ class RoutingInformationBase {
       FibUpdateFunction fibUpdateCallback,
       void* cookie);
 
+  /*
+   * Chunked alternative to update() with resetClientsRoutes, for route sets
+   * too large to hold in memory twice. beginSyncFib() starts a sync of
+   * clientID's routes in routerID. addSyncFibRoutes() adds and programs
+   * routes as they are received. commitSyncFib() then deletes the routes
+   * of clientID which were not added since beginSyncFib(), through
+   * addSyncFibRoutes() or any other unicast route update. For the
+   * duration of the sync only the prefixes of the client's existing routes
+   * are retained. Calling beginSyncFib() again restarts the sync, routes
+   * added by the abandoned sync are kept until the next commit.
+   */
+  void beginSyncFib(RouterID routerID, ClientID clientID);
+  SyncFibProgress addSyncFibRoutes(
+      const SwitchIdScopeResolver* resolver,
+      RouterID routerID,
+      ClientID clientID,
+      AdminDistance adminDistanceFromClientID,
+      const std::vector<UnicastRoute>& toAdd,
+      FibUpdateFunction fibUpdateCallback,
+      void* cookie);
+  SyncFibProgress commitSyncFib(
+      const SwitchIdScopeResolver* resolver,
+      RouterID routerID,
+      ClientID clientID,
+      AdminDistance adminDistanceFromClientID,
+      FibUpdateFunction fibUpdateCallback,
+      void* cookie);
+
   /*
    * VrfAndNetworkToInterfaceRoute is conceptually a mapping from the pair
    * (RouterID, folly::CIDRNetwork) to the pair (Interface(1),
@@ -326,8 +379,22 @@ class RoutingInformationBase {
       const FibUpdateFunction& fibUpdateCallback,
       void* cookie);
 
+  /*
+   * Run fn on the RIB update thread, with no route update in progress on any
+   * RIB update shard.
+   */
   void updateStateInRibThread(const std::function<void()>& fn);
 
+  /*
+   * RIB updates are processed by FLAGS_rib_update_shards threads, with VRFs
+   * assigned to shards by RouterID. Returns the statistics accumulated by
+   * each shard since the RIB was created, indexed by shard.
+   */
+  std::vector<UpdateStatistics> getShardStatistics() const;
+  std::size_t getNumShards() const {
+    return shards_.size();
+  }
+
   /*
    * FIB assisted fromThrift. With shared data structure of routes
    * all except the unresolved routes are shared b/w rib and FIB, so
@@ -353,7 +420,9 @@ class RoutingInformationBase {
   }
   void waitForRibUpdates() {
     ensureRunning();
-    ribUpdateEventBase_.runInFbossEventBaseThreadAndWait([] { return; });
+    for (auto& shard : shards_) {
+      shard->eventBase.runInFbossEventBaseThreadAndWait([] { return; });
+    }
   }
 
   void stop();
@@ -394,8 +463,47 @@ class RoutingInformationBase {
       FibUpdateFunction fibUpdateCallback,
       void* cookie);
 
-  std::unique_ptr<std::thread> ribUpdateThread_;
-  FbossEventBase ribUpdateEventBase_{"RibUpdateEventBase"};
+  struct UpdateShard {
+    explicit UpdateShard(const std::string& name) : eventBase(name) {}
+
+    std::unique_ptr<std::thread> thread;
+    FbossEventBase eventBase;
+    folly::Synchronized<UpdateStatistics> stats;
+  };
+
+  std::size_t getShardIndex(RouterID vrf) const {
+    return static_cast<std::size_t>(vrf) % shards_.size();
+  }
+  UpdateShard& getShard(RouterID vrf) const {
+    return *shards_[getShardIndex(vrf)];
+  }
+  // Runs fn on the first shard while all other shards are parked. Not to be
+  // called from a shard thread.
+  void runExclusive(const std::function<void()>& fn);
+  // Marks the added routes resent in the syncFib session of the client, if
+  // any
+  void markSyncFibRoutesResent(
+      RouterID routerID,
+      ClientID clientID,
+      const std::vector<UnicastRoute>& added);
+
+  struct SyncFibSession {
+    // Prefixes of the client's routes at beginSyncFib, sorted
+    std::vector<folly::CIDRNetwork> prefixes;
+    // Whether the corresponding prefix has been resent
+    std::vector<bool> resent;
+    SyncFibProgress progress;
+    std::chrono::steady_clock::time_point start;
+  };
+  using SynchronizedSyncFibSession = folly::Synchronized<SyncFibSession>;
+  using SyncFibSessions = std::map<
+      std::pair<RouterID, ClientID>,
+      std::shared_ptr<SynchronizedSyncFibSession>>;
+
+  std::vector<std::unique_ptr<UpdateShard>> shards_;
+  // Serializes runExclusive callers
+  std::mutex exclusiveLock_;
+  folly::Synchronized<SyncFibSessions> syncFibSessions_;
   RibRouteTables ribTables_;
 };
 
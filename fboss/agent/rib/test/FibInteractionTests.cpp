@@ -10,6 +10,7 @@
 
 #include "common/network/if/gen-cpp2/Address_types.h"
 #include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
@@ -342,6 +343,83 @@ TEST(Rib, Update) {
   EXPECT_FIB_SIZE(state, vrfZero, 4, 4);
 }
 
+TEST(Rib, ChunkedSyncFib) {
+  cfg::SwitchConfig config;
+  config.vlans()->resize(1);
+  *config.vlans()[0].id() = 1;
+  config.interfaces()->resize(1);
+  *config.interfaces()[0].intfID() = 1;
+  *config.interfaces()[0].vlanID() = 1;
+  *config.interfaces()[0].routerID() = 0;
+  config.interfaces()[0].mac() = "00:02:00:00:00:01";
+  config.interfaces()[0].ipAddresses()->resize(2);
+  config.interfaces()[0].ipAddresses()[0] = "0.0.0.0/0";
+  config.interfaces()[0].ipAddresses()[1] = "::/0";
+
+  auto testHandle = createTestHandle(&config);
+  auto sw = testHandle->getSw();
+  const auto kClient10 = ClientID(10);
+  const auto kClient20 = ClientID(20);
+  auto nexthop = folly::IPAddressV4("11.11.11.11");
+  auto prefixA4 = folly::CIDRNetworkV4(folly::IPAddressV4("7.1.0.0"), 16);
+  auto prefixB4 = folly::CIDRNetworkV4(folly::IPAddressV4("7.2.0.0"), 16);
+  auto prefixC4 = folly::CIDRNetworkV4(folly::IPAddressV4("7.3.0.0"), 16);
+  auto routeA4 = createUnicastRoute(prefixA4.first, prefixA4.second, nexthop);
+  auto routeB4 = createUnicastRoute(prefixB4.first, prefixB4.second, nexthop);
+  auto routeC4 = createUnicastRoute(prefixC4.first, prefixC4.second, nexthop);
+
+  programRoutes(sw, kClient10, {routeA4, routeB4});
+  programRoutes(sw, kClient20, {routeB4});
+  EXPECT_FIB_SIZE(sw->getState(), vrfZero, 3, 2);
+
+  // Committing without a sync in progress is an error
+  EXPECT_THROW(
+      sw->getRouteUpdater().commitSyncFib(vrfZero, kClient10), FbossError);
+
+  sw->getRouteUpdater().beginSyncFib(vrfZero, kClient10);
+  auto progress =
+      sw->getRouteUpdater().addSyncFibRoutes(vrfZero, kClient10, {routeB4});
+  EXPECT_EQ(1, progress.chunks);
+  progress =
+      sw->getRouteUpdater().addSyncFibRoutes(vrfZero, kClient10, {routeC4});
+  EXPECT_EQ(2, progress.chunks);
+  EXPECT_EQ(2, progress.total.v4RoutesAdded);
+  // Chunks are programmed right away, nothing is deleted before commit
+  auto state = sw->getState();
+  EXPECT_ROUTE(state, vrfZero, prefixA4.first, prefixA4.second);
+  EXPECT_ROUTE(state, vrfZero, prefixC4.first, prefixC4.second);
+
+  progress = sw->getRouteUpdater().commitSyncFib(vrfZero, kClient10);
+  EXPECT_EQ(1, progress.total.v4RoutesDeleted);
+  state = sw->getState();
+  EXPECT_NO_ROUTE(state, vrfZero, prefixA4.first, prefixA4.second);
+  EXPECT_ROUTE(state, vrfZero, prefixB4.first, prefixB4.second);
+  EXPECT_ROUTE(state, vrfZero, prefixC4.first, prefixC4.second);
+  EXPECT_FIB_SIZE(state, vrfZero, 3, 2);
+  // The session ends once the commit is applied
+  EXPECT_THROW(
+      sw->getRouteUpdater().commitSyncFib(vrfZero, kClient10), FbossError);
+
+  // Client 20's route is untouched by client 10's sync
+  sw->getRouteUpdater().beginSyncFib(vrfZero, kClient10);
+  sw->getRouteUpdater().commitSyncFib(vrfZero, kClient10);
+  state = sw->getState();
+  EXPECT_ROUTE(state, vrfZero, prefixB4.first, prefixB4.second);
+  EXPECT_NO_ROUTE(state, vrfZero, prefixC4.first, prefixC4.second);
+  EXPECT_FIB_SIZE(state, vrfZero, 2, 2);
+
+  // Existing routes re-added by other route updates during the sync are kept,
+  // just as routes new to the sync are
+  programRoutes(sw, kClient10, {routeA4, routeC4});
+  sw->getRouteUpdater().beginSyncFib(vrfZero, kClient10);
+  programRoutes(sw, kClient10, {routeA4});
+  sw->getRouteUpdater().commitSyncFib(vrfZero, kClient10);
+  state = sw->getState();
+  EXPECT_ROUTE(state, vrfZero, prefixA4.first, prefixA4.second);
+  EXPECT_NO_ROUTE(state, vrfZero, prefixC4.first, prefixC4.second);
+  EXPECT_FIB_SIZE(state, vrfZero, 3, 2);
+}
+
 // There are 3 cases that should be exercised:
 // 1) a route has been added whose prefix _doesn't_ exist in the RIB
 // 2) a route has been added whose prefix exists in the RIB BUT whose
@@ -20,9 +20,12 @@
 #include "fboss/agent/state/SwitchState.h"
 
 #include <folly/IPAddress.h>
+#include <folly/ScopeGuard.h>
 #include <folly/json/dynamic.h>
 
 #include <gtest/gtest.h>
+#include <future>
+#include <thread>
 
 using namespace facebook::fboss;
 
@@ -425,3 +428,82 @@ TEST_F(RibRollbackTest, rollbackMpls) {
   assertRouteCount(0, 1, 1);
   EXPECT_EQ(routeTableBeforeFailedUpdate, rib_.getRouteTableDetails(kRid));
 }
+
+TEST(RibUpdateShards, updatesToOtherShardsNotBlocked) {
+  FLAGS_rib_update_shards = 2;
+  SCOPE_EXIT {
+    FLAGS_rib_update_shards = 1;
+  };
+  RoutingInformationBase rib;
+  ASSERT_EQ(2, rib.getNumShards());
+  const RouterID kRid0(0), kRid1(1);
+  rib.ensureVrf(kRid0);
+  rib.ensureVrf(kRid1);
+
+  // Hold up FIB programming for VRF 0
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> blocked;
+  auto blockingFibUpdate = [&](const SwitchIdScopeResolver* resolver,
+                               RouterID vrf,
+                               const IPv4NetworkToRouteMap& v4NetworkToRoute,
+                               const IPv6NetworkToRouteMap& v6NetworkToRoute,
+                               const LabelToRouteMap& labelToRoute,
+                               void* cookie) {
+    blocked.set_value();
+    released.wait();
+    return noopFibUpdate(
+        resolver,
+        vrf,
+        v4NetworkToRoute,
+        v6NetworkToRoute,
+        labelToRoute,
+        cookie);
+  };
+  RoutingInformationBase::UpdateStatistics vrf0Stats;
+  std::thread vrf0Updater([&] {
+    vrf0Stats = rib.update(
+        scopeResolver(),
+        kRid0,
+        kBgpClient,
+        kBgpDistance,
+        {makeDropUnicastRoute(kPrefix1), makeDropUnicastRoute(kPrefix2)},
+        {},
+        false,
+        "blocked add",
+        blockingFibUpdate,
+        nullptr);
+  });
+  blocked.get_future().wait();
+
+  // VRF 1 is handled by the other shard and goes through
+  auto vrf1Stats = rib.update(
+      scopeResolver(),
+      kRid1,
+      kBgpClient,
+      kBgpDistance,
+      {makeDropUnicastRoute(kPrefix1)},
+      {},
+      false,
+      "add",
+      noopFibUpdate,
+      nullptr);
+  EXPECT_EQ(1, vrf1Stats.shard);
+  EXPECT_EQ(1, vrf1Stats.v6RoutesAdded);
+  EXPECT_EQ(1, rib.getRouteTableDetails(kRid1).size());
+
+  release.set_value();
+  vrf0Updater.join();
+  EXPECT_EQ(0, vrf0Stats.shard);
+  EXPECT_EQ(2, rib.getRouteTableDetails(kRid0).size());
+
+  auto shardStats = rib.getShardStatistics();
+  ASSERT_EQ(2, shardStats.size());
+  EXPECT_EQ(2, shardStats[0].v6RoutesAdded);
+  EXPECT_EQ(1, shardStats[1].v6RoutesAdded);
+
+  // Exclusive updates run with every shard idle
+  bool ran{false};
+  rib.updateStateInRibThread([&ran] { ran = true; });
+  EXPECT_TRUE(ran);
+}
@@ -16,6 +16,7 @@
 #include "fboss/agent/rib/RouteUpdater.h"
 
 #include <folly/IPAddress.h>
+#include <folly/ScopeGuard.h>
 #include <folly/json/dynamic.h>
 
 #include <gtest/gtest.h>
@@ -165,4 +166,87 @@ TEST(Route, serializeRouteTable) {
       false);
 }
 
+TEST(Route, incrementalResolution) {
+  FLAGS_rib_incremental_resolution = true;
+  SCOPE_EXIT {
+    FLAGS_rib_incremental_resolution = false;
+  };
+  // Same updates are applied to a table resolved incrementally and to one
+  // resolved in full, results must match
+  IPv4NetworkToRouteMap v4Incremental, v4Full;
+  IPv6NetworkToRouteMap v6Incremental, v6Full;
+  LabelToRouteMap mplsIncremental, mplsFull;
+  NextHopDependencyIndex nhopDependencies;
+
+  auto update = [&](ClientID client,
+                    const std::vector<RibRouteUpdater::RouteEntry>& toAdd,
+                    const std::vector<folly::CIDRNetwork>& toDel) {
+    RibRouteUpdater incremental(
+        &v4Incremental, &v6Incremental, &mplsIncremental, &nhopDependencies);
+    incremental.update(client, toAdd, toDel, false);
+    RibRouteUpdater full(&v4Full, &v6Full, &mplsFull);
+    full.update(client, toAdd, toDel, false);
+    EXPECT_ROUTES_MATCH(&v4Incremental, &v4Full);
+    EXPECT_ROUTES_MATCH(&v6Incremental, &v6Full);
+  };
+  auto interfaceRoute = [](const std::string& network,
+                           const std::string& addr,
+                           int intf) {
+    return RibRouteUpdater::RouteEntry(
+        {IPAddress(network), 24},
+        RouteNextHopEntry(
+            static_cast<NextHop>(ResolvedNextHop(
+                IPAddress(addr), InterfaceID(intf), UCMP_DEFAULT_WEIGHT)),
+            AdminDistance::DIRECTLY_CONNECTED));
+  };
+  auto findRoute = [&v4Incremental](const std::string& network, uint8_t mask) {
+    auto itr = v4Incremental.exactMatch(IPAddressV4(network), mask);
+    CHECK(itr != v4Incremental.end());
+    return itr->value();
+  };
+
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {interfaceRoute("1.1.1.0", "1.1.1.1", 1),
+       interfaceRoute("2.2.2.0", "2.2.2.1", 2)},
+      {});
+  // First update resolves in full and builds the index
+  EXPECT_TRUE(nhopDependencies.isValid());
+
+  // A and B resolve over interfaces, C recursively over A
+  update(
+      kClientA,
+      {{{IPAddress("10.1.0.0"), 16},
+        RouteNextHopEntry(makeNextHops({"1.1.1.10"}), kDistance)},
+       {{IPAddress("10.2.0.0"), 16},
+        RouteNextHopEntry(makeNextHops({"2.2.2.10"}), kDistance)},
+       {{IPAddress("30.0.0.0"), 8},
+        RouteNextHopEntry(makeNextHops({"10.1.0.5"}), kDistance)}},
+      {});
+  EXPECT_TRUE(findRoute("30.0.0.0", 8)->isResolved());
+  EXPECT_EQ(3, nhopDependencies.numRoutes());
+
+  // Removing interface 1 affects A and, through A, C. B is not touched.
+  auto routeB = findRoute("10.2.0.0", 16);
+  update(ClientID::INTERFACE_ROUTE, {}, {{IPAddress("1.1.1.0"), 24}});
+  EXPECT_EQ(routeB, findRoute("10.2.0.0", 16));
+  EXPECT_FALSE(findRoute("10.1.0.0", 16)->isResolved());
+  EXPECT_FALSE(findRoute("30.0.0.0", 8)->isResolved());
+
+  // A more specific route covering C's next hop re-resolves C
+  update(
+      kClientA,
+      {{{IPAddress("10.1.0.0"), 24},
+        RouteNextHopEntry(makeNextHops({"2.2.2.11"}), kDistance)}},
+      {});
+  EXPECT_EQ(routeB, findRoute("10.2.0.0", 16));
+  EXPECT_TRUE(findRoute("30.0.0.0", 8)->isResolved());
+  EXPECT_EQ(4, nhopDependencies.numRoutes());
+
+  // And deleting it makes C unresolvable again
+  update(kClientA, {}, {{IPAddress("10.1.0.0"), 24}});
+  EXPECT_FALSE(findRoute("30.0.0.0", 8)->isResolved());
+  EXPECT_EQ(3, nhopDependencies.numRoutes());
+}
+
 } // namespace facebook::fboss
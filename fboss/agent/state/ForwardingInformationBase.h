@@ -14,6 +14,7 @@
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteTypes.h"
 #include "fboss/agent/state/Thrifty.h"
+#include "fboss/thrift_cow/nodes/PersistentSortedMap.h"
 
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
@@ -35,12 +36,20 @@ using ForwardingInformationBaseType = std::map<std::string, state::RouteFields>;
 template <typename AddrT>
 class ForwardingInformationBase;
 
+/*
+ * FIBs hold up to millions of routes and are cloned for every route update,
+ * so routes are kept in a map sharing structure between FIB versions.
+ */
 template <typename AddrT>
-using ForwardingInformationBaseTraits = ThriftMapNodeTraits<
-    ForwardingInformationBase<AddrT>,
-    ForwardingInformationBaseClass,
-    ForwardingInformationBaseType,
-    Route<AddrT>>;
+struct ForwardingInformationBaseTraits
+    : ThriftMapNodeTraits<
+          ForwardingInformationBase<AddrT>,
+          ForwardingInformationBaseClass,
+          ForwardingInformationBaseType,
+          Route<AddrT>> {
+  template <typename K, typename V>
+  using MapStorage = thrift_cow::PersistentSortedMap<K, V>;
+};
 
 template <typename AddressT>
 class ForwardingInformationBase
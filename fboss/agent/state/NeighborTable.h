@@ -16,6 +16,7 @@
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/NodeMap.h"
 #include "fboss/agent/state/PortDescriptor.h"
+#include "fboss/thrift_cow/nodes/PersistentSortedMap.h"
 
 namespace facebook::fboss {
 
@@ -46,7 +47,11 @@ struct NbrTableTraits : ThriftMapNodeTraits<
                             SUBCLASS,
                             NbrTableTypeClass,
                             NbrTableThriftType,
-                            NODE> {};
+                            NODE> {
+  // neighbor tables of large VLANs are cloned per resolved entry
+  template <typename K, typename V>
+  using MapStorage = thrift_cow::PersistentSortedMap<K, V>;
+};
 
 /*
  * A map of IP --> MAC for the IP addresses of other nodes on a VLAN.
@@ -458,7 +458,12 @@ class Route : public ThriftStructNode<Route<AddrT>, ThriftFieldsT<AddrT>> {
   }
   // THRIFT_COPY
   void setResolved(const RouteNextHopEntry& fwd) {
-    this->template set<switch_state_tags::fwd>(fwd.toThrift());
+    if (FLAGS_intern_route_nexthops) {
+      this->template ref<switch_state_tags::fwd>() =
+          RouteNextHopEntry::intern(fwd);
+    } else {
+      this->template set<switch_state_tags::fwd>(fwd.toThrift());
+    }
     setFlags(flags() | RESOLVED);
     setFlags(flags() & (~(UNRESOLVABLE | PROCESSING)));
   }
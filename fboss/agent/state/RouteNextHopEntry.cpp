@@ -12,10 +12,14 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/state/RouteNextHop.h"
 
+#include <folly/Indestructible.h>
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
 #include <gflags/gflags.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
+#include <algorithm>
 #include <iterator>
+#include <map>
 #include <numeric>
 #include "folly/IPAddress.h"
 
@@ -39,6 +43,12 @@ std::vector<facebook::fboss::NextHopThrift> thriftNextHopsFromAddresses(
 DEFINE_bool(wide_ecmp, false, "Enable fixed width wide ECMP feature");
 DEFINE_bool(optimized_ucmp, false, "Enable UCMP normalization optimizations");
 DEFINE_double(ucmp_max_error, 0.05, "Max UCMP normalization error");
+DEFINE_bool(
+    intern_route_nexthops,
+    false,
+    "Share resolved forwarding info between routes with identical next hops. "
+    "All RIB shards intern through one lock protected table, so this "
+    "serializes route resolution across shards");
 
 namespace facebook::fboss {
 
@@ -626,6 +636,49 @@ RouteNextHopEntry RouteNextHopEntry::fromStaticMplsRoute(
   return RouteNextHopEntry(std::move(nhops), AdminDistance::STATIC_ROUTE);
 }
 
+namespace {
+// Interned entries are swept for expired ones whenever the pool has doubled
+// since the last sweep
+constexpr size_t kMinInternSweepSize = 1024;
+
+struct InternedEntries {
+  std::map<state::RouteNextHopEntry, std::weak_ptr<RouteNextHopEntry>> entries;
+  size_t sweepSize{kMinInternSweepSize};
+};
+
+folly::Synchronized<InternedEntries>& internedEntries() {
+  static folly::Indestructible<folly::Synchronized<InternedEntries>> pool;
+  return *pool;
+}
+} // namespace
+
+std::shared_ptr<RouteNextHopEntry> RouteNextHopEntry::intern(
+    const RouteNextHopEntry& entry) {
+  auto thrift = entry.toThrift();
+  auto pool = internedEntries().wlock();
+  auto& interned = pool->entries[thrift];
+  if (auto existing = interned.lock()) {
+    return existing;
+  }
+  auto created = std::make_shared<RouteNextHopEntry>(std::move(thrift));
+  created->publish();
+  interned = created;
+  if (pool->entries.size() >= 2 * pool->sweepSize) {
+    std::erase_if(
+        pool->entries, [](const auto& kv) { return kv.second.expired(); });
+    pool->sweepSize = std::max(kMinInternSweepSize, pool->entries.size());
+  }
+  return created;
+}
+
+size_t RouteNextHopEntry::numInterned() {
+  auto pool = internedEntries().rlock();
+  return std::count_if(
+      pool->entries.begin(), pool->entries.end(), [](const auto& kv) {
+        return !kv.second.expired();
+      });
+}
+
 bool RouteNextHopEntry::isUcmp(const NextHopSet& nhopSet) {
   return totalWeight(nhopSet) != nhopSet.size();
 }
@@ -22,6 +22,7 @@
 DECLARE_uint32(ecmp_width);
 DECLARE_bool(optimized_ucmp);
 DECLARE_bool(wide_ecmp);
+DECLARE_bool(intern_route_nexthops);
 
 namespace facebook::fboss {
 
@@ -161,6 +162,15 @@ class RouteNextHopEntry
       const cfg::StaticIp2MplsRoute& route);
   static facebook::fboss::RouteNextHopEntry fromStaticMplsRoute(
       const cfg::StaticMplsRouteWithNextHops& route);
+  /*
+   * Published entry equal to the given one, shared by all callers asking for
+   * the same forwarding info. Entries are held weakly and released once the
+   * last route referencing them goes away.
+   */
+  static std::shared_ptr<RouteNextHopEntry> intern(
+      const RouteNextHopEntry& entry);
+  // Number of distinct entries currently interned
+  static size_t numInterned();
   static bool isUcmp(const NextHopSet& nhopSet);
   static void normalizeNextHopWeightsToMaxPaths(
       std::vector<uint64_t>& nhWeights,
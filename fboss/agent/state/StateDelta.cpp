@@ -36,8 +36,14 @@
 #include "fboss/agent/state/VlanMapDelta.h"
 #include "fboss/fsdb/common/Utils.h"
 
+#include <folly/Indestructible.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/json/dynamic.h>
 
+#include <atomic>
+
 using std::shared_ptr;
 
 DEFINE_bool(
@@ -50,9 +56,24 @@ DEFINE_bool(
     false,
     "Make sure oper delta apply is correct, this is expensive operation to be used only in tests");
 
+DEFINE_int32(
+    state_delta_threads,
+    1,
+    "Threads computing the oper delta of changed SwitchState members in "
+    "parallel, 1 to compute it on the calling thread");
+
 namespace facebook::fboss {
 
 namespace {
+std::atomic<uint64_t> operDeltaComputationCount{0};
+
+folly::Executor* stateDeltaExecutor() {
+  static folly::Indestructible<folly::CPUThreadPoolExecutor> executor(
+      std::max(FLAGS_state_delta_threads, 1),
+      std::make_shared<folly::NamedThreadFactory>("StateDelta"));
+  return &*executor;
+}
+
 template <
     typename Map,
     typename MultiNpuMap,
@@ -84,15 +105,18 @@ StateDelta::StateDelta(
 StateDelta::StateDelta(
     std::shared_ptr<SwitchState> oldState,
     fsdb::OperDelta operDelta)
-    : old_(oldState), operDelta_(std::move(operDelta)) {
+    : old_(oldState) {
   // compute new state from old state and oper delta
   fsdb::CowStorage<state::SwitchState, SwitchState> cowState{old_->clone()};
-  if (auto error = cowState.patch_impl(operDelta_.value())) {
+  if (auto error = cowState.patch_impl(operDelta)) {
     throw FbossError(
         "Error while applying the patch: ", static_cast<int>(error.value()));
   }
   new_ = cowState.root();
   new_->publish();
+  std::call_once(operDeltaCache_->computed, [&]() {
+    operDeltaCache_->operDelta.emplace(std::move(operDelta));
+  });
 }
 
 StateDelta::~StateDelta() = default;
@@ -299,11 +323,66 @@ MultiSwitchMapDelta<MultiTeFlowTable> StateDelta::getTeFlowEntriesDelta()
 }
 
 const fsdb::OperDelta& StateDelta::getOperDelta() const {
-  if (!operDelta_.has_value()) {
-    operDelta_.emplace(fsdb::computeOperDelta(
-        old_, new_, {}, FLAGS_state_oper_delta_use_id_paths));
+  std::call_once(operDeltaCache_->computed, [this]() {
+    operDeltaCache_->operDelta.emplace(computeOperDelta());
+  });
+  return operDeltaCache_->operDelta.value();
+}
+
+uint64_t StateDelta::operDeltaComputations() {
+  return operDeltaComputationCount.load();
+}
+
+/*
+ * Members of SwitchState are independent subtrees, so the oper delta of each
+ * changed member is computed on its own against a copy of the old state with
+ * only that member taken from the new state. Concatenated in member order,
+ * these match the delta computed over the whole state in one pass.
+ */
+fsdb::OperDelta StateDelta::computeOperDelta() const {
+  ++operDeltaComputationCount;
+  std::vector<std::shared_ptr<SwitchState>> memberStates;
+  if (FLAGS_state_delta_threads > 1) {
+    fatal::foreach<SwitchState::Fields::Members>([&](auto indexed) {
+      using member = decltype(fatal::tag_type(indexed));
+      using Name = typename member::name;
+      if (old_->template cref<Name>() != new_->template cref<Name>()) {
+        auto memberState = old_->clone();
+        memberState->template ref<Name>() = new_->template cref<Name>();
+        memberStates.push_back(std::move(memberState));
+      }
+    });
+  }
+  if (memberStates.size() <= 1) {
+    return fsdb::computeOperDelta(
+        old_, new_, {}, FLAGS_state_oper_delta_use_id_paths);
+  }
+
+  std::vector<folly::SemiFuture<fsdb::OperDelta>> memberDeltas;
+  memberDeltas.reserve(memberStates.size());
+  for (auto& memberState : memberStates) {
+    memberDeltas.push_back(
+        folly::via(
+            stateDeltaExecutor(),
+            [oldState = old_, memberState = std::move(memberState)]() {
+              return fsdb::computeOperDelta(
+                  oldState,
+                  memberState,
+                  {},
+                  FLAGS_state_oper_delta_use_id_paths);
+            })
+            .semi());
+  }
+  auto deltas = folly::collect(std::move(memberDeltas)).get();
+  auto operDelta = std::move(deltas.front());
+  auto& changes = *operDelta.changes();
+  for (auto it = std::next(deltas.begin()); it != deltas.end(); ++it) {
+    changes.insert(
+        changes.end(),
+        std::make_move_iterator(it->changes()->begin()),
+        std::make_move_iterator(it->changes()->end()));
   }
-  return operDelta_.value();
+  return operDelta;
 }
 
 // Explicit instantiations of NodeMapDelta that are used by StateDelta.
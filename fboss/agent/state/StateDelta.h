@@ -11,6 +11,8 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 
 #include "fboss/agent/state/AclMap.h"
@@ -46,7 +48,9 @@
 
 #include "fboss/thrift_cow/nodes/Types.h"
 
+DECLARE_bool(state_oper_delta_use_id_paths);
 DECLARE_bool(verify_apply_oper_delta);
+DECLARE_int32(state_delta_threads);
 
 namespace facebook::fboss {
 
@@ -116,16 +120,28 @@ class StateDelta {
   MultiSwitchMapDelta<MultiSwitchDsfNodeMap> getDsfNodesDelta() const;
 
   const fsdb::OperDelta& getOperDelta() const;
+  // Number of oper deltas computed from a pair of states so far, across all
+  // StateDeltas. Lets tests check an update computes its delta only once.
+  static uint64_t operDeltaComputations();
 
  private:
   // Forbidden copy constructor and assignment operator
   StateDelta(StateDelta const&) = delete;
   StateDelta& operator=(StateDelta const&) = delete;
 
+  fsdb::OperDelta computeOperDelta() const;
+
+  struct OperDeltaCache {
+    std::once_flag computed;
+    std::optional<fsdb::OperDelta> operDelta;
+  };
+
   std::shared_ptr<SwitchState> old_;
   std::shared_ptr<SwitchState> new_;
-  // on-demand populate oper delta and keep it cached
-  mutable std::optional<fsdb::OperDelta> operDelta_;
+  // on-demand populate oper delta and keep it cached. Observers notified
+  // concurrently share the delta, so population is once-only.
+  std::unique_ptr<OperDeltaCache> operDeltaCache_{
+      std::make_unique<OperDeltaCache>()};
 };
 
 bool isStateDeltaEmpty(const StateDelta& stateDelta);
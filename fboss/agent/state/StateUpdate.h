@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include <folly/FBString.h>
@@ -36,6 +37,7 @@ class StateUpdate {
     NONE = 0x0,
     NON_COALESCING = 0x1,
     HW_FAILURE_PROTECTION = 0x2,
+    HIGH_PRIORITY = 0x4,
   };
   static constexpr int kDefaultBehaviorFlags =
       static_cast<int>(BehaviorFlags::NONE);
@@ -57,6 +59,9 @@ class StateUpdate {
     return behaviorFlags_ &
         static_cast<int>(BehaviorFlags::HW_FAILURE_PROTECTION);
   }
+  bool isHighPriority() const {
+    return behaviorFlags_ & static_cast<int>(BehaviorFlags::HIGH_PRIORITY);
+  }
 
   /*
    * Apply the update, and return a new SwitchState.
@@ -98,6 +103,8 @@ class StateUpdate {
 
   std::string name_;
   int behaviorFlags_{static_cast<int>(BehaviorFlags::NONE)};
+  // When the update was queued, maintained by SwSwitch.
+  std::chrono::steady_clock::time_point enqueueTime_;
 
   // An intrusive list hook for maintaining the list of pending updates.
   folly::IntrusiveListHook listHook_;
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/AggregatePort.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+cfg::AclEntry makeAcl(const std::string& name, const std::string& dstIp) {
+  cfg::AclEntry acl;
+  acl.name() = name;
+  acl.actionType() = cfg::AclActionType::DENY;
+  acl.dstIp() = dstIp;
+  return acl;
+}
+
+cfg::QosPolicy makeQosPolicy(const std::string& name, int16_t dscp) {
+  cfg::QosRule rule;
+  rule.queueId() = 0;
+  rule.dscp() = {dscp};
+  cfg::QosPolicy policy;
+  policy.name() = name;
+  policy.rules() = {rule};
+  return policy;
+}
+
+class IncrementalConfigTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    platform_ = createMockPlatform(cfg::SwitchType::VOQ, kVoqSwitchIdBegin);
+    auto stateV0 = std::make_shared<SwitchState>();
+    addSwitchInfo(stateV0, cfg::SwitchType::VOQ, kVoqSwitchIdBegin);
+    config_ = testConfigA(cfg::SwitchType::VOQ);
+    config_.acls()->push_back(makeAcl("acl0", "10.0.0.0/24"));
+    state_ = publishAndApplyConfig(stateV0, &config_, platform_.get());
+    ASSERT_NE(nullptr, state_);
+  }
+
+  // applies newConfig to state_, incrementally and as a whole, expecting the
+  // same resulting state
+  std::shared_ptr<SwitchState> applyIncrementally(
+      cfg::SwitchConfig& newConfig) {
+    auto full = publishAndApplyConfig(state_, &newConfig, platform_.get());
+    auto incremental = publishAndApplyConfig(
+        state_, &newConfig, platform_.get(), nullptr, nullptr, &config_);
+    EXPECT_EQ(full == nullptr, incremental == nullptr);
+    if (full && incremental) {
+      EXPECT_TRUE(full->toThrift() == incremental->toThrift());
+    }
+    return incremental;
+  }
+
+  std::unique_ptr<MockPlatform> platform_;
+  cfg::SwitchConfig config_;
+  std::shared_ptr<SwitchState> state_;
+};
+
+} // namespace
+
+TEST_F(IncrementalConfigTest, unchangedConfig) {
+  auto config = config_;
+  EXPECT_EQ(nullptr, applyIncrementally(config));
+}
+
+TEST_F(IncrementalConfigTest, aclChangeKeepsOtherSections) {
+  auto config = config_;
+  config.acls()->push_back(makeAcl("acl1", "10.0.1.0/24"));
+  auto newState = applyIncrementally(config);
+  ASSERT_NE(nullptr, newState);
+  EXPECT_NE(nullptr, newState->getAcl("acl0"));
+  EXPECT_NE(nullptr, newState->getAcl("acl1"));
+
+  // sections not built from the acls are reused as is
+  EXPECT_EQ(state_->getPorts(), newState->getPorts());
+  EXPECT_EQ(state_->getSystemPorts(), newState->getSystemPorts());
+  EXPECT_EQ(state_->getDsfNodes(), newState->getDsfNodes());
+  EXPECT_EQ(state_->getQosPolicies(), newState->getQosPolicies());
+  EXPECT_EQ(state_->getMirrors(), newState->getMirrors());
+}
+
+TEST_F(IncrementalConfigTest, portChangeReappliesDependentSections) {
+  auto config = config_;
+  config.ports()[0].description() = "incremental";
+  auto newState = applyIncrementally(config);
+  ASSERT_NE(nullptr, newState);
+  EXPECT_EQ(
+      "incremental",
+      newState->getPorts()
+          ->getNodeIf(PortID(*config.ports()[0].logicalID()))
+          ->getDescription());
+}
+
+TEST_F(IncrementalConfigTest, aclRemoval) {
+  auto config = config_;
+  config.acls()->clear();
+  auto newState = applyIncrementally(config);
+  ASSERT_NE(nullptr, newState);
+  EXPECT_EQ(nullptr, newState->getAcl("acl0"));
+  EXPECT_EQ(state_->getPorts(), newState->getPorts());
+}
+
+TEST_F(IncrementalConfigTest, defaultQosPolicyChange) {
+  // the default data plane policy is kept out of the qos policy map
+  config_.qosPolicies()->push_back(makeQosPolicy("qp0", 10));
+  config_.qosPolicies()->push_back(makeQosPolicy("qp1", 20));
+  cfg::TrafficPolicyConfig trafficPolicy;
+  trafficPolicy.defaultQosPolicy() = "qp0";
+  config_.dataPlaneTrafficPolicy() = trafficPolicy;
+  state_ = publishAndApplyConfig(state_, &config_, platform_.get());
+  ASSERT_NE(nullptr, state_);
+  EXPECT_EQ(nullptr, state_->getQosPolicies()->getNodeIf("qp0"));
+
+  auto config = config_;
+  config.dataPlaneTrafficPolicy()->defaultQosPolicy() = "qp1";
+  auto newState = applyIncrementally(config);
+  ASSERT_NE(nullptr, newState);
+  EXPECT_NE(nullptr, newState->getQosPolicies()->getNodeIf("qp0"));
+  EXPECT_EQ(nullptr, newState->getQosPolicies()->getNodeIf("qp1"));
+}
+
+TEST_F(IncrementalConfigTest, lacpChange) {
+  config_.aggregatePorts()->resize(1);
+  config_.aggregatePorts()[0].key() = 1;
+  config_.aggregatePorts()[0].name() = "port-channel";
+  config_.aggregatePorts()[0].description() = "single bundle";
+  config_.aggregatePorts()[0].memberPorts()->resize(1);
+  config_.aggregatePorts()[0].memberPorts()[0].memberPortID() =
+      *config_.ports()[0].logicalID();
+  state_ = publishAndApplyConfig(state_, &config_, platform_.get());
+  ASSERT_NE(nullptr, state_);
+
+  auto config = config_;
+  cfg::Lacp lacp;
+  lacp.systemID() = "02:00:00:00:00:01";
+  lacp.systemPriority() = 1000;
+  config.lacp() = lacp;
+  auto newState = applyIncrementally(config);
+  ASSERT_NE(nullptr, newState);
+  auto aggPort = newState->getAggregatePorts()->getNodeIf(AggregatePortID(1));
+  ASSERT_NE(nullptr, aggPort);
+  EXPECT_EQ(folly::MacAddress("02:00:00:00:00:01"), aggPort->getSystemID());
+  EXPECT_EQ(1000, aggPort->getSystemPriority());
+}
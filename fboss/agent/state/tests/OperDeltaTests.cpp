@@ -22,6 +22,7 @@
 
 #include <boost/container/flat_map.hpp>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace facebook::fboss;
 using boost::container::flat_map;
@@ -62,6 +63,43 @@ TEST(OperDeltaTests, OperDeltaCompute) {
   EXPECT_EQ(delta2.getOperDelta().changes()->size(), 1);
 }
 
+TEST(OperDeltaTests, OperDeltaParallelCompute) {
+  auto platform = createMockPlatform();
+  auto emptyConfig = cfg::SwitchConfig();
+  auto stateV0 = publishAndApplyConfig(
+      make_shared<SwitchState>(), &emptyConfig, platform.get());
+  addSwitchInfo(stateV0);
+  auto config = testConfigA();
+  auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+
+  auto threads = FLAGS_state_delta_threads;
+  FLAGS_state_delta_threads = 1;
+  auto serialDelta = StateDelta(stateV0, stateV1);
+  auto serial = serialDelta.getOperDelta();
+  FLAGS_state_delta_threads = 4;
+  auto parallelDelta = StateDelta(stateV0, stateV1);
+  std::vector<std::thread> consumers;
+  std::vector<const fsdb::OperDelta*> computed(4);
+  for (size_t i = 0; i < computed.size(); ++i) {
+    consumers.emplace_back(
+        [&, i]() { computed[i] = &parallelDelta.getOperDelta(); });
+  }
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+  FLAGS_state_delta_threads = threads;
+
+  // Computed once and shared by all consumers
+  for (auto operDelta : computed) {
+    EXPECT_EQ(operDelta, computed.front());
+  }
+  EXPECT_EQ(*computed.front(), serial);
+  EXPECT_EQ(
+      StateDelta(stateV0, *computed.front()).newState()->toThrift(),
+      stateV1->toThrift());
+}
+
 TEST(OperDeltaTests, OperDeltaProcess) {
   auto platform = createMockPlatform();
   auto stateV0 = make_shared<SwitchState>();
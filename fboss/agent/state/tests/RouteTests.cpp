@@ -291,6 +291,44 @@ TEST(Route, serializeRouteOverrideEcmpMode) {
   rt.setResolved(nhopEntry);
   validateThriftStructNodeSerialization(rt);
 }
+
+// Routes resolving to the same forwarding info share a single entry
+TEST(Route, internedForwardInfo) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_intern_route_nexthops = true;
+  ClientID clientId = ClientID(1);
+  auto nxtHops = makeNextHops({"10.10.10.10", "11.11.11.11"});
+  auto otherNxtHops = makeNextHops({"10.10.10.10"});
+  auto numInterned = RouteNextHopEntry::numInterned();
+  {
+    Route<IPAddressV4> rt1(Route<IPAddressV4>::makeThrift(
+        makePrefixV4("1.2.3.4/32"),
+        clientId,
+        RouteNextHopEntry(nxtHops, DISTANCE)));
+    Route<IPAddressV4> rt2(Route<IPAddressV4>::makeThrift(
+        makePrefixV4("1.2.3.5/32"),
+        clientId,
+        RouteNextHopEntry(nxtHops, DISTANCE)));
+    Route<IPAddressV4> rt3(Route<IPAddressV4>::makeThrift(
+        makePrefixV4("1.2.3.6/32"),
+        clientId,
+        RouteNextHopEntry(otherNxtHops, DISTANCE)));
+    rt1.setResolved(RouteNextHopEntry(nxtHops, DISTANCE));
+    rt2.setResolved(RouteNextHopEntry(nxtHops, DISTANCE));
+    rt3.setResolved(RouteNextHopEntry(otherNxtHops, DISTANCE));
+    EXPECT_EQ(&rt1.getForwardInfo(), &rt2.getForwardInfo());
+    EXPECT_NE(&rt1.getForwardInfo(), &rt3.getForwardInfo());
+    EXPECT_EQ(rt1.getForwardInfo().getNextHopSet(), nxtHops);
+    EXPECT_EQ(RouteNextHopEntry::numInterned(), numInterned + 2);
+
+    // Modifying a route must not affect the routes it shares an entry with
+    rt1.setResolved(RouteNextHopEntry(otherNxtHops, DISTANCE));
+    EXPECT_EQ(&rt1.getForwardInfo(), &rt3.getForwardInfo());
+    EXPECT_EQ(rt2.getForwardInfo().getNextHopSet(), nxtHops);
+    validateThriftStructNodeSerialization(rt2);
+  }
+  EXPECT_EQ(RouteNextHopEntry::numInterned(), numInterned);
+}
 // Test utility functions for converting RouteNextHopSet to thrift and back
 TEST(RouteTypes, toFromRouteNextHops) {
   RouteNextHopSet nhs;
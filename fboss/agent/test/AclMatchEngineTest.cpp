@@ -0,0 +1,265 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AclMatchEngine.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Conv.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace facebook::fboss;
+
+namespace {
+
+std::shared_ptr<AclEntry> makeAcl(int priority, const std::string& name) {
+  auto acl = std::make_shared<AclEntry>(priority, name);
+  acl->setActionType(cfg::AclActionType::DENY);
+  return acl;
+}
+
+AclPacketHeaders v6Packet(const std::string& srcIp, const std::string& dstIp) {
+  AclPacketHeaders headers;
+  headers.etherType = static_cast<uint16_t>(cfg::EtherType::IPv6);
+  headers.srcIp = folly::IPAddress(srcIp);
+  headers.dstIp = folly::IPAddress(dstIp);
+  headers.proto = 6;
+  headers.ttl = 64;
+  headers.l4SrcPort = 1000;
+  headers.l4DstPort = 179;
+  headers.tcpFlags = 0x02;
+  headers.srcPort = PortID(1);
+  return headers;
+}
+
+std::string matchName(const std::shared_ptr<AclEntry>& acl) {
+  return acl ? acl->getID() : "";
+}
+
+// the entry with the highest priority matching, entry by entry
+std::shared_ptr<AclEntry> linearMatch(
+    const std::vector<std::shared_ptr<AclEntry>>& acls,
+    const AclPacketHeaders& headers) {
+  std::shared_ptr<AclEntry> best;
+  for (const auto& acl : acls) {
+    if ((!best || acl->getPriority() < best->getPriority()) &&
+        AclClassifier::matches(*acl, headers)) {
+      best = acl;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+TEST(AclClassifierTest, highestPriorityMatchWins) {
+  AclClassifier classifier;
+  auto wide = makeAcl(20, "wide");
+  wide->setDstIp(folly::IPAddress::createNetwork("2401:db00::/32"));
+  auto narrow = makeAcl(10, "narrow");
+  narrow->setDstIp(folly::IPAddress::createNetwork("2401:db00:1::/48"));
+  narrow->setL4DstPort(179);
+  auto lowest = makeAcl(30, "lowest");
+  classifier.addEntry(wide);
+  classifier.addEntry(narrow);
+  classifier.addEntry(lowest);
+  EXPECT_EQ(3, classifier.numEntries());
+  EXPECT_EQ(3, classifier.numTuples());
+
+  EXPECT_EQ(
+      "narrow", matchName(classifier.match(v6Packet("::1", "2401:db00:1::1"))));
+  EXPECT_EQ(
+      "wide", matchName(classifier.match(v6Packet("::1", "2401:db00:2::1"))));
+  EXPECT_EQ("lowest", matchName(classifier.match(v6Packet("::1", "fc00::1"))));
+
+  // an entry moving to another priority
+  classifier.addEntry(makeAcl(5, "lowest"));
+  EXPECT_EQ(3, classifier.numEntries());
+  EXPECT_EQ(
+      "lowest",
+      matchName(classifier.match(v6Packet("::1", "2401:db00:1::1"))));
+}
+
+TEST(AclClassifierTest, removeEntry) {
+  AclClassifier classifier;
+  auto first = makeAcl(10, "first");
+  first->setL4DstPort(179);
+  auto second = makeAcl(20, "second");
+  second->setL4DstPort(179);
+  classifier.addEntry(first);
+  classifier.addEntry(second);
+  EXPECT_EQ(1, classifier.numTuples());
+
+  auto packet = v6Packet("::1", "::2");
+  EXPECT_EQ("first", matchName(classifier.match(packet)));
+  classifier.removeEntry("first");
+  EXPECT_EQ("second", matchName(classifier.match(packet)));
+  classifier.removeEntry("second");
+  EXPECT_EQ(nullptr, classifier.match(packet));
+  EXPECT_EQ(0, classifier.numEntries());
+  EXPECT_EQ(0, classifier.numTuples());
+  // removing an unknown entry is a noop
+  classifier.removeEntry("second");
+}
+
+TEST(AclClassifierTest, ipTypeAndFragments) {
+  AclClassifier classifier;
+  auto ip = makeAcl(10, "ip");
+  ip->setIpType(cfg::IpType::IP);
+  ip->setIpFrag(cfg::IpFragMatch::MATCH_NOT_FIRST_FRAGMENT);
+  auto arp = makeAcl(20, "arp");
+  arp->setIpType(cfg::IpType::ARP_REQUEST);
+  auto nonIp = makeAcl(30, "nonIp");
+  nonIp->setIpType(cfg::IpType::NON_IP);
+  classifier.addEntry(ip);
+  classifier.addEntry(arp);
+  classifier.addEntry(nonIp);
+
+  auto v4 = v6Packet("::1", "::2");
+  v4.srcIp = folly::IPAddress("10.0.0.1");
+  v4.dstIp = folly::IPAddress("10.0.0.2");
+  v4.fragment = AclPacketHeaders::Fragment::NON_FIRST_FRAGMENT;
+  EXPECT_EQ("ip", matchName(classifier.match(v4)));
+  auto v6 = v6Packet("::1", "::2");
+  v6.fragment = AclPacketHeaders::Fragment::NON_FIRST_FRAGMENT;
+  EXPECT_EQ("ip", matchName(classifier.match(v6)));
+  v6.fragment = AclPacketHeaders::Fragment::FIRST_FRAGMENT;
+  EXPECT_EQ(nullptr, classifier.match(v6));
+
+  AclPacketHeaders arpRequest;
+  arpRequest.etherType = static_cast<uint16_t>(cfg::EtherType::ARP);
+  arpRequest.arpOp = AclPacketHeaders::ArpOp::REQUEST;
+  EXPECT_EQ("arp", matchName(classifier.match(arpRequest)));
+  auto arpReply = arpRequest;
+  arpReply.arpOp = AclPacketHeaders::ArpOp::REPLY;
+  EXPECT_EQ("nonIp", matchName(classifier.match(arpReply)));
+}
+
+TEST(AclClassifierTest, unsupportedEntriesNeverMatch) {
+  AclClassifier classifier;
+  auto disabled = makeAcl(10, "disabled");
+  disabled->setEnabled(false);
+  auto roce = makeAcl(20, "roce");
+  roce->setRoceOpcode(17);
+  classifier.addEntry(disabled);
+  classifier.addEntry(roce);
+  EXPECT_EQ(2, classifier.numUnsupportedEntries());
+  EXPECT_EQ(nullptr, classifier.match(v6Packet("::1", "::2")));
+  classifier.removeEntry("roce");
+  EXPECT_EQ(1, classifier.numUnsupportedEntries());
+}
+
+TEST(AclClassifierTest, matchesLinearWalk) {
+  std::mt19937 gen(0x5eed);
+  auto pick = [&gen](int n) {
+    return std::uniform_int_distribution<int>(0, n - 1)(gen);
+  };
+
+  std::vector<std::shared_ptr<AclEntry>> acls;
+  AclClassifier classifier;
+  for (int i = 0; i < 500; ++i) {
+    auto acl = makeAcl(pick(1000), folly::to<std::string>("acl", i));
+    if (pick(2)) {
+      acl->setDstIp(folly::IPAddress::createNetwork(folly::to<std::string>(
+          "10.", pick(4), ".", pick(4), ".0/", 16 + pick(9))));
+    }
+    if (pick(3) == 0) {
+      acl->setSrcIp(folly::IPAddress::createNetwork(
+          folly::to<std::string>("2401:db00:", pick(4), "::/", 32 + pick(17))));
+    }
+    if (pick(3) == 0) {
+      acl->setProto(pick(2) ? 6 : 17);
+    }
+    if (pick(3) == 0) {
+      acl->setL4DstPort(pick(4));
+    }
+    if (pick(4) == 0) {
+      acl->setTtl(AclTtl(pick(2) ? 1 : 128, pick(2) ? 0xFF : 0x80));
+    }
+    if (pick(4) == 0) {
+      acl->setIpType(
+          std::vector<cfg::IpType>{
+              cfg::IpType::IP, cfg::IpType::IP4, cfg::IpType::IP6}[pick(3)]);
+    }
+    if (pick(5) == 0) {
+      acl->setSrcPort(pick(3));
+    }
+    if (pick(6) == 0) {
+      acl->setLookupClassNeighbor(
+          cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0);
+    }
+    acls.push_back(acl);
+    classifier.addEntry(acl);
+  }
+  // and remove a few
+  for (int i = 0; i < 50; ++i) {
+    auto index = pick(acls.size());
+    classifier.removeEntry(acls[index]->getID());
+    acls.erase(acls.begin() + index);
+  }
+  EXPECT_EQ(acls.size(), classifier.numEntries());
+
+  for (int i = 0; i < 5000; ++i) {
+    AclPacketHeaders headers;
+    if (pick(2)) {
+      headers.etherType = static_cast<uint16_t>(cfg::EtherType::IPv4);
+      headers.srcIp = folly::IPAddress(
+          folly::to<std::string>("10.", pick(4), ".", pick(4), ".1"));
+      headers.dstIp = folly::IPAddress(
+          folly::to<std::string>("10.", pick(4), ".", pick(4), ".1"));
+    } else {
+      headers.etherType = static_cast<uint16_t>(cfg::EtherType::IPv6);
+      headers.srcIp = folly::IPAddress(
+          folly::to<std::string>("2401:db00:", pick(4), "::1"));
+      headers.dstIp = folly::IPAddress("2401:db00::2");
+    }
+    headers.proto = pick(2) ? 6 : 17;
+    headers.ttl = pick(256);
+    headers.l4SrcPort = pick(4);
+    headers.l4DstPort = pick(4);
+    headers.srcPort = PortID(pick(3));
+    if (pick(2)) {
+      headers.lookupClassNeighbor =
+          cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0;
+    }
+    auto expected = linearMatch(acls, headers);
+    auto matched = classifier.match(headers);
+    ASSERT_EQ(matchName(expected), matchName(matched)) << "packet " << i;
+  }
+}
+
+TEST(AclMatchEngineTest, followsAppliedState) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_acl_match_engine = true;
+  auto config = testConfigA();
+  cfg::AclEntry acl;
+  acl.name() = "bgp";
+  acl.actionType() = cfg::AclActionType::DENY;
+  acl.l4DstPort() = 179;
+  config.acls()->push_back(acl);
+  auto handle = createTestHandle(&config);
+  auto sw = handle->getSw();
+  ASSERT_NE(nullptr, sw->getAclMatchEngine());
+  waitForStateUpdates(sw);
+
+  auto packet = v6Packet("::1", "::2");
+  EXPECT_EQ(1, sw->getAclMatchEngine()->numEntries());
+  EXPECT_EQ("bgp", matchName(sw->getAclMatchEngine()->match(packet)));
+
+  config.acls()->clear();
+  sw->applyConfig("remove acls", config);
+  waitForStateUpdates(sw);
+  EXPECT_EQ(0, sw->getAclMatchEngine()->numEntries());
+  EXPECT_EQ(nullptr, sw->getAclMatchEngine()->match(packet));
+}
@@ -134,6 +134,11 @@ class AgentEnsemble : public TestEnsembleIf {
     getSw()->packetReceived(std::move(pkt));
   }
 
+  void packetsReceived(
+      std::vector<std::unique_ptr<RxPacket>> pkts) noexcept override {
+    getSw()->packetsReceived(std::move(pkts));
+  }
+
   void linkStateChanged(
       PortID port,
       bool up,
@@ -18,12 +18,29 @@
 #include "fboss/agent/hw/sim/SimSwitch.h"
 #include "fboss/agent/single/MonolithicHwSwitchHandler.h"
 #include "fboss/agent/state/ArpResponseTable.h"
+#include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/StateUtils.h"
+#include "fboss/agent/state/SwitchSettings.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/state/VlanMap.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <sys/resource.h>
+
+#include <limits>
+#include <thread>
+
+DEFINE_uint32(
+    arp_benchmark_neighbors,
+    100000,
+    "Number of neighbors of the steady state ARP benchmark");
+DEFINE_uint32(
+    arp_benchmark_steady_state_secs,
+    10,
+    "Duration over which the steady state ARP benchmark measures CPU usage");
+
 using namespace facebook::fboss;
 using folly::IPAddress;
 using folly::IPAddressV4;
@@ -149,6 +166,95 @@ void init() {
   arpRequest_10_0_0_5->setSrcVlan(VlanID(1));
 }
 
+std::chrono::microseconds cpuTime() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  auto toUsecs = [](const timeval& tv) {
+    return std::chrono::seconds(tv.tv_sec) +
+        std::chrono::microseconds(tv.tv_usec);
+  };
+  return toUsecs(usage.ru_utime) + toUsecs(usage.ru_stime);
+}
+
+void setNeighborProbing(
+    shared_ptr<SwitchState>* state,
+    std::optional<int32_t> maxProbes,
+    std::optional<std::chrono::seconds> staleEntryInterval) {
+  auto matcher = HwSwitchMatcher(std::unordered_set<SwitchID>({SwitchID(0)}));
+  auto oldSettings = utility::getFirstNodeIf((*state)->getSwitchSettings());
+  auto switchSettings =
+      oldSettings ? oldSettings->clone() : make_shared<SwitchSettings>();
+  switchSettings->setMaxNeighborProbes(maxProbes);
+  switchSettings->setStaleEntryInterval(staleEntryInterval);
+  auto multiSwitchSettings = make_shared<MultiSwitchSettings>();
+  multiSwitchSettings->addNode(matcher.matcherString(), switchSettings);
+  (*state)->resetSwitchSettings(multiSwitchSettings);
+}
+
+/*
+ * Add VLAN 2 with an ARP table of numNeighbors entries, from which the
+ * neighbor cache of the VLAN is populated. Entries are repopulated as STALE
+ * and never run out of probes, so every entry keeps expiring and probing its
+ * neighbor once a second.
+ */
+void addNeighborVlan(uint32_t numNeighbors) {
+  auto matcher = HwSwitchMatcher(std::unordered_set<SwitchID>({SwitchID(0)}));
+  sw->updateStateBlocking(
+      "add neighbor vlan",
+      [numNeighbors, &matcher](const shared_ptr<SwitchState>& oldState) {
+        auto state = oldState->clone();
+        // probing starts up to 1.1 stale intervals after the entries are
+        // repopulated, keep that well within the warm up
+        setNeighborProbing(
+            &state,
+            std::numeric_limits<int32_t>::max(),
+            std::chrono::seconds(1));
+
+        auto intf2 = make_shared<Interface>(
+            InterfaceID(2),
+            RouterID(0),
+            std::optional<VlanID>(2),
+            folly::StringPiece("interface2"),
+            MacAddress("02:00:01:00:00:02"),
+            9000,
+            false, /* is virtual */
+            false /* is state_sync disabled*/);
+        Interface::Addresses addrs2;
+        addrs2.emplace(IPAddress("172.16.0.1"), 14);
+        intf2->setAddresses(addrs2);
+        state->getInterfaces()->modify(&state)->addNode(intf2, matcher);
+
+        auto arpTable = make_shared<ArpTable>();
+        auto firstIP = IPAddressV4("172.16.1.0").toLongHBO();
+        for (uint32_t i = 0; i < numNeighbors; ++i) {
+          arpTable->addEntry(
+              IPAddressV4::fromLongHBO(firstIP + i),
+              MacAddress::fromHBO(0x020000100000 + i),
+              PortDescriptor(PortID(1 + i % 9)),
+              InterfaceID(2));
+        }
+        auto vlan2 = make_shared<Vlan>(VlanID(2), std::string("Vlan2"));
+        vlan2->setInterfaceID(InterfaceID(2));
+        for (int idx = 1; idx < 10; ++idx) {
+          vlan2->addPort(PortID(idx), true);
+        }
+        vlan2->setArpTable(arpTable);
+        state->getVlans()->modify(&state)->addNode(vlan2, matcher);
+        return state;
+      });
+}
+
+void removeNeighborVlan() {
+  sw->updateStateBlocking(
+      "remove neighbor vlan", [](const shared_ptr<SwitchState>& oldState) {
+        auto state = oldState->clone();
+        state->getVlans()->modify(&state)->removeNode(VlanID(2));
+        state->getInterfaces()->modify(&state)->removeNode(InterfaceID(2));
+        setNeighborProbing(&state, std::nullopt, std::nullopt);
+        return state;
+      });
+}
+
 } // unnamed namespace
 
 BENCHMARK(ArpRequest, numIters) {
@@ -193,6 +299,37 @@ BENCHMARK(ArpRequestNotMine, numIters) {
   }
 }
 
+/*
+ * CPU used per second by a switch with FLAGS_arp_benchmark_neighbors
+ * neighbors, all of whose entries expire and probe once a second, i.e. the
+ * cost of the neighbor cache timers and the probes they send.
+ */
+BENCHMARK_COUNTERS(ArpSteadyStateNeighbors, counters) {
+  folly::BenchmarkSuspender suspender;
+  SimSwitch* sim =
+      boost::polymorphic_downcast<SimSwitch*>(simPlatform->getHwSwitch());
+  addNeighborVlan(FLAGS_arp_benchmark_neighbors);
+  // let the initial probes of the repopulated entries go out
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+  sim->resetTxCount();
+  auto cpuStart = cpuTime();
+  auto start = std::chrono::steady_clock::now();
+  suspender.dismiss();
+
+  std::this_thread::sleep_for(
+      std::chrono::seconds(FLAGS_arp_benchmark_steady_state_secs));
+
+  suspender.rehire();
+  auto cpuUsecs = (cpuTime() - cpuStart).count();
+  auto elapsedUsecs = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+  counters["cpu_ms_per_sec"] = cpuUsecs * 1000 / elapsedUsecs;
+  counters["arp_probes_per_sec"] =
+      sim->getTxCount() * 1000000 / elapsedUsecs;
+  removeNeighborVlan();
+}
+
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
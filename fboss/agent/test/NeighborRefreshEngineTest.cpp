@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NeighborRefreshEngine.h"
+#include "fboss/agent/FbossEventBase.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/Conv.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace facebook::fboss;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+struct PostedUpdate {
+  std::string name;
+  NeighborRefreshEngine::StateUpdateFn fn;
+  bool allowCoalescing;
+};
+
+const InterfaceID kIntf1(1);
+const InterfaceID kIntf2(2);
+
+class NeighborRefreshEngineTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    NeighborRefreshEngine::Config config;
+    config.interval = milliseconds(20);
+    // 2 probes per interface per tick
+    config.maxProbesPerSec = 100;
+    engine = std::make_unique<NeighborRefreshEngine>(
+        &evb,
+        config,
+        [this](
+            const std::string& name,
+            NeighborRefreshEngine::StateUpdateFn fn,
+            bool allowCoalescing) {
+          posted.push_back({name, std::move(fn), allowCoalescing});
+        },
+        [this]() { return &stats; });
+  }
+
+  // runs the event base until done() holds, or for 5s at most
+  template <typename Pred>
+  void loopUntil(Pred done) {
+    auto deadline = steady_clock::now() + std::chrono::seconds(5);
+    while (!done() && steady_clock::now() < deadline) {
+      evb.loopOnce();
+    }
+  }
+
+  NeighborRefreshEngine::ProbeFn probe(std::string id) {
+    return [this, id = std::move(id)]() { sent.push_back(id); };
+  }
+
+  // records that it ran, and changes the state unless noop
+  NeighborRefreshEngine::StateUpdateFn update(int id, bool noop = false) {
+    return [this, id, noop](const std::shared_ptr<SwitchState>& /*state*/)
+               -> std::shared_ptr<SwitchState> {
+      applied.push_back(id);
+      return noop ? nullptr : std::make_shared<SwitchState>();
+    };
+  }
+
+  FbossEventBase evb{"NeighborRefreshEngineTest"};
+  SwitchStats stats{1};
+  std::unique_ptr<NeighborRefreshEngine> engine;
+  std::vector<std::string> sent;
+  std::vector<int> applied;
+  std::vector<PostedUpdate> posted;
+  const int owner{0};
+};
+
+} // namespace
+
+TEST_F(NeighborRefreshEngineTest, probesPacedPerInterface) {
+  auto ip = [](int i) {
+    return folly::IPAddress(folly::to<std::string>("10.0.0.", i));
+  };
+  engine->enqueueProbe(&owner, kIntf1, ip(1), probe("a1"));
+  engine->enqueueProbe(&owner, kIntf1, ip(2), probe("a2"));
+  engine->enqueueProbe(&owner, kIntf1, ip(3), probe("a3"));
+  // replaces the queued probe, keeping its place
+  engine->enqueueProbe(&owner, kIntf1, ip(1), probe("a1'"));
+  engine->enqueueProbe(&owner, kIntf2, ip(1), probe("b1"));
+  EXPECT_EQ(engine->probesQueued(kIntf1), 3);
+  EXPECT_EQ(engine->probesQueued(kIntf2), 1);
+  EXPECT_TRUE(sent.empty());
+
+  // first tick
+  loopUntil([this]() { return !sent.empty(); });
+  EXPECT_EQ(sent.size(), 3);
+  EXPECT_EQ(engine->probesQueued(kIntf1), 1);
+  EXPECT_EQ(engine->probesQueued(kIntf2), 0);
+
+  loopUntil([this]() { return sent.size() == 4; });
+  std::sort(sent.begin(), sent.begin() + 3);
+  EXPECT_EQ(sent, std::vector<std::string>({"a1'", "a2", "b1", "a3"}));
+}
+
+TEST_F(NeighborRefreshEngineTest, updatesCoalescedPerTick) {
+  engine->enqueueUpdate(&owner, update(1));
+  engine->enqueueUpdate(&owner, update(2, true /* noop */));
+  engine->enqueueUpdate(&owner, update(3));
+  EXPECT_EQ(engine->updatesQueued(), 3);
+  loopUntil([this]() { return !posted.empty(); });
+  ASSERT_EQ(posted.size(), 1);
+  EXPECT_TRUE(posted[0].allowCoalescing);
+  EXPECT_EQ(engine->updatesQueued(), 0);
+
+  auto state = std::make_shared<SwitchState>();
+  auto newState = posted[0].fn(state);
+  EXPECT_NE(newState, nullptr);
+  EXPECT_NE(newState, state);
+  EXPECT_EQ(applied, std::vector<int>({1, 2, 3}));
+
+  // nothing changed
+  posted.clear();
+  applied.clear();
+  engine->enqueueUpdate(&owner, update(4, true /* noop */));
+  loopUntil([this]() { return !posted.empty(); });
+  ASSERT_EQ(posted.size(), 1);
+  EXPECT_EQ(posted[0].fn(state), nullptr);
+}
+
+TEST_F(NeighborRefreshEngineTest, nonCoalescingUpdateEndsBatch) {
+  engine->enqueueUpdate(&owner, update(1));
+  engine->enqueueUpdate(&owner, update(2), false /* allowCoalescing */);
+  engine->enqueueUpdate(&owner, update(3));
+  // posts right away
+  engine->flushUpdates();
+  ASSERT_EQ(posted.size(), 2);
+  EXPECT_FALSE(posted[0].allowCoalescing);
+  EXPECT_TRUE(posted[1].allowCoalescing);
+
+  auto state = std::make_shared<SwitchState>();
+  posted[0].fn(state);
+  EXPECT_EQ(applied, std::vector<int>({1, 2}));
+  posted[1].fn(state);
+  EXPECT_EQ(applied, std::vector<int>({1, 2, 3}));
+}
+
+TEST_F(NeighborRefreshEngineTest, cancelDropsOwnerQueue) {
+  const int otherOwner{0};
+  engine->enqueueProbe(
+      &owner, kIntf1, folly::IPAddress("10.0.0.1"), probe("a"));
+  engine->enqueueProbe(
+      &otherOwner, kIntf1, folly::IPAddress("10.0.0.2"), probe("b"));
+  engine->enqueueUpdate(&owner, update(1));
+  engine->enqueueUpdate(&otherOwner, update(2));
+  engine->cancel(&owner);
+  EXPECT_EQ(engine->probesQueued(kIntf1), 1);
+  EXPECT_EQ(engine->updatesQueued(), 1);
+
+  loopUntil([this]() { return !posted.empty(); });
+  EXPECT_EQ(sent, std::vector<std::string>({"b"}));
+  ASSERT_EQ(posted.size(), 1);
+  posted[0].fn(std::make_shared<SwitchState>());
+  EXPECT_EQ(applied, std::vector<int>({2}));
+}
@@ -9,6 +9,10 @@
  */
 #include <folly/Benchmark.h>
 #include <folly/Random.h>
+#include <unistd.h>
+#include <fstream>
+#include <thread>
+#include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteNextHopEntry.h"
 
 using namespace facebook::fboss;
@@ -23,8 +27,147 @@ static constexpr int kRSWNumPaths = 8;
 static constexpr int kFSWNumPaths = 36;
 static constexpr int kRSWNumRoutes = 10000;
 static constexpr int kFSWNumRoutes = 30000;
+static constexpr int kNumEcmpGroups = 16;
+
+int64_t residentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  int64_t size{0}, resident{0};
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+RouteNextHopEntry::NextHopSet makeEcmpGroup(int groupIndex, int numPaths) {
+  RouteNextHopEntry::NextHopSet nhops;
+  for (auto pathIndex = 0; pathIndex < numPaths; ++pathIndex) {
+    nhops.emplace(ResolvedNextHop(
+        folly::IPAddressV6::fromHighLow(
+            0x2401db0000000000ULL | (uint64_t(groupIndex) << 16), pathIndex),
+        InterfaceID(pathIndex + 1),
+        ECMP_WEIGHT));
+  }
+  return nhops;
+}
 } // namespace
 
+/*
+ * Resolved routes spread over a small number of ECMP groups, as seen on
+ * RSWs/FSWs. Reports resident bytes per route with the resolved forwarding
+ * info interned (shared between routes) or copied into every route.
+ */
+void RouteResolvedScaleMemory(
+    folly::UserCounters& counters,
+    bool intern,
+    int numPaths,
+    int numRoutes) {
+  folly::BenchmarkSuspender suspender;
+  auto internFlag = FLAGS_intern_route_nexthops;
+  FLAGS_intern_route_nexthops = intern;
+  std::vector<RouteNextHopEntry> entries;
+  for (auto group = 0; group < kNumEcmpGroups; ++group) {
+    entries.emplace_back(
+        makeEcmpGroup(group, numPaths), kDefaultAdminDistance);
+  }
+  std::vector<std::shared_ptr<RouteV6>> routes;
+  routes.reserve(numRoutes);
+  auto before = residentBytes();
+  suspender.dismiss();
+
+  for (auto routeIndex = 0; routeIndex < numRoutes; ++routeIndex) {
+    auto route = std::make_shared<RouteV6>(RoutePrefixV6{
+        folly::IPAddressV6::fromHighLow(
+            0x2401db0100000000ULL | (uint64_t(routeIndex) << 16), 0),
+        64});
+    route->setResolved(entries[routeIndex % kNumEcmpGroups]);
+    route->publish();
+    routes.push_back(std::move(route));
+  }
+
+  suspender.rehire();
+  counters["bytes_per_route"] = (residentBytes() - before) / numRoutes;
+  routes.clear();
+  FLAGS_intern_route_nexthops = internFlag;
+}
+
+BENCHMARK_COUNTERS(RouteResolvedScaleMemoryRSWInterned, counters) {
+  RouteResolvedScaleMemory(counters, true, kRSWNumPaths, kRSWNumRoutes);
+}
+BENCHMARK_COUNTERS(RouteResolvedScaleMemoryRSWCopied, counters) {
+  RouteResolvedScaleMemory(counters, false, kRSWNumPaths, kRSWNumRoutes);
+}
+BENCHMARK_COUNTERS(RouteResolvedScaleMemoryFSWInterned, counters) {
+  RouteResolvedScaleMemory(counters, true, kFSWNumPaths, kFSWNumRoutes);
+}
+BENCHMARK_COUNTERS(RouteResolvedScaleMemoryFSWCopied, counters) {
+  RouteResolvedScaleMemory(counters, false, kFSWNumPaths, kFSWNumRoutes);
+}
+
+/*
+ * Routes resolved concurrently by numShards threads, as the sharded RIB
+ * does, each thread resolving its own routes. With interning on, all
+ * threads go through the one global intern table.
+ */
+void RouteResolvedShardedUpdate(
+    folly::UserCounters& counters,
+    bool intern,
+    int numShards) {
+  folly::BenchmarkSuspender suspender;
+  auto internFlag = FLAGS_intern_route_nexthops;
+  FLAGS_intern_route_nexthops = intern;
+  std::vector<RouteNextHopEntry> entries;
+  for (auto group = 0; group < kNumEcmpGroups; ++group) {
+    entries.emplace_back(
+        makeEcmpGroup(group, kRSWNumPaths), kDefaultAdminDistance);
+  }
+  std::vector<std::vector<std::shared_ptr<RouteV6>>> shardRoutes(numShards);
+  for (auto shard = 0; shard < numShards; ++shard) {
+    for (auto routeIndex = 0; routeIndex < kRSWNumRoutes; ++routeIndex) {
+      shardRoutes[shard].push_back(std::make_shared<RouteV6>(RoutePrefixV6{
+          folly::IPAddressV6::fromHighLow(
+              0x2401db0100000000ULL | (uint64_t(shard) << 32) |
+                  (uint64_t(routeIndex) << 16),
+              0),
+          64}));
+    }
+  }
+  suspender.dismiss();
+
+  std::vector<std::thread> threads;
+  for (auto shard = 0; shard < numShards; ++shard) {
+    threads.emplace_back([&entries, &routes = shardRoutes[shard]] {
+      for (size_t routeIndex = 0; routeIndex < routes.size(); ++routeIndex) {
+        routes[routeIndex]->setResolved(entries[routeIndex % kNumEcmpGroups]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  suspender.rehire();
+  counters["routes"] = numShards * kRSWNumRoutes;
+  shardRoutes.clear();
+  FLAGS_intern_route_nexthops = internFlag;
+}
+
+BENCHMARK_COUNTERS(RouteResolvedShardedUpdate1ShardInterned, counters) {
+  RouteResolvedShardedUpdate(counters, true, 1);
+}
+BENCHMARK_COUNTERS(RouteResolvedShardedUpdate1ShardCopied, counters) {
+  RouteResolvedShardedUpdate(counters, false, 1);
+}
+BENCHMARK_COUNTERS(RouteResolvedShardedUpdate4ShardsInterned, counters) {
+  RouteResolvedShardedUpdate(counters, true, 4);
+}
+BENCHMARK_COUNTERS(RouteResolvedShardedUpdate4ShardsCopied, counters) {
+  RouteResolvedShardedUpdate(counters, false, 4);
+}
+BENCHMARK_COUNTERS(RouteResolvedShardedUpdate8ShardsInterned, counters) {
+  RouteResolvedShardedUpdate(counters, true, 8);
+}
+BENCHMARK_COUNTERS(RouteResolvedShardedUpdate8ShardsCopied, counters) {
+  RouteResolvedShardedUpdate(counters, false, 8);
+}
+
 void RouteNextHopEntryScaleOptimized(
     bool optimized,
     int ecmpWidth,
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketClassifier.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <folly/MacAddress.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using folly::MacAddress;
+
+namespace {
+constexpr uint32_t kMinLength = 64;
+
+std::unique_ptr<RxPacket> makePacket(
+    folly::StringPiece hex,
+    uint32_t length = kMinLength) {
+  auto pkt = MockRxPacket::fromHex(hex);
+  pkt->padToLength(length);
+  return pkt;
+}
+
+std::vector<std::unique_ptr<RxPacket>> makeBurst() {
+  std::vector<std::unique_ptr<RxPacket>> pkts;
+  // 0: untagged ARP request
+  pkts.push_back(makePacket(
+      "ff ff ff ff ff ff  00 02 00 01 02 03  08 06"
+      "00 01  08 00  06  04  00 01"));
+  // 1: IPv6 neighbor solicitation, tagged with vlan 5
+  pkts.push_back(makePacket(
+      "33 33 ff 00 00 01  00 02 00 01 02 04  81 00 00 05  86 dd"
+      "60 00 00 00  00 20  3a  ff"
+      "fe 80 00 00 00 00 00 00  00 02 00 ff fe 01 02 04"
+      "ff 02 00 00 00 00 00 00  00 00 00 01 ff 00 00 01"
+      "87 00 00 00",
+      90));
+  // 2: IPv4 TCP
+  pkts.push_back(makePacket(
+      "00 02 00 00 00 01  00 02 00 01 02 05  08 00"
+      "45 00 00 28  00 00 40 00  40 06 00 00"
+      "0a 00 00 01  0a 00 00 02"));
+  // 3: LACPDU
+  pkts.push_back(makePacket(
+      "01 80 c2 00 00 02  00 02 00 01 02 06  88 09  01 01"));
+  // 4: LLDP, but shorter than the minimum frame length
+  pkts.push_back(makePacket(
+      "01 80 c2 00 00 0e  00 02 00 01 02 07  88 cc", 30));
+  // 5: IPv6 TCP
+  pkts.push_back(makePacket(
+      "00 02 00 00 00 01  00 02 00 01 02 08  86 dd"
+      "60 00 00 00  00 14  06  40"
+      "20 01 0d b8 00 00 00 00  00 00 00 00 00 00 00 01"
+      "20 01 0d b8 00 00 00 00  00 00 00 00 00 00 00 02",
+      80));
+  // 6: unknown ethertype
+  pkts.push_back(makePacket(
+      "00 02 00 00 00 01  00 02 00 01 02 09  12 34"));
+  // 7: second ARP, after the other packets
+  pkts.push_back(makePacket(
+      "ff ff ff ff ff ff  00 02 00 01 02 0a  08 06"
+      "00 01  08 00  06  04  00 02"));
+  return pkts;
+}
+} // namespace
+
+TEST(RxPacketClassifier, classify) {
+  auto pkts = makeBurst();
+  RxPacketBurstClassifier classifier;
+  classifier.classify(pkts, kMinLength);
+  ASSERT_EQ(classifier.size(), pkts.size());
+
+  EXPECT_EQ(classifier.packetClass(0), RxPacketClass::ARP);
+  EXPECT_EQ(classifier.packetClass(1), RxPacketClass::NDP);
+  EXPECT_EQ(classifier.packetClass(2), RxPacketClass::IPV4);
+  EXPECT_EQ(classifier.packetClass(3), RxPacketClass::SLOW_PROTOCOLS);
+  EXPECT_EQ(classifier.packetClass(4), RxPacketClass::BOGUS);
+  EXPECT_EQ(classifier.packetClass(5), RxPacketClass::IPV6);
+  EXPECT_EQ(classifier.packetClass(6), RxPacketClass::OTHER);
+  EXPECT_EQ(classifier.packetClass(7), RxPacketClass::ARP);
+
+  EXPECT_EQ(classifier.dstMac(0), MacAddress("ff:ff:ff:ff:ff:ff"));
+  EXPECT_EQ(classifier.srcMac(0), MacAddress("00:02:00:01:02:03"));
+  EXPECT_EQ(classifier.l2HeaderLength(0), 14);
+  EXPECT_EQ(classifier.vlanTag(0), 0);
+
+  EXPECT_EQ(classifier.ethertype(1), 0x86dd);
+  EXPECT_EQ(classifier.l2HeaderLength(1), 18);
+  EXPECT_EQ(classifier.vlanTag(1), 5);
+  EXPECT_EQ(classifier.ipProtocol(1), 58);
+
+  EXPECT_EQ(classifier.ipProtocol(2), 6);
+  EXPECT_EQ(classifier.ipProtocol(5), 6);
+  EXPECT_EQ(classifier.ipProtocol(0), 0);
+}
+
+TEST(RxPacketClassifier, groupsInArrivalOrder) {
+  auto pkts = makeBurst();
+  RxPacketBurstClassifier classifier;
+  classifier.classify(pkts, kMinLength);
+  EXPECT_EQ(
+      classifier.packetsOfClass(RxPacketClass::ARP),
+      std::vector<uint32_t>({0, 7}));
+  EXPECT_EQ(
+      classifier.packetsOfClass(RxPacketClass::BOGUS),
+      std::vector<uint32_t>({4}));
+  EXPECT_TRUE(classifier.packetsOfClass(RxPacketClass::LLDP).empty());
+
+  // a lower minimum length lets the short LLDP packet through
+  classifier.classify(pkts, 0);
+  EXPECT_EQ(
+      classifier.packetsOfClass(RxPacketClass::LLDP),
+      std::vector<uint32_t>({4}));
+  EXPECT_TRUE(classifier.packetsOfClass(RxPacketClass::BOGUS).empty());
+}
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxSlowPathScheduler.h"
+#include "fboss/agent/RxPacketClassifier.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kArp =
+    "ff ff ff ff ff ff  00 02 00 01 02 03  08 06"
+    "00 01  08 00  06  04  00 01";
+// IPv4 TCP from port 50000 to the BGP port
+constexpr auto kBgp =
+    "00 02 00 00 00 01  00 02 00 01 02 05  08 00"
+    "45 00 00 28  00 00 40 00  40 06 00 00"
+    "0a 00 00 01  0a 00 00 02"
+    "c3 50 00 b3";
+// IPv4 TCP between non BGP ports
+constexpr auto kTcp =
+    "00 02 00 00 00 01  00 02 00 01 02 05  08 00"
+    "45 00 00 28  00 00 40 00  40 06 00 00"
+    "0a 00 00 01  0a 00 00 02"
+    "c3 50 00 16";
+constexpr auto kLacp = "01 80 c2 00 00 02  00 02 00 01 02 06  88 09  01 01";
+constexpr auto kUnknown = "00 02 00 00 00 01  00 02 00 01 02 09  12 34";
+
+std::unique_ptr<RxPacket> makePacket(folly::StringPiece hex, PortID port) {
+  auto pkt = MockRxPacket::fromHex(hex);
+  pkt->padToLength(64);
+  pkt->setSrcPort(port);
+  return pkt;
+}
+
+class RxSlowPathSchedulerTest : public ::testing::Test {
+ public:
+  std::unique_ptr<RxSlowPathScheduler> makeScheduler(
+      RxSlowPathScheduler::Config config) {
+    return std::make_unique<RxSlowPathScheduler>(
+        config,
+        [this](std::unique_ptr<RxPacket> pkt) {
+          handled_.push_back(std::move(pkt));
+          if (handled_.size() == expectedHandled_) {
+            allHandled_.set_value();
+          }
+        },
+        [this]() { return &stats_; });
+  }
+
+ protected:
+  SwitchStats stats_{1};
+  std::vector<std::unique_ptr<RxPacket>> handled_;
+  size_t expectedHandled_{0};
+  std::promise<void> allHandled_;
+};
+} // namespace
+
+TEST_F(RxSlowPathSchedulerTest, classify) {
+  std::vector<std::unique_ptr<RxPacket>> pkts;
+  pkts.push_back(makePacket(kArp, PortID(1)));
+  pkts.push_back(makePacket(kBgp, PortID(1)));
+  pkts.push_back(makePacket(kTcp, PortID(1)));
+  pkts.push_back(makePacket(kLacp, PortID(1)));
+  pkts.push_back(makePacket(kUnknown, PortID(1)));
+  RxPacketBurstClassifier classifier;
+  classifier.classify(pkts, 0);
+
+  EXPECT_EQ(classifier.l4SrcPort(1), 50000);
+  EXPECT_EQ(classifier.l4DstPort(1), 179);
+  EXPECT_EQ(classifier.l4DstPort(0), 0);
+
+  EXPECT_EQ(
+      RxSlowPathScheduler::classify(classifier, 0), RxSlowPathClass::NEIGHBOR);
+  EXPECT_EQ(RxSlowPathScheduler::classify(classifier, 1), RxSlowPathClass::BGP);
+  EXPECT_EQ(
+      RxSlowPathScheduler::classify(classifier, 2), RxSlowPathClass::OTHER);
+  EXPECT_EQ(
+      RxSlowPathScheduler::classify(classifier, 3), RxSlowPathClass::CONTROL);
+  EXPECT_EQ(
+      RxSlowPathScheduler::classify(classifier, 4), RxSlowPathClass::OTHER);
+}
+
+TEST_F(RxSlowPathSchedulerTest, rateLimitPerPort) {
+  RxSlowPathScheduler::Config config;
+  config[static_cast<size_t>(RxSlowPathClass::NEIGHBOR)] = {1, 2, 0};
+  auto scheduler = makeScheduler(config);
+
+  // the token bucket of port 1 admits its burst size, port 2 is unaffected
+  std::vector<std::unique_ptr<RxPacket>> pkts;
+  for (int i = 0; i < 3; ++i) {
+    pkts.push_back(makePacket(kArp, PortID(1)));
+  }
+  pkts.push_back(makePacket(kArp, PortID(2)));
+  // BGP is not rate limited
+  for (int i = 0; i < 3; ++i) {
+    pkts.push_back(makePacket(kBgp, PortID(1)));
+  }
+  scheduler->enqueue(std::move(pkts));
+
+  EXPECT_EQ(scheduler->queueDepth(RxSlowPathClass::NEIGHBOR), 3);
+  EXPECT_EQ(scheduler->queueDepth(RxSlowPathClass::BGP), 3);
+}
+
+TEST_F(RxSlowPathSchedulerTest, queueDepthLimit) {
+  RxSlowPathScheduler::Config config;
+  config[static_cast<size_t>(RxSlowPathClass::OTHER)] = {0, 0, 2};
+  auto scheduler = makeScheduler(config);
+
+  for (int i = 0; i < 3; ++i) {
+    scheduler->enqueue(makePacket(kUnknown, PortID(1)));
+  }
+  scheduler->enqueue(makePacket(kLacp, PortID(1)));
+
+  EXPECT_EQ(scheduler->queueDepth(RxSlowPathClass::OTHER), 2);
+  EXPECT_EQ(scheduler->queueDepth(RxSlowPathClass::CONTROL), 1);
+}
+
+TEST_F(RxSlowPathSchedulerTest, strictPriority) {
+  auto scheduler = makeScheduler(RxSlowPathScheduler::Config{});
+
+  // queue lower priority packets first, then start the worker
+  std::vector<std::unique_ptr<RxPacket>> pkts;
+  pkts.push_back(makePacket(kUnknown, PortID(1)));
+  pkts.push_back(makePacket(kArp, PortID(2)));
+  pkts.push_back(makePacket(kBgp, PortID(3)));
+  pkts.push_back(makePacket(kLacp, PortID(4)));
+  pkts.push_back(makePacket(kArp, PortID(5)));
+  expectedHandled_ = pkts.size();
+  scheduler->enqueue(std::move(pkts));
+  scheduler->start();
+  allHandled_.get_future().wait();
+  scheduler->stop();
+
+  std::vector<PortID> order;
+  for (const auto& pkt : handled_) {
+    order.push_back(pkt->getSrcPort());
+  }
+  EXPECT_EQ(
+      order,
+      std::vector<PortID>(
+          {PortID(4), PortID(3), PortID(2), PortID(5), PortID(1)}));
+}
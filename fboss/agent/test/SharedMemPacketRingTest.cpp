@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/mnpu/SharedMemPacketRing.h"
+#include "fboss/agent/FbossError.h"
+
+#include <folly/Conv.h>
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <future>
+#include <thread>
+
+using namespace facebook::fboss;
+
+namespace {
+std::string testRingName(const std::string& suffix) {
+  return folly::to<std::string>(
+      "/fboss_pkt_ring_test_", getpid(), "_", suffix);
+}
+
+std::unique_ptr<folly::IOBuf> makePacket(size_t length, uint8_t fill) {
+  auto buf = folly::IOBuf::create(length);
+  memset(buf->writableData(), fill, length);
+  buf->append(length);
+  return buf;
+}
+} // namespace
+
+TEST(SharedMemPacketRingTest, pushPop) {
+  auto name = testRingName("pushPop");
+  auto owner = SharedMemPacketRing::create(name, 4);
+  auto peer = SharedMemPacketRing::attach(name);
+  EXPECT_EQ(peer->numSlots(), 4);
+  EXPECT_TRUE(peer->empty());
+
+  SharedMemPacketRing::PacketMeta meta;
+  meta.port = 5;
+  meta.vlan = 2000;
+  meta.queue = 7;
+  // chained buffers are copied into a single slot
+  auto pkt = makePacket(60, 0xab);
+  pkt->appendToChain(makePacket(40, 0xcd));
+  EXPECT_TRUE(owner->push(meta, *pkt));
+  EXPECT_FALSE(peer->empty());
+
+  bool popped = peer->pop([](const SharedMemPacketRing::PacketMeta& meta,
+                             folly::ByteRange data) {
+    EXPECT_EQ(meta.port, 5);
+    EXPECT_EQ(meta.aggPort, -1);
+    EXPECT_EQ(meta.vlan, 2000);
+    EXPECT_EQ(meta.queue, 7);
+    EXPECT_EQ(meta.length, 100);
+    ASSERT_EQ(data.size(), 100);
+    EXPECT_EQ(data[0], 0xab);
+    EXPECT_EQ(data[59], 0xab);
+    EXPECT_EQ(data[60], 0xcd);
+    EXPECT_EQ(data[99], 0xcd);
+  });
+  EXPECT_TRUE(popped);
+  EXPECT_TRUE(peer->empty());
+  EXPECT_FALSE(peer->pop([](const auto&, folly::ByteRange) { FAIL(); }));
+}
+
+TEST(SharedMemPacketRingTest, fullRing) {
+  auto name = testRingName("fullRing");
+  auto owner = SharedMemPacketRing::create(name, 2);
+  auto peer = SharedMemPacketRing::attach(name);
+  SharedMemPacketRing::PacketMeta meta;
+  for (uint8_t i = 0; i < 2; ++i) {
+    EXPECT_TRUE(owner->push(meta, *makePacket(64, i)));
+  }
+  EXPECT_FALSE(owner->push(meta, *makePacket(64, 2)));
+
+  // packets come out in order, freeing their slots
+  uint8_t expected = 0;
+  auto checkOrder = [&expected](const auto&, folly::ByteRange data) {
+    EXPECT_EQ(data[0], expected++);
+  };
+  EXPECT_TRUE(peer->pop(checkOrder));
+  EXPECT_TRUE(owner->push(meta, *makePacket(64, 2)));
+  EXPECT_TRUE(peer->pop(checkOrder));
+  EXPECT_TRUE(peer->pop(checkOrder));
+  EXPECT_EQ(expected, 3);
+}
+
+TEST(SharedMemPacketRingTest, packetTooLong) {
+  auto name = testRingName("packetTooLong");
+  auto owner = SharedMemPacketRing::create(name, 2);
+  SharedMemPacketRing::PacketMeta meta;
+  EXPECT_FALSE(owner->push(
+      meta, *makePacket(SharedMemPacketRing::kMaxPacketSize + 1, 0)));
+  EXPECT_TRUE(
+      owner->push(meta, *makePacket(SharedMemPacketRing::kMaxPacketSize, 0)));
+}
+
+TEST(SharedMemPacketRingTest, peerAttached) {
+  auto name = testRingName("peerAttached");
+  auto owner = SharedMemPacketRing::create(name, 2);
+  EXPECT_FALSE(owner->peerAttached());
+  {
+    auto peer = SharedMemPacketRing::attach(name);
+    EXPECT_TRUE(owner->peerAttached());
+  }
+  EXPECT_FALSE(owner->peerAttached());
+}
+
+TEST(SharedMemPacketRingTest, peerReattached) {
+  auto name = testRingName("peerReattached");
+  auto owner = SharedMemPacketRing::create(name, 2);
+  auto oldPeer = SharedMemPacketRing::attach(name);
+  auto newPeer = SharedMemPacketRing::attach(name);
+  // the mapping replaced does not detach the new one
+  oldPeer.reset();
+  EXPECT_TRUE(owner->peerAttached());
+  newPeer.reset();
+  EXPECT_FALSE(owner->peerAttached());
+}
+
+TEST(SharedMemPacketRingTest, attachFailures) {
+  auto name = testRingName("attachFailures");
+  EXPECT_THROW(SharedMemPacketRing::attach(name), FbossError);
+  {
+    auto owner = SharedMemPacketRing::create(name, 2);
+    // re-creating the ring replaces the region of the previous instance
+    auto newOwner = SharedMemPacketRing::create(name, 2);
+    EXPECT_NO_THROW(SharedMemPacketRing::attach(name));
+  }
+  // the owner removes the region
+  EXPECT_THROW(SharedMemPacketRing::attach(name), FbossError);
+}
+
+TEST(SharedMemPacketRingTest, waitForPush) {
+  auto name = testRingName("waitForPush");
+  auto owner = SharedMemPacketRing::create(name, 2);
+  auto peer = SharedMemPacketRing::attach(name);
+
+  std::promise<void> waiting;
+  std::thread consumer([&peer, &waiting]() {
+    waiting.set_value();
+    while (peer->empty()) {
+      peer->wait(std::chrono::seconds(10));
+    }
+  });
+  waiting.get_future().wait();
+  auto start = std::chrono::steady_clock::now();
+  SharedMemPacketRing::PacketMeta meta;
+  EXPECT_TRUE(owner->push(meta, *makePacket(64, 0)));
+  consumer.join();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST(SharedMemPacketRingTest, waitTimeout) {
+  auto name = testRingName("waitTimeout");
+  auto owner = SharedMemPacketRing::create(name, 2);
+  auto peer = SharedMemPacketRing::attach(name);
+  auto start = std::chrono::steady_clock::now();
+  peer->wait(std::chrono::milliseconds(10));
+  EXPECT_GE(
+      std::chrono::steady_clock::now() - start, std::chrono::milliseconds(5));
+  EXPECT_TRUE(peer->empty());
+}
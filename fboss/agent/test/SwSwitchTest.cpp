@@ -10,11 +10,13 @@
 
 #include <gtest/gtest.h>
 
+#include "fboss/agent/AgentFeatures.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossHwUpdateError.h"
 #include "fboss/agent/MultiSwitchFb303Stats.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/StateObserver.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/Interface.h"
@@ -29,6 +31,7 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <folly/Synchronized.h>
 
 #include <algorithm>
 
@@ -293,6 +296,89 @@ TEST_F(SwSwitchTest, swSwitchRunState) {
   EXPECT_EQ(switchSettings->getSwSwitchRunState(), SwitchRunState::CONFIGURED);
 }
 
+namespace {
+class OrderRecordingObserver : public StateObserver {
+ public:
+  OrderRecordingObserver(
+      std::string name,
+      bool concurrent,
+      std::vector<std::string> dependencies,
+      folly::Synchronized<std::vector<std::string>>* order)
+      : name_(std::move(name)),
+        concurrent_(concurrent),
+        dependencies_(std::move(dependencies)),
+        order_(order) {}
+
+  void stateUpdated(const StateDelta& /*delta*/) override {
+    order_->wlock()->push_back(name_);
+  }
+  bool isConcurrentSafe() const override {
+    return concurrent_;
+  }
+  std::vector<std::string> getStateObserverDependencies() const override {
+    return dependencies_;
+  }
+
+ private:
+  std::string name_;
+  bool concurrent_;
+  std::vector<std::string> dependencies_;
+  folly::Synchronized<std::vector<std::string>>* order_;
+};
+} // namespace
+
+class SwSwitchParallelObserversTest : public SwSwitchTest {
+ public:
+  void SetUp() override {
+    FLAGS_parallel_state_observers = true;
+    SwSwitchTest::SetUp();
+  }
+  void TearDown() override {
+    SwSwitchTest::TearDown();
+    FLAGS_parallel_state_observers = false;
+  }
+};
+
+TEST_F(SwSwitchParallelObserversTest, dependenciesHonored) {
+  folly::Synchronized<std::vector<std::string>> order;
+  OrderRecordingObserver first("first", true, {}, &order);
+  OrderRecordingObserver second("second", true, {"first"}, &order);
+  OrderRecordingObserver serial("serial", false, {}, &order);
+  OrderRecordingObserver afterSerial("afterSerial", true, {"serial"}, &order);
+  OrderRecordingObserver unknownDep("unknownDep", true, {"missing"}, &order);
+  std::vector<std::pair<StateObserver*, std::string>> observers = {
+      {&first, "first"},
+      {&second, "second"},
+      {&serial, "serial"},
+      {&afterSerial, "afterSerial"},
+      {&unknownDep, "unknownDep"}};
+  for (const auto& [observer, name] : observers) {
+    sw->registerStateObserver(observer, name);
+  }
+
+  auto bringPortsUpUpdateFn = [](const std::shared_ptr<SwitchState>& state) {
+    return bringAllPortsUp(state);
+  };
+  sw->updateStateBlocking("Bring Ports Up", bringPortsUpUpdateFn);
+  waitForStateUpdates(sw);
+
+  auto notified = order.copy();
+  // Later updates triggered by this one may have been observed as well,
+  // check the ordering of the first notification of each observer.
+  auto position = [&notified](const std::string& name) {
+    return static_cast<size_t>(
+        std::find(notified.begin(), notified.end(), name) - notified.begin());
+  };
+  EXPECT_GE(notified.size(), observers.size());
+  EXPECT_LT(position("first"), position("second"));
+  EXPECT_LT(position("serial"), position("afterSerial"));
+  EXPECT_LT(position("unknownDep"), notified.size());
+
+  for (const auto& [observer, name] : observers) {
+    sw->unregisterStateObserver(observer);
+  }
+}
+
 template <bool enableIntfNbrTable>
 struct EnableIntfNbrTable {
   static constexpr auto intfNbrTable = enableIntfNbrTable;
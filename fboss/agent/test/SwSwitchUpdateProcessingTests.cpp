@@ -11,12 +11,16 @@
 #include <gtest/gtest.h>
 
 #include "fboss/agent/FbossHwUpdateError.h"
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/StateUpdateBatchingPolicy.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/CounterCache.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/synchronization/Baton.h>
+
 #include <algorithm>
 
 using namespace facebook::fboss;
@@ -26,6 +30,45 @@ using ::testing::ByRef;
 using ::testing::Eq;
 using ::testing::Return;
 
+namespace {
+class TestBatchingPolicy : public StateUpdateBatchingPolicy {
+ public:
+  TestBatchingPolicy(
+      size_t maxBatchSize,
+      bool priorityLanes,
+      std::chrono::milliseconds linger = std::chrono::milliseconds(0))
+      : maxBatchSize_(maxBatchSize),
+        priorityLanes_(priorityLanes),
+        linger_(linger) {}
+
+  size_t getMaxBatchSize() const override {
+    return maxBatchSize_;
+  }
+  std::chrono::milliseconds getMaxBatchDuration() const override {
+    return std::chrono::milliseconds(0);
+  }
+  std::chrono::milliseconds getLingerDuration() const override {
+    return linger_;
+  }
+  bool usePriorityLanes() const override {
+    return priorityLanes_;
+  }
+
+ private:
+  size_t maxBatchSize_;
+  bool priorityLanes_;
+  std::chrono::milliseconds linger_;
+};
+
+class NotificationCounter : public StateObserver {
+ public:
+  void stateUpdated(const StateDelta& /*delta*/) override {
+    ++count;
+  }
+  std::atomic<int> count{0};
+};
+} // namespace
+
 class SwSwitchUpdateProcessingTest : public ::testing::TestWithParam<bool> {
  public:
   void SetUp() override {
@@ -339,6 +382,93 @@ TEST_P(SwSwitchUpdateProcessingTest, ProcessDeltaVector) {
   }
 }
 
+TEST_P(SwSwitchUpdateProcessingTest, BatchSizeLimited) {
+  setStateChangedReturn(back);
+  sw->setStateUpdateBatchingPolicy(
+      std::make_shared<TestBatchingPolicy>(2, false));
+  NotificationCounter notifications;
+  sw->registerStateObserver(&notifications, "NotificationCounter");
+
+  // Hold the update thread so that all updates are queued before any of
+  // them gets processed.
+  folly::Baton<> queued;
+  sw->getUpdateEvb()->runInEventBaseThread([&queued]() { queued.wait(); });
+  constexpr int kNumUpdates = 5;
+  std::vector<int> batchIds(kNumUpdates, -1);
+  for (int i = 0; i < kNumUpdates; ++i) {
+    sw->updateState(
+        folly::to<std::string>("add acl ", i),
+        [this, i, &batchIds, &notifications](
+            const std::shared_ptr<SwitchState>& state) {
+          batchIds[i] = notifications.count.load();
+          return addAcl(state, i + 1);
+        });
+  }
+  queued.post();
+  waitForStateUpdates(sw);
+
+  // Updates applied in the same batch observe the same notification count
+  EXPECT_EQ(batchIds[0], batchIds[1]);
+  EXPECT_NE(batchIds[1], batchIds[2]);
+  EXPECT_EQ(batchIds[2], batchIds[3]);
+  EXPECT_NE(batchIds[3], batchIds[4]);
+  sw->unregisterStateObserver(&notifications);
+}
+
+TEST_P(SwSwitchUpdateProcessingTest, HighPriorityUpdatesFirst) {
+  setStateChangedReturn(back);
+  sw->setStateUpdateBatchingPolicy(
+      std::make_shared<TestBatchingPolicy>(0, true));
+
+  folly::Baton<> queued;
+  sw->getUpdateEvb()->runInEventBaseThread([&queued]() { queued.wait(); });
+  std::vector<std::string> applied;
+  sw->updateStateNoCoalescing(
+      "regular", [this, &applied](const std::shared_ptr<SwitchState>& state) {
+        applied.push_back("regular");
+        return addAcl(state, 1);
+      });
+  sw->updateStateHighPriority(
+      "high priority",
+      [this, &applied](const std::shared_ptr<SwitchState>& state) {
+        applied.push_back("high priority");
+        return addAcl(state, 2);
+      },
+      false /* allowCoalescing */);
+  queued.post();
+  waitForStateUpdates(sw);
+
+  EXPECT_EQ(applied, (std::vector<std::string>{"high priority", "regular"}));
+}
+
+TEST_P(SwSwitchUpdateProcessingTest, HighPriorityUpdatesDontLinger) {
+  setStateChangedReturn(back);
+  // Without priority lanes, so the high priority update is queued behind a
+  // regular one which would otherwise linger for an hour
+  sw->setStateUpdateBatchingPolicy(std::make_shared<TestBatchingPolicy>(
+      0, false, std::chrono::hours(1)));
+
+  folly::Baton<> queued;
+  sw->getUpdateEvb()->runInEventBaseThread([&queued]() { queued.wait(); });
+  sw->updateState(
+      "regular", [this](const std::shared_ptr<SwitchState>& state) {
+        return addAcl(state, 1);
+      });
+  folly::Baton<> highPriorityApplied;
+  sw->updateStateHighPriority(
+      "high priority",
+      [this, &highPriorityApplied](const std::shared_ptr<SwitchState>& state) {
+        highPriorityApplied.post();
+        return addAcl(state, 2);
+      });
+  queued.post();
+  EXPECT_TRUE(highPriorityApplied.try_wait_for(std::chrono::seconds(10)));
+
+  sw->setStateUpdateBatchingPolicy(
+      std::make_shared<TestBatchingPolicy>(0, false));
+  waitForStateUpdates(sw);
+}
+
 INSTANTIATE_TEST_CASE_P(
     SwSwitchUpdateProcessingTest,
     SwSwitchUpdateProcessingTest,
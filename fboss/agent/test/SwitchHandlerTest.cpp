@@ -161,6 +161,22 @@ TEST_F(SwSwitchHandlerTest, GetOperDelta) {
   clientRequestThread2.join();
 }
 
+TEST_F(SwSwitchHandlerTest, operDeltaComputedOnceWhenCancelled) {
+  auto stateV0 = std::make_shared<SwitchState>();
+  auto stateV1 = getInitialTestState();
+
+  std::vector<StateDelta> deltas;
+  deltas.emplace_back(stateV0, stateV1);
+  waitForStateUpdates(sw_.get());
+  auto computations = StateDelta::operDeltaComputations();
+  // no HwSwitch connected, so both switches cancel the update
+  auto stateReturned = getHwSwitchHandler()->stateChanged(deltas, false);
+  EXPECT_EQ(stateReturned, stateV0);
+  // cancelled switches hand back the delta they were sent instead of
+  // computing it again
+  EXPECT_EQ(StateDelta::operDeltaComputations(), computations + 1);
+}
+
 TEST_F(SwSwitchHandlerTest, cancelHwSwitchWait) {
   std::thread serverThread([&]() {
     EXPECT_FALSE(getHwSwitchHandler()->waitUntilHwSwitchConnected());
@@ -729,13 +729,19 @@ shared_ptr<SwitchState> publishAndApplyConfig(
     cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib,
-    PlatformMapping* platformMapping) {
+    PlatformMapping* platformMapping,
+    const cfg::SwitchConfig* prevConfig) {
   if (config->switchSettings()->switchIdToSwitchInfo()->empty()) {
     config->switchSettings()->switchIdToSwitchInfo() = {
         {0, createSwitchInfo(cfg::SwitchType::NPU)}};
   }
   return publishAndApplyConfig(
-      state, (const cfg::SwitchConfig*)config, platform, rib, platformMapping);
+      state,
+      (const cfg::SwitchConfig*)config,
+      platform,
+      rib,
+      platformMapping,
+      prevConfig);
 }
 
 shared_ptr<SwitchState> publishAndApplyConfig(
@@ -743,7 +749,8 @@ shared_ptr<SwitchState> publishAndApplyConfig(
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib,
-    PlatformMapping* platformMapping) {
+    PlatformMapping* platformMapping,
+    const cfg::SwitchConfig* prevConfig) {
   state->publish();
 
   // Create a temp mock platform mapping if none is passed in.
@@ -766,7 +773,9 @@ shared_ptr<SwitchState> publishAndApplyConfig(
       platform->supportsAddRemovePort(),
       platformMapping,
       &hwAsicTable,
-      rib);
+      rib,
+      nullptr /* aclNexthopHandler */,
+      prevConfig);
 }
 
 std::unique_ptr<SwSwitch> setupMockSwitchWithoutHW(
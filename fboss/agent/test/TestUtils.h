@@ -117,14 +117,16 @@ std::shared_ptr<SwitchState> publishAndApplyConfig(
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib = nullptr,
-    PlatformMapping* platformMapping = nullptr);
+    PlatformMapping* platformMapping = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 std::shared_ptr<SwitchState> publishAndApplyConfig(
     const std::shared_ptr<SwitchState>& state,
     cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib = nullptr,
-    PlatformMapping* platformMapping = nullptr);
+    PlatformMapping* platformMapping = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 /*
  * Create a SwSwitch for testing purposes, with the specified initial state.
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/TimerWheel.h"
+
+#include <folly/io/async/EventBase.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+
+using namespace facebook::fboss;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+class TestTimer : public TimerWheel::Callback {
+ public:
+  TestTimer(TimerWheel* wheel, std::function<void()> onExpiry = nullptr)
+      : TimerWheel::Callback(wheel), onExpiry_(std::move(onExpiry)) {}
+
+  void schedule(milliseconds timeout) {
+    scheduledAt_ = steady_clock::now();
+    timeout_ = timeout;
+    scheduleTimeout(timeout);
+  }
+
+  int expiries() const {
+    return expiries_;
+  }
+
+ private:
+  void timeoutExpired() noexcept override {
+    EXPECT_GE(steady_clock::now() - scheduledAt_, timeout_);
+    ++expiries_;
+    if (onExpiry_) {
+      onExpiry_();
+    }
+  }
+
+  std::function<void()> onExpiry_;
+  steady_clock::time_point scheduledAt_;
+  milliseconds timeout_{0};
+  int expiries_{0};
+};
+
+class TimerWheelTest : public ::testing::Test {
+ public:
+  // runs the event base until all timers ran, or for 5s at most
+  void loopUntilIdle() {
+    auto deadline = steady_clock::now() + std::chrono::seconds(5);
+    while (wheel.count() && steady_clock::now() < deadline) {
+      evb.loopOnce();
+    }
+  }
+
+  folly::EventBase evb;
+  TimerWheel wheel{&evb, milliseconds(1), 2 /* maxExpiriesPerLoop */};
+};
+
+} // namespace
+
+TEST_F(TimerWheelTest, expiresAfterTimeout) {
+  std::vector<int> order;
+  TestTimer first(&wheel, [&order]() { order.push_back(1); });
+  TestTimer second(&wheel, [&order]() { order.push_back(2); });
+  second.schedule(milliseconds(30));
+  first.schedule(milliseconds(10));
+  EXPECT_TRUE(first.isScheduled());
+  EXPECT_EQ(wheel.count(), 2);
+
+  loopUntilIdle();
+  EXPECT_EQ(order, std::vector<int>({1, 2}));
+  EXPECT_FALSE(first.isScheduled());
+  EXPECT_EQ(wheel.count(), 0);
+}
+
+TEST_F(TimerWheelTest, cancelAndReschedule) {
+  TestTimer cancelled(&wheel);
+  TestTimer rescheduled(&wheel);
+  cancelled.schedule(milliseconds(5));
+  rescheduled.schedule(milliseconds(5));
+  {
+    TestTimer scoped(&wheel);
+    scoped.schedule(milliseconds(5));
+  }
+  cancelled.cancelTimeout();
+  rescheduled.schedule(milliseconds(20));
+  EXPECT_FALSE(cancelled.isScheduled());
+  EXPECT_EQ(wheel.count(), 1);
+
+  loopUntilIdle();
+  EXPECT_EQ(cancelled.expiries(), 0);
+  EXPECT_EQ(rescheduled.expiries(), 1);
+}
+
+TEST_F(TimerWheelTest, rescheduleFromExpiry) {
+  int rounds = 0;
+  TestTimer* timerPtr = nullptr;
+  TestTimer timer(&wheel, [&rounds, &timerPtr]() {
+    if (++rounds < 3) {
+      timerPtr->schedule(milliseconds(2));
+    }
+  });
+  timerPtr = &timer;
+  timer.schedule(milliseconds(2));
+  loopUntilIdle();
+  EXPECT_EQ(timer.expiries(), 3);
+}
+
+TEST_F(TimerWheelTest, cascadeFromHigherLevels) {
+  // beyond the 256 ticks of the first level
+  TestTimer timer(&wheel);
+  timer.schedule(milliseconds(600));
+  loopUntilIdle();
+  EXPECT_EQ(timer.expiries(), 1);
+}
+
+TEST_F(TimerWheelTest, expiresAcrossLevelBoundary) {
+  // a lone timer scheduled near the end of the first 256 ticks, expiring in
+  // the first level but past the next cascade
+  TestTimer crossing(&wheel);
+  TestTimer advance(
+      &wheel, [&crossing]() { crossing.schedule(milliseconds(20)); });
+  advance.schedule(milliseconds(245));
+  loopUntilIdle();
+  EXPECT_EQ(advance.expiries(), 1);
+  EXPECT_EQ(crossing.expiries(), 1);
+}
+
+TEST_F(TimerWheelTest, herdExpiresInBatches) {
+  // more timers than expire per event base loop
+  std::vector<std::unique_ptr<TestTimer>> timers;
+  for (auto i = 0; i < 100; ++i) {
+    timers.push_back(std::make_unique<TestTimer>(&wheel));
+  }
+  // timers may be cancelled while waiting for their batch
+  TestTimer* cancelled = timers.back().get();
+  TestTimer canceller(&wheel, [cancelled]() { cancelled->cancelTimeout(); });
+  canceller.schedule(milliseconds(10));
+  for (auto& timer : timers) {
+    timer->schedule(milliseconds(10));
+  }
+
+  loopUntilIdle();
+  for (auto i = 0; i < 99; ++i) {
+    EXPECT_EQ(timers[i]->expiries(), 1);
+  }
+  EXPECT_EQ(cancelled->expiries(), 0);
+}
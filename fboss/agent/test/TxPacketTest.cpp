@@ -1,4 +1,5 @@
 #include "fboss/agent/TxPacket.h"
+#include "fboss/agent/TxPacketPool.h"
 #include <gtest/gtest.h>
 
 namespace facebook::fboss {
@@ -66,4 +67,60 @@ TEST_F(TxPacketTest, DestroyOwnedPacket) {
   EXPECT_EQ(owner.getOwnedPacket() == nullptr, true);
 }
 
+/*
+ * Testing that released buffers are reused rather than reallocated
+ */
+TEST(TxPacketPoolTest, ReuseReleasedBuffer) {
+  TxPacketPool pool(2);
+  auto buf = pool.allocate(64);
+  EXPECT_EQ(buf->length(), 64);
+  EXPECT_EQ(buf->capacity(), TxPacketPool::kBufferSizes[0]);
+  const auto* data = buf->data();
+  buf.reset();
+  EXPECT_EQ(pool.freeBuffers(0), 1);
+
+  buf = pool.allocate(100);
+  EXPECT_EQ(buf->data(), data);
+  EXPECT_EQ(buf->length(), 100);
+  EXPECT_EQ(pool.heapAllocations(), 1);
+  EXPECT_EQ(pool.reusedBuffers(), 1);
+  EXPECT_EQ(pool.freeBuffers(0), 0);
+}
+
+/*
+ * Testing that buffers are pooled by size class, and the number of free
+ * buffers per class is bounded
+ */
+TEST(TxPacketPoolTest, SizeClasses) {
+  TxPacketPool pool(2);
+  std::vector<std::unique_ptr<folly::IOBuf>> bufs;
+  for (auto i = 0; i < 3; ++i) {
+    bufs.push_back(pool.allocate(1500));
+    EXPECT_EQ(bufs.back()->capacity(), TxPacketPool::kBufferSizes[2]);
+  }
+  // larger than the largest class, not pooled
+  bufs.push_back(pool.allocate(TxPacketPool::kBufferSizes.back() + 1));
+  EXPECT_EQ(pool.heapAllocations(), 4);
+  bufs.clear();
+
+  EXPECT_EQ(pool.freeBuffers(0), 0);
+  EXPECT_EQ(pool.freeBuffers(1), 0);
+  EXPECT_EQ(pool.freeBuffers(2), 2);
+  EXPECT_EQ(pool.freeBuffers(3), 0);
+}
+
+/*
+ * Testing that pooled packets still maintain the packet counter
+ */
+TEST_F(TxPacketTest, PooledPacketCounter) {
+  FLAGS_tx_packet_pool = true;
+  auto initialCount = TxPacket::getPacketCounter()->load();
+  auto packet = TxPacket::allocateTxPacket(128);
+  EXPECT_EQ(packet->buf()->length(), 128);
+  EXPECT_EQ(TxPacket::getPacketCounter()->load(), initialCount + 1);
+  packet.reset();
+  EXPECT_EQ(TxPacket::getPacketCounter()->load(), initialCount);
+  FLAGS_tx_packet_pool = false;
+}
+
 } // namespace facebook::fboss
@@ -1,8 +1,11 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
 #include <folly/Benchmark.h>
+#include <folly/synchronization/Latch.h>
 
 #include "fboss/fsdb/benchmarks/FsdbBenchmarkTestHelper.h"
+#include "fboss/fsdb/benchmarks/StateGenerator.h"
+#include "fboss/fsdb/oper/SubscriptionManager.h"
 #include "fboss/fsdb/tests/utils/FsdbTestServer.h"
 #include "fboss/lib/CommonFileUtils.h"
 
@@ -15,6 +18,19 @@ DEFINE_string(
     service_file_name_for_scale,
     "",
     "Service file name for SAI Agent Scale Benchmarks");
+
+DEFINE_int32(
+    system_scale_subscribers,
+    512,
+    "number of subscribers to agent state in many-subscribers mode");
+DEFINE_int32(
+    system_scale_switch_ids,
+    4,
+    "number of NPUs in agent state in many-subscribers mode");
+DEFINE_int32(
+    system_scale_system_ports,
+    8000,
+    "number of System Ports per NPU in many-subscribers mode");
 using facebook::fboss::fsdb::test::FsdbTestServer;
 
 namespace {
@@ -69,4 +85,75 @@ BENCHMARK(FsdbSystemScaleStats) {
   }
   helper.TearDown(false /*stopFsdbTestServer*/);
 }
+
+/*
+ * Many-subscribers mode: system scale agent state published to
+ * --system_scale_subscribers subscribers of the agent root. Measures the time
+ * for an update to reach all subscribers, with the subscribers served from
+ * the publish thread or fanned out over serve threads.
+ */
+void FsdbSystemScaleSubscribers(uint32_t /* iters */, int32_t serveThreads) {
+  const int numSubscribers = FLAGS_system_scale_subscribers;
+  folly::Latch subscriptionComplete(numSubscribers);
+  folly::Latch updateReceived(numSubscribers);
+
+  folly::BenchmarkSuspender suspender;
+  auto origServeThreads = FLAGS_subscriptionServeThreads;
+  FLAGS_subscriptionServeThreads = serveThreads;
+
+  FsdbBenchmarkTestHelper helper;
+  helper.setup(numSubscribers);
+
+  helper.startPublisher(false /* stats*/);
+  auto state = std::make_shared<state::SwitchState>();
+  helper.publishStatePatch(*state, 1);
+  helper.waitForPublisherConnected();
+
+  StateGenerator::fillSwitchState(
+      state.get(),
+      FLAGS_system_scale_switch_ids,
+      FLAGS_system_scale_system_ports);
+  helper.publishStatePatch(*state, 2);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numSubscribers; i++) {
+    threads.emplace_back([&, i] {
+      fsdb::FsdbPatchSubscriber::FsdbOperPatchUpdateCb subscriptionCb =
+          [&](SubscriberChunk&& patch) {
+            for (const auto& [key, patches] : *patch.patchGroups()) {
+              auto timestampVal =
+                  patches[0].metadata()->lastConfirmedAt().value();
+              if (timestampVal == 3) {
+                updateReceived.count_down();
+              } else if (timestampVal == 2) {
+                subscriptionComplete.count_down();
+              }
+            }
+          };
+      helper.addStatePatchSubscription(subscriptionCb, i);
+    });
+  }
+  // wait for all subscribers to receive the system scale initial sync
+  subscriptionComplete.wait();
+
+  StateGenerator::updateSysPorts(state.get(), 100);
+
+  // benchmark test: update state and wait for all subscribers to receive it
+  suspender.dismiss();
+  helper.publishStatePatch(*state, 3);
+  updateReceived.wait();
+  suspender.rehire();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < numSubscribers; i++) {
+    helper.removeSubscription(false, i);
+  }
+  helper.TearDown();
+  FLAGS_subscriptionServeThreads = origServeThreads;
+}
+
+BENCHMARK_NAMED_PARAM(FsdbSystemScaleSubscribers, serial, 0);
+BENCHMARK_NAMED_PARAM(FsdbSystemScaleSubscribers, parallel, 8);
 } // namespace facebook::fboss::fsdb::test
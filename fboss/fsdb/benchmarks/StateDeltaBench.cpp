@@ -0,0 +1,99 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/fsdb/benchmarks/StateGenerator.h"
+
+DEFINE_int32(delta_switch_ids, 4, "number of NPUs in the state");
+DEFINE_int32(delta_system_ports, 8000, "number of System Ports per NPU");
+DEFINE_int32(
+    delta_sysports_to_add,
+    100,
+    "number of System Ports and RIFs added per NPU by the update");
+DEFINE_int32(
+    delta_neighbors_to_add,
+    2,
+    "number of neighbors added per RIF by the update");
+DEFINE_int32(
+    delta_consumers,
+    4,
+    "number of consumers reading the oper delta of an update");
+
+namespace facebook::fboss::fsdb::test {
+
+namespace {
+/*
+ * VOQ switch scale state and an update adding system ports, RIFs and
+ * neighbors to it. Members not touched by the update are shared between the
+ * two states, as they are for state updates in the agent.
+ */
+std::pair<std::shared_ptr<SwitchState>, std::shared_ptr<SwitchState>>
+makeStates() {
+  state::SwitchState thriftState;
+  StateGenerator::fillSwitchState(
+      &thriftState, FLAGS_delta_switch_ids, FLAGS_delta_system_ports);
+  auto oldState = SwitchState::fromThrift(thriftState);
+  oldState->publish();
+
+  StateGenerator::updateSysPorts(&thriftState, FLAGS_delta_sysports_to_add);
+  StateGenerator::updateNeighborTables(
+      &thriftState, FLAGS_delta_neighbors_to_add);
+  auto updated = SwitchState::fromThrift(thriftState);
+  auto newState = oldState->clone();
+  newState->ref<switch_state_tags::systemPortMaps>() =
+      updated->cref<switch_state_tags::systemPortMaps>();
+  newState->ref<switch_state_tags::interfaceMaps>() =
+      updated->cref<switch_state_tags::interfaceMaps>();
+  newState->publish();
+  return {oldState, newState};
+}
+} // namespace
+
+/*
+ * Oper delta of a VOQ scale update, computed serially or with the changed
+ * SwitchState members spread over threads.
+ */
+void StateDeltaOperDelta(uint32_t /* iters */, int32_t threads) {
+  folly::BenchmarkSuspender suspender;
+  auto [oldState, newState] = makeStates();
+  auto origThreads = FLAGS_state_delta_threads;
+  FLAGS_state_delta_threads = threads;
+  StateDelta delta(oldState, newState);
+
+  suspender.dismiss();
+  folly::doNotOptimizeAway(delta.getOperDelta());
+  suspender.rehire();
+
+  FLAGS_state_delta_threads = origThreads;
+}
+
+/*
+ * Several consumers of the same update needing its oper delta, either each
+ * computing it from the two states or all reading the one cached in the
+ * StateDelta.
+ */
+void StateDeltaOperDeltaConsumers(uint32_t /* iters */, bool shared) {
+  folly::BenchmarkSuspender suspender;
+  auto [oldState, newState] = makeStates();
+  StateDelta delta(oldState, newState);
+
+  suspender.dismiss();
+  for (auto i = 0; i < FLAGS_delta_consumers; ++i) {
+    if (shared) {
+      folly::doNotOptimizeAway(delta.getOperDelta());
+    } else {
+      folly::doNotOptimizeAway(StateDelta(oldState, newState).getOperDelta());
+    }
+  }
+  suspender.rehire();
+}
+
+BENCHMARK_NAMED_PARAM(StateDeltaOperDelta, serial, 1);
+BENCHMARK_NAMED_PARAM(StateDeltaOperDelta, parallel, 4);
+BENCHMARK_NAMED_PARAM(StateDeltaOperDeltaConsumers, recomputed, false);
+BENCHMARK_NAMED_PARAM(StateDeltaOperDeltaConsumers, cached, true);
+
+} // namespace facebook::fboss::fsdb::test
@@ -13,7 +13,10 @@
 
 #include <folly/io/async/EventBase.h>
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <utility>
 
 DECLARE_bool(publish_use_id_paths);
 
@@ -139,6 +142,32 @@ class FsdbSyncManager {
     storage_.updateState("Update internal state to publish", updateFun);
   }
 
+  //  update function which also returns the oper delta of its change relative
+  //  to the root of the state, if it already knows it
+  using CowStateDeltaUpdateFn = std::function<
+      std::pair<std::shared_ptr<CowState>, std::optional<OperDelta>>(
+          const std::shared_ptr<CowState>&)>;
+
+  //  same as updateState, but a delta returned by updateFun is published as is
+  //  instead of being computed again from the two states. These updates are
+  //  not coalesced with others, so that the delta covers all that changed.
+  void updateStateWithDelta(CowStateDeltaUpdateFn updateFun) {
+    storage_.updateStateNoCoalescing(
+        "Update internal state to publish with delta",
+        [this, updateFun = std::move(updateFun)](const auto& oldState) {
+          auto [newState, delta] = updateFun(oldState);
+          if (delta && newState && newState != oldState) {
+            knownDelta_ = KnownDelta{oldState, newState, std::move(*delta)};
+          }
+          return newState;
+        });
+  }
+
+  //  whether published deltas use thrift ids rather than names in paths
+  bool useIdPaths() const {
+    return useIdPaths_;
+  }
+
   FsdbPubSubManager* pubSubMgr() {
     return pubSubMgr_.get();
   }
@@ -155,11 +184,18 @@ class FsdbSyncManager {
   void processDelta(
       const std::shared_ptr<CowState>& oldState,
       const std::shared_ptr<CowState>& newState) {
+    // delta only ever describes the update applied right after it was known
+    auto knownDelta = std::exchange(knownDelta_, std::nullopt);
     // TODO: hold lock here to sync with stop()?
     if (readyForPublishing_.load()) {
       switch (pubType_) {
         case PubSubType::DELTA:
-          publishDelta(oldState, newState);
+          if (knownDelta && knownDelta->oldState == oldState &&
+              knownDelta->newState == newState) {
+            publishDelta(std::move(knownDelta->delta));
+          } else {
+            publishDelta(oldState, newState);
+          }
           break;
         case PubSubType::PATH:
           publishPath(newState);
@@ -218,6 +254,14 @@ class FsdbSyncManager {
     publish(computeOperDelta(oldState, newState, basePath_, useIdPaths_));
   }
 
+  void publishDelta(OperDelta delta) {
+    for (auto& change : *delta.changes()) {
+      auto& path = *change.path()->raw();
+      path.insert(path.begin(), basePath_.begin(), basePath_.end());
+    }
+    publish(std::move(delta));
+  }
+
   void publishPath(const std::shared_ptr<CowState>& newState) {
     OperState state;
     state.contents() = newState->encode(OperProtocol::BINARY);
@@ -290,6 +334,14 @@ class FsdbSyncManager {
   std::vector<std::string> basePath_;
   bool isStats_;
   PubSubType pubType_;
+  struct KnownDelta {
+    std::shared_ptr<CowState> oldState;
+    std::shared_ptr<CowState> newState;
+    OperDelta delta;
+  };
+  // delta of the pending update from updateStateWithDelta, only accessed on
+  // the storage thread. Declared ahead of storage_ to outlive its thread.
+  std::optional<KnownDelta> knownDelta_;
   CowStorageManager storage_;
   std::atomic_bool readyForPublishing_ = false;
   bool useIdPaths_ = false;
@@ -26,6 +26,10 @@
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 
 #include <folly/Traits.h>
+#include <folly/io/IOBuf.h>
+
+#include <map>
+#include <set>
 
 namespace facebook::fboss::fsdb {
 
@@ -86,6 +90,17 @@ class OperUnitCache {
     throw std::runtime_error("Unsupported protocol");
   }
 
+  // Encoded new state as an IOBuf, copies share the underlying buffer
+  const folly::IOBuf& getEncodedBuf(const fsdb::OperProtocol& protocol) {
+    auto& buf = newStateBufs_[protocol];
+    if (!buf) {
+      const auto& state = getEncodedState(protocol);
+      buf = state ? folly::IOBuf::copyBuffer(state->data(), state->length())
+                  : folly::IOBuf::create(0);
+    }
+    return *buf;
+  }
+
  private:
   const OperDeltaUnit& getOrBuildDelta(
       std::optional<OperDeltaUnit>& unit,
@@ -119,6 +134,7 @@ class OperUnitCache {
       newStateJson_;
   std::optional<folly::fbstring> oldStateBinary_, oldStateCompact_,
       oldStateJson_;
+  std::map<fsdb::OperProtocol, std::unique_ptr<folly::IOBuf>> newStateBufs_;
 };
 } // namespace csm_detail
 
@@ -163,6 +179,45 @@ class CowSubscriptionManager
     }
   }
 
+  template <typename OperCache>
+  void serveExactSubscription(
+      Subscription* relevant,
+      OperCache& cache,
+      bool isMinimalOrAddedOrRemoved,
+      const std::optional<thrift_cow::PatchNodeBuilder>& patchBuilder,
+      const SubscriptionMetadataServer& metadataServer) {
+    if (relevant->type() == PubSubType::PATH) {
+      auto* pathSubscription = static_cast<BasePathSubscription*>(relevant);
+      servePathEncoded(
+          pathSubscription,
+          cache,
+          pathSubscription->operProtocol(),
+          metadataServer);
+    } else if (relevant->type() == PubSubType::DELTA) {
+      if (isMinimalOrAddedOrRemoved) {
+        auto* deltaSubscription = static_cast<DeltaSubscription*>(relevant);
+        deltaSubscription->appendRootDeltaUnit(
+            cache.getEncodedDelta(relevant->operProtocol()));
+      }
+    } else if (relevant->type() == PubSubType::PATCH && patchBuilder) {
+      // patches only supported when using id paths
+      auto* patchSubscription = static_cast<PatchSubscription*>(relevant);
+      auto ret = patchSubscription->offer(patchBuilder->curPatch());
+      if (ret.has_value()) {
+        patchSubscription->requestPruneWithReason(ret.value());
+      }
+    }
+  }
+
+  static std::set<OperProtocol> subscriptionProtocols(
+      const std::vector<Subscription*>& subscriptions) {
+    std::set<OperProtocol> protocols;
+    for (const auto* subscription : subscriptions) {
+      protocols.insert(subscription->operProtocol());
+    }
+    return protocols;
+  }
+
   void doInitialSyncSimple(
       SubscriptionStore& store,
       const std::shared_ptr<Root>& newRoot,
@@ -219,12 +274,9 @@ class CowSubscriptionManager
           auto patchSubscription =
               static_cast<PatchSubscription*>(subscription);
           thrift_cow::PatchNode patchNode;
-          // TODO: try to change to a shared holding a IOBuf instead of
-          // copying from an fbstring
-          auto& state =
-              operUnitCache.getEncodedState(subscription->operProtocol());
-          auto buf = folly::IOBuf::copyBuffer(state->data(), state->length());
-          patchNode.set_val(*buf);
+          // shares the buffer encoded for the first patch subscriber
+          patchNode.set_val(
+              operUnitCache.getEncodedBuf(subscription->operProtocol()));
           auto ret = patchSubscription->offer(std::move(patchNode));
           if (ret.has_value()) {
             patchSubscription->requestPruneWithReason(ret.value());
@@ -416,35 +468,24 @@ class CowSubscriptionManager
 
       if (lookup) {
         const auto& exactSubscriptions = lookup->subscriptions();
-        for (auto& relevant : exactSubscriptions) {
-          if (relevant->type() == PubSubType::PATH) {
-            auto* pathSubscription =
-                static_cast<BasePathSubscription*>(relevant);
-            // TODO: cache encoded state
-            servePathEncoded(
-                pathSubscription,
-                operUnitCache,
-                pathSubscription->operProtocol(),
-                metadataServer);
-          } else if (relevant->type() == PubSubType::DELTA) {
-            if (isMinimalOrAddedOrRemoved) {
-              auto* deltaSubscription =
-                  static_cast<DeltaSubscription*>(relevant);
-              deltaSubscription->appendRootDeltaUnit(
-                  operUnitCache.getEncodedDelta(relevant->operProtocol()));
-            }
-          } else if (
-              relevant->type() == PubSubType::PATCH &&
-              traverser.patchBuilder()) {
-            // patches only supported when using id paths
-            auto* patchSubscription = static_cast<PatchSubscription*>(relevant);
-            auto ret =
-                patchSubscription->offer(traverser.patchBuilder()->curPatch());
-            if (ret.has_value()) {
-              patchSubscription->requestPruneWithReason(ret.value());
-            }
+        if (this->parallelServeEnabled(exactSubscriptions.size())) {
+          // Encode everything subscribers will read upfront, shards only
+          // read from the cache
+          for (auto protocol : subscriptionProtocols(exactSubscriptions)) {
+            operUnitCache.getEncodedDelta(protocol);
           }
         }
+        this->serveInShards(
+            exactSubscriptions.size(), [&](size_t begin, size_t end) {
+              for (auto i = begin; i < end; ++i) {
+                serveExactSubscription(
+                    exactSubscriptions[i],
+                    operUnitCache,
+                    isMinimalOrAddedOrRemoved,
+                    traverser.patchBuilder(),
+                    metadataServer);
+              }
+            });
       }
 
       if (visitTag != thrift_cow::DeltaElemTag::MINIMAL) {
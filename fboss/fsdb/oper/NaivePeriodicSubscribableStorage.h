@@ -11,9 +11,12 @@
 #include <fboss/thrift_cow/storage/Storage.h>
 
 #include <folly/Expected.h>
+#include <folly/concurrency/AtomicSharedPtr.h>
 #include <folly/coro/Sleep.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <utility>
 
 namespace facebook::fboss::fsdb {
@@ -44,7 +47,7 @@ class NaivePeriodicSubscribableStorage
       StorageParams params = {})
       : NaivePeriodicSubscribableStorageBase(params),
         currentState_(std::in_place, initialState),
-        lastPublishedState_(*currentState_.rlock()),
+        lastPublishedRoot_(currentState_.rlock()->root()),
         subscriptions_(
             patchOperProtocol_,
             params.requireResponseOnInitialSync_) {
@@ -77,9 +80,8 @@ class NaivePeriodicSubscribableStorage
 
   template <typename T>
   Result<T> get_impl(PathIter begin, PathIter end) const {
-    if (params_.serveGetRequestsWithLastPublishedState_) {
-      auto state = Storage(*lastPublishedState_.rlock());
-      return state.template get<T>(begin, end);
+    if (auto state = lockFreeReadState()) {
+      return state->template get<T>(begin, end);
     } else {
       // hold rlock on current state to avoid racing with writers
       auto currentState = currentState_.rlock();
@@ -90,9 +92,8 @@ class NaivePeriodicSubscribableStorage
   Result<OperState>
   get_encoded_impl(PathIter begin, PathIter end, OperProtocol protocol) const {
     Result<OperState> result;
-    if (params_.serveGetRequestsWithLastPublishedState_) {
-      auto state = Storage(*lastPublishedState_.rlock());
-      result = state.get_encoded(begin, end, protocol);
+    if (auto state = lockFreeReadState()) {
+      result = state->get_encoded(begin, end, protocol);
     } else {
       // hold rlock on current state to avoid racing with writers
       auto currentState = currentState_.rlock();
@@ -124,9 +125,8 @@ class NaivePeriodicSubscribableStorage
       ExtPathIter end,
       OperProtocol protocol) const {
     Result<std::vector<TaggedOperState>> result;
-    if (params_.serveGetRequestsWithLastPublishedState_) {
-      auto state = Storage(*lastPublishedState_.rlock());
-      result = state.get_encoded_extended(begin, end, protocol);
+    if (auto state = lockFreeReadState()) {
+      result = state->get_encoded_extended(begin, end, protocol);
     } else {
       // hold rlock on current state to avoid racing with writers
       auto currentState = currentState_.rlock();
@@ -159,6 +159,7 @@ class NaivePeriodicSubscribableStorage
   std::optional<StorageError>
   set_impl(PathIter begin, PathIter end, T&& value) {
     auto state = currentState_.wlock();
+    currentStateDirty_ = true;
     updateMetadata(begin, end);
     return state->set(begin, end, std::forward<T>(value));
   }
@@ -166,6 +167,7 @@ class NaivePeriodicSubscribableStorage
   std::optional<StorageError>
   set_encoded_impl(PathIter begin, PathIter end, const OperState& value) {
     auto state = currentState_.wlock();
+    currentStateDirty_ = true;
     auto metadata = value.metadata() ? *value.metadata() : OperMetadata();
     updateMetadata(begin, end, metadata);
     return state->set_encoded(begin, end, value);
@@ -175,12 +177,14 @@ class NaivePeriodicSubscribableStorage
   std::optional<StorageError>
   add_impl(PathIter begin, PathIter end, T&& value) {
     auto state = currentState_.wlock();
+    currentStateDirty_ = true;
     updateMetadata(begin, end);
     return state->add(begin, end, std::forward<T>(value));
   }
 
   void remove_impl(PathIter begin, PathIter end) {
     auto state = currentState_.wlock();
+    currentStateDirty_ = true;
     updateMetadata(begin, end);
     state->remove(begin, end);
   }
@@ -192,6 +196,7 @@ class NaivePeriodicSubscribableStorage
     }
     auto& path = *patch.basePath();
     auto state = currentState_.wlock();
+    currentStateDirty_ = true;
     updateMetadata(path.begin(), path.end(), *patch.metadata());
     return state->patch(std::move(patch));
   }
@@ -207,6 +212,7 @@ class NaivePeriodicSubscribableStorage
     // we do for oper state
     auto& path = *delta.changes()->begin()->path()->raw();
     auto state = currentState_.wlock();
+    currentStateDirty_ = true;
     auto metadata = delta.metadata() ? *delta.metadata() : OperMetadata();
     updateMetadata(path.begin(), path.end(), metadata);
     return state->patch(delta);
@@ -216,6 +222,7 @@ class NaivePeriodicSubscribableStorage
       const fsdb::TaggedOperState& operState) {
     auto& path = *operState.path()->path();
     auto state = currentState_.wlock();
+    currentStateDirty_ = true;
     auto metadata = operState.state()->metadata()
         ? *operState.state()->metadata()
         : OperMetadata();
@@ -234,10 +241,10 @@ class NaivePeriodicSubscribableStorage
       std::shared_ptr<RootNode>,
       SubscriptionMetadataServer>
   publishCurrentState() {
-    auto lastState = lastPublishedState_.wlock();
+    std::lock_guard<std::mutex> publishLock(publishMutex_);
     auto currentState = currentState_.rlock();
 
-    auto oldRoot = lastState->root();
+    auto oldRoot = lastPublishedRoot_.load();
     auto newRoot = currentState->root();
     /*
      * Grab a copy of metadata while holding current state
@@ -251,7 +258,9 @@ class NaivePeriodicSubscribableStorage
       subscriptions_.publishAndAddPaths(newRoot);
     }
 
-    *lastState = Storage(*currentState);
+    // newRoot is immutable from here on, readers pick it up without locking
+    lastPublishedRoot_.store(newRoot);
+    currentStateDirty_ = false;
     return std::make_tuple(oldRoot, newRoot, metadataServer);
   }
 
@@ -290,7 +299,7 @@ class NaivePeriodicSubscribableStorage
   }
 
   OperState publishedStateEncoded(OperProtocol protocol) {
-    auto lastState = Storage(*lastPublishedState_.rlock());
+    auto lastState = Storage(lastPublishedRoot_.load());
     std::vector<std::string> rootPath;
     return *lastState.get_encoded(rootPath.begin(), rootPath.end(), protocol);
   }
@@ -308,8 +317,28 @@ class NaivePeriodicSubscribableStorage
 
   ExtPath convertPath(const ExtPath& path) const override;
 
+  /*
+   * Published state that reads can be served from without locking, if any.
+   * That is the last published state when serving gets from it, or when no
+   * writes landed since the last publish, as it is the current state then.
+   * Published nodes are never modified, so the snapshot stays consistent
+   * while writers move on.
+   */
+  std::optional<Storage> lockFreeReadState() const {
+    if (params_.serveGetRequestsWithLastPublishedState_ ||
+        !currentStateDirty_) {
+      return Storage(lastPublishedRoot_.load());
+    }
+    return std::nullopt;
+  }
+
   folly::Synchronized<Storage> currentState_;
-  folly::Synchronized<Storage> lastPublishedState_;
+  // Root of the last published state, swapped RCU style after each publish
+  folly::atomic_shared_ptr<RootNode> lastPublishedRoot_;
+  // Whether currentState_ was written since it was last published
+  std::atomic<bool> currentStateDirty_{false};
+  // Serializes publishes, never taken by readers
+  std::mutex publishMutex_;
 
   SubscribeManager subscriptions_;
 };
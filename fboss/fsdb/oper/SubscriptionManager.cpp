@@ -3,8 +3,68 @@
 #include "fboss/fsdb/oper/SubscriptionManager.h"
 #include "fboss/fsdb/oper/SubscriptionMetadataServer.h"
 
+#include <folly/Indestructible.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <gflags/gflags.h>
+
+DEFINE_int32(
+    subscriptionServeThreads,
+    0,
+    "Threads serving the subscribers of a changed path in parallel, "
+    "0 to serve all subscribers on the publish thread");
+
+DEFINE_int32(
+    subscriptionServeMinFanout,
+    64,
+    "Minimum number of subscribers at a path for them to be served in "
+    "parallel");
+
 namespace facebook::fboss::fsdb {
 
+namespace {
+folly::Executor* subscriptionServeExecutor() {
+  static folly::Indestructible<folly::CPUThreadPoolExecutor> executor(
+      std::max(FLAGS_subscriptionServeThreads, 1),
+      std::make_shared<folly::NamedThreadFactory>("SubscriptionServe"));
+  return &*executor;
+}
+} // namespace
+
+bool SubscriptionManagerBase::parallelServeEnabled(
+    size_t numSubscriptions) const {
+  return FLAGS_subscriptionServeThreads > 1 &&
+      numSubscriptions >=
+      static_cast<size_t>(std::max(FLAGS_subscriptionServeMinFanout, 1));
+}
+
+void SubscriptionManagerBase::serveInShards(
+    size_t numSubscriptions,
+    const std::function<void(size_t, size_t)>& serveRange) const {
+  if (!parallelServeEnabled(numSubscriptions)) {
+    serveRange(0, numSubscriptions);
+    return;
+  }
+  size_t numShards = FLAGS_subscriptionServeThreads;
+  auto shardSize = (numSubscriptions + numShards - 1) / numShards;
+  std::vector<folly::SemiFuture<folly::Unit>> shards;
+  for (size_t begin = shardSize; begin < numSubscriptions; begin += shardSize) {
+    auto end = std::min(begin + shardSize, numSubscriptions);
+    shards.push_back(
+        folly::via(subscriptionServeExecutor(), [&serveRange, begin, end]() {
+          serveRange(begin, end);
+        }).semi());
+  }
+  // first shard is served on the calling thread
+  serveRange(0, std::min(shardSize, numSubscriptions));
+  // wait for every shard before surfacing errors, shards reference
+  // serveRange
+  for (auto& result : folly::collectAll(std::move(shards)).get()) {
+    result.throwUnlessValue();
+  }
+}
+
 void SubscriptionManagerBase::registerExtendedSubscription(
     std::shared_ptr<ExtendedSubscription> subscription) {
   if (subscription->type() == PubSubType::PATCH && !useIdPaths_) {
@@ -9,9 +9,14 @@
 #include "fboss/fsdb/oper/SubscriptionStore.h"
 
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+#include <functional>
 #include <string>
 #include <vector>
 
+DECLARE_int32(subscriptionServeThreads);
+DECLARE_int32(subscriptionServeMinFanout);
+
 namespace facebook::fboss::fsdb {
 
 class SubscriptionMetadataServer;
@@ -86,6 +91,16 @@ class SubscriptionManagerBase {
  protected:
   void registerPendingSubscriptions(SubscriptionStore& store);
 
+  // Whether subscriptions at a single path are numerous enough to be served
+  // in parallel
+  bool parallelServeEnabled(size_t numSubscriptions) const;
+
+  // Invokes serveRange over [0, numSubscriptions), split in shards served in
+  // parallel when enabled. Returns once all shards are served.
+  void serveInShards(
+      size_t numSubscriptions,
+      const std::function<void(size_t, size_t)>& serveRange) const;
+
   folly::Synchronized<SubscriptionStore> store_;
 
   bool useIdPaths_{false};
@@ -9,12 +9,17 @@
 #include <folly/logging/xlog.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
 #include <fboss/fsdb/oper/NaivePeriodicSubscribableStorage.h>
 #include "fboss/fsdb/tests/gen-cpp2-thriftpath/thriftpath_test.h" // @manual=//fboss/fsdb/tests:thriftpath_test_thrift-cpp2-thriftpath
 
 namespace {
 constexpr auto kReadsPerTask = 1000;
 constexpr auto kWritesPerTask = 200;
+constexpr auto kTimedWritesPerPublisher = 2000;
 } // namespace
 
 namespace facebook::fboss::fsdb::test {
@@ -55,6 +60,27 @@ class StorageBenchmarkHelper {
     co_return;
   }
 
+  // polls until stop is set
+  folly::coro::Task<void> pollRequests(const std::atomic<bool>& stop) {
+    while (!stop.load()) {
+      storage_.get_encoded(this->root.structMap(), OperProtocol::BINARY);
+    }
+    co_return;
+  }
+
+  // small writes, recording how long each took
+  folly::coro::Task<void> publishDataTimed(
+      uint32_t numWrites,
+      std::vector<std::chrono::nanoseconds>& latencies) {
+    for (auto count = 0; count < numWrites; count++) {
+      int version = (count % 2);
+      auto start = std::chrono::steady_clock::now();
+      storage_.set(root.structMap()[42], testData_[version].structMap()[42]);
+      latencies.push_back(std::chrono::steady_clock::now() - start);
+    }
+    co_return;
+  }
+
   folly::coro::Task<void> publishData(uint32_t numWrites, bool useLargeData) {
     for (auto count = 0; count < numWrites; count++) {
       int version = (count % 2);
@@ -155,6 +181,59 @@ void bm_concurrent_get_set(
   suspender.rehire();
 }
 
+/*
+ * numPublishers writing while numReaders poll the storage with gets, reports
+ * p99 latency of a single write
+ */
+void bm_publish_latency(
+    folly::UserCounters& counters,
+    uint32_t /* unused */,
+    uint32_t numPublishers,
+    uint32_t numReaders,
+    bool serveGetRequestsWithLastPublishedState) {
+  folly::BenchmarkSuspender suspender;
+
+  StorageBenchmarkHelper helper(serveGetRequestsWithLastPublishedState);
+  helper.startStorage();
+
+  folly::coro::AsyncScope readerScope, publisherScope;
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(
+      numPublishers + numReaders);
+  std::atomic<bool> stopReaders{false};
+  std::vector<std::vector<std::chrono::nanoseconds>> latencies(numPublishers);
+
+  for (int i = 0; i < numReaders; i++) {
+    readerScope.add(
+        co_withExecutor(executor.get(), helper.pollRequests(stopReaders)));
+  }
+
+  suspender.dismiss();
+
+  for (int i = 0; i < numPublishers; i++) {
+    publisherScope.add(co_withExecutor(
+        executor.get(),
+        helper.publishDataTimed(kTimedWritesPerPublisher, latencies[i])));
+  }
+  folly::coro::blockingWait(publisherScope.joinAsync());
+
+  suspender.rehire();
+
+  stopReaders = true;
+  folly::coro::blockingWait(readerScope.joinAsync());
+
+  std::vector<std::chrono::nanoseconds> allLatencies;
+  for (const auto& publisherLatencies : latencies) {
+    allLatencies.insert(
+        allLatencies.end(),
+        publisherLatencies.begin(),
+        publisherLatencies.end());
+  }
+  auto p99 = allLatencies.begin() + allLatencies.size() * 99 / 100;
+  std::nth_element(allLatencies.begin(), p99, allLatencies.end());
+  counters["p99_publish_us"] =
+      std::chrono::duration_cast<std::chrono::microseconds>(*p99).count();
+}
+
 BENCHMARK_NAMED_PARAM(bm_get, threads_1, 1, kReadsPerTask);
 
 BENCHMARK_NAMED_PARAM(bm_get, threads_2, 2, kReadsPerTask);
@@ -222,6 +301,30 @@ BENCHMARK_NAMED_PARAM(
     true,
     false);
 
+BENCHMARK_COUNTERS_NAMED_PARAM(
+    bm_publish_latency,
+    counters,
+    publishers_1_readers_8,
+    1,
+    8,
+    true);
+
+BENCHMARK_COUNTERS_NAMED_PARAM(
+    bm_publish_latency,
+    counters,
+    publishers_4_readers_8,
+    4,
+    8,
+    true);
+
+BENCHMARK_COUNTERS_NAMED_PARAM(
+    bm_publish_latency,
+    counters,
+    publishers_4_readers_8_serveGetWithCurrentState,
+    4,
+    8,
+    false);
+
 } // namespace facebook::fboss::fsdb::test
 
 int main(int argc, char* argv[]) {
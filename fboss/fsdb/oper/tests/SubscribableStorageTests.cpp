@@ -374,6 +374,63 @@ TYPED_TEST(SubscribableStorageTests, SubscribePatchMulti) {
   }
 }
 
+TYPED_TEST(SubscribableStorageTests, SubscribePatchParallelServe) {
+  using namespace facebook::fboss::fsdb;
+  using namespace facebook::fboss::thrift_cow;
+
+  // serve subscribers of a path in shards of a few subscribers each
+  gflags::FlagSaver flagSaver;
+  FLAGS_subscriptionServeThreads = 4;
+  FLAGS_subscriptionServeMinFanout = 2;
+  constexpr int kSubscribersPerPath = 10;
+
+  auto storage = this->initStorage(this->testStruct);
+  storage.setConvertToIDPaths(true);
+  storage.start();
+
+  const auto& path1 = this->root.stringToStruct()["test1"].max();
+  const auto& path2 = this->root.stringToStruct()["test2"].max();
+  std::vector<decltype(storage.subscribe_patch(
+      SubscriptionIdentifier(SubscriberId(kSubscriber)), path1))>
+      generators1, generators2;
+  for (int i = 0; i < kSubscribersPerPath; ++i) {
+    generators1.push_back(storage.subscribe_patch(
+        SubscriptionIdentifier(SubscriberId(fmt::format("path1_{}", i))),
+        path1));
+    generators2.push_back(storage.subscribe_patch(
+        SubscriptionIdentifier(SubscriberId(fmt::format("path2_{}", i))),
+        path2));
+  }
+  WITH_RETRIES(EXPECT_EVENTUALLY_EQ(
+      storage.numSubscriptions(), 2 * kSubscribersPerPath));
+
+  auto expectPatch = [](auto& generator, int expected) {
+    auto msg = folly::coro::blockingWait(
+        folly::coro::timeout(consumeOne(generator), std::chrono::seconds(5)));
+    auto patchGroups = *msg.get_chunk().patchGroups();
+    ASSERT_EQ(patchGroups.size(), 1);
+    auto patches = patchGroups.begin()->second;
+    ASSERT_EQ(patches.size(), 1);
+    auto& patch = patches.front();
+    auto deserialized = facebook::fboss::thrift_cow::
+        deserializeBuf<apache::thrift::type_class::integral, int32_t>(
+            *patch.protocol(), patch.patch()->move_val());
+    EXPECT_EQ(deserialized, expected);
+  };
+
+  // every subscriber of both paths sees every update, in order
+  for (int round = 1; round <= 5; ++round) {
+    EXPECT_EQ(storage.set(path1, round), std::nullopt);
+    EXPECT_EQ(storage.set(path2, round * 100), std::nullopt);
+    for (auto& generator : generators1) {
+      expectPatch(generator, round);
+    }
+    for (auto& generator : generators2) {
+      expectPatch(generator, round * 100);
+    }
+  }
+}
+
 TYPED_TEST(SubscribableStorageTests, SubscribePatchHeartbeat) {
   FLAGS_serveHeartbeats = true;
   auto storage = this->initStorage(this->testStruct);
@@ -1048,6 +1105,31 @@ TYPED_TEST(SubscribableStorageTests, ApplyPatch) {
   EXPECT_EQ(*memberStruct->max(), 1001);
 }
 
+TYPED_TEST(SubscribableStorageTests, GetAcrossPublish) {
+  auto constexpr isHybridStorage = TypeParam::hybridStorage;
+  // gets served from last published state see writes once published
+  auto storage = this->initStorage(this->testStruct);
+  storage.set(this->root.tx(), false);
+  EXPECT_EQ(storage.get(this->root.tx()).value(), true);
+  storage.publishCurrentState();
+  EXPECT_EQ(storage.get(this->root.tx()).value(), false);
+
+  // gets served from current state see writes right away, whether or not
+  // they were published
+  auto currentStorage =
+      NaivePeriodicSubscribableCowStorage<TestStruct, isHybridStorage>(
+          this->testStruct,
+          NaivePeriodicSubscribableStorageBase::StorageParams()
+              .setServeGetRequestsWithLastPublishedState(false));
+  EXPECT_EQ(currentStorage.get(this->root.tx()).value(), true);
+  currentStorage.set(this->root.tx(), false);
+  EXPECT_EQ(currentStorage.get(this->root.tx()).value(), false);
+  currentStorage.publishCurrentState();
+  EXPECT_EQ(currentStorage.get(this->root.tx()).value(), false);
+  currentStorage.set(this->root.tx(), true);
+  EXPECT_EQ(currentStorage.get(this->root.tx()).value(), true);
+}
+
 TYPED_TEST(SubscribableStorageTests, PatchInvalidDeltaPath) {
   auto storage = this->initStorage(this->testStruct);
   TestStructSimple newStruct;
@@ -0,0 +1,326 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/BinaryDynamic.h"
+
+#include <fmt/format.h>
+#include <folly/FileUtil.h>
+#include <folly/Varint.h>
+#include <folly/lang/Bits.h>
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr folly::StringPiece kMagic{"FBDY"};
+// bump on any incompatible change to the encoding
+constexpr uint32_t kVersion = 1;
+
+enum class Tag : uint8_t {
+  NULLT = 0,
+  FALSE = 1,
+  TRUE = 2,
+  INT64 = 3,
+  DOUBLE = 4,
+  STRING = 5,
+  ARRAY = 6,
+  OBJECT = 7,
+};
+
+template <typename T>
+void appendFixed(std::string& out, T value) {
+  value = folly::Endian::little(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendVarint(std::string& out, uint64_t value) {
+  uint8_t buf[folly::kMaxVarintLength64];
+  auto len = folly::encodeVarint(value, buf);
+  out.append(reinterpret_cast<const char*>(buf), len);
+}
+
+void appendTag(std::string& out, Tag tag) {
+  out.push_back(static_cast<char>(tag));
+}
+
+void encode(const folly::dynamic& value, std::string& out);
+
+// count and byte length of the elements, the length is filled in once known
+template <typename EncodeElementsFn>
+void encodeContainer(
+    std::string& out,
+    Tag tag,
+    size_t count,
+    EncodeElementsFn encodeElements) {
+  appendTag(out, tag);
+  appendVarint(out, count);
+  auto lengthPos = out.size();
+  appendFixed<uint32_t>(out, 0);
+  encodeElements();
+  auto length = out.size() - lengthPos - sizeof(uint32_t);
+  if (length > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error(
+        fmt::format("Value too large for binary dynamic: {}", length));
+  }
+  auto le = folly::Endian::little(static_cast<uint32_t>(length));
+  std::memcpy(&out[lengthPos], &le, sizeof(le));
+}
+
+void encode(const folly::dynamic& value, std::string& out) {
+  switch (value.type()) {
+    case folly::dynamic::NULLT:
+      appendTag(out, Tag::NULLT);
+      break;
+    case folly::dynamic::BOOL:
+      appendTag(out, value.getBool() ? Tag::TRUE : Tag::FALSE);
+      break;
+    case folly::dynamic::INT64:
+      appendTag(out, Tag::INT64);
+      appendVarint(out, folly::encodeZigZag(value.getInt()));
+      break;
+    case folly::dynamic::DOUBLE: {
+      appendTag(out, Tag::DOUBLE);
+      uint64_t bits;
+      auto dbl = value.getDouble();
+      std::memcpy(&bits, &dbl, sizeof(bits));
+      appendFixed(out, bits);
+      break;
+    }
+    case folly::dynamic::STRING: {
+      const auto& str = value.getString();
+      appendTag(out, Tag::STRING);
+      appendVarint(out, str.size());
+      out.append(str);
+      break;
+    }
+    case folly::dynamic::ARRAY:
+      encodeContainer(out, Tag::ARRAY, value.size(), [&value, &out]() {
+        for (const auto& elem : value) {
+          encode(elem, out);
+        }
+      });
+      break;
+    case folly::dynamic::OBJECT:
+      encodeContainer(out, Tag::OBJECT, value.size(), [&value, &out]() {
+        for (const auto& [key, elem] : value.items()) {
+          encode(key, out);
+          encode(elem, out);
+        }
+      });
+      break;
+  }
+}
+
+[[noreturn]] void truncated() {
+  throw std::runtime_error("Truncated binary dynamic");
+}
+
+Tag readTag(folly::ByteRange& in) {
+  if (in.empty()) {
+    truncated();
+  }
+  auto tag = in.front();
+  in.advance(1);
+  if (tag > static_cast<uint8_t>(Tag::OBJECT)) {
+    throw std::runtime_error(
+        fmt::format("Invalid binary dynamic type tag: {}", tag));
+  }
+  return static_cast<Tag>(tag);
+}
+
+uint64_t readVarint(folly::ByteRange& in) {
+  auto value = folly::tryDecodeVarint(in);
+  if (value.hasError()) {
+    truncated();
+  }
+  return value.value();
+}
+
+template <typename T>
+T readFixed(folly::ByteRange& in) {
+  if (in.size() < sizeof(T)) {
+    truncated();
+  }
+  T value;
+  std::memcpy(&value, in.data(), sizeof(T));
+  in.advance(sizeof(T));
+  return folly::Endian::little(value);
+}
+
+folly::ByteRange readBytes(folly::ByteRange& in, uint64_t len) {
+  if (in.size() < len) {
+    truncated();
+  }
+  auto bytes = in.subpiece(0, len);
+  in.advance(len);
+  return bytes;
+}
+
+// count and elements of an array or object
+std::pair<uint64_t, folly::ByteRange> readContainer(folly::ByteRange& in) {
+  auto count = readVarint(in);
+  auto length = readFixed<uint32_t>(in);
+  return {count, readBytes(in, length)};
+}
+
+void skip(folly::ByteRange& in) {
+  switch (readTag(in)) {
+    case Tag::NULLT:
+    case Tag::FALSE:
+    case Tag::TRUE:
+      break;
+    case Tag::INT64:
+      readVarint(in);
+      break;
+    case Tag::DOUBLE:
+      readBytes(in, sizeof(uint64_t));
+      break;
+    case Tag::STRING:
+      readBytes(in, readVarint(in));
+      break;
+    case Tag::ARRAY:
+    case Tag::OBJECT:
+      readContainer(in);
+      break;
+  }
+}
+
+folly::dynamic decode(folly::ByteRange& in) {
+  switch (readTag(in)) {
+    case Tag::NULLT:
+      return nullptr;
+    case Tag::FALSE:
+      return false;
+    case Tag::TRUE:
+      return true;
+    case Tag::INT64:
+      return folly::decodeZigZag(readVarint(in));
+    case Tag::DOUBLE: {
+      auto bits = readFixed<uint64_t>(in);
+      double dbl;
+      std::memcpy(&dbl, &bits, sizeof(dbl));
+      return dbl;
+    }
+    case Tag::STRING: {
+      auto str = readBytes(in, readVarint(in));
+      return std::string(reinterpret_cast<const char*>(str.data()), str.size());
+    }
+    case Tag::ARRAY: {
+      auto [count, elems] = readContainer(in);
+      folly::dynamic array = folly::dynamic::array;
+      array.reserve(count);
+      for (uint64_t i = 0; i < count; ++i) {
+        array.push_back(decode(elems));
+      }
+      return array;
+    }
+    case Tag::OBJECT: {
+      auto [count, elems] = readContainer(in);
+      folly::dynamic object = folly::dynamic::object;
+      object.reserve(count);
+      for (uint64_t i = 0; i < count; ++i) {
+        auto key = decode(elems);
+        object.insert(std::move(key), decode(elems));
+      }
+      return object;
+    }
+  }
+  folly::assume_unreachable();
+}
+} // namespace
+
+BinaryDynamicView::BinaryDynamicView(folly::ByteRange value)
+    : value_(value) {}
+
+bool BinaryDynamicView::isObject() const {
+  auto in = value_;
+  return readTag(in) == Tag::OBJECT;
+}
+
+bool BinaryDynamicView::isArray() const {
+  auto in = value_;
+  return readTag(in) == Tag::ARRAY;
+}
+
+size_t BinaryDynamicView::size() const {
+  auto in = value_;
+  auto tag = readTag(in);
+  if (tag != Tag::ARRAY && tag != Tag::OBJECT) {
+    throw std::runtime_error("Binary dynamic size() of a scalar");
+  }
+  return readVarint(in);
+}
+
+std::optional<BinaryDynamicView> BinaryDynamicView::find(
+    folly::StringPiece key) const {
+  auto in = value_;
+  if (readTag(in) != Tag::OBJECT) {
+    throw std::runtime_error("Binary dynamic find() on a non object");
+  }
+  auto [count, elems] = readContainer(in);
+  for (uint64_t i = 0; i < count; ++i) {
+    auto keyStart = elems;
+    if (readTag(elems) == Tag::STRING &&
+        folly::StringPiece(readBytes(elems, readVarint(elems))) == key) {
+      return BinaryDynamicView(elems);
+    }
+    // step over the key, then the value
+    elems = keyStart;
+    skip(elems);
+    skip(elems);
+  }
+  return std::nullopt;
+}
+
+folly::dynamic BinaryDynamicView::toDynamic() const {
+  auto in = value_;
+  return decode(in);
+}
+
+std::string toBinaryDynamic(const folly::dynamic& value) {
+  std::string out(kMagic.begin(), kMagic.end());
+  appendFixed(out, kVersion);
+  encode(value, out);
+  return out;
+}
+
+BinaryDynamicView binaryDynamicRoot(folly::ByteRange encoded) {
+  if (encoded.size() < kMagic.size() ||
+      folly::StringPiece(encoded.subpiece(0, kMagic.size())) != kMagic) {
+    throw std::runtime_error("Not a binary dynamic");
+  }
+  encoded.advance(kMagic.size());
+  auto version = readFixed<uint32_t>(encoded);
+  if (version != kVersion) {
+    throw std::runtime_error(fmt::format(
+        "Unsupported binary dynamic version {}, expected {}",
+        version,
+        kVersion));
+  }
+  return BinaryDynamicView(encoded);
+}
+
+folly::dynamic fromBinaryDynamic(folly::ByteRange encoded) {
+  return binaryDynamicRoot(encoded).toDynamic();
+}
+
+BinaryDynamicFile::BinaryDynamicFile(const std::string& fileName)
+    : mapping_(fileName.c_str()) {}
+
+void BinaryDynamicFile::write(
+    const std::string& fileName,
+    const folly::dynamic& value) {
+  folly::writeFileAtomic(fileName, toBinaryDynamic(value));
+}
+
+} // namespace facebook::fboss
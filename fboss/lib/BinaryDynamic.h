@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/json/dynamic.h>
+#include <folly/system/MemoryMapping.h>
+
+#include <optional>
+#include <string>
+
+namespace facebook::fboss {
+
+/*
+ * Compact binary encoding of folly::dynamic, used for state which is
+ * otherwise stored as JSON, such as the hw switch warm boot state.
+ *
+ * The encoding is a header (magic and format version) followed by the root
+ * value. Each value is a type tag followed by its payload: zigzag varint for
+ * integers, length prefixed bytes for strings, and for arrays and objects the
+ * element count and the byte length of the elements. The byte length lets a
+ * reader step over a value without decoding it, so a member of a large
+ * object can be looked up and decoded on its own, straight out of a memory
+ * mapped file.
+ */
+class BinaryDynamicView {
+ public:
+  explicit BinaryDynamicView(folly::ByteRange value);
+
+  bool isObject() const;
+  bool isArray() const;
+  // element count of an array or object
+  size_t size() const;
+
+  // member of an object with the given string key
+  std::optional<BinaryDynamicView> find(folly::StringPiece key) const;
+
+  folly::dynamic toDynamic() const;
+
+ private:
+  folly::ByteRange value_;
+};
+
+std::string toBinaryDynamic(const folly::dynamic& value);
+
+// root of an encoded buffer, after checking its header
+BinaryDynamicView binaryDynamicRoot(folly::ByteRange encoded);
+
+folly::dynamic fromBinaryDynamic(folly::ByteRange encoded);
+
+/*
+ * Binary encoded dynamic stored in a file, which is memory mapped rather
+ * than read so only the values looked up get paged in.
+ */
+class BinaryDynamicFile {
+ public:
+  explicit BinaryDynamicFile(const std::string& fileName);
+
+  BinaryDynamicView root() const {
+    return binaryDynamicRoot(mapping_.range());
+  }
+
+  // write atomically, as the file may be mapped by a reader
+  static void write(const std::string& fileName, const folly::dynamic& value);
+
+ private:
+  folly::MemoryMapping mapping_;
+};
+
+} // namespace facebook::fboss
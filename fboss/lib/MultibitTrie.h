@@ -0,0 +1,479 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "fboss/lib/RadixTree.h"
+
+namespace facebook::network {
+
+/*
+ * Path compressed multibit trie for longest prefix match lookups on full
+ * length addresses.
+ *
+ * Each node consumes one byte (stride of 8 bits) of the address. Prefixes
+ * whose length ends within a node's byte are stored on that node and
+ * expanded into a 256 entry table, so resolving a host address costs at
+ * most one table read per byte instead of one branch per bit as in
+ * RadixTree. Nodes which would hold neither prefixes nor more than one
+ * child are elided, a child records the key bytes (stem) leading to it and
+ * the stem is verified during lookup.
+ *
+ * Values are expected to be pointer like, a value initialized T denotes
+ * the absence of a prefix.
+ */
+template <typename IPADDRTYPE, typename T>
+class MultibitTrie {
+ public:
+  static constexpr uint8_t kStride = 8;
+  static constexpr size_t kSlots = 1 << kStride;
+  static constexpr size_t kKeyBytes = IPADDRTYPE::byteCount();
+
+  MultibitTrie() : root_(std::make_unique<Node>(0, nullptr)) {}
+
+  MultibitTrie(const MultibitTrie&) = delete;
+  MultibitTrie& operator=(const MultibitTrie&) = delete;
+  MultibitTrie(MultibitTrie&&) noexcept = default;
+  MultibitTrie& operator=(MultibitTrie&&) noexcept = default;
+
+  /*
+   * Insert or overwrite value for ipaddr/masklen. Returns true if a new
+   * prefix was added.
+   */
+  bool insert(const IPADDRTYPE& ipaddr, uint8_t masklen, T value) {
+    DCHECK(value != T{});
+    DCHECK_LE(masklen, IPADDRTYPE::bitCount());
+    if (masklen == 0) {
+      auto inserted = defaultValue_ == T{};
+      defaultValue_ = value;
+      size_ += inserted;
+      return inserted;
+    }
+    const auto* key = ipaddr.bytes();
+    auto node = findOrCreateNode(key, (masklen - 1) / kStride);
+    auto [index, first, last] = prefixSlots(key, masklen);
+    auto inserted = node->setPrefix(index, value);
+    node->updateSlots(first, last);
+    size_ += inserted;
+    return inserted;
+  }
+
+  // Erase ipaddr/masklen, returns true if the prefix was present
+  bool erase(const IPADDRTYPE& ipaddr, uint8_t masklen) {
+    DCHECK_LE(masklen, IPADDRTYPE::bitCount());
+    if (masklen == 0) {
+      auto erased = defaultValue_ != T{};
+      defaultValue_ = T{};
+      size_ -= erased;
+      return erased;
+    }
+    const auto* key = ipaddr.bytes();
+    auto node = findNode(key, (masklen - 1) / kStride);
+    if (!node) {
+      return false;
+    }
+    auto [index, first, last] = prefixSlots(key, masklen);
+    if (!node->erasePrefix(index)) {
+      return false;
+    }
+    node->updateSlots(first, last);
+    compact(node);
+    --size_;
+    return true;
+  }
+
+  // Longest prefix covering ipaddr, value initialized T if none does
+  T longestMatch(const IPADDRTYPE& ipaddr) const {
+    const auto* key = ipaddr.bytes();
+    auto match = defaultValue_;
+    const Node* node = root_.get();
+    uint8_t depth = 0;
+    while (node) {
+      if (!node->stemMatches(key, depth)) {
+        break;
+      }
+      auto byte = key[node->depth];
+      if (node->slots && (*node->slots)[byte] != T{}) {
+        match = (*node->slots)[byte];
+      }
+      if (!node->children) {
+        break;
+      }
+      depth = node->depth + 1;
+      node = (*node->children)[byte].get();
+    }
+    return match;
+  }
+
+  void clear() {
+    root_ = std::make_unique<Node>(0, nullptr);
+    defaultValue_ = T{};
+    size_ = 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  // Number of trie nodes, root included
+  size_t nodeCount() const {
+    return countNodes(root_.get());
+  }
+
+  // Bytes allocated by the trie, not counting allocator overhead
+  size_t memoryUsage() const {
+    return sizeof(*this) + nodeMemoryUsage(root_.get());
+  }
+
+ private:
+  struct Node {
+    Node(uint8_t depth, const uint8_t* key) : depth(depth) {
+      if (key) {
+        std::copy(key, key + depth, stem.begin());
+      }
+    }
+
+    bool stemMatches(const uint8_t* key, uint8_t from) const {
+      return from >= depth ||
+          std::memcmp(key + from, stem.data() + from, depth - from) == 0;
+    }
+
+    /*
+     * Prefixes rooted at this node are keyed as in a binary heap,
+     * (1 << bits) + value of the first bits of this node's byte.
+     */
+    T findPrefix(uint16_t index) const {
+      auto itr = std::lower_bound(
+          prefixes.begin(),
+          prefixes.end(),
+          index,
+          [](const auto& entry, uint16_t idx) { return entry.first < idx; });
+      return itr != prefixes.end() && itr->first == index ? itr->second : T{};
+    }
+
+    bool setPrefix(uint16_t index, T value) {
+      auto itr = std::lower_bound(
+          prefixes.begin(),
+          prefixes.end(),
+          index,
+          [](const auto& entry, uint16_t idx) { return entry.first < idx; });
+      if (itr != prefixes.end() && itr->first == index) {
+        itr->second = value;
+        return false;
+      }
+      prefixes.emplace(itr, index, value);
+      if (!slots) {
+        slots = std::make_unique<std::array<T, kSlots>>();
+      }
+      return true;
+    }
+
+    bool erasePrefix(uint16_t index) {
+      auto itr = std::lower_bound(
+          prefixes.begin(),
+          prefixes.end(),
+          index,
+          [](const auto& entry, uint16_t idx) { return entry.first < idx; });
+      if (itr == prefixes.end() || itr->first != index) {
+        return false;
+      }
+      prefixes.erase(itr);
+      return true;
+    }
+
+    // Recompute expanded table entries [first, last)
+    void updateSlots(size_t first, size_t last) {
+      if (prefixes.empty()) {
+        slots.reset();
+        prefixes.shrink_to_fit();
+        return;
+      }
+      for (auto byte = first; byte < last; ++byte) {
+        auto best = T{};
+        for (auto bits = kStride; bits > 0 && best == T{}; --bits) {
+          best = findPrefix((1 << bits) + (byte >> (kStride - bits)));
+        }
+        (*slots)[byte] = best;
+      }
+    }
+
+    std::unique_ptr<Node>& child(uint8_t byte) {
+      if (!children) {
+        children =
+            std::make_unique<std::array<std::unique_ptr<Node>, kSlots>>();
+      }
+      return (*children)[byte];
+    }
+
+    // Index of the key byte consumed by this node
+    uint8_t depth;
+    uint16_t numChildren{0};
+    Node* parent{nullptr};
+    // Key bytes [0, depth) on the path to this node
+    std::array<uint8_t, kKeyBytes> stem{};
+    std::vector<std::pair<uint16_t, T>> prefixes;
+    std::unique_ptr<std::array<T, kSlots>> slots;
+    std::unique_ptr<std::array<std::unique_ptr<Node>, kSlots>> children;
+  };
+
+  struct PrefixSlots {
+    uint16_t index;
+    size_t first;
+    size_t last;
+  };
+
+  static PrefixSlots prefixSlots(const uint8_t* key, uint8_t masklen) {
+    uint8_t depth = (masklen - 1) / kStride;
+    uint8_t bits = masklen - depth * kStride;
+    uint8_t value = key[depth] >> (kStride - bits);
+    size_t first = static_cast<size_t>(value) << (kStride - bits);
+    return {
+        static_cast<uint16_t>((1 << bits) + value),
+        first,
+        first + (size_t(1) << (kStride - bits))};
+  }
+
+  // Index of the first byte in [from, to) where key and stem differ
+  static uint8_t
+  mismatch(const uint8_t* key, const Node& node, uint8_t from, uint8_t to) {
+    while (from < to && key[from] == node.stem[from]) {
+      ++from;
+    }
+    return from;
+  }
+
+  Node* findNode(const uint8_t* key, uint8_t depth) const {
+    Node* node = root_.get();
+    uint8_t from = 0;
+    while (node && node->stemMatches(key, from)) {
+      if (node->depth >= depth) {
+        return node->depth == depth ? node : nullptr;
+      }
+      if (!node->children) {
+        return nullptr;
+      }
+      from = node->depth + 1;
+      node = (*node->children)[key[node->depth]].get();
+    }
+    return nullptr;
+  }
+
+  Node* findOrCreateNode(const uint8_t* key, uint8_t depth) {
+    Node* node = root_.get();
+    while (node->depth < depth) {
+      auto& slot = node->child(key[node->depth]);
+      if (!slot) {
+        slot = std::make_unique<Node>(depth, key);
+        slot->parent = node;
+        ++node->numChildren;
+        return slot.get();
+      }
+      Node* child = slot.get();
+      auto diverge = mismatch(
+          key, *child, node->depth + 1, std::min(child->depth, depth));
+      if (diverge == child->depth) {
+        node = child;
+        continue;
+      }
+      // Key leaves child's stem (or ends) above child, split the edge with
+      // a node at the divergence point.
+      auto split = std::make_unique<Node>(diverge, key);
+      split->parent = node;
+      child->parent = split.get();
+      split->child(child->stem[diverge]) = std::move(slot);
+      split->numChildren = 1;
+      slot = std::move(split);
+      node = slot.get();
+    }
+    return node;
+  }
+
+  /*
+   * Remove nodes left without prefixes and children, and splice out nodes
+   * without prefixes that have a single child.
+   */
+  void compact(Node* node) {
+    while (node != root_.get() && node->prefixes.empty() &&
+           node->numChildren <= 1) {
+      auto parent = node->parent;
+      auto& slot = (*parent->children)[node->stem[parent->depth]];
+      if (node->numChildren == 0) {
+        slot.reset();
+        if (--parent->numChildren == 0) {
+          parent->children.reset();
+        }
+        node = parent;
+        continue;
+      }
+      auto only = std::find_if(
+          node->children->begin(), node->children->end(), [](const auto& c) {
+            return c != nullptr;
+          });
+      auto survivor = std::move(*only);
+      survivor->parent = parent;
+      slot = std::move(survivor);
+      break;
+    }
+  }
+
+  static size_t countNodes(const Node* node) {
+    size_t count = 1;
+    if (node->children) {
+      for (const auto& child : *node->children) {
+        if (child) {
+          count += countNodes(child.get());
+        }
+      }
+    }
+    return count;
+  }
+
+  static size_t nodeMemoryUsage(const Node* node) {
+    size_t bytes = sizeof(Node) +
+        node->prefixes.capacity() * sizeof(std::pair<uint16_t, T>);
+    if (node->slots) {
+      bytes += sizeof(*node->slots);
+    }
+    if (node->children) {
+      bytes += sizeof(*node->children);
+      for (const auto& child : *node->children) {
+        if (child) {
+          bytes += nodeMemoryUsage(child.get());
+        }
+      }
+    }
+    return bytes;
+  }
+
+  std::unique_ptr<Node> root_;
+  T defaultValue_{};
+  size_t size_{0};
+};
+
+/*
+ * RadixTree which keeps a MultibitTrie of its value nodes in sync, used to
+ * speed up full length longest match lookups (e.g. nexthop resolution).
+ * The trie is maintained incrementally on insert/erase and is off by
+ * default, all other operations (including iteration) are served by the
+ * radix tree unchanged.
+ */
+template <typename IPADDRTYPE, typename T>
+class LpmCachedRadixTree : public RadixTree<IPADDRTYPE, T> {
+ public:
+  using Base = RadixTree<IPADDRTYPE, T>;
+  using TreeNode = typename Base::TreeNode;
+  using Iterator = typename Base::Iterator;
+  using ConstIterator = typename Base::ConstIterator;
+  using LpmCache = MultibitTrie<IPADDRTYPE, const TreeNode*>;
+
+  LpmCachedRadixTree() = default;
+  /* implicit */ LpmCachedRadixTree(Base&& tree) : Base(std::move(tree)) {}
+
+  LpmCachedRadixTree(LpmCachedRadixTree&& other) noexcept
+      : Base(std::move(other)), lpmCache_(std::move(other.lpmCache_)) {}
+
+  // Contents are moved, whether the lpm cache is enabled stays with this
+  LpmCachedRadixTree& operator=(LpmCachedRadixTree&& other) noexcept {
+    Base::operator=(std::move(other));
+    if (lpmCache_) {
+      if (other.lpmCache_) {
+        lpmCache_ = std::move(other.lpmCache_);
+      } else {
+        buildLpmCache();
+      }
+    }
+    other.lpmCache_.reset();
+    return *this;
+  }
+
+  void setLpmCacheEnabled(bool enabled) {
+    if (!enabled) {
+      lpmCache_.reset();
+    } else if (!lpmCache_) {
+      buildLpmCache();
+    }
+  }
+
+  bool lpmCacheEnabled() const {
+    return lpmCache_ != nullptr;
+  }
+
+  const LpmCache* lpmCache() const {
+    return lpmCache_.get();
+  }
+
+  template <typename VALUE>
+  std::pair<Iterator, bool>
+  insert(const IPADDRTYPE& ipaddr, uint8_t masklen, VALUE&& value) {
+    auto ret = Base::insert(ipaddr, masklen, std::forward<VALUE>(value));
+    if (ret.second && lpmCache_) {
+      lpmCache_->insert(
+          ret.first->ipAddress(), ret.first->masklen(), &*ret.first);
+    }
+    return ret;
+  }
+
+  bool erase(const IPADDRTYPE& ipaddr, uint8_t masklen) {
+    return erase(Base::exactMatch(ipaddr, masklen));
+  }
+
+  bool erase(Iterator itr) {
+    if (itr == this->end()) {
+      return false;
+    }
+    return erase(&(*itr));
+  }
+
+  bool erase(TreeNode* node) {
+    if (node && lpmCache_) {
+      lpmCache_->erase(node->ipAddress(), node->masklen());
+    }
+    return Base::erase(node);
+  }
+
+  void clear() {
+    Base::clear();
+    if (lpmCache_) {
+      lpmCache_->clear();
+    }
+  }
+
+  ConstIterator longestMatch(const IPADDRTYPE& ipaddr, uint8_t masklen) const {
+    if (lpmCache_ && masklen == IPADDRTYPE::bitCount()) {
+      return ConstIterator(lpmCache_->longestMatch(ipaddr));
+    }
+    return Base::longestMatch(ipaddr, masklen);
+  }
+
+  Iterator longestMatch(const IPADDRTYPE& ipaddr, uint8_t masklen) {
+    if (lpmCache_ && masklen == IPADDRTYPE::bitCount()) {
+      return Iterator(const_cast<TreeNode*>(lpmCache_->longestMatch(ipaddr)));
+    }
+    return Base::longestMatch(ipaddr, masklen);
+  }
+
+ private:
+  void buildLpmCache() {
+    lpmCache_ = std::make_unique<LpmCache>();
+    for (const auto& node : static_cast<const Base&>(*this)) {
+      lpmCache_->insert(node.ipAddress(), node.masklen(), &node);
+    }
+  }
+
+  std::unique_ptr<LpmCache> lpmCache_;
+};
+
+} // namespace facebook::network
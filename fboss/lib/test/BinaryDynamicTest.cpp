@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/BinaryDynamic.h"
+
+#include <folly/testing/TestUtil.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace facebook::fboss;
+
+namespace {
+folly::dynamic testValue() {
+  return folly::dynamic::object("null", nullptr)("bool", true)(
+      "int", -1234567890123)("double", 2.5)("string", "fboss")(
+      "array", folly::dynamic::array(1, "two", folly::dynamic::array()))(
+      "object",
+      folly::dynamic::object("nested", folly::dynamic::object("x", 1))(
+          "empty", folly::dynamic::object()));
+}
+
+folly::ByteRange range(const std::string& encoded) {
+  return folly::StringPiece(encoded);
+}
+} // namespace
+
+TEST(BinaryDynamic, roundTrip) {
+  auto value = testValue();
+  EXPECT_EQ(fromBinaryDynamic(range(toBinaryDynamic(value))), value);
+  for (const auto& scalar :
+       {folly::dynamic(nullptr),
+        folly::dynamic(false),
+        folly::dynamic(std::numeric_limits<int64_t>::min()),
+        folly::dynamic(""),
+        folly::dynamic(-0.5)}) {
+    EXPECT_EQ(fromBinaryDynamic(range(toBinaryDynamic(scalar))), scalar);
+  }
+}
+
+TEST(BinaryDynamic, find) {
+  auto encoded = toBinaryDynamic(testValue());
+  auto root = binaryDynamicRoot(range(encoded));
+  EXPECT_TRUE(root.isObject());
+  EXPECT_EQ(root.size(), testValue().size());
+  for (const auto& [key, value] : testValue().items()) {
+    auto member = root.find(key.getString());
+    ASSERT_TRUE(member.has_value());
+    EXPECT_EQ(member->toDynamic(), value);
+  }
+  EXPECT_FALSE(root.find("missing").has_value());
+
+  auto nested = root.find("object")->find("nested");
+  ASSERT_TRUE(nested.has_value());
+  EXPECT_EQ(nested->find("x")->toDynamic(), 1);
+  EXPECT_TRUE(root.find("array")->isArray());
+  EXPECT_EQ(root.find("array")->size(), 3);
+}
+
+TEST(BinaryDynamic, invalid) {
+  EXPECT_ANY_THROW(fromBinaryDynamic(range("{\"json\": 1}")));
+  auto encoded = toBinaryDynamic(testValue());
+  EXPECT_ANY_THROW(
+      fromBinaryDynamic(range(encoded.substr(0, encoded.size() - 1))));
+  auto badVersion = encoded;
+  badVersion[4] = 2;
+  EXPECT_ANY_THROW(fromBinaryDynamic(range(badVersion)));
+}
+
+TEST(BinaryDynamic, file) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto fileName = (tmpDir.path() / "state.bin").string();
+  BinaryDynamicFile::write(fileName, testValue());
+  BinaryDynamicFile file(fileName);
+  EXPECT_EQ(file.root().toDynamic(), testValue());
+  EXPECT_EQ(file.root().find("string")->toDynamic(), "fboss");
+}
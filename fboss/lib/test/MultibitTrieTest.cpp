@@ -0,0 +1,191 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <vector>
+
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include "common/base/Random.h"
+
+#include "fboss/lib/MultibitTrie.h"
+#include "fboss/lib/RadixTree.h"
+
+using namespace facebook::network;
+using folly::IPAddressV4;
+using folly::IPAddressV6;
+
+namespace {
+
+template <typename IPADDRTYPE>
+IPADDRTYPE randomAddress() {
+  typename IPADDRTYPE::ByteArray bytes;
+  for (auto& byte : bytes) {
+    byte = folly::Random::rand32(256);
+  }
+  return IPADDRTYPE(bytes);
+}
+
+/*
+ * Apply random inserts and erases to a plain RadixTree and an lpm cached
+ * one, verify host lookups agree after each round.
+ */
+template <typename IPADDRTYPE>
+void verifyAgainstRadixTree(int prefixCount, int lookupCount) {
+  RadixTree<IPADDRTYPE, int> reference;
+  LpmCachedRadixTree<IPADDRTYPE, int> cached;
+  cached.setLpmCacheEnabled(true);
+  std::vector<std::pair<IPADDRTYPE, uint8_t>> prefixes;
+
+  auto verify = [&]() {
+    ASSERT_EQ(reference.size(), cached.size());
+    ASSERT_EQ(cached.size(), cached.lpmCache()->size());
+    for (auto i = 0; i < lookupCount; ++i) {
+      auto addr = randomAddress<IPADDRTYPE>();
+      // Also probe hosts inside inserted prefixes so long matches are hit
+      if (!prefixes.empty() && i % 2) {
+        const auto& [network, mask] =
+            prefixes[folly::Random::rand32(prefixes.size())];
+        auto bytes = network.toByteArray();
+        auto hostMask = IPADDRTYPE::fetchMask(mask);
+        auto random = addr.toByteArray();
+        for (size_t b = 0; b < bytes.size(); ++b) {
+          bytes[b] |= random[b] & ~hostMask[b];
+        }
+        addr = IPADDRTYPE(bytes);
+      }
+      auto expected = reference.longestMatch(addr, IPADDRTYPE::bitCount());
+      auto actual = cached.longestMatch(addr, IPADDRTYPE::bitCount());
+      ASSERT_EQ(expected == reference.end(), actual == cached.end())
+          << addr.str();
+      if (expected != reference.end()) {
+        EXPECT_EQ(expected->ipAddress(), actual->ipAddress()) << addr.str();
+        EXPECT_EQ(expected->masklen(), actual->masklen()) << addr.str();
+        EXPECT_EQ(expected->value(), actual->value()) << addr.str();
+      }
+    }
+  };
+
+  for (auto i = 0; i < prefixCount; ++i) {
+    auto mask = folly::Random::rand32(IPADDRTYPE::bitCount() + 1);
+    auto network = randomAddress<IPADDRTYPE>().mask(mask);
+    if (reference.insert(network, mask, i).second) {
+      EXPECT_TRUE(cached.insert(network, mask, i).second);
+      prefixes.emplace_back(network, mask);
+    }
+  }
+  verify();
+
+  // Erase half the prefixes to exercise compaction
+  for (size_t i = 0; i < prefixes.size(); i += 2) {
+    const auto& [network, mask] = prefixes[i];
+    EXPECT_TRUE(reference.erase(network, mask));
+    EXPECT_TRUE(cached.erase(network, mask));
+  }
+  verify();
+
+  // Disabling and re-enabling rebuilds the cache from the tree
+  cached.setLpmCacheEnabled(false);
+  cached.setLpmCacheEnabled(true);
+  verify();
+
+  for (size_t i = 1; i < prefixes.size(); i += 2) {
+    const auto& [network, mask] = prefixes[i];
+    EXPECT_TRUE(cached.erase(network, mask));
+  }
+  EXPECT_EQ(0, cached.size());
+  EXPECT_EQ(1, cached.lpmCache()->nodeCount());
+}
+} // namespace
+
+TEST(MultibitTrie, LongestMatch4) {
+  MultibitTrie<IPAddressV4, const int*> trie;
+  int defaultRoute = 0, slash8 = 8, slash20 = 20, slash30 = 30, host = 32;
+  trie.insert(IPAddressV4("10.0.0.0"), 8, &slash8);
+  trie.insert(IPAddressV4("10.1.16.0"), 20, &slash20);
+  trie.insert(IPAddressV4("10.1.17.4"), 30, &slash30);
+  trie.insert(IPAddressV4("10.1.17.5"), 32, &host);
+  EXPECT_EQ(4, trie.size());
+
+  EXPECT_EQ(nullptr, trie.longestMatch(IPAddressV4("11.0.0.1")));
+  EXPECT_EQ(&slash8, trie.longestMatch(IPAddressV4("10.2.0.1")));
+  EXPECT_EQ(&slash20, trie.longestMatch(IPAddressV4("10.1.31.1")));
+  EXPECT_EQ(&slash30, trie.longestMatch(IPAddressV4("10.1.17.6")));
+  EXPECT_EQ(&host, trie.longestMatch(IPAddressV4("10.1.17.5")));
+
+  trie.insert(IPAddressV4("0.0.0.0"), 0, &defaultRoute);
+  EXPECT_EQ(&defaultRoute, trie.longestMatch(IPAddressV4("11.0.0.1")));
+
+  EXPECT_TRUE(trie.erase(IPAddressV4("10.1.17.5"), 32));
+  EXPECT_FALSE(trie.erase(IPAddressV4("10.1.17.5"), 32));
+  EXPECT_EQ(&slash30, trie.longestMatch(IPAddressV4("10.1.17.5")));
+  EXPECT_TRUE(trie.erase(IPAddressV4("10.1.16.0"), 20));
+  EXPECT_EQ(&slash8, trie.longestMatch(IPAddressV4("10.1.31.1")));
+  EXPECT_EQ(&slash30, trie.longestMatch(IPAddressV4("10.1.17.6")));
+  EXPECT_EQ(3, trie.size());
+}
+
+TEST(MultibitTrie, PathCompression6) {
+  MultibitTrie<IPAddressV6, const int*> trie;
+  int a = 1, b = 2, c = 3;
+  trie.insert(IPAddressV6("2401:db00:1:2::"), 64, &a);
+  // Root plus a single node holding byte 7, bytes 1-6 are compressed
+  EXPECT_EQ(2, trie.nodeCount());
+  trie.insert(IPAddressV6("2401:db00:1:3::"), 64, &b);
+  // Both /64s end in byte 7 and share the node
+  EXPECT_EQ(2, trie.nodeCount());
+  trie.insert(IPAddressV6("2401:db00:2::"), 48, &c);
+  // The /48 diverges in byte 5 which splits the compressed edge
+  EXPECT_EQ(3, trie.nodeCount());
+  EXPECT_EQ(&a, trie.longestMatch(IPAddressV6("2401:db00:1:2::1")));
+  EXPECT_EQ(&b, trie.longestMatch(IPAddressV6("2401:db00:1:3::1")));
+  EXPECT_EQ(&c, trie.longestMatch(IPAddressV6("2401:db00:2:5::1")));
+  EXPECT_EQ(nullptr, trie.longestMatch(IPAddressV6("2401:db00:3::1")));
+
+  // Split node is left with a single child and no prefixes, splice it out
+  EXPECT_TRUE(trie.erase(IPAddressV6("2401:db00:2::"), 48));
+  EXPECT_EQ(2, trie.nodeCount());
+  EXPECT_TRUE(trie.erase(IPAddressV6("2401:db00:1:2::"), 64));
+  EXPECT_EQ(2, trie.nodeCount());
+  EXPECT_EQ(nullptr, trie.longestMatch(IPAddressV6("2401:db00:1:2::1")));
+  EXPECT_EQ(&b, trie.longestMatch(IPAddressV6("2401:db00:1:3::1")));
+}
+
+TEST(MultibitTrie, MemoryUsage) {
+  MultibitTrie<IPAddressV4, const int*> trie;
+  int a = 1;
+  auto emptyUsage = trie.memoryUsage();
+  // A /24 ends in byte 2, and its node gets an expanded table of its own
+  trie.insert(IPAddressV4("10.1.2.0"), 24, &a);
+  EXPECT_GE(
+      trie.memoryUsage(),
+      emptyUsage + sizeof(std::array<const int*, 256>));
+  trie.clear();
+  EXPECT_EQ(emptyUsage, trie.memoryUsage());
+}
+
+TEST(LpmCachedRadixTree, MatchesRadixTree4) {
+  verifyAgainstRadixTree<IPAddressV4>(5000, 20000);
+}
+
+TEST(LpmCachedRadixTree, MatchesRadixTree6) {
+  verifyAgainstRadixTree<IPAddressV6>(5000, 20000);
+}
+
+TEST(LpmCachedRadixTree, MoveKeepsCacheSetting) {
+  LpmCachedRadixTree<IPAddressV4, int> cached;
+  cached.setLpmCacheEnabled(true);
+  LpmCachedRadixTree<IPAddressV4, int> plain;
+  plain.insert(IPAddressV4("10.0.0.0"), 8, 1);
+
+  cached = std::move(plain);
+  ASSERT_TRUE(cached.lpmCacheEnabled());
+  EXPECT_EQ(1, cached.lpmCache()->size());
+  auto itr = cached.longestMatch(IPAddressV4("10.1.1.1"), 32);
+  ASSERT_NE(itr, cached.end());
+  EXPECT_EQ(1, itr->value());
+
+  LpmCachedRadixTree<IPAddressV4, int> moved(std::move(cached));
+  EXPECT_TRUE(moved.lpmCacheEnabled());
+  EXPECT_EQ(1, moved.longestMatch(IPAddressV4("10.1.1.1"), 32)->value());
+}
@@ -3,10 +3,13 @@
 #include <folly/Benchmark.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <unistd.h>
+#include <fstream>
 #include <set>
 #include <vector>
 #include "common/base/Random.h"
 #include "common/init/Init.h"
+#include "fboss/lib/MultibitTrie.h"
 #include "fboss/lib/RadixTree.h"
 #include "fboss/lib/test/PyRadixWrapper.h"
 
@@ -36,8 +39,67 @@ set<Prefix6> insertSet6;
 set<Prefix6> eraseSet6;
 set<Prefix6> exactMatchSet6;
 set<Prefix6> longestMatchSet6;
+vector<IPAddressV4> hostLookups4;
+vector<IPAddressV6> hostLookups6;
 vector<int> valueSet;
 
+template <typename TREE>
+TREE makeLpmCachedTree() {
+  TREE tree;
+  tree.setLpmCacheEnabled(true);
+  return tree;
+}
+
+// Random host address within the given prefix
+template <typename IPADDRTYPE, typename PREFIX>
+IPADDRTYPE hostInPrefix(const PREFIX& pfx) {
+  auto bytes = pfx.ip.toByteArray();
+  auto mask = IPADDRTYPE::fetchMask(pfx.mask);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] |= folly::Random::rand32(256) & ~mask[i];
+  }
+  return IPADDRTYPE(bytes);
+}
+
+size_t residentBytes() {
+  size_t totalPages = 0, residentPages = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> totalPages >> residentPages;
+  return residentPages * sysconf(_SC_PAGESIZE);
+}
+
+template <typename TREE>
+void reportLpmCacheMemory(const std::string& /*name*/, const TREE& /*tree*/) {}
+
+// What the lpm cache costs on top of the radix tree
+template <typename IPADDRTYPE, typename T>
+void reportLpmCacheMemory(
+    const std::string& name,
+    const LpmCachedRadixTree<IPADDRTYPE, T>& tree) {
+  auto cacheBytes = tree.lpmCache()->memoryUsage();
+  LOG(INFO) << name << ": lpm cache uses " << cacheBytes / 1024 << " KB, "
+            << cacheBytes / tree.size() << " bytes per prefix";
+}
+
+/*
+ * Report growth in RSS from building a tree over all inserted prefixes.
+ * Allocator caching makes this an approximation, so run each tree type
+ * in a fresh scope and only compare the relative numbers.
+ */
+template <typename TREE, typename PREFIXES>
+void reportRss(const std::string& name, const PREFIXES& prefixes, TREE tree) {
+  auto before = residentBytes();
+  auto count = 0;
+  for (auto pfx : prefixes) {
+    tree.insert(pfx.ip, pfx.mask, valueSet[count++ % valueSet.size()]);
+  }
+  auto grown = residentBytes() - before;
+  LOG(INFO) << name << ": " << tree.size() << " prefixes, RSS grew by "
+            << grown / 1024 << " KB, " << grown / tree.size()
+            << " bytes per prefix";
+  reportLpmCacheMemory(name, tree);
+}
+
 // V4 Benchmarks
 template <typename TREE>
 void setupTree4(TREE& tree) {
@@ -117,6 +179,36 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch4) {
   }
 }
 
+BENCHMARK(RadixTreeInsertBaseline4) {
+  RadixTree<IPAddressV4, int> rtree;
+  setupTree4(rtree);
+}
+
+BENCHMARK_RELATIVE(LpmCachedRadixTreeInsert4) {
+  auto rtree = makeLpmCachedTree<LpmCachedRadixTree<IPAddressV4, int>>();
+  setupTree4(rtree);
+}
+
+BENCHMARK(RadixTreeHostLookup4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  for (const auto& addr : hostLookups4) {
+    folly::doNotOptimizeAway(rtree.longestMatch(addr, 32));
+  }
+}
+
+BENCHMARK_RELATIVE(LpmCachedRadixTreeHostLookup4) {
+  auto rtree = makeLpmCachedTree<LpmCachedRadixTree<IPAddressV4, int>>();
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  for (const auto& addr : hostLookups4) {
+    folly::doNotOptimizeAway(rtree.longestMatch(addr, 32));
+  }
+}
+
 // V6 benchmarks
 
 template <typename TREE>
@@ -197,6 +289,36 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch6) {
   }
 }
 
+BENCHMARK(RadixTreeInsertBaseline6) {
+  RadixTree<IPAddressV6, int> rtree;
+  setupTree6(rtree);
+}
+
+BENCHMARK_RELATIVE(LpmCachedRadixTreeInsert6) {
+  auto rtree = makeLpmCachedTree<LpmCachedRadixTree<IPAddressV6, int>>();
+  setupTree6(rtree);
+}
+
+BENCHMARK(RadixTreeHostLookup6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  for (const auto& addr : hostLookups6) {
+    folly::doNotOptimizeAway(rtree.longestMatch(addr, 128));
+  }
+}
+
+BENCHMARK_RELATIVE(LpmCachedRadixTreeHostLookup6) {
+  auto rtree = makeLpmCachedTree<LpmCachedRadixTree<IPAddressV6, int>>();
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  for (const auto& addr : hostLookups6) {
+    folly::doNotOptimizeAway(rtree.longestMatch(addr, 128));
+  }
+}
+
 } // namespace
 
 int main(int /*argc*/, char* /*argv*/[]) {
@@ -252,5 +374,22 @@ int main(int /*argc*/, char* /*argv*/[]) {
     auto newIp = pfx.ip.mask(newMask);
     longestMatchSet6.insert(Prefix6(newIp, newMask));
   }
+  for (const auto& pfx : exactMatchSet4) {
+    hostLookups4.push_back(hostInPrefix<IPAddressV4>(pfx));
+  }
+  for (const auto& pfx : exactMatchSet6) {
+    hostLookups6.push_back(hostInPrefix<IPAddressV6>(pfx));
+  }
   runBenchmarks();
+
+  reportRss("RadixTree4", insertSet4, RadixTree<IPAddressV4, int>());
+  reportRss(
+      "LpmCachedRadixTree4",
+      insertSet4,
+      makeLpmCachedTree<LpmCachedRadixTree<IPAddressV4, int>>());
+  reportRss("RadixTree6", insertSet6, RadixTree<IPAddressV6, int>());
+  reportRss(
+      "LpmCachedRadixTree6",
+      insertSet6,
+      makeLpmCachedTree<LpmCachedRadixTree<IPAddressV6, int>>());
 }
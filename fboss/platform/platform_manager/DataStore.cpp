@@ -5,13 +5,26 @@
 #include <fmt/format.h>
 #include <folly/logging/xlog.h>
 
+#include <mutex>
+
 namespace facebook::fboss::platform::platform_manager {
 
 DataStore::DataStore(const PlatformConfig& config) : platformConfig_(config) {}
 
+DataStore::DataStore(const DataStore& other)
+    : platformConfig_(other.platformConfig_) {
+  std::shared_lock lock(other.mutex_);
+  i2cBusNums_ = other.i2cBusNums_;
+  pciSubDevicePathToSysfsPath_ = other.pciSubDevicePathToSysfsPath_;
+  pciSubDevicePathToCharDevPath_ = other.pciSubDevicePathToCharDevPath_;
+  slotPathToPmUnitInfo = other.slotPathToPmUnitInfo;
+  eepromContents_ = other.eepromContents_;
+}
+
 uint16_t DataStore::getI2cBusNum(
     const std::optional<std::string>& slotPath,
     const std::string& pmUnitScopeBusName) const {
+  std::shared_lock lock(mutex_);
   auto it = i2cBusNums_.find(std::make_pair(std::nullopt, pmUnitScopeBusName));
   if (it != i2cBusNums_.end()) {
     return it->second;
@@ -30,6 +43,7 @@ void DataStore::updateI2cBusNum(
     const std::optional<std::string>& slotPath,
     const std::string& pmUnitScopeBusName,
     uint16_t busNum) {
+  std::unique_lock lock(mutex_);
   XLOG(INFO) << fmt::format(
       "Updating bus {} in {} to bus number {} (i2c-{})",
       pmUnitScopeBusName,
@@ -40,6 +54,7 @@ void DataStore::updateI2cBusNum(
 }
 
 PmUnitInfo DataStore::getPmUnitInfo(const std::string& slotPath) const {
+  std::shared_lock lock(mutex_);
   if (slotPathToPmUnitInfo.find(slotPath) != slotPathToPmUnitInfo.end()) {
     return slotPathToPmUnitInfo.at(slotPath);
   }
@@ -48,10 +63,12 @@ PmUnitInfo DataStore::getPmUnitInfo(const std::string& slotPath) const {
 }
 
 bool DataStore::hasPmUnit(const std::string& slotPath) const {
+  std::shared_lock lock(mutex_);
   return slotPathToPmUnitInfo.find(slotPath) != slotPathToPmUnitInfo.end();
 }
 
 std::string DataStore::getSysfsPath(const std::string& devicePath) const {
+  std::shared_lock lock(mutex_);
   auto itr = pciSubDevicePathToSysfsPath_.find(devicePath);
   if (itr != pciSubDevicePathToSysfsPath_.end()) {
     return itr->second;
@@ -63,17 +80,20 @@ std::string DataStore::getSysfsPath(const std::string& devicePath) const {
 void DataStore::updateSysfsPath(
     const std::string& devicePath,
     const std::string& sysfsPath) {
+  std::unique_lock lock(mutex_);
   XLOG(INFO) << fmt::format(
       "Updating SysfsPath for {} to {}", devicePath, sysfsPath);
   pciSubDevicePathToSysfsPath_[devicePath] = sysfsPath;
 }
 
 bool DataStore::hasSysfsPath(const std::string& devicePath) const {
+  std::shared_lock lock(mutex_);
   return pciSubDevicePathToSysfsPath_.find(devicePath) !=
       pciSubDevicePathToSysfsPath_.end();
 }
 
 std::string DataStore::getCharDevPath(const std::string& devicePath) const {
+  std::shared_lock lock(mutex_);
   auto itr = pciSubDevicePathToCharDevPath_.find(devicePath);
   if (itr != pciSubDevicePathToCharDevPath_.end()) {
     return itr->second;
@@ -85,6 +105,7 @@ std::string DataStore::getCharDevPath(const std::string& devicePath) const {
 void DataStore::updateCharDevPath(
     const std::string& devicePath,
     const std::string& charDevPath) {
+  std::unique_lock lock(mutex_);
   XLOG(INFO) << fmt::format(
       "Updating CharDevPath for {} to {}", devicePath, charDevPath);
   pciSubDevicePathToCharDevPath_[devicePath] = charDevPath;
@@ -93,6 +114,7 @@ void DataStore::updateCharDevPath(
 void DataStore::updatePmUnitName(
     const std::string& slotPath,
     const std::string& name) {
+  std::unique_lock lock(mutex_);
   slotPathToPmUnitInfo[slotPath].name() = name;
   XLOG(INFO) << fmt::format(
       "At SlotPath {}, updating to PmUnit with name: {}", slotPath, name);
@@ -101,6 +123,7 @@ void DataStore::updatePmUnitName(
 void DataStore::updatePmUnitVersion(
     const std::string& slotPath,
     const PmUnitVersion& version) {
+  std::unique_lock lock(mutex_);
   slotPathToPmUnitInfo[slotPath].version() = version;
   XLOG(INFO) << fmt::format(
       "At SlotPath {}, updating to PmUnit `{}` with {}",
@@ -116,16 +139,19 @@ void DataStore::updatePmUnitVersion(
 void DataStore::updatePmUnitSuccessfullyExplored(
     const std::string& slotPath,
     bool successfullyExplored) {
+  std::unique_lock lock(mutex_);
   slotPathToPmUnitInfo[slotPath].successfullyExplored() = successfullyExplored;
 }
 
 void DataStore::updatePmUnitPresenceInfo(
     const std::string& slotPath,
     const PresenceInfo& presenceInfo) {
+  std::unique_lock lock(mutex_);
   slotPathToPmUnitInfo[slotPath].presenceInfo() = presenceInfo;
 }
 
 PmUnitConfig DataStore::resolvePmUnitConfig(const std::string& slotPath) const {
+  std::shared_lock lock(mutex_);
   if (slotPathToPmUnitInfo.find(slotPath) == slotPathToPmUnitInfo.end()) {
     throw std::runtime_error(
         fmt::format("Unable to resolve PmUnitInfo for {}", slotPath));
@@ -167,6 +193,7 @@ PmUnitConfig DataStore::resolvePmUnitConfig(const std::string& slotPath) const {
 void DataStore::updateEepromContents(
     const std::string& devicePath,
     const FbossEepromInterface& contents) {
+  std::unique_lock lock(mutex_);
   XLOG(INFO) << fmt::format(
       "Updating EepromContents for DevicePath ({})", devicePath);
   eepromContents_.insert(std::make_pair(devicePath, contents));
@@ -174,7 +201,8 @@ void DataStore::updateEepromContents(
 
 FbossEepromInterface DataStore::getEepromContents(
     const std::string& devicePath) const {
-  if (!hasEepromContents(devicePath)) {
+  std::shared_lock lock(mutex_);
+  if (!eepromContents_.contains(devicePath)) {
     throw std::runtime_error(fmt::format(
         "Couldn't find EepromContents at DevicePath ({})", devicePath));
   }
@@ -182,10 +210,12 @@ FbossEepromInterface DataStore::getEepromContents(
 }
 
 bool DataStore::hasEepromContents(const std::string& devicePath) const {
+  std::shared_lock lock(mutex_);
   return eepromContents_.contains(devicePath);
 }
 
 std::map<std::string, PmUnitInfo> DataStore::getSlotPathToPmUnitInfo() const {
+  std::shared_lock lock(mutex_);
   return slotPathToPmUnitInfo;
 }
 } // namespace facebook::fboss::platform::platform_manager
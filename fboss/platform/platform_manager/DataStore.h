@@ -4,6 +4,7 @@
 
 #include <map>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_types.h"
@@ -11,9 +12,11 @@
 #include "fboss/platform/weutil/FbossEepromInterface.h"
 
 namespace facebook::fboss::platform::platform_manager {
+// Thread safe, exploration updates it from concurrent steps.
 class DataStore {
  public:
   explicit DataStore(const PlatformConfig& config);
+  DataStore(const DataStore& other);
   virtual ~DataStore() = default;
 
   // Get the kernel assigned I2C bus number for the given busName.
@@ -118,5 +121,7 @@ class DataStore {
   std::unordered_map<std::string, FbossEepromInterface> eepromContents_{};
 
   const PlatformConfig& platformConfig_;
+
+  mutable std::shared_mutex mutex_;
 };
 } // namespace facebook::fboss::platform::platform_manager
@@ -0,0 +1,229 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/platform/platform_manager/ExplorationScheduler.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/ExceptionString.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss::platform::platform_manager {
+namespace {
+// The step running on this thread, if any, to attribute the steps it adds to.
+thread_local const ExplorationScheduler* currentScheduler{nullptr};
+thread_local ExplorationScheduler::StepId currentStep{0};
+
+std::chrono::milliseconds toMs(ExplorationScheduler::Clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(d);
+}
+} // namespace
+
+ExplorationScheduler::ExplorationScheduler(size_t numThreads)
+    : depthFirst_(numThreads <= 1),
+      creationTime_(Clock::now()),
+      lastEndTime_(creationTime_),
+      executor_(std::make_unique<folly::CPUThreadPoolExecutor>(
+          std::max<size_t>(numThreads, 1),
+          std::make_shared<folly::NamedThreadFactory>("PlatformExplorer"))) {}
+
+ExplorationScheduler::~ExplorationScheduler() {
+  executor_->join();
+}
+
+ExplorationScheduler::StepId ExplorationScheduler::addStep(
+    std::string name,
+    const std::vector<StepId>& deps,
+    folly::Function<void()> fn) {
+  std::lock_guard lock(mutex_);
+  StepId id = steps_.size();
+  auto& step = steps_.emplace_back();
+  step.name = std::move(name);
+  step.fn = std::move(fn);
+  // A step added by a running step starts after it, and after any of its
+  // deps which are already done.
+  if (currentScheduler == this) {
+    step.predecessor = currentStep;
+  }
+  bool depFailed = false;
+  for (auto dep : deps) {
+    XCHECK_LT(dep, id) << "Step " << step.name << " depends on a later step";
+    auto& depStep = steps_[dep];
+    if (!depStep.done) {
+      step.numPendingDeps++;
+      depStep.dependents.push_back(id);
+      continue;
+    }
+    depFailed |= depStep.failed;
+    if (currentScheduler != this &&
+        (!step.predecessor ||
+         depStep.endTime > steps_[*step.predecessor].endTime)) {
+      step.predecessor = dep;
+    }
+  }
+  numPendingSteps_++;
+  if (depFailed) {
+    // Skipped along with its dependents once its pending deps are done.
+    step.failed = true;
+  }
+  if (step.numPendingDeps == 0) {
+    schedule(id);
+  }
+  return id;
+}
+
+void ExplorationScheduler::schedule(StepId id) {
+  auto& step = steps_[id];
+  step.readyTime = Clock::now();
+  if (step.failed) {
+    // A dep threw, skip this step. Done inline, with mutex_ already held.
+    XLOG(ERR) << "Skipping exploration step " << step.name
+              << " since a step it depends on failed";
+    step.startTime = step.endTime = step.readyTime;
+    step.done = true;
+    lastEndTime_ = step.endTime;
+    for (auto dependent : step.dependents) {
+      auto& dependentStep = steps_[dependent];
+      dependentStep.failed = true;
+      dependentStep.predecessor = id;
+      if (--dependentStep.numPendingDeps == 0) {
+        schedule(dependent);
+      }
+    }
+    if (--numPendingSteps_ == 0) {
+      allDone_.notify_all();
+    }
+    return;
+  }
+  if (depthFirst_) {
+    if (currentScheduler == this) {
+      ready_.insert(ready_.begin() + numReadiedByCurrentStep_++, id);
+    } else {
+      ready_.push_back(id);
+    }
+    executor_->add([this]() { runNext(); });
+    return;
+  }
+  executor_->add([this, id]() { run(id); });
+}
+
+void ExplorationScheduler::runNext() {
+  StepId id;
+  {
+    std::lock_guard lock(mutex_);
+    id = ready_.front();
+    ready_.pop_front();
+    numReadiedByCurrentStep_ = 0;
+  }
+  run(id);
+}
+
+void ExplorationScheduler::run(StepId id) {
+  folly::Function<void()> fn;
+  std::string name;
+  {
+    std::lock_guard lock(mutex_);
+    steps_[id].startTime = Clock::now();
+    fn = std::move(steps_[id].fn);
+    name = steps_[id].name;
+  }
+  currentScheduler = this;
+  currentStep = id;
+  bool failed = false;
+  try {
+    fn();
+  } catch (...) {
+    XLOG(ERR) << "Exploration step " << name << " failed: "
+              << folly::exceptionStr(std::current_exception());
+    failed = true;
+    std::lock_guard lock(mutex_);
+    if (!firstException_) {
+      firstException_ = std::current_exception();
+    }
+  }
+  // Still the current step, the steps it makes ready are its own.
+  finish(id, failed);
+  currentScheduler = nullptr;
+}
+
+void ExplorationScheduler::finish(StepId id, bool failed) {
+  std::lock_guard lock(mutex_);
+  auto& step = steps_[id];
+  step.endTime = Clock::now();
+  step.done = true;
+  step.failed = failed;
+  lastEndTime_ = step.endTime;
+  for (auto dependent : step.dependents) {
+    auto& dependentStep = steps_[dependent];
+    dependentStep.failed |= failed;
+    if (--dependentStep.numPendingDeps == 0) {
+      // The last dep to finish held this step back.
+      dependentStep.predecessor = id;
+      schedule(dependent);
+    }
+  }
+  if (--numPendingSteps_ == 0) {
+    allDone_.notify_all();
+  }
+}
+
+void ExplorationScheduler::wait() {
+  std::unique_lock lock(mutex_);
+  allDone_.wait(lock, [this]() { return numPendingSteps_ == 0; });
+  if (firstException_) {
+    std::rethrow_exception(firstException_);
+  }
+}
+
+std::vector<ExplorationScheduler::StepTiming>
+ExplorationScheduler::getCriticalPath() const {
+  std::lock_guard lock(mutex_);
+  std::optional<StepId> last;
+  for (StepId id = 0; id < steps_.size(); ++id) {
+    if (steps_[id].done &&
+        (!last || steps_[id].endTime > steps_[*last].endTime)) {
+      last = id;
+    }
+  }
+  std::vector<StepTiming> path;
+  for (auto id = last; id; id = steps_[*id].predecessor) {
+    const auto& step = steps_[*id];
+    path.push_back(StepTiming{
+        step.name,
+        toMs(step.startTime - creationTime_),
+        toMs(step.endTime - step.startTime),
+        toMs(step.startTime - step.readyTime)});
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+std::chrono::milliseconds ExplorationScheduler::getElapsedTime() const {
+  std::lock_guard lock(mutex_);
+  return toMs(lastEndTime_ - creationTime_);
+}
+
+std::string ExplorationScheduler::getCriticalPathReport() const {
+  auto path = getCriticalPath();
+  std::chrono::milliseconds total{0};
+  for (const auto& step : path) {
+    total += step.duration;
+  }
+  std::string report = fmt::format(
+      "Critical path of {} steps, {}ms running out of {}ms elapsed",
+      path.size(),
+      total.count(),
+      getElapsedTime().count());
+  for (const auto& step : path) {
+    report += fmt::format(
+        "\n  at {:>6}ms took {:>6}ms queued {:>4}ms {}",
+        step.start.count(),
+        step.duration.count(),
+        step.queued.count(),
+        step.name);
+  }
+  return report;
+}
+
+} // namespace facebook::fboss::platform::platform_manager
@@ -0,0 +1,107 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <folly/Function.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+namespace facebook::fboss::platform::platform_manager {
+
+// Runs the steps of platform exploration (PCI devices, I2C devices, slots..)
+// on a bounded thread pool, each step once all the steps it depends on are
+// done. Steps can add further steps while running, e.g. a slot adds the steps
+// of the PmUnit found in it.
+//
+// Steps are expected to handle their own errors. If a step throws anyway, the
+// steps depending on it are skipped and wait() rethrows the first exception.
+class ExplorationScheduler {
+ public:
+  using StepId = size_t;
+  using Clock = std::chrono::steady_clock;
+
+  struct StepTiming {
+    std::string name;
+    // Since the scheduler was created.
+    std::chrono::milliseconds start{};
+    std::chrono::milliseconds duration{};
+    // Between all its deps being done and starting, waiting for a thread.
+    std::chrono::milliseconds queued{};
+  };
+
+  // With numThreads of 1, steps run one at a time depth first: the steps made
+  // ready by a step, added by it or depending on it, run before the steps
+  // which were ready already. So PmUnits are explored in the same order as
+  // exploring them recursively would.
+  explicit ExplorationScheduler(size_t numThreads);
+  ~ExplorationScheduler();
+
+  // Add a step running fn once all deps are done. deps must be steps added
+  // before. Steps added while a step runs start no earlier than that step.
+  StepId addStep(
+      std::string name,
+      const std::vector<StepId>& deps,
+      folly::Function<void()> fn);
+
+  // Wait for all the steps, including the ones added meanwhile, to be done.
+  void wait();
+
+  // The chain of steps which ended last: the last step to finish, the step
+  // it waited for last, and so on. Callable once wait() returns.
+  std::vector<StepTiming> getCriticalPath() const;
+
+  // Until the last step finished.
+  std::chrono::milliseconds getElapsedTime() const;
+
+  // Human readable report of the critical path, one step per line.
+  std::string getCriticalPathReport() const;
+
+ private:
+  struct Step {
+    std::string name;
+    folly::Function<void()> fn;
+    size_t numPendingDeps{0};
+    std::vector<StepId> dependents;
+    // The step to blame for this step starting when it did: the dep which
+    // finished last, or the step which added this one.
+    std::optional<StepId> predecessor;
+    Clock::time_point readyTime;
+    Clock::time_point startTime;
+    Clock::time_point endTime;
+    bool done{false};
+    bool failed{false};
+  };
+
+  // Called with mutex_ held.
+  void schedule(StepId id);
+  // Runs the first of ready_, when depth first.
+  void runNext();
+  void run(StepId id);
+  void finish(StepId id, bool failed);
+
+  const bool depthFirst_;
+  const Clock::time_point creationTime_;
+  Clock::time_point lastEndTime_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  mutable std::mutex mutex_;
+  std::condition_variable allDone_;
+  // Stable references, steps are never removed.
+  std::deque<Step> steps_;
+  size_t numPendingSteps_{0};
+  // Steps ready to run in order, when depth first.
+  std::deque<StepId> ready_;
+  // Steps the running step made ready, which went in front of ready_.
+  size_t numReadiedByCurrentStep_{0};
+  std::exception_ptr firstException_;
+};
+
+} // namespace facebook::fboss::platform::platform_manager
@@ -26,7 +26,9 @@ void ExplorationSummary::addError(
   ExplorationError newError;
   newError.errorType() = toExplorationErrorTypeStr(errorType);
   newError.message() = message;
-  if (isDeviceExpectedToFail(devicePath)) {
+  bool expectedToFail = isDeviceExpectedToFail(devicePath);
+  std::lock_guard lock(mutex_);
+  if (expectedToFail) {
     devicePathToExpectedErrors_[devicePath].push_back(newError);
     nExpectedErrs_++;
   } else {
@@ -106,6 +108,7 @@ void ExplorationSummary::publishCounters(ExplorationStatus finalStatus) {
 }
 
 ExplorationStatus ExplorationSummary::summarize() {
+  std::lock_guard lock(mutex_);
   ExplorationStatus finalStatus = ExplorationStatus::FAILED;
   if (devicePathToErrors_.empty() && devicePathToExpectedErrors_.empty()) {
     finalStatus = ExplorationStatus::SUCCEEDED;
@@ -124,6 +127,7 @@ bool ExplorationSummary::isDeviceExpectedToFail(const std::string& devicePath) {
 
 std::unordered_map<std::string, std::vector<ExplorationError>>
 ExplorationSummary::getFailedDevices() {
+  std::lock_guard lock(mutex_);
   return devicePathToErrors_;
 }
 } // namespace facebook::fboss::platform::platform_manager
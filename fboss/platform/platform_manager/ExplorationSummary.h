@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -119,6 +120,8 @@ class ExplorationSummary {
  private:
   const PlatformConfig& platformConfig_;
   const DataStore& dataStore_;
+  // Errors are added from concurrent exploration steps.
+  std::mutex mutex_;
   uint nExpectedErrs_{0}, nErrs_{0};
   std::unordered_map<std::string, std::vector<ExplorationError>>
       devicePathToErrors_{}, devicePathToExpectedErrors_{};
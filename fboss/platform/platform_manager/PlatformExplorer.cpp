@@ -7,10 +7,12 @@
 #include <filesystem>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include <fb303/ServiceData.h>
 #include <folly/FileUtil.h>
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 #include <re2/re2.h>
 
@@ -21,6 +23,12 @@
 #include "fboss/platform/weutil/FbossEepromParser.h"
 #include "fboss/platform/weutil/IoctlSmbusEepromReader.h"
 
+DEFINE_int32(
+    explorer_threads,
+    4,
+    "Number of threads exploring the platform. Independent devices and slots "
+    "are explored concurrently, each once the devices it depends on are.");
+
 namespace facebook::fboss::platform::platform_manager {
 namespace {
 constexpr auto kRootSlotPath = "/";
@@ -131,6 +139,15 @@ PlatformManagerStatus createPmStatus(
     const ExplorationStatus& explorationStatus) {
   return createPmStatus(explorationStatus, 0);
 }
+
+template <typename T>
+const std::string& getPmUnitScopedName(const T& pciSubDeviceConfig) {
+  if constexpr (std::is_same_v<T, FpgaIpBlockConfig>) {
+    return *pciSubDeviceConfig.pmUnitScopedName();
+  } else {
+    return *pciSubDeviceConfig.fpgaIpBlockConfig()->pmUnitScopedName();
+  }
+}
 } // namespace
 
 namespace constants = platform_manager_config_constants;
@@ -158,7 +175,26 @@ void PlatformExplorer::explore() {
   auto pmUnitName =
       getPmUnitNameFromSlot(*platformConfig_.rootSlotType(), kRootSlotPath);
   CHECK(pmUnitName == *platformConfig_.rootPmUnitName());
-  explorePmUnit(kRootSlotPath, *platformConfig_.rootPmUnitName());
+  // Before any step runs, so the ids don't depend on their order
+  assignFpgaInstanceIds(kRootSlotPath, *platformConfig_.rootPmUnitName(), {});
+  {
+    ExplorationScheduler scheduler(FLAGS_explorer_threads);
+    scheduler_ = &scheduler;
+    SCOPE_EXIT {
+      scheduler_ = nullptr;
+    };
+    scheduler.addStep(
+        fmt::format("Root PmUnit {}", *platformConfig_.rootPmUnitName()),
+        {},
+        [this]() {
+          explorePmUnit(kRootSlotPath, *platformConfig_.rootPmUnitName());
+        });
+    scheduler.wait();
+    XLOG(INFO) << fmt::format(
+        "Explored the PmUnits with {} threads. {}",
+        FLAGS_explorer_threads,
+        scheduler.getCriticalPathReport());
+  }
   XLOG(INFO) << "Creating symbolic links ...";
   for (const auto& [linkPath, devicePath] :
        *platformConfig_.symbolicLinkToDevicePath()) {
@@ -178,6 +214,7 @@ void PlatformExplorer::explore() {
 void PlatformExplorer::explorePmUnit(
     const std::string& slotPath,
     const std::string& pmUnitName) {
+  XCHECK(scheduler_) << "PmUnits are explored as part of explore()";
   auto pmUnitConfig = dataStore_.resolvePmUnitConfig(slotPath);
   XLOG(INFO) << fmt::format("Exploring PmUnit {} at {}", pmUnitName, slotPath);
   dataStore_.updatePmUnitSuccessfullyExplored(slotPath, false);
@@ -187,14 +224,19 @@ void PlatformExplorer::explorePmUnit(
       pmUnitName,
       slotPath,
       pmUnitConfig.pciDeviceConfigs()->size());
-  explorePciDevices(slotPath, *pmUnitConfig.pciDeviceConfigs());
+  auto deviceSteps =
+      explorePciDevices(slotPath, *pmUnitConfig.pciDeviceConfigs());
 
   XLOG(INFO) << fmt::format(
       "Exploring I2C Devices for PmUnit {} at SlotPath {}. Count {}",
       pmUnitName,
       slotPath,
       pmUnitConfig.i2cDeviceConfigs()->size());
-  exploreI2cDevices(slotPath, *pmUnitConfig.i2cDeviceConfigs());
+  // The PCI devices may provide the I2C buses, or set up the I2C devices, of
+  // the PmUnit. Explore the I2C devices once the PCI devices are done.
+  auto i2cSteps = exploreI2cDevices(
+      slotPath, *pmUnitConfig.i2cDeviceConfigs(), deviceSteps);
+  deviceSteps.insert(deviceSteps.end(), i2cSteps.begin(), i2cSteps.end());
 
   if (!pmUnitConfig.embeddedSensorConfigs()->empty()) {
     XLOG(INFO) << fmt::format(
@@ -210,17 +252,31 @@ void PlatformExplorer::explorePmUnit(
           *embeddedSensorConfig.sysfsPath());
     }
   }
-  dataStore_.updatePmUnitSuccessfullyExplored(slotPath, true);
 
-  XLOG(INFO) << fmt::format(
-      "Exploring Slots for PmUnit {} at SlotPath {}. Count {}",
-      pmUnitName,
-      slotPath,
-      pmUnitConfig.outgoingSlotConfigs()->size());
-  for (const auto& [slotName, slotConfig] :
-       *pmUnitConfig.outgoingSlotConfigs()) {
-    exploreSlot(slotPath, slotName, slotConfig);
-  }
+  // The slots of the PmUnit are explored, independently of each other, once
+  // all the devices of the PmUnit are.
+  scheduler_->addStep(
+      fmt::format("Devices of PmUnit {} at {}", pmUnitName, slotPath),
+      deviceSteps,
+      [this,
+       slotPath,
+       pmUnitName,
+       slotConfigs = *pmUnitConfig.outgoingSlotConfigs()]() {
+        dataStore_.updatePmUnitSuccessfullyExplored(slotPath, true);
+        XLOG(INFO) << fmt::format(
+            "Exploring Slots for PmUnit {} at SlotPath {}. Count {}",
+            pmUnitName,
+            slotPath,
+            slotConfigs.size());
+        for (const auto& [slotName, slotConfig] : slotConfigs) {
+          scheduler_->addStep(
+              fmt::format("Slot {}", getSlotPath(slotPath, slotName)),
+              {},
+              [this, slotPath, slotName = slotName, slotConfig = slotConfig]() {
+                exploreSlot(slotPath, slotName, slotConfig);
+              });
+        }
+      });
 }
 
 void PlatformExplorer::exploreSlot(
@@ -433,88 +489,156 @@ std::optional<std::string> PlatformExplorer::getPmUnitNameFromSlot(
   return pmUnitName;
 }
 
-void PlatformExplorer::exploreI2cDevices(
+std::vector<ExplorationScheduler::StepId> PlatformExplorer::exploreI2cDevices(
     const std::string& slotPath,
-    const std::vector<I2cDeviceConfig>& i2cDeviceConfigs) {
+    const std::vector<I2cDeviceConfig>& i2cDeviceConfigs,
+    const std::vector<ExplorationScheduler::StepId>& deps) {
+  std::vector<ExplorationScheduler::StepId> steps;
+  // Devices on the same bus are explored one after the other, in config
+  // order. Devices on different buses are explored concurrently.
+  std::map<std::string, ExplorationScheduler::StepId> lastStepOnBus;
+  // Steps of the muxes, by pmUnitScopedName. A mux channel bus is named
+  // <mux pmUnitScopedName>@<channel>.
+  std::map<std::string, ExplorationScheduler::StepId> muxSteps;
+  // Initializing registers may be needed by any of the later devices, which
+  // are explored once it is done.
+  std::optional<ExplorationScheduler::StepId> lastRegInitStep;
   for (const auto& i2cDeviceConfig : i2cDeviceConfigs) {
-    try {
-      auto busNum =
-          dataStore_.getI2cBusNum(slotPath, *i2cDeviceConfig.busName());
-      auto devAddr = I2cAddr(*i2cDeviceConfig.address());
-      auto devicePath = Utils().createDevicePath(
-          slotPath, *i2cDeviceConfig.pmUnitScopedName());
-      if (i2cDeviceConfig.initRegSettings()) {
-        setupI2cDevice(
-            devicePath, busNum, devAddr, *i2cDeviceConfig.initRegSettings());
-      }
-      createI2cDevice(
-          devicePath, *i2cDeviceConfig.kernelDeviceName(), busNum, devAddr);
-      if (i2cDeviceConfig.numOutgoingChannels()) {
-        auto channelToBusNums =
-            i2cExplorer_.getMuxChannelI2CBuses(busNum, devAddr);
-        if (channelToBusNums.size() != *i2cDeviceConfig.numOutgoingChannels()) {
-          throw std::runtime_error(fmt::format(
-              "Unexpected number mux channels for {}. Expected: {}. Actual: {}",
-              *i2cDeviceConfig.pmUnitScopedName(),
-              *i2cDeviceConfig.numOutgoingChannels(),
-              channelToBusNums.size()));
-        }
-        for (const auto& [channelNum, busNum] : channelToBusNums) {
-          dataStore_.updateI2cBusNum(
-              slotPath,
-              fmt::format(
-                  "{}@{}", *i2cDeviceConfig.pmUnitScopedName(), channelNum),
-              busNum);
-        }
-      }
-      if (*i2cDeviceConfig.isGpioChip()) {
-        auto i2cDevicePath = i2cExplorer_.getDeviceI2cPath(busNum, devAddr);
-        dataStore_.updateCharDevPath(
+    const auto& busName = *i2cDeviceConfig.busName();
+    auto stepDeps = deps;
+    if (auto it = lastStepOnBus.find(busName); it != lastStepOnBus.end()) {
+      stepDeps.push_back(it->second);
+    }
+    if (auto it = muxSteps.find(busName.substr(0, busName.rfind('@')));
+        it != muxSteps.end()) {
+      stepDeps.push_back(it->second);
+    }
+    if (lastRegInitStep) {
+      stepDeps.push_back(*lastRegInitStep);
+    }
+    if (i2cDeviceConfig.initRegSettings()) {
+      stepDeps.insert(stepDeps.end(), steps.begin(), steps.end());
+    }
+    auto step = scheduler_->addStep(
+        fmt::format(
+            "I2C device {}",
             Utils().createDevicePath(
-                slotPath, *i2cDeviceConfig.pmUnitScopedName()),
-            Utils().resolveGpioChipCharDevPath(i2cDevicePath));
+                slotPath, *i2cDeviceConfig.pmUnitScopedName())),
+        stepDeps,
+        [this, slotPath, i2cDeviceConfig]() {
+          exploreI2cDevice(slotPath, i2cDeviceConfig);
+        });
+    lastStepOnBus[busName] = step;
+    if (i2cDeviceConfig.numOutgoingChannels()) {
+      muxSteps[*i2cDeviceConfig.pmUnitScopedName()] = step;
+    }
+    if (i2cDeviceConfig.initRegSettings()) {
+      lastRegInitStep = step;
+    }
+    steps.push_back(step);
+  }
+  return steps;
+}
+
+void PlatformExplorer::exploreI2cDevice(
+    const std::string& slotPath,
+    const I2cDeviceConfig& i2cDeviceConfig) {
+  try {
+    auto busNum = dataStore_.getI2cBusNum(slotPath, *i2cDeviceConfig.busName());
+    auto devAddr = I2cAddr(*i2cDeviceConfig.address());
+    auto devicePath =
+        Utils().createDevicePath(slotPath, *i2cDeviceConfig.pmUnitScopedName());
+    if (i2cDeviceConfig.initRegSettings()) {
+      setupI2cDevice(
+          devicePath, busNum, devAddr, *i2cDeviceConfig.initRegSettings());
+    }
+    createI2cDevice(
+        devicePath, *i2cDeviceConfig.kernelDeviceName(), busNum, devAddr);
+    if (i2cDeviceConfig.numOutgoingChannels()) {
+      auto channelToBusNums =
+          i2cExplorer_.getMuxChannelI2CBuses(busNum, devAddr);
+      if (channelToBusNums.size() != *i2cDeviceConfig.numOutgoingChannels()) {
+        throw std::runtime_error(fmt::format(
+            "Unexpected number mux channels for {}. Expected: {}. Actual: {}",
+            *i2cDeviceConfig.pmUnitScopedName(),
+            *i2cDeviceConfig.numOutgoingChannels(),
+            channelToBusNums.size()));
       }
-      if (*i2cDeviceConfig.isWatchdog()) {
-        auto i2cDevicePath = i2cExplorer_.getDeviceI2cPath(busNum, devAddr);
-        dataStore_.updateCharDevPath(
-            Utils().createDevicePath(
-                slotPath, *i2cDeviceConfig.pmUnitScopedName()),
-            Utils().resolveWatchdogCharDevPath(i2cDevicePath));
+      for (const auto& [channelNum, busNum] : channelToBusNums) {
+        dataStore_.updateI2cBusNum(
+            slotPath,
+            fmt::format(
+                "{}@{}", *i2cDeviceConfig.pmUnitScopedName(), channelNum),
+            busNum);
       }
-    } catch (const std::exception& ex) {
-      auto errMsg = fmt::format(
-          "Failed to explore I2C device {} at {}. {}",
-          *i2cDeviceConfig.pmUnitScopedName(),
-          slotPath,
-          ex.what());
-      XLOG(ERR) << errMsg;
-      explorationSummary_.addError(
-          ExplorationErrorType::I2C_DEVICE_EXPLORE,
-          slotPath,
-          *i2cDeviceConfig.pmUnitScopedName(),
-          errMsg);
     }
+    if (*i2cDeviceConfig.isGpioChip()) {
+      auto i2cDevicePath = i2cExplorer_.getDeviceI2cPath(busNum, devAddr);
+      dataStore_.updateCharDevPath(
+          Utils().createDevicePath(
+              slotPath, *i2cDeviceConfig.pmUnitScopedName()),
+          Utils().resolveGpioChipCharDevPath(i2cDevicePath));
+    }
+    if (*i2cDeviceConfig.isWatchdog()) {
+      auto i2cDevicePath = i2cExplorer_.getDeviceI2cPath(busNum, devAddr);
+      dataStore_.updateCharDevPath(
+          Utils().createDevicePath(
+              slotPath, *i2cDeviceConfig.pmUnitScopedName()),
+          Utils().resolveWatchdogCharDevPath(i2cDevicePath));
+    }
+  } catch (const std::exception& ex) {
+    auto errMsg = fmt::format(
+        "Failed to explore I2C device {} at {}. {}",
+        *i2cDeviceConfig.pmUnitScopedName(),
+        slotPath,
+        ex.what());
+    XLOG(ERR) << errMsg;
+    explorationSummary_.addError(
+        ExplorationErrorType::I2C_DEVICE_EXPLORE,
+        slotPath,
+        *i2cDeviceConfig.pmUnitScopedName(),
+        errMsg);
   }
 }
 
-void PlatformExplorer::explorePciDevices(
+std::vector<ExplorationScheduler::StepId> PlatformExplorer::explorePciDevices(
     const std::string& slotPath,
     const std::vector<PciDeviceConfig>& pciDeviceConfigs) {
+  std::vector<ExplorationScheduler::StepId> steps;
   for (const auto& pciDeviceConfig : pciDeviceConfigs) {
-    auto pciDevice = PciDevice(pciDeviceConfig, platformFsUtils_);
+    // Instance ids are assigned to the sub-devices in config order, as if
+    // they were created one after the other.
     auto instId =
         getFpgaInstanceId(slotPath, *pciDeviceConfig.pmUnitScopedName());
-    auto pciDevicePath = Utils().createDevicePath(slotPath, pciDevice.name());
-    dataStore_.updateSysfsPath(pciDevicePath, pciDevice.sysfsPath());
-    dataStore_.updateCharDevPath(pciDevicePath, pciDevice.charDevPath());
+    // Set by the PCI device step, which the sub-device steps depend on.
+    auto pciDevice = std::make_shared<std::optional<PciDevice>>();
+    auto pciDeviceStep = scheduler_->addStep(
+        fmt::format(
+            "PCI device {}",
+            Utils().createDevicePath(
+                slotPath, *pciDeviceConfig.pmUnitScopedName())),
+        {},
+        [this, slotPath, pciDeviceConfig, pciDevice]() {
+          pciDevice->emplace(pciDeviceConfig, platformFsUtils_);
+          auto pciDevicePath =
+              Utils().createDevicePath(slotPath, (*pciDevice)->name());
+          dataStore_.updateSysfsPath(pciDevicePath, (*pciDevice)->sysfsPath());
+          dataStore_.updateCharDevPath(
+              pciDevicePath, (*pciDevice)->charDevPath());
+        });
+    steps.push_back(pciDeviceStep);
 
     createPciSubDevices(
         slotPath,
         *pciDeviceConfig.i2cAdapterConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_I2C_ADAPTER,
-        [&](const auto& i2cAdapterConfig) {
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, slotPath, pciDevice](
+            const auto& i2cAdapterConfig, uint32_t instanceId) {
           auto busNums = pciExplorer_.createI2cAdapter(
-              pciDevice, i2cAdapterConfig, instId++);
+              **pciDevice, i2cAdapterConfig, instanceId);
           if (*i2cAdapterConfig.numberOfAdapters() > 1) {
             CHECK_EQ(busNums.size(), *i2cAdapterConfig.numberOfAdapters());
             for (auto i = 0; i < busNums.size(); i++) {
@@ -538,9 +662,13 @@ void PlatformExplorer::explorePciDevices(
         slotPath,
         *pciDeviceConfig.spiMasterConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_SPI_MASTER,
-        [&](const auto& spiMasterConfig) {
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, slotPath, pciDevice](
+            const auto& spiMasterConfig, uint32_t instanceId) {
           auto spiCharDevPaths = pciExplorer_.createSpiMaster(
-              pciDevice, spiMasterConfig, instId++);
+              **pciDevice, spiMasterConfig, instanceId);
           for (const auto& [pmUnitScopedName, spiCharDevPath] :
                spiCharDevPaths) {
             dataStore_.updateCharDevPath(
@@ -552,9 +680,13 @@ void PlatformExplorer::explorePciDevices(
         slotPath,
         *pciDeviceConfig.gpioChipConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_GPIO_CHIP,
-        [&](const auto& gpioChipConfig) {
-          auto gpioCharDevPath =
-              pciExplorer_.createGpioChip(pciDevice, gpioChipConfig, instId++);
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, slotPath, pciDevice](
+            const auto& gpioChipConfig, uint32_t instanceId) {
+          auto gpioCharDevPath = pciExplorer_.createGpioChip(
+              **pciDevice, gpioChipConfig, instanceId);
           dataStore_.updateCharDevPath(
               Utils().createDevicePath(
                   slotPath, *gpioChipConfig.pmUnitScopedName()),
@@ -564,9 +696,13 @@ void PlatformExplorer::explorePciDevices(
         slotPath,
         *pciDeviceConfig.watchdogConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_WATCH_DOG,
-        [&](const auto& watchdogConfig) {
-          auto watchdogCharDevPath =
-              pciExplorer_.createWatchdog(pciDevice, watchdogConfig, instId++);
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, slotPath, pciDevice](
+            const auto& watchdogConfig, uint32_t instanceId) {
+          auto watchdogCharDevPath = pciExplorer_.createWatchdog(
+              **pciDevice, watchdogConfig, instanceId);
           dataStore_.updateCharDevPath(
               Utils().createDevicePath(
                   slotPath, *watchdogConfig.pmUnitScopedName()),
@@ -576,9 +712,13 @@ void PlatformExplorer::explorePciDevices(
         slotPath,
         *pciDeviceConfig.fanTachoPwmConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_FAN_CTRL,
-        [&](const auto& fanPwmCtrlConfig) {
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, slotPath, pciDevice](
+            const auto& fanPwmCtrlConfig, uint32_t instanceId) {
           auto fanCtrlSysfsPath = pciExplorer_.createFanPwmCtrl(
-              pciDevice, fanPwmCtrlConfig, instId++);
+              **pciDevice, fanPwmCtrlConfig, instanceId);
           dataStore_.updateSysfsPath(
               Utils().createDevicePath(
                   slotPath,
@@ -589,28 +729,39 @@ void PlatformExplorer::explorePciDevices(
         slotPath,
         *pciDeviceConfig.ledCtrlConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_LED_CTRL,
-        [&](const auto& ledCtrlConfig) {
-          pciExplorer_.createLedCtrl(pciDevice, ledCtrlConfig, instId++);
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, pciDevice](const auto& ledCtrlConfig, uint32_t instanceId) {
+          pciExplorer_.createLedCtrl(**pciDevice, ledCtrlConfig, instanceId);
         });
     createPciSubDevices(
         slotPath,
         *pciDeviceConfig.xcvrCtrlConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_XCVR_CTRL,
-        [&](const auto& xcvrCtrlConfig) {
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, slotPath, pciDevice](
+            const auto& xcvrCtrlConfig, uint32_t instanceId) {
           auto devicePath = Utils().createDevicePath(
               slotPath,
               *xcvrCtrlConfig.fpgaIpBlockConfig()->pmUnitScopedName());
-          auto xcvrCtrlSysfsPath =
-              pciExplorer_.createXcvrCtrl(pciDevice, xcvrCtrlConfig, instId++);
+          auto xcvrCtrlSysfsPath = pciExplorer_.createXcvrCtrl(
+              **pciDevice, xcvrCtrlConfig, instanceId);
           dataStore_.updateSysfsPath(devicePath, xcvrCtrlSysfsPath);
         });
     createPciSubDevices(
         slotPath,
         *pciDeviceConfig.infoRomConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_INFO_ROM,
-        [&](const auto& infoRomConfig) {
-          auto infoRomSysfsPath =
-              pciExplorer_.createInfoRom(pciDevice, infoRomConfig, instId++);
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, slotPath, pciDevice](
+            const auto& infoRomConfig, uint32_t instanceId) {
+          auto infoRomSysfsPath = pciExplorer_.createInfoRom(
+              **pciDevice, infoRomConfig, instanceId);
           dataStore_.updateSysfsPath(
               Utils().createDevicePath(
                   slotPath, *infoRomConfig.pmUnitScopedName()),
@@ -620,15 +771,56 @@ void PlatformExplorer::explorePciDevices(
         slotPath,
         *pciDeviceConfig.miscCtrlConfigs(),
         ExplorationErrorType::PCI_SUB_DEVICE_CREATE_MISC_CTRL,
-        [&](const auto& miscCtrlConfig) {
-          pciExplorer_.createFpgaIpBlock(pciDevice, miscCtrlConfig, instId++);
+        pciDeviceStep,
+        instId,
+        steps,
+        [this, pciDevice](const auto& miscCtrlConfig, uint32_t instanceId) {
+          pciExplorer_.createFpgaIpBlock(
+              **pciDevice, miscCtrlConfig, instanceId);
         });
   }
+  return steps;
+}
+
+void PlatformExplorer::assignFpgaInstanceIds(
+    const std::string& slotPath,
+    const std::string& pmUnitName,
+    std::set<std::string> pmUnitsAbove) {
+  pmUnitsAbove.insert(pmUnitName);
+  std::vector<const PmUnitConfig*> pmUnitConfigs;
+  if (auto it = platformConfig_.pmUnitConfigs()->find(pmUnitName);
+      it != platformConfig_.pmUnitConfigs()->end()) {
+    pmUnitConfigs.push_back(&it->second);
+  }
+  if (auto it = platformConfig_.versionedPmUnitConfigs()->find(pmUnitName);
+      it != platformConfig_.versionedPmUnitConfigs()->end()) {
+    for (const auto& versionedPmUnitConfig : it->second) {
+      pmUnitConfigs.push_back(&*versionedPmUnitConfig.pmUnitConfig());
+    }
+  }
+  for (const auto* pmUnitConfig : pmUnitConfigs) {
+    for (const auto& pciDeviceConfig : *pmUnitConfig->pciDeviceConfigs()) {
+      getFpgaInstanceId(slotPath, *pciDeviceConfig.pmUnitScopedName());
+    }
+    for (const auto& [slotName, slotConfig] :
+         *pmUnitConfig->outgoingSlotConfigs()) {
+      // any PmUnit that plugs into the slot may be found there
+      for (const auto& [childPmUnitName, childPmUnitConfig] :
+           *platformConfig_.pmUnitConfigs()) {
+        if (*childPmUnitConfig.pluggedInSlotType() == *slotConfig.slotType() &&
+            !pmUnitsAbove.contains(childPmUnitName)) {
+          assignFpgaInstanceIds(
+              getSlotPath(slotPath, slotName), childPmUnitName, pmUnitsAbove);
+        }
+      }
+    }
+  }
 }
 
 uint32_t PlatformExplorer::getFpgaInstanceId(
     const std::string& slotPath,
     const std::string& fpgaName) {
+  std::lock_guard lock(fpgaInstanceIdsMutex_);
   auto key = std::make_pair(slotPath, fpgaName);
   auto it = fpgaInstanceIds_.find(key);
   if (it == fpgaInstanceIds_.end()) {
@@ -876,20 +1068,36 @@ void PlatformExplorer::createPciSubDevices(
     const std::string& slotPath,
     const std::vector<T>& pciSubDeviceConfigs,
     ExplorationErrorType errorType,
+    ExplorationScheduler::StepId pciDeviceStep,
+    uint32_t& instId,
+    std::vector<ExplorationScheduler::StepId>& steps,
     auto&& deviceCreationLambda) {
   for (const auto& pciSubDeviceConfig : pciSubDeviceConfigs) {
-    try {
-      deviceCreationLambda(pciSubDeviceConfig);
-    } catch (PciSubDeviceRuntimeError& ex) {
-      auto errMsg = fmt::format(
-          "Failed to explore PCISubDevice {} at {}. Details: {}",
-          ex.getPmUnitScopedName(),
-          slotPath,
-          ex.what());
-      XLOG(ERR) << errMsg;
-      explorationSummary_.addError(
-          errorType, slotPath, ex.getPmUnitScopedName(), errMsg);
-    }
+    steps.push_back(scheduler_->addStep(
+        fmt::format(
+            "PCI sub-device {}",
+            Utils().createDevicePath(
+                slotPath, getPmUnitScopedName(pciSubDeviceConfig))),
+        {pciDeviceStep},
+        [this,
+         slotPath,
+         errorType,
+         pciSubDeviceConfig,
+         instanceId = instId++,
+         deviceCreationLambda]() {
+          try {
+            deviceCreationLambda(pciSubDeviceConfig, instanceId);
+          } catch (PciSubDeviceRuntimeError& ex) {
+            auto errMsg = fmt::format(
+                "Failed to explore PCISubDevice {} at {}. Details: {}",
+                ex.getPmUnitScopedName(),
+                slotPath,
+                ex.what());
+            XLOG(ERR) << errMsg;
+            explorationSummary_.addError(
+                errorType, slotPath, ex.getPmUnitScopedName(), errMsg);
+          }
+        }));
   }
 }
 
@@ -4,11 +4,16 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 
+#include <gflags/gflags.h>
+
 #include "fboss/platform/helpers/PlatformFsUtils.h"
 #include "fboss/platform/platform_manager/DataStore.h"
 #include "fboss/platform/platform_manager/DevicePathResolver.h"
+#include "fboss/platform/platform_manager/ExplorationScheduler.h"
 #include "fboss/platform/platform_manager/ExplorationSummary.h"
 #include "fboss/platform/platform_manager/I2cExplorer.h"
 #include "fboss/platform/platform_manager/PciExplorer.h"
@@ -16,6 +21,8 @@
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_types.h"
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_service_types.h"
 
+DECLARE_int32(explorer_threads);
+
 namespace facebook::fboss::platform::platform_manager {
 class PlatformExplorer {
  public:
@@ -46,10 +53,14 @@ class PlatformExplorer {
 
   virtual ~PlatformExplorer() = default;
 
-  // Explore the platform.
+  // Explore the platform. Devices and slots are explored on
+  // --explorer_threads threads, each once the devices it depends on are, and
+  // the critical path of the exploration is logged.
   void explore();
 
-  // Explore the PmUnit present at the given slotPath.
+  // Explore the PmUnit present at the given slotPath: its PCI devices, then
+  // its I2C devices, then its slots. Adds the exploration steps to the
+  // scheduler of the ongoing explore().
   void explorePmUnit(
       const std::string& slotPath,
       const std::string& pmUnitName);
@@ -67,16 +78,30 @@ class PlatformExplorer {
       const std::string& slotType,
       const std::string& slotPath);
 
-  // Explore the I2C devices in the PmUnit at the given SlotPath.
-  void exploreI2cDevices(
+  // Explore the I2C devices in the PmUnit at the given SlotPath, once the
+  // deps are done. Devices on the same bus are explored in config order, and
+  // after the mux providing the bus, if any. Returns the exploration steps.
+  std::vector<ExplorationScheduler::StepId> exploreI2cDevices(
       const std::string& slotPath,
-      const std::vector<I2cDeviceConfig>& i2cDeviceConfigs);
+      const std::vector<I2cDeviceConfig>& i2cDeviceConfigs,
+      const std::vector<ExplorationScheduler::StepId>& deps = {});
 
-  // Explore the PCI devices in the PmUnit at the given SlotPath.
-  void explorePciDevices(
+  // Explore the PCI devices in the PmUnit at the given SlotPath, each
+  // sub-device once its PCI device is. Returns the exploration steps.
+  std::vector<ExplorationScheduler::StepId> explorePciDevices(
       const std::string& slotPath,
       const std::vector<PciDeviceConfig>& pciDeviceConfigs);
 
+  // Assign the FPGA instance ids of the PmUnit at the given slotPath and of
+  // the PmUnits which may be plugged into its slots, in the order a depth
+  // first exploration of the config finds the FPGAs. Ids then neither depend
+  // on the order concurrent exploration steps run in, nor on which PmUnits
+  // are present.
+  void assignFpgaInstanceIds(
+      const std::string& slotPath,
+      const std::string& pmUnitName,
+      std::set<std::string> pmUnitsAbove);
+
   // Get the instance id base for the FPGA at the given slotPath and
   // PmUnitScopedName. The instance id base is unique for each fpga hardware
   // discovered in the platform.
@@ -121,11 +146,18 @@ class PlatformExplorer {
       const std::string& deviceName,
       uint16_t busNum,
       const I2cAddr& addr);
+  void exploreI2cDevice(
+      const std::string& slotPath,
+      const I2cDeviceConfig& i2cDeviceConfig);
+  // Adds a step per sub-device, depending on pciDeviceStep, to steps.
   template <typename T>
   void createPciSubDevices(
       const std::string& slotPath,
       const std::vector<T>& pciSubDeviceConfigs,
       ExplorationErrorType errorType,
+      ExplorationScheduler::StepId pciDeviceStep,
+      uint32_t& instId,
+      std::vector<ExplorationScheduler::StepId>& steps,
       auto&& deviceCreationLambda);
   void genHumanReadableEeproms();
 
@@ -136,6 +168,8 @@ class PlatformExplorer {
   DevicePathResolver devicePathResolver_;
   PresenceChecker presenceChecker_;
   std::shared_ptr<PlatformFsUtils> platformFsUtils_;
+  // Set while explore() runs.
+  ExplorationScheduler* scheduler_{nullptr};
 
   // Map from <pmUnitPath, pmUnitScopeBusName> to kernel i2c bus name.
   // - The pmUnitPath to the rootPmUnit is /. So a bus at root PmUnit will
@@ -149,6 +183,7 @@ class PlatformExplorer {
 
   // Map from <slotPath, PmUnitScopedName> to instance ids for FPGAs.
   std::map<std::pair<std::string, std::string>, uint32_t> fpgaInstanceIds_{};
+  std::mutex fpgaInstanceIdsMutex_;
 
   // Map from <SlotPath, GpioChipDeviceName> to gpio chip number.
   std::map<std::pair<std::string, std::string>, uint16_t> gpioChipNums_{};
@@ -0,0 +1,195 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "fboss/platform/platform_manager/ExplorationScheduler.h"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace facebook::fboss::platform::platform_manager {
+namespace {
+class OrderRecorder {
+ public:
+  folly::Function<void()> step(
+      std::string name,
+      std::chrono::milliseconds sleep = 0ms) {
+    return [this, name = std::move(name), sleep]() {
+      std::this_thread::sleep_for(sleep);
+      std::lock_guard lock(mutex_);
+      order_.push_back(name);
+    };
+  }
+
+  size_t position(const std::string& name) {
+    std::lock_guard lock(mutex_);
+    auto it = std::find(order_.begin(), order_.end(), name);
+    EXPECT_NE(it, order_.end()) << name << " did not run";
+    return it - order_.begin();
+  }
+
+  size_t size() {
+    std::lock_guard lock(mutex_);
+    return order_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::string> order_;
+};
+
+std::vector<std::string> names(
+    const std::vector<ExplorationScheduler::StepTiming>& path) {
+  std::vector<std::string> result;
+  for (const auto& step : path) {
+    result.push_back(step.name);
+  }
+  return result;
+}
+} // namespace
+
+TEST(ExplorationSchedulerTest, StepsRunAfterTheirDeps) {
+  OrderRecorder recorder;
+  ExplorationScheduler scheduler(4);
+  auto pci = scheduler.addStep("pci", {}, recorder.step("pci", 20ms));
+  auto mux = scheduler.addStep("mux", {pci}, recorder.step("mux", 10ms));
+  auto cpld = scheduler.addStep("cpld", {pci}, recorder.step("cpld"));
+  scheduler.addStep("slot", {mux, cpld}, recorder.step("slot"));
+  scheduler.addStep("other", {}, recorder.step("other"));
+  scheduler.wait();
+
+  EXPECT_EQ(recorder.size(), 5);
+  EXPECT_LT(recorder.position("pci"), recorder.position("mux"));
+  EXPECT_LT(recorder.position("pci"), recorder.position("cpld"));
+  EXPECT_LT(recorder.position("mux"), recorder.position("slot"));
+  EXPECT_LT(recorder.position("cpld"), recorder.position("slot"));
+  // Ran while pci was running
+  EXPECT_LT(recorder.position("other"), recorder.position("pci"));
+}
+
+TEST(ExplorationSchedulerTest, ConcurrencyIsBounded) {
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  ExplorationScheduler scheduler(3);
+  for (int i = 0; i < 9; i++) {
+    scheduler.addStep(fmt::format("step{}", i), {}, [&]() {
+      auto nowRunning = ++running;
+      auto prevMax = maxRunning.load();
+      while (nowRunning > prevMax &&
+             !maxRunning.compare_exchange_weak(prevMax, nowRunning)) {
+      }
+      std::this_thread::sleep_for(20ms);
+      --running;
+    });
+  }
+  scheduler.wait();
+  EXPECT_EQ(maxRunning.load(), 3);
+}
+
+TEST(ExplorationSchedulerTest, StepsAddedByRunningSteps) {
+  OrderRecorder recorder;
+  ExplorationScheduler scheduler(2);
+  scheduler.addStep("pmUnit", {}, [&]() {
+    std::this_thread::sleep_for(10ms);
+    // Slots found in the PmUnit
+    for (int i = 0; i < 3; i++) {
+      auto name = fmt::format("slot{}", i);
+      scheduler.addStep(name, {}, recorder.step(name, i * 20ms));
+    }
+  });
+  scheduler.addStep("fan", {}, recorder.step("fan"));
+  scheduler.wait();
+
+  EXPECT_EQ(recorder.size(), 4);
+  // The slowest slot, held back by the PmUnit it is in
+  EXPECT_EQ(
+      names(scheduler.getCriticalPath()),
+      std::vector<std::string>({"pmUnit", "slot2"}));
+  EXPECT_GE(scheduler.getElapsedTime(), 50ms);
+}
+
+TEST(ExplorationSchedulerTest, CriticalPathFollowsLastDep) {
+  OrderRecorder recorder;
+  ExplorationScheduler scheduler(4);
+  auto fastPci = scheduler.addStep("fastPci", {}, recorder.step("fastPci"));
+  auto slowPci =
+      scheduler.addStep("slowPci", {}, recorder.step("slowPci", 50ms));
+  scheduler.addStep("i2c", {fastPci, slowPci}, recorder.step("i2c", 10ms));
+  scheduler.addStep("sensor", {fastPci}, recorder.step("sensor"));
+  scheduler.wait();
+
+  auto path = scheduler.getCriticalPath();
+  EXPECT_EQ(names(path), std::vector<std::string>({"slowPci", "i2c"}));
+  EXPECT_GE(path[0].duration, 50ms);
+  EXPECT_GE(path[1].start, path[0].start + path[0].duration);
+  auto report = scheduler.getCriticalPathReport();
+  EXPECT_NE(report.find("slowPci"), std::string::npos);
+  EXPECT_EQ(report.find("sensor"), std::string::npos);
+}
+
+TEST(ExplorationSchedulerTest, FailedStepSkipsDependents) {
+  OrderRecorder recorder;
+  ExplorationScheduler scheduler(2);
+  auto pci = scheduler.addStep(
+      "pci", {}, []() { throw std::runtime_error("No PCI device"); });
+  auto subDevice =
+      scheduler.addStep("subDevice", {pci}, recorder.step("subDevice"));
+  scheduler.addStep("i2c", {subDevice}, recorder.step("i2c"));
+  scheduler.addStep("other", {}, recorder.step("other", 10ms));
+  EXPECT_THROW(scheduler.wait(), std::runtime_error);
+  EXPECT_EQ(recorder.size(), 1);
+  EXPECT_EQ(recorder.position("other"), 0);
+}
+
+TEST(ExplorationSchedulerTest, NonStdExceptionIsRethrown) {
+  OrderRecorder recorder;
+  ExplorationScheduler scheduler(2);
+  auto pci = scheduler.addStep("pci", {}, []() { throw 42; });
+  scheduler.addStep("subDevice", {pci}, recorder.step("subDevice"));
+  scheduler.addStep("other", {}, recorder.step("other"));
+  EXPECT_THROW(scheduler.wait(), int);
+  EXPECT_EQ(recorder.size(), 1);
+  EXPECT_EQ(recorder.position("other"), 0);
+}
+
+TEST(ExplorationSchedulerTest, SingleThreadRunsDepthFirst) {
+  OrderRecorder recorder;
+  ExplorationScheduler scheduler(1);
+  // A PmUnit with two slots, the PmUnit in the first slot having one more
+  scheduler.addStep("pmUnit", {}, [&]() {
+    scheduler.addStep("slot0", {}, [&]() {
+      auto fpga = scheduler.addStep("slot0/fpga", {}, recorder.step("fpga"));
+      scheduler.addStep("slot0/i2c", {fpga}, recorder.step("i2c"));
+      scheduler.addStep("slot0/slot0", {}, recorder.step("slot0/slot0"));
+    });
+    scheduler.addStep("slot1", {}, recorder.step("slot1"));
+  });
+  scheduler.addStep("fan", {}, recorder.step("fan"));
+  scheduler.wait();
+
+  EXPECT_EQ(recorder.size(), 5);
+  // Everything in slot0 before slot1, the FPGA's dependents included
+  EXPECT_EQ(recorder.position("fpga"), 0);
+  EXPECT_EQ(recorder.position("i2c"), 1);
+  EXPECT_EQ(recorder.position("slot0/slot0"), 2);
+  EXPECT_EQ(recorder.position("slot1"), 3);
+  EXPECT_EQ(recorder.position("fan"), 4);
+}
+
+TEST(ExplorationSchedulerTest, SingleThreadRunsInReadyOrder) {
+  OrderRecorder recorder;
+  ExplorationScheduler scheduler(1);
+  auto a = scheduler.addStep("a", {}, recorder.step("a"));
+  scheduler.addStep("b", {a}, recorder.step("b"));
+  scheduler.addStep("c", {}, recorder.step("c"));
+  scheduler.wait();
+  EXPECT_LT(recorder.position("a"), recorder.position("b"));
+  EXPECT_EQ(recorder.size(), 3);
+}
+} // namespace facebook::fboss::platform::platform_manager
@@ -93,4 +93,38 @@ TEST(PlatformExplorerTest, PublishFirmwareVersions) {
   expectVersions("NONE", PlatformExplorer::kFwVerErrorFileNotFound);
 }
 
+TEST(PlatformExplorerTest, FpgaInstanceIdsFollowConfigOrder) {
+  auto tmpDir = folly::test::TemporaryDirectory();
+  auto platformFsUtils =
+      std::make_shared<PlatformFsUtils>(tmpDir.path().string());
+  auto makePciDeviceConfig = [](const std::string& name) {
+    PciDeviceConfig pciDeviceConfig;
+    pciDeviceConfig.pmUnitScopedName() = name;
+    return pciDeviceConfig;
+  };
+  PlatformConfig platformConfig;
+  platformConfig.rootPmUnitName() = "MCB";
+  PmUnitConfig mcb;
+  mcb.pciDeviceConfigs() = {
+      makePciDeviceConfig("MCB_FPGA"), makePciDeviceConfig("MCB_IOB")};
+  SlotConfig pimSlot;
+  pimSlot.slotType() = "PIM_SLOT";
+  mcb.outgoingSlotConfigs()["PIM_SLOT@0"] = pimSlot;
+  mcb.outgoingSlotConfigs()["PIM_SLOT@1"] = pimSlot;
+  platformConfig.pmUnitConfigs()["MCB"] = mcb;
+  PmUnitConfig pim;
+  pim.pluggedInSlotType() = "PIM_SLOT";
+  pim.pciDeviceConfigs() = {makePciDeviceConfig("PIM_FPGA")};
+  platformConfig.pmUnitConfigs()["PIM"] = pim;
+
+  PlatformExplorer explorer(platformConfig, platformFsUtils);
+  explorer.assignFpgaInstanceIds("/", "MCB", {});
+  // the ids are fixed before exploring, whatever order the FPGAs are then
+  // explored in, and whether or not the PIMs are present
+  EXPECT_EQ(explorer.getFpgaInstanceId("/PIM_SLOT@1", "PIM_FPGA"), 4000);
+  EXPECT_EQ(explorer.getFpgaInstanceId("/", "MCB_IOB"), 2000);
+  EXPECT_EQ(explorer.getFpgaInstanceId("/PIM_SLOT@0", "PIM_FPGA"), 3000);
+  EXPECT_EQ(explorer.getFpgaInstanceId("/", "MCB_FPGA"), 1000);
+}
+
 } // namespace facebook::fboss::platform::platform_manager
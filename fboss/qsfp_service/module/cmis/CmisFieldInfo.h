@@ -45,6 +45,8 @@ enum FieldMasks : uint8_t {
   DATA_PATH_ID_BITSHIFT = 0x1,
   FWFAULT_MASK = 0x06,
   MODULE_STATE_CHANGED_MASK = 0x01,
+  // Byte 3 bit 0, cleared while the module interrupt is asserted
+  INTERRUPT_DEASSERTED_MASK = 0x01,
   UPPER_FOUR_BITS_MASK = 0xf0,
   LOWER_FOUR_BITS_MASK = 0x0f,
   VDM_SUPPORT_MASK = 0x40,
@@ -36,6 +36,20 @@ DEFINE_bool(
     false,
     "Flag to enable setting max FEC sampling for module");
 
+DEFINE_bool(
+    cmis_adaptive_refresh,
+    false,
+    "On partial refreshes, skip the static vendor info page, read the DOM and "
+    "VDM pages and the lane monitors every cmis_slow_pages_refresh_cycles, "
+    "and read the latched lane flags only when the module interrupt is "
+    "asserted");
+
+DEFINE_int32(
+    cmis_slow_pages_refresh_cycles,
+    5,
+    "With cmis_adaptive_refresh, partial refreshes between reads of the DOM "
+    "and VDM pages and the lane monitors");
+
 namespace {
 
 constexpr int kUsecBetweenPowerModeFlap = 100000;
@@ -47,6 +61,9 @@ constexpr int kUsecDatapathStateUpdateTime = 5000000; // 5 seconds
 constexpr int kUsecDatapathStatePollTime = 500000; // 500 ms
 constexpr double kU16TypeLsbDivisor = 256.0;
 constexpr int kVdmDescriptorLength = 2;
+// Page 11h bytes 134-152 hold the latched lane flags, starting with the data
+// path state changed flags
+constexpr int kPage11LatchedFlagsStart = 134;
 constexpr int kFR4LiteSMFLength = 500; // 500 meters
 
 // Definitions for CDB Histogram
@@ -494,6 +511,35 @@ void CmisModule::readCmisField(
       CAST_TO_INT(field));
 }
 
+void CmisModule::readCmisPageRange(
+    CmisField pageField,
+    uint8_t* pageData,
+    int begin,
+    int end,
+    bool skipPageChange) {
+  int dataLength, dataPage, dataOffset;
+  getQsfpFieldAddress(pageField, dataPage, dataOffset, dataLength);
+  CHECK_GE(begin, dataOffset);
+  CHECK_LT(begin, end);
+  CHECK_LE(end, dataOffset + dataLength);
+  if (static_cast<CmisPages>(dataPage) != CmisPages::LOWER && !flatMem_ &&
+      !skipPageChange) {
+    uint8_t page = static_cast<uint8_t>(dataPage);
+    qsfpImpl_->writeTransceiver(
+        {TransceiverAccessParameter::ADDR_QSFP,
+         127,
+         sizeof(page),
+         static_cast<int>(CmisPages::LOWER)},
+        &page,
+        POST_I2C_WRITE_DELAY_US,
+        CAST_TO_INT(CmisField::PAGE_CHANGE));
+  }
+  qsfpImpl_->readTransceiver(
+      {TransceiverAccessParameter::ADDR_QSFP, begin, end - begin, dataPage},
+      pageData + begin - dataOffset,
+      CAST_TO_INT(pageField));
+}
+
 void CmisModule::writeCmisField(
     CmisField field,
     uint8_t* data,
@@ -2039,15 +2085,32 @@ void CmisModule::updateQsfpData(bool allPages) {
     dirty_ = false;
     setQsfpFlatMem();
 
-    readCmisField(CmisField::PAGE_UPPER00H, page0_);
+    // Pages are either static (vendor info, advertisements, thresholds),
+    // slow changing (DOM, VDM and lane monitors) or fast changing (module and
+    // lane state, flags). Adaptive partial refreshes only read what may have
+    // changed since the last refresh
+    bool adaptive = FLAGS_cmis_adaptive_refresh && !allPages;
+    if (!adaptive) {
+      readCmisField(CmisField::PAGE_UPPER00H, page0_);
+    }
     if (!flatMem_) {
+      bool readSlowPages = true;
+      if (adaptive) {
+        uint32_t slowPagesCycles =
+            std::max(FLAGS_cmis_slow_pages_refresh_cycles, 1);
+        readSlowPages = ++partialRefreshCount_ % slowPagesCycles == 0;
+      }
       readCmisField(CmisField::PAGE_UPPER10H, page10_);
-      readCmisField(CmisField::PAGE_UPPER11H, page11_);
+      if (readSlowPages) {
+        readCmisField(CmisField::PAGE_UPPER11H, page11_);
+      } else {
+        readPage11LaneState();
+      }
 
       bool isReady =
           ((CmisModuleState)(getSettingsValue(CmisField::MODULE_STATE) >> 1) ==
            CmisModuleState::READY);
-      if (isReady) {
+      if (isReady && readSlowPages) {
         auto diagFeature = (uint8_t)DiagnosticFeatureEncoding::SNR;
         writeCmisField(CmisField::DIAG_SEL, &diagFeature);
         readCmisField(CmisField::PAGE_UPPER14H, page14_);
@@ -2086,6 +2149,53 @@ void CmisModule::updateQsfpData(bool allPages) {
   }
 }
 
+bool CmisModule::moduleInterruptAsserted() const {
+  // The interrupt is active low, and is asserted while any unmasked flag is
+  // latched
+  return getSettingsValue(
+             CmisField::MODULE_STATE, FieldMasks::INTERRUPT_DEASSERTED_MASK) ==
+      0;
+}
+
+void CmisModule::readPage11LaneState() {
+  // Everything but the lane monitors, which are left to slow cycles: the
+  // data path state and output status every cycle, the latched lane flags
+  // when the interrupt shows some are set, and the lane config status
+  int dataPage, monitorsBegin, monitorsEnd, dataLength;
+  getQsfpFieldAddress(
+      CmisField::CHANNEL_TX_PWR, dataPage, monitorsBegin, dataLength);
+  getQsfpFieldAddress(
+      CmisField::CHANNEL_RX_PWR, dataPage, monitorsEnd, dataLength);
+  monitorsEnd += dataLength;
+  bool readFlags = moduleInterruptAsserted();
+  if (!readFlags) {
+    clearCachedLaneFlags();
+  }
+  readCmisPageRange(
+      CmisField::PAGE_UPPER11H,
+      page11_,
+      MAX_QSFP_PAGE_SIZE,
+      readFlags ? monitorsBegin : kPage11LatchedFlagsStart);
+  readCmisPageRange(
+      CmisField::PAGE_UPPER11H,
+      page11_,
+      monitorsEnd,
+      2 * MAX_QSFP_PAGE_SIZE,
+      true /* skipPageChange */);
+}
+
+void CmisModule::clearCachedLaneFlags() {
+  // With the interrupt deasserted no lane flag latched since the last read
+  // of page 11h, which cleared them, so they read as clear
+  int dataPage, dataOffset, dataLength;
+  getQsfpFieldAddress(CmisField::RX_PWR_FLAG, dataPage, dataOffset, dataLength);
+  auto flagsEnd = dataOffset + dataLength;
+  std::fill(
+      page11_ + kPage11LatchedFlagsStart - MAX_QSFP_PAGE_SIZE,
+      page11_ + flagsEnd - MAX_QSFP_PAGE_SIZE,
+      0);
+}
+
 /*
  * setApplicationSelectCode
  *
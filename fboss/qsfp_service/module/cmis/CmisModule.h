@@ -9,8 +9,12 @@
 #include "fboss/lib/firmware_storage/FbossFirmware.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+#include <gflags/gflags.h>
 #include <optional>
 
+DECLARE_bool(cmis_adaptive_refresh);
+DECLARE_int32(cmis_slow_pages_refresh_cycles);
+
 namespace facebook {
 namespace fboss {
 
@@ -194,6 +198,8 @@ class CmisModule : public QsfpModule {
 
   // Some of the pages are static and they need not be read every refresh cycle
   bool staticPagesCached_{false};
+  // Partial refreshes, to read the slow changing pages every few of them
+  uint32_t partialRefreshCount_{0};
 
   /*
    * This function returns a pointer to the value in the static cached
@@ -514,6 +520,21 @@ class CmisModule : public QsfpModule {
   writeCmisField(CmisField field, uint8_t* data, bool skipPageChange = false);
 
   void getFieldValueLocked(CmisField fieldName, uint8_t* fieldValue) const;
+
+  // Reads bytes [begin, end) of a whole page field into its cached copy
+  void readCmisPageRange(
+      CmisField pageField,
+      uint8_t* pageData,
+      int begin,
+      int end,
+      bool skipPageChange = false);
+
+  // From the cached lower page
+  bool moduleInterruptAsserted() const;
+  // Read page 11h without its lane monitors
+  void readPage11LaneState();
+  // Clear the cached latched lane flags of page 11h, without reading it
+  void clearCachedLaneFlags();
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
    * extra fields that FB has vendors put in the 'Vendor specific'
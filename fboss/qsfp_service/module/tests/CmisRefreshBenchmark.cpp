@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Time and i2c bytes read per partial refresh cycle of a CMIS module, reading
+ * every dynamic page each cycle vs the adaptive refresh.
+ */
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
+#include "common/init/Init.h"
+#include "fboss/qsfp_service/module/cmis/CmisModule.h"
+#include "fboss/qsfp_service/module/tests/FakeTransceiverImpl.h"
+
+using namespace facebook::fboss;
+
+namespace {
+
+class RefreshCmisModule : public CmisModule {
+ public:
+  explicit RefreshCmisModule(TransceiverImpl* qsfpImpl)
+      : CmisModule({}, qsfpImpl, nullptr, false /*supportRemediate*/, "") {
+    present_ = true;
+    // as done when the module is detected
+    updateQsfpData(true);
+  }
+
+  void partialRefresh() {
+    updateQsfpData(false);
+  }
+};
+
+void cmisPartialRefresh(
+    folly::UserCounters& counters,
+    unsigned iters,
+    bool adaptive) {
+  folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  FLAGS_cmis_adaptive_refresh = adaptive;
+  // no transceiver manager, state machine events are not expected
+  Cmis400GLr4Transceiver qsfpImpl(0, nullptr);
+  RefreshCmisModule module(&qsfpImpl);
+  auto bytesRead = qsfpImpl.getBytesRead();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    module.partialRefresh();
+  }
+
+  suspender.rehire();
+  counters["i2c_bytes_per_cycle"] =
+      (qsfpImpl.getBytesRead() - bytesRead) / std::max(iters, 1u);
+}
+} // namespace
+
+BENCHMARK_COUNTERS(CmisPartialRefreshAllPages, counters, iters) {
+  cmisPartialRefresh(counters, iters, false /*adaptive*/);
+}
+
+BENCHMARK_COUNTERS(CmisPartialRefreshAdaptive, counters, iters) {
+  cmisPartialRefresh(counters, iters, true /*adaptive*/);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -45,6 +45,8 @@ class MockCmisModule : public CmisModule {
   MOCK_METHOD0(ensureTransceiverReadyLocked, bool());
 
   using CmisModule::getApplicationField;
+  using CmisModule::getSettingsValue;
+  using CmisModule::updateQsfpData;
 
  private:
   uint8_t moduleStateChangedReadTimes_{0};
@@ -1980,4 +1982,44 @@ TEST_F(CmisTest, cmis2x800GDr4TransceiverInfoTest) {
   EXPECT_TRUE(xcvr->isSnrSupported(phy::Side::LINE));
   EXPECT_TRUE(xcvr->isSnrSupported(phy::Side::SYSTEM));
 }
+
+TEST_F(CmisTest, adaptiveRefreshTest) {
+  gflags::FlagSaver flagSaver;
+  auto xcvrID = TransceiverID(1);
+  auto xcvr = overrideCmisModule<Cmis400GLr4Transceiver>(xcvrID);
+  auto qsfpImpl = static_cast<FakeTransceiverImpl*>(qsfpImpls_.back().get());
+  auto partialRefreshBytes = [xcvr, qsfpImpl]() {
+    auto bytesRead = qsfpImpl->getBytesRead();
+    xcvr->updateQsfpData(false);
+    return qsfpImpl->getBytesRead() - bytesRead;
+  };
+  auto partialBytes = partialRefreshBytes();
+
+  FLAGS_cmis_adaptive_refresh = true;
+  FLAGS_cmis_slow_pages_refresh_cycles = 2;
+  auto writePage11 = [qsfpImpl](int offset, uint8_t value) {
+    uint8_t page = 0x11;
+    qsfpImpl->writeTransceiver(
+        {TransceiverAccessParameter::ADDR_QSFP, 127, 1}, &page, 0, 0);
+    qsfpImpl->writeTransceiver(
+        {TransceiverAccessParameter::ADDR_QSFP, offset, 1}, &value, 0, 0);
+  };
+  // data path state of lanes 1-2 and tx power of lane 1
+  writePage11(128, 0x11);
+  writePage11(154, 0x12);
+  // The lower page, page 10h and page 11h without the latched lane flags,
+  // as the interrupt is deasserted, and without the lane monitors (bytes
+  // 134-201)
+  auto fastBytes = partialRefreshBytes();
+  EXPECT_EQ(fastBytes, 3 * QsfpModule::MAX_QSFP_PAGE_SIZE - (202 - 134));
+  EXPECT_EQ(xcvr->getSettingsValue(CmisField::DATA_PATH_STATE), 0x11);
+  EXPECT_NE(xcvr->getSettingsValue(CmisField::CHANNEL_TX_PWR), 0x12);
+  // Every other refresh also reads the DOM and VDM pages and the lane
+  // monitors, but never the static page 00h
+  auto slowBytes = partialRefreshBytes();
+  EXPECT_GT(slowBytes, fastBytes);
+  EXPECT_EQ(slowBytes, partialBytes - QsfpModule::MAX_QSFP_PAGE_SIZE);
+  EXPECT_EQ(xcvr->getSettingsValue(CmisField::CHANNEL_TX_PWR), 0x12);
+  EXPECT_EQ(partialRefreshBytes(), fastBytes);
+}
 } // namespace facebook::fboss
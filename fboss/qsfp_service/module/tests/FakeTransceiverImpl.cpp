@@ -57,6 +57,7 @@ int FakeTransceiverImpl::readTransceiver(
         fieldValue + read);
     read += len;
   }
+  bytesRead_ += read;
   return read;
 }
 
@@ -44,6 +44,11 @@ class FakeTransceiverImpl : public TransceiverImpl {
   void triggerQsfpHardReset() override;
   void updateTransceiverState(TransceiverStateMachineEvent event) override;
 
+  // Bytes read from the eeprom so far, i.e. the i2c bus load
+  uint64_t getBytesRead() const {
+    return bytesRead_;
+  }
+
  private:
   int module_{0};
   std::string moduleName_;
@@ -51,6 +56,7 @@ class FakeTransceiverImpl : public TransceiverImpl {
   std::map<uint8_t, std::map<int, std::array<uint8_t, 128>>> upperPages_;
   std::map<uint8_t, std::array<uint8_t, 128>> lowerPages_;
   TransceiverManager* tcvrManager_;
+  uint64_t bytesRead_{0};
 };
 
 class SffDacTransceiver : public FakeTransceiverImpl {
@@ -0,0 +1,591 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/small_vector.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::thrift_cow {
+
+/*
+ * Sorted map with structural sharing between copies, usable as storage of
+ * map nodes in place of std::map.
+ *
+ * Entries live in a B+tree whose nodes are held by shared_ptr. Copying the
+ * map only copies the root pointer, and a modification copies the nodes on
+ * the path to the modified entry that are shared with other copies, so
+ * cloning a map node and changing a single entry costs O(log n) node copies
+ * instead of copying all n entries.
+ *
+ * Differences from std::map:
+ *  - value_type is std::pair<K, V>, as with boost::container::flat_map
+ *  - iterators are forward only, and are invalidated by any modification
+ *  - mutable access (non-const find, at, begin, ...) unshares the nodes it
+ *    may hand out references into, all of them for non-const begin()
+ */
+class PersistentSortedMapTest;
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class PersistentSortedMap {
+  friend class PersistentSortedMapTest;
+  struct Node;
+  using NodePtr = std::shared_ptr<Node>;
+
+  // Position in a node, entry index for leaves and child index otherwise
+  struct Frame {
+    Node* node;
+    size_t index;
+  };
+
+  // Max entries of a leaf and children of an inner node. Nodes other than
+  // the root are kept at least half full.
+  static constexpr size_t kMaxFill = 32;
+  static constexpr size_t kMinFill = kMaxFill / 2;
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  template <bool Const>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = PersistentSortedMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<Const, const value_type&, value_type&>;
+    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+    Iterator() = default;
+
+    template <bool C = Const>
+    /* implicit */ Iterator(const Iterator<false>& other)
+      requires(C)
+        : path_(other.path_) {}
+
+    reference operator*() const {
+      const auto& frame = path_.back();
+      return frame.node->entries[frame.index];
+    }
+
+    pointer operator->() const {
+      return &**this;
+    }
+
+    Iterator& operator++() {
+      increment();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto tmp = *this;
+      increment();
+      return tmp;
+    }
+
+    template <bool C>
+    bool operator==(const Iterator<C>& other) const {
+      if (path_.empty() || other.path_.empty()) {
+        return path_.empty() == other.path_.empty();
+      }
+      return path_.back().node == other.path_.back().node &&
+          path_.back().index == other.path_.back().index;
+    }
+
+    template <bool C>
+    bool operator!=(const Iterator<C>& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class PersistentSortedMap;
+    template <bool>
+    friend class Iterator;
+
+    void descendLeftmost(Node* node) {
+      while (true) {
+        path_.push_back({node, 0});
+        if (node->leaf) {
+          return;
+        }
+        node = node->children.front().get();
+      }
+    }
+
+    void increment() {
+      if (++path_.back().index < path_.back().node->entries.size()) {
+        return;
+      }
+      path_.pop_back();
+      while (!path_.empty()) {
+        auto& frame = path_.back();
+        if (++frame.index < frame.node->children.size()) {
+          descendLeftmost(frame.node->children[frame.index].get());
+          return;
+        }
+        path_.pop_back();
+      }
+    }
+
+    // An empty path is the end iterator
+    folly::small_vector<Frame, 8> path_;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  PersistentSortedMap() = default;
+
+  explicit PersistentSortedMap(const Compare& comp) : comp_(comp) {}
+
+  PersistentSortedMap(std::initializer_list<value_type> entries) {
+    for (const auto& entry : entries) {
+      insert(entry);
+    }
+  }
+
+  PersistentSortedMap(const PersistentSortedMap&) = default;
+  PersistentSortedMap& operator=(const PersistentSortedMap&) = default;
+
+  PersistentSortedMap(PersistentSortedMap&& other) noexcept
+      : root_(std::move(other.root_)),
+        size_(std::exchange(other.size_, 0)),
+        comp_(std::move(other.comp_)) {}
+
+  PersistentSortedMap& operator=(PersistentSortedMap&& other) noexcept {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    comp_ = std::move(other.comp_);
+    return *this;
+  }
+
+  size_type size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  // iterators
+
+  const_iterator begin() const {
+    const_iterator it;
+    if (root_) {
+      it.descendLeftmost(root_.get());
+    }
+    return it;
+  }
+
+  iterator begin() {
+    if (root_) {
+      unshareAll(root_);
+    }
+    iterator it;
+    if (root_) {
+      it.descendLeftmost(root_.get());
+    }
+    return it;
+  }
+
+  const_iterator end() const {
+    return const_iterator();
+  }
+
+  iterator end() {
+    return iterator();
+  }
+
+  const_iterator cbegin() const {
+    return begin();
+  }
+
+  const_iterator cend() const {
+    return end();
+  }
+
+  // lookup
+
+  const_iterator find(const K& key) const {
+    const_iterator it;
+    if (!root_) {
+      return it;
+    }
+    Node* node = root_.get();
+    while (!node->leaf) {
+      auto index = childIndex(*node, key);
+      it.path_.push_back({node, index});
+      node = node->children[index].get();
+    }
+    auto pos = lowerBound(*node, key);
+    if (pos == node->entries.size() ||
+        comp_(key, node->entries[pos].first)) {
+      return const_iterator();
+    }
+    it.path_.push_back({node, pos});
+    return it;
+  }
+
+  iterator find(const K& key) {
+    if (std::as_const(*this).find(key) == cend()) {
+      return end();
+    }
+    // unshare the path to the entry, it may be modified through the iterator
+    iterator it;
+    NodePtr* nodePtr = &root_;
+    while (true) {
+      Node& node = unshare(*nodePtr);
+      if (node.leaf) {
+        it.path_.push_back({&node, lowerBound(node, key)});
+        return it;
+      }
+      auto index = childIndex(node, key);
+      it.path_.push_back({&node, index});
+      nodePtr = &node.children[index];
+    }
+  }
+
+  size_type count(const K& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  bool contains(const K& key) const {
+    return count(key) != 0;
+  }
+
+  const V& at(const K& key) const {
+    auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("PersistentSortedMap::at: key not found");
+    }
+    return it->second;
+  }
+
+  V& at(const K& key) {
+    auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("PersistentSortedMap::at: key not found");
+    }
+    return it->second;
+  }
+
+  V& operator[](const K& key) {
+    return try_emplace(key).first->second;
+  }
+
+  // modifiers
+
+  std::pair<iterator, bool> insert(const value_type& entry) {
+    return try_emplace(entry.first, entry.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& entry) {
+    return try_emplace(entry.first, std::move(entry.second));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type entry(std::forward<Args>(args)...);
+    return try_emplace(entry.first, std::move(entry.second));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator /* hint */, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    if (auto it = find(key); it != end()) {
+      return {it, false};
+    }
+    if (!root_) {
+      root_ = std::make_shared<Node>();
+    }
+    if (auto split =
+            insertInto(unshare(root_), key, std::forward<Args>(args)...)) {
+      auto newRoot = std::make_shared<Node>();
+      newRoot->leaf = false;
+      newRoot->children.push_back(std::move(root_));
+      newRoot->children.push_back(std::move(split));
+      newRoot->first = newRoot->children.front()->firstKey();
+      root_ = std::move(newRoot);
+    }
+    ++size_;
+    return {find(key), true};
+  }
+
+  size_type erase(const K& key) {
+    if (std::as_const(*this).find(key) == cend()) {
+      return 0;
+    }
+    eraseFrom(unshare(root_), key);
+    --size_;
+    if (root_->leaf && root_->entries.empty()) {
+      root_.reset();
+    }
+    while (root_ && !root_->leaf && root_->children.size() == 1) {
+      auto child = root_->children.front();
+      root_ = std::move(child);
+    }
+    return 1;
+  }
+
+  iterator erase(const_iterator pos) {
+    auto next = pos;
+    ++next;
+    std::optional<K> nextKey;
+    if (next != cend()) {
+      nextKey = next->first;
+    }
+    erase(K(pos->first));
+    return nextKey ? find(*nextKey) : end();
+  }
+
+  iterator erase(iterator pos) {
+    return erase(const_iterator(pos));
+  }
+
+  void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+  void swap(PersistentSortedMap& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+  }
+
+  bool operator==(const PersistentSortedMap& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    return root_ == other.root_ ||
+        std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  bool operator!=(const PersistentSortedMap& other) const {
+    return !(*this == other);
+  }
+
+  key_compare key_comp() const {
+    return comp_;
+  }
+
+ private:
+  struct Node {
+    bool leaf{true};
+    // leaf nodes only
+    std::vector<value_type> entries;
+    // inner nodes only, along with the first key in the subtree
+    std::vector<NodePtr> children;
+    K first{};
+
+    const K& firstKey() const {
+      return leaf ? entries.front().first : first;
+    }
+
+    size_t fill() const {
+      return leaf ? entries.size() : children.size();
+    }
+  };
+
+  // Makes node exclusively owned by this map, copying it if shared
+  static Node& unshare(NodePtr& node) {
+    if (node.use_count() != 1) {
+      node = std::make_shared<Node>(*node);
+    } else {
+      // pairs with the release of the last other owner
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *node;
+  }
+
+  static void unshareAll(NodePtr& node) {
+    auto& unshared = unshare(node);
+    for (auto& child : unshared.children) {
+      unshareAll(child);
+    }
+  }
+
+  bool equivalent(const K& lhs, const K& rhs) const {
+    return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+  }
+
+  // Index of the child of an inner node whose subtree may hold key
+  size_t childIndex(const Node& node, const K& key) const {
+    auto it = std::upper_bound(
+        node.children.begin() + 1,
+        node.children.end(),
+        key,
+        [this](const K& lhs, const NodePtr& child) {
+          return comp_(lhs, child->firstKey());
+        });
+    return std::distance(node.children.begin(), it) - 1;
+  }
+
+  // Index of the first entry of a leaf not less than key
+  size_t lowerBound(const Node& node, const K& key) const {
+    auto it = std::lower_bound(
+        node.entries.begin(),
+        node.entries.end(),
+        key,
+        [this](const value_type& entry, const K& rhs) {
+          return comp_(entry.first, rhs);
+        });
+    return std::distance(node.entries.begin(), it);
+  }
+
+  void updateFirst(Node& node) const {
+    if (!node.leaf &&
+        !equivalent(node.first, node.children.front()->firstKey())) {
+      node.first = node.children.front()->firstKey();
+    }
+  }
+
+  // Moves the upper half of a full node into a new right sibling
+  NodePtr split(Node& node) const {
+    auto right = std::make_shared<Node>();
+    right->leaf = node.leaf;
+    if (node.leaf) {
+      auto mid = node.entries.begin() + node.entries.size() / 2;
+      right->entries.assign(
+          std::make_move_iterator(mid),
+          std::make_move_iterator(node.entries.end()));
+      node.entries.erase(mid, node.entries.end());
+    } else {
+      auto mid = node.children.begin() + node.children.size() / 2;
+      right->children.assign(
+          std::make_move_iterator(mid),
+          std::make_move_iterator(node.children.end()));
+      node.children.erase(mid, node.children.end());
+      right->first = right->children.front()->firstKey();
+    }
+    return right;
+  }
+
+  // Inserts a key known to be missing into an unshared subtree. Returns the
+  // new right sibling of node if it had to be split.
+  template <typename... Args>
+  NodePtr insertInto(Node& node, const K& key, Args&&... args) {
+    if (node.leaf) {
+      node.entries.emplace(
+          node.entries.begin() + lowerBound(node, key),
+          std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    } else {
+      auto index = childIndex(node, key);
+      if (auto split = insertInto(
+              unshare(node.children[index]),
+              key,
+              std::forward<Args>(args)...)) {
+        node.children.insert(
+            node.children.begin() + index + 1, std::move(split));
+      }
+      if (index == 0) {
+        updateFirst(node);
+      }
+    }
+    return node.fill() > kMaxFill ? split(node) : nullptr;
+  }
+
+  // Erases a key known to be present from an unshared subtree
+  void eraseFrom(Node& node, const K& key) {
+    if (node.leaf) {
+      node.entries.erase(node.entries.begin() + lowerBound(node, key));
+      return;
+    }
+    auto index = childIndex(node, key);
+    eraseFrom(unshare(node.children[index]), key);
+    rebalance(node, index);
+    updateFirst(node);
+  }
+
+  // Merges or evens out an underfull child with a sibling
+  void rebalance(Node& parent, size_t index) {
+    if (parent.children[index]->fill() >= kMinFill ||
+        parent.children.size() < 2) {
+      return;
+    }
+    auto leftIndex = index == 0 ? 0 : index - 1;
+    auto& left = unshare(parent.children[leftIndex]);
+    auto& right = unshare(parent.children[leftIndex + 1]);
+    if (left.fill() + right.fill() <= kMaxFill) {
+      if (left.leaf) {
+        std::move(
+            right.entries.begin(),
+            right.entries.end(),
+            std::back_inserter(left.entries));
+      } else {
+        std::move(
+            right.children.begin(),
+            right.children.end(),
+            std::back_inserter(left.children));
+      }
+      updateFirst(left);
+      parent.children.erase(parent.children.begin() + leftIndex + 1);
+      return;
+    }
+    auto leftFill = (left.fill() + right.fill()) / 2;
+    if (left.leaf) {
+      moveBetween(left.entries, right.entries, leftFill);
+    } else {
+      moveBetween(left.children, right.children, leftFill);
+    }
+    updateFirst(left);
+    updateFirst(right);
+  }
+
+  // Moves elements across adjacent siblings so left holds leftFill of them
+  template <typename T>
+  static void
+  moveBetween(std::vector<T>& left, std::vector<T>& right, size_t leftFill) {
+    if (left.size() > leftFill) {
+      auto from = left.begin() + leftFill;
+      right.insert(
+          right.begin(),
+          std::make_move_iterator(from),
+          std::make_move_iterator(left.end()));
+      left.erase(from, left.end());
+    } else {
+      auto to = right.begin() + (leftFill - left.size());
+      left.insert(
+          left.end(),
+          std::make_move_iterator(right.begin()),
+          std::make_move_iterator(to));
+      right.erase(right.begin(), to);
+    }
+  }
+
+  NodePtr root_;
+  size_type size_{0};
+  Compare comp_;
+};
+
+} // namespace facebook::fboss::thrift_cow
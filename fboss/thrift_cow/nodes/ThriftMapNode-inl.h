@@ -17,6 +17,7 @@
 #include <thrift/lib/cpp2/reflection/reflection.h>
 #include "fboss/agent/state/NodeBase-defs.h"
 #include "fboss/thrift_cow/nodes/NodeUtils.h"
+#include "fboss/thrift_cow/nodes/PersistentSortedMap.h"
 #include "fboss/thrift_cow/nodes/Serializer.h"
 #include "fboss/thrift_cow/nodes/Types.h"
 
@@ -38,6 +39,23 @@ struct ExtractTypeClass<
   using value_type = ValueTypeClass;
 };
 
+// Container holding the children of a map node. std::map unless the traits
+// pick another one through a MapStorage<K, V> alias, e.g. PersistentSortedMap
+// for large maps that are cloned to change a handful of entries.
+template <typename Traits, typename K, typename V, typename = void>
+struct MapStorage {
+  using type = std::map<K, V, typename Traits::KeyCompare>;
+};
+
+template <typename Traits, typename K, typename V>
+struct MapStorage<
+    Traits,
+    K,
+    V,
+    std::void_t<typename Traits::template MapStorage<K, V>>> {
+  using type = typename Traits::template MapStorage<K, V>;
+};
+
 } // namespace map_helpers
 
 template <typename Traits>
@@ -56,8 +74,8 @@ struct ThriftMapFields : public FieldBaseType {
       template ConvertToNodeTraits<std::false_type, ValueTypeClass, ValueTType>;
   using key_type = typename TType::key_type;
   using value_type = typename ValueTraits::type;
-  using StorageType =
-      std::map<key_type, value_type, typename Traits::KeyCompare>;
+  using StorageType = typename map_helpers::
+      MapStorage<Traits, key_type, value_type>::type;
   using iterator = typename StorageType::iterator;
   using const_iterator = typename StorageType::const_iterator;
   using Tag = apache::thrift::type::map<
@@ -242,7 +260,9 @@ struct ThriftMapFields : public FieldBaseType {
   template <typename Fn>
   void forEachChild(Fn fn) {
     if constexpr (HasChildNodes) {
-      for (auto&& [key, value] : storage_) {
+      // const iteration, storage with structural sharing would otherwise
+      // unshare all of itself
+      for (auto&& [key, value] : std::as_const(storage_)) {
         fn(value.get());
       }
     }
@@ -0,0 +1,353 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/thrift_cow/nodes/PersistentSortedMap.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::thrift_cow {
+
+class PersistentSortedMapTest : public ::testing::Test {
+ protected:
+  using Map = PersistentSortedMap<int, int>;
+  using Node = Map::Node;
+  static constexpr size_t kMaxFill = Map::kMaxFill;
+  static constexpr size_t kMinFill = Map::kMinFill;
+
+  static Map fromRange(int begin, int end) {
+    Map map;
+    for (int key = begin; key < end; ++key) {
+      map.emplace(key, key);
+    }
+    return map;
+  }
+
+  static size_t height(const Map& map) {
+    size_t height = 0;
+    for (auto node = map.root_.get(); node;
+         node = node->leaf ? nullptr : node->children.front().get()) {
+      ++height;
+    }
+    return height;
+  }
+
+  static std::vector<size_t> leafFills(const Map& map) {
+    std::vector<size_t> fills;
+    if (map.root_) {
+      collectLeafFills(*map.root_, fills);
+    }
+    return fills;
+  }
+
+  static const Node* root(const Map& map) {
+    return map.root_.get();
+  }
+
+  // Checks the B+tree shape and that the map holds exactly expected
+  static void checkMap(const Map& map, const std::map<int, int>& expected) {
+    EXPECT_EQ(map.size(), expected.size());
+    EXPECT_EQ(map.empty(), expected.empty());
+    EXPECT_EQ(map.root_ == nullptr, expected.empty());
+    EXPECT_TRUE(std::equal(
+        map.begin(),
+        map.end(),
+        expected.begin(),
+        expected.end(),
+        [](const auto& entry, const auto& expectedEntry) {
+          return entry.first == expectedEntry.first &&
+              entry.second == expectedEntry.second;
+        }));
+    if (!map.root_) {
+      return;
+    }
+    if (!map.root_->leaf) {
+      EXPECT_GE(map.root_->children.size(), 2);
+    }
+    std::optional<size_t> leafDepth;
+    std::optional<int> prevKey;
+    size_t count = 0;
+    checkNode(*map.root_, true, 0, leafDepth, prevKey, count);
+    EXPECT_EQ(count, map.size());
+  }
+
+ private:
+  static void collectLeafFills(const Node& node, std::vector<size_t>& fills) {
+    if (node.leaf) {
+      fills.push_back(node.entries.size());
+      return;
+    }
+    for (const auto& child : node.children) {
+      collectLeafFills(*child, fills);
+    }
+  }
+
+  static void checkNode(
+      const Node& node,
+      bool isRoot,
+      size_t depth,
+      std::optional<size_t>& leafDepth,
+      std::optional<int>& prevKey,
+      size_t& count) {
+    EXPECT_LE(node.fill(), kMaxFill);
+    EXPECT_GE(node.fill(), isRoot ? 1 : kMinFill);
+    if (node.leaf) {
+      EXPECT_TRUE(node.children.empty());
+      if (!leafDepth) {
+        leafDepth = depth;
+      }
+      // all leaves are at the same depth
+      EXPECT_EQ(depth, *leafDepth);
+      for (const auto& [key, value] : node.entries) {
+        if (prevKey) {
+          EXPECT_LT(*prevKey, key);
+        }
+        prevKey = key;
+      }
+      count += node.entries.size();
+      return;
+    }
+    EXPECT_TRUE(node.entries.empty());
+    EXPECT_EQ(node.first, node.children.front()->firstKey());
+    for (const auto& child : node.children) {
+      checkNode(*child, false, depth + 1, leafDepth, prevKey, count);
+    }
+  }
+};
+
+TEST_F(PersistentSortedMapTest, RandomOpsMatchStdMap) {
+  std::mt19937 rng(0x5eed);
+  std::uniform_int_distribution<int> keyDist(0, 2000);
+  std::uniform_int_distribution<int> opDist(0, 9);
+
+  Map map;
+  std::map<int, int> expected;
+  // copies taken along the way, which must not see later changes
+  std::vector<std::pair<Map, std::map<int, int>>> snapshots;
+
+  for (int step = 0; step < 10000; ++step) {
+    auto key = keyDist(rng);
+    switch (opDist(rng)) {
+      case 0:
+      case 1:
+      case 2: {
+        auto [it, inserted] = map.emplace(key, step);
+        EXPECT_EQ(inserted, expected.emplace(key, step).second);
+        EXPECT_EQ(it->first, key);
+        EXPECT_EQ(it->second, expected.at(key));
+        break;
+      }
+      case 3:
+        map[key] = step;
+        expected[key] = step;
+        break;
+      case 4: {
+        auto it = map.find(key);
+        EXPECT_EQ(it == map.end(), !expected.count(key));
+        if (it != map.end()) {
+          it->second = -step;
+          expected[key] = -step;
+        }
+        break;
+      }
+      case 5: {
+        // erase by iterator returns the following entry
+        auto it = std::as_const(map).find(key);
+        if (it == map.cend()) {
+          break;
+        }
+        auto next = map.erase(it);
+        auto expectedNext = expected.erase(expected.find(key));
+        EXPECT_EQ(next == map.end(), expectedNext == expected.end());
+        if (next != map.end()) {
+          EXPECT_EQ(next->first, expectedNext->first);
+          EXPECT_EQ(next->second, expectedNext->second);
+        }
+        break;
+      }
+      default:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+        break;
+    }
+    checkMap(map, expected);
+    if (step % 500 == 0) {
+      snapshots.emplace_back(map, expected);
+    }
+  }
+
+  for (const auto& [snapshot, snapshotExpected] : snapshots) {
+    checkMap(snapshot, snapshotExpected);
+  }
+
+  // erase everything left, collapsing the tree down to an empty map
+  while (!expected.empty()) {
+    auto key = expected.begin()->first;
+    EXPECT_EQ(map.erase(key), 1);
+    expected.erase(key);
+    checkMap(map, expected);
+  }
+  EXPECT_EQ(height(map), 0);
+}
+
+TEST_F(PersistentSortedMapTest, CopiesAreIsolated) {
+  auto map = fromRange(0, 1000);
+  std::map<int, int> expected;
+  for (int key = 0; key < 1000; ++key) {
+    expected.emplace(key, key);
+  }
+  ASSERT_GE(height(map), 2);
+
+  auto copy = map;
+  EXPECT_EQ(root(copy), root(map));
+  EXPECT_EQ(copy, map);
+
+  // every way of modifying the copy leaves the original alone
+  copy.emplace(1000, 1000);
+  copy.erase(10);
+  copy[20] = -20;
+  copy.at(30) = -30;
+  copy.find(40)->second = -40;
+  copy.erase(std::as_const(copy).find(50));
+  checkMap(map, expected);
+  EXPECT_NE(copy, map);
+  EXPECT_EQ(copy.size(), 999);
+  EXPECT_EQ(copy.at(20), -20);
+  EXPECT_EQ(map.at(20), 20);
+
+  auto copy2 = map;
+  for (auto& [key, value] : copy2) {
+    value = -key;
+  }
+  checkMap(map, expected);
+  EXPECT_EQ(copy2.at(999), -999);
+
+  // and modifying the original leaves the copies alone
+  auto copy3 = map;
+  map.clear();
+  checkMap(map, {});
+  checkMap(copy3, expected);
+}
+
+TEST_F(PersistentSortedMapTest, LeafSplitAndMerge) {
+  auto map = fromRange(0, kMaxFill);
+  EXPECT_EQ(height(map), 1);
+  EXPECT_EQ(leafFills(map), std::vector<size_t>{kMaxFill});
+
+  // overflowing the root leaf splits it in halves under a new root
+  map.emplace(kMaxFill, kMaxFill);
+  EXPECT_EQ(height(map), 2);
+  EXPECT_EQ(
+      leafFills(map), (std::vector<size_t>{kMinFill, kMaxFill + 1 - kMinFill}));
+
+  // the left leaf underflows, and the two leaves fit in one, so they are
+  // merged and the root with a single child left collapses
+  auto copy = map;
+  map.erase(0);
+  EXPECT_EQ(height(map), 1);
+  EXPECT_EQ(leafFills(map), std::vector<size_t>{kMaxFill});
+  std::map<int, int> expected;
+  for (int key = 1; key <= static_cast<int>(kMaxFill); ++key) {
+    expected.emplace(key, key);
+  }
+  checkMap(map, expected);
+  expected.emplace(0, 0);
+  checkMap(copy, expected);
+}
+
+TEST_F(PersistentSortedMapTest, LeafBorrow) {
+  int maxFill = kMaxFill;
+  auto map = fromRange(0, maxFill + 1);
+  // grow the right leaf so the two leaves no longer fit in one
+  int extra = kMinFill / 2;
+  for (int key = maxFill + 1; key < maxFill + 1 + extra; ++key) {
+    map.emplace(key, key);
+  }
+  auto rightFill = kMaxFill + 1 - kMinFill + extra;
+  ASSERT_EQ(leafFills(map), (std::vector<size_t>{kMinFill, rightFill}));
+
+  // the underflowing left leaf borrows from the right one instead
+  map.erase(0);
+  auto total = kMinFill - 1 + rightFill;
+  EXPECT_EQ(height(map), 2);
+  EXPECT_EQ(
+      leafFills(map), (std::vector<size_t>{total / 2, total - total / 2}));
+  std::map<int, int> expected;
+  for (int key = 1; key < maxFill + 1 + extra; ++key) {
+    expected.emplace(key, key);
+  }
+  checkMap(map, expected);
+
+  // same from the right, the last leaf borrows from its left sibling once
+  // it underflows
+  auto leftFill = total / 2;
+  rightFill = total - leftFill;
+  int last = maxFill + extra;
+  for (int key = last; rightFill >= kMinFill; --key, --rightFill) {
+    map.erase(key);
+    expected.erase(key);
+  }
+  total = leftFill + rightFill;
+  EXPECT_EQ(height(map), 2);
+  EXPECT_EQ(
+      leafFills(map), (std::vector<size_t>{total / 2, total - total / 2}));
+  checkMap(map, expected);
+}
+
+TEST_F(PersistentSortedMapTest, InnerSplitAndRootCollapse) {
+  // enough entries in ascending order to split inner nodes too
+  int numEntries = kMaxFill * kMaxFill;
+  Map map;
+  std::map<int, int> expected;
+  size_t prevHeight = 0;
+  for (int key = 0; key < numEntries; ++key) {
+    map.emplace(key, key);
+    expected.emplace(key, key);
+    // the tree only grows at the root, one level at a time
+    EXPECT_LE(height(map), prevHeight + 1);
+    prevHeight = height(map);
+  }
+  checkMap(map, expected);
+  EXPECT_EQ(height(map), 3);
+
+  // a copy shares the whole tree until either side changes
+  auto copy = map;
+
+  // erasing from the middle out merges and borrows between inner nodes
+  // too, collapsing the root as it runs out of children
+  std::vector<int> keys;
+  for (int offset = 0; offset < numEntries / 2; ++offset) {
+    keys.push_back(numEntries / 2 + offset);
+    keys.push_back(numEntries / 2 - offset - 1);
+  }
+  for (auto key : keys) {
+    EXPECT_EQ(map.erase(key), 1);
+    expected.erase(key);
+    EXPECT_LE(height(map), prevHeight);
+    prevHeight = height(map);
+    if (expected.size() % kMinFill == 0) {
+      checkMap(map, expected);
+    }
+  }
+  checkMap(map, {});
+  EXPECT_EQ(height(map), 0);
+  EXPECT_EQ(copy.size(), numEntries);
+  EXPECT_EQ(height(copy), 3);
+  std::map<int, int> copyExpected;
+  for (int key = 0; key < numEntries; ++key) {
+    copyExpected.emplace(key, key);
+  }
+  checkMap(copy, copyExpected);
+}
+
+} // namespace facebook::fboss::thrift_cow
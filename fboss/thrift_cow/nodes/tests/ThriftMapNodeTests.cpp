@@ -661,3 +661,64 @@ TEST(ThriftMapNodeTests, MapDelta) {
     EXPECT_EQ(newNode->toThrift(), buildPortRange(1001, 1999));
   });
 }
+
+namespace {
+struct PersistentMapTraits : ThriftMapTraits<
+                                 false,
+                                 apache::thrift::type_class::map<
+                                     apache::thrift::type_class::integral,
+                                     apache::thrift::type_class::structure>,
+                                 std::map<int, cfg::L4PortRange>> {
+  template <typename K, typename V>
+  using MapStorage = PersistentSortedMap<K, V>;
+};
+} // namespace
+
+TEST(ThriftMapNodeTests, PersistentStorageModify) {
+  using Map = ThriftMapNode<PersistentMapTraits>;
+  static_assert(std::is_same_v<
+                Map::Fields::StorageType,
+                PersistentSortedMap<int, std::shared_ptr<Map::value_type>>>);
+
+  std::map<int, cfg::L4PortRange> data;
+  for (int i = 0; i < 1000; ++i) {
+    data.emplace(i, buildPortRange(i, i + 1));
+  }
+  auto map = std::make_shared<Map>(data);
+  map->publish();
+
+  auto map1 = map->clone();
+  map1->remove(10);
+  map1->emplace(1000, buildPortRange(1000, 1001));
+  Map::modify(&map1, "20");
+  map1->ref(20)->template set<sk::max>(2000);
+  map1->publish();
+
+  // the original map is unaffected and unchanged children are shared
+  EXPECT_EQ(map->size(), 1000);
+  EXPECT_EQ(map->toThrift(), data);
+  EXPECT_EQ(map1->size(), 1000);
+  EXPECT_EQ(map->cref(0), map1->cref(0));
+  EXPECT_NE(map->cref(20), map1->cref(20));
+  EXPECT_EQ(*map->cref(20)->toThrift().max(), 21);
+  EXPECT_EQ(*map1->cref(20)->toThrift().max(), 2000);
+  EXPECT_EQ(map1->find(10), map1->end());
+
+  // iteration stays sorted
+  int prev = -1;
+  for (const auto& [key, value] : std::as_const(*map1)) {
+    EXPECT_LT(prev, key);
+    prev = key;
+  }
+
+  auto delta = ThriftMapDelta(map.get(), map1.get());
+  int added = 0, removed = 0, changed = 0;
+  DeltaFunctions::forEachChanged(
+      delta,
+      [&](auto /* oldNode */, auto /* newNode */) { ++changed; },
+      [&](auto /* addedNode */) { ++added; },
+      [&](auto /* removedNode */) { ++removed; });
+  EXPECT_EQ(added, 1);
+  EXPECT_EQ(removed, 1);
+  EXPECT_EQ(changed, 1);
+}